@@ -0,0 +1,315 @@
+/**
+ * @file ansi_frame.c
+ * @brief Реализация сборки кадра терминала в буфер ANSI.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "../../include/brickgame/common/ansi_frame.h"
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/// Худший случай для одной клетки: CSI 99999;99999H и два символа.
+#define CELL_BYTES_MAX 16
+/// Запас на очистку экрана и панель.
+#define PANEL_BYTES_MAX 1024
+
+/// Строки панели (в строках терминала, считая с 1).
+#define PANEL_ROW_NEXT 2
+#define PANEL_ROW_SCORE 8
+#define PANEL_ROW_VIEW 15
+
+/**
+ * @brief Положение курсора терминала после уже собранной части кадра.
+ */
+typedef struct {
+  int row;
+  int col;
+} Cursor;
+
+static void append(AnsiFrame *frame, const char *text, size_t len) {
+  if (frame->len + len > frame->capacity) len = frame->capacity - frame->len;
+  memcpy(frame->buf + frame->len, text, len);
+  frame->len += len;
+}
+
+static void append_fmt(AnsiFrame *frame, const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  size_t room = frame->capacity - frame->len;
+  int written = vsnprintf(frame->buf + frame->len, room, format, args);
+  va_end(args);
+  if (written > 0) {
+    frame->len += (size_t)written < room ? (size_t)written : room - 1;
+  }
+}
+
+/**
+ * @brief Переставляет курсор, если он уже не стоит в нужной позиции.
+ */
+static void move_to(AnsiFrame *frame, Cursor *cursor, int row, int col) {
+  if (cursor->row == row && cursor->col == col) return;
+  append_fmt(frame, "\x1b[%d;%dH", row, col);
+  cursor->row = row;
+  cursor->col = col;
+}
+
+static void put(AnsiFrame *frame, Cursor *cursor, const char *text,
+                size_t len) {
+  append(frame, text, len);
+  cursor->col += (int)len;
+}
+
+static uint8_t cell_at(const GameInfo_t *info, int x, int y) {
+  return info->field && info->field[y][x] ? 1 : 0;
+}
+
+/**
+ * @brief Размер окна просмотра для терминала cols x rows.
+ */
+static void fit_viewport(AnsiFrame *frame, int term_cols, int term_rows) {
+  int cols = (term_cols - 3 - ANSI_FRAME_PANEL_COLS) / 2;
+  int rows = term_rows - 2;
+  frame->view_w = cols < 1 ? 1 : (cols > frame->width ? frame->width : cols);
+  frame->view_h = rows < 1 ? 1 : (rows > frame->height ? frame->height : rows);
+}
+
+/**
+ * @brief Худший размер кадра для окна view_w x view_h: все клетки окна,
+ *        рамка и панель, каждая с перестановкой курсора.
+ */
+static size_t capacity_for(int view_w, int view_h) {
+  return (size_t)view_w * view_h * CELL_BYTES_MAX +
+         (size_t)(view_w + view_h) * 2 * CELL_BYTES_MAX + PANEL_BYTES_MAX;
+}
+
+/**
+ * @brief Увеличивает буфер кадра под окно view_w x view_h.
+ * @return false при нехватке памяти (буфер остаётся прежним)
+ */
+static bool reserve(AnsiFrame *frame, int view_w, int view_h) {
+  size_t capacity = capacity_for(view_w, view_h);
+  if (capacity <= frame->capacity) return true;
+  char *buf = realloc(frame->buf, capacity);
+  if (!buf) return false;
+  frame->buf = buf;
+  frame->capacity = capacity;
+  return true;
+}
+
+static int clamp(int value, int low, int high) {
+  return value < low ? low : (value > high ? high : value);
+}
+
+bool ansi_frame_init(AnsiFrame *frame, int width, int height, int term_cols,
+                     int term_rows) {
+  memset(frame, 0, sizeof(*frame));
+  if (width <= 0 || height <= 0) return false;
+
+  frame->width = width;
+  frame->height = height;
+  fit_viewport(frame, term_cols, term_rows);
+  frame->shown = calloc((size_t)width * height, 1);
+  if (!frame->shown || !reserve(frame, frame->view_w, frame->view_h)) {
+    ansi_frame_free(frame);
+    return false;
+  }
+  frame->full = true;
+  return true;
+}
+
+void ansi_frame_free(AnsiFrame *frame) {
+  free(frame->buf);
+  free(frame->shown);
+  frame->buf = NULL;
+  frame->shown = NULL;
+  frame->capacity = 0;
+  frame->len = 0;
+}
+
+bool ansi_frame_resize(AnsiFrame *frame, int term_cols, int term_rows) {
+  int view_w = frame->view_w;
+  int view_h = frame->view_h;
+  fit_viewport(frame, term_cols, term_rows);
+  if (!reserve(frame, frame->view_w, frame->view_h)) {
+    frame->view_w = view_w;
+    frame->view_h = view_h;
+    return false;
+  }
+  frame->view_x = clamp(frame->view_x, 0, frame->width - frame->view_w);
+  frame->view_y = clamp(frame->view_y, 0, frame->height - frame->view_h);
+  frame->full = true;
+  return true;
+}
+
+void ansi_frame_invalidate(AnsiFrame *frame) { frame->full = true; }
+
+/**
+ * @brief Сдвигает окно к области изменений, если она ушла к краю.
+ * @return true, если окно сдвинулось
+ */
+static bool follow_changes(AnsiFrame *frame, const GameInfo_t *info) {
+  if (frame->view_w == frame->width && frame->view_h == frame->height) {
+    return false;
+  }
+
+  int x0 = frame->width, y0 = frame->height, x1 = -1, y1 = -1;
+  for (int y = 0; y < frame->height; ++y) {
+    const uint8_t *shown = frame->shown + (size_t)y * frame->width;
+    for (int x = 0; x < frame->width; ++x) {
+      if (cell_at(info, x, y) == shown[x]) continue;
+      if (x < x0) x0 = x;
+      if (x > x1) x1 = x;
+      if (y < y0) y0 = y;
+      if (y > y1) y1 = y;
+    }
+  }
+  if (x1 < 0) return false;
+
+  int view_x = frame->view_x;
+  int view_y = frame->view_y;
+  int cx = (x0 + x1) / 2;
+  int cy = (y0 + y1) / 2;
+  int margin_x = frame->view_w / 4;
+  int margin_y = frame->view_h / 4;
+  if (cx < view_x + margin_x || cx >= view_x + frame->view_w - margin_x) {
+    view_x = cx - frame->view_w / 2;
+  }
+  if (cy < view_y + margin_y || cy >= view_y + frame->view_h - margin_y) {
+    view_y = cy - frame->view_h / 2;
+  }
+  view_x = clamp(view_x, 0, frame->width - frame->view_w);
+  view_y = clamp(view_y, 0, frame->height - frame->view_h);
+
+  bool moved = view_x != frame->view_x || view_y != frame->view_y;
+  frame->view_x = view_x;
+  frame->view_y = view_y;
+  return moved;
+}
+
+static void compose_borders(AnsiFrame *frame, Cursor *cursor) {
+  int right = 2 + frame->view_w * 2;
+  for (int row = 1; row <= frame->view_h + 2; row += frame->view_h + 1) {
+    move_to(frame, cursor, row, 1);
+    put(frame, cursor, "+", 1);
+    for (int i = 0; i < frame->view_w * 2; ++i) put(frame, cursor, "-", 1);
+    put(frame, cursor, "+", 1);
+  }
+  for (int row = 2; row <= frame->view_h + 1; ++row) {
+    move_to(frame, cursor, row, 1);
+    put(frame, cursor, "|", 1);
+    move_to(frame, cursor, row, right);
+    put(frame, cursor, "|", 1);
+  }
+}
+
+static void compose_cells(AnsiFrame *frame, Cursor *cursor,
+                          const GameInfo_t *info, bool full) {
+  for (int vy = 0; vy < frame->view_h; ++vy) {
+    int y = frame->view_y + vy;
+    const uint8_t *shown = frame->shown + (size_t)y * frame->width;
+    for (int vx = 0; vx < frame->view_w; ++vx) {
+      int x = frame->view_x + vx;
+      uint8_t cell = cell_at(info, x, y);
+      if (!full && cell == shown[x]) continue;
+      move_to(frame, cursor, 2 + vy, 2 + vx * 2);
+      put(frame, cursor, cell ? "[]" : "  ", 2);
+    }
+  }
+}
+
+static void compose_panel(AnsiFrame *frame, Cursor *cursor,
+                          const GameInfo_t *info, bool full) {
+  int col = 2 * frame->view_w + 4;
+
+  uint16_t mask = 0;
+  if (info->next) {
+    for (int y = 0; y < ANSI_FRAME_NEXT_SIZE; ++y) {
+      for (int x = 0; x < ANSI_FRAME_NEXT_SIZE; ++x) {
+        if (info->next[y][x]) mask |= (uint16_t)(1u << (y * 4 + x));
+      }
+    }
+  }
+  bool has_next = info->next != NULL;
+  if (has_next && (full || !frame->has_next || mask != frame->next_mask)) {
+    move_to(frame, cursor, PANEL_ROW_NEXT, col);
+    put(frame, cursor, "Next:", 5);
+    for (int y = 0; y < ANSI_FRAME_NEXT_SIZE; ++y) {
+      move_to(frame, cursor, PANEL_ROW_NEXT + 1 + y, col);
+      for (int x = 0; x < ANSI_FRAME_NEXT_SIZE; ++x) {
+        put(frame, cursor, mask & (1u << (y * 4 + x)) ? "[]" : "  ", 2);
+      }
+    }
+  }
+  frame->next_mask = mask;
+  frame->has_next = has_next;
+
+  static const char *const labels[] = {"Score: ", "High:  ", "Level: ",
+                                       "Speed: ", ""};
+  const int values[] = {info->score, info->high_score, info->level,
+                        info->speed, info->pause};
+  for (int i = 0; i < 5; ++i) {
+    if (!full && values[i] == frame->panel[i]) continue;
+    frame->panel[i] = values[i];
+    int row = PANEL_ROW_SCORE + i + (i == 4 ? 1 : 0);
+    move_to(frame, cursor, row, col);
+    if (i == 4) {
+      append_fmt(frame, "%s\x1b[K", values[i] ? "PAUSED" : "");
+    } else {
+      append_fmt(frame, "%s%d\x1b[K", labels[i], values[i]);
+    }
+    cursor->row = -1;  // длина вывода не отслеживается
+  }
+
+  if (full && (frame->view_w < frame->width || frame->view_h < frame->height)) {
+    move_to(frame, cursor, PANEL_ROW_VIEW, col);
+    append_fmt(frame, "View %d,%d of %dx%d", frame->view_x, frame->view_y,
+               frame->width, frame->height);
+    cursor->row = -1;
+  }
+}
+
+size_t ansi_frame_compose(AnsiFrame *frame, const GameInfo_t *info) {
+  frame->len = 0;
+  if (!frame->buf) return 0;
+
+  bool full = follow_changes(frame, info) || frame->full;
+  Cursor cursor = {-1, -1};
+  if (full) {
+    append(frame, "\x1b[H\x1b[2J", 7);
+    compose_borders(frame, &cursor);
+  }
+  compose_cells(frame, &cursor, info, full);
+  compose_panel(frame, &cursor, info, full);
+
+  for (int y = 0; y < frame->height; ++y) {
+    uint8_t *shown = frame->shown + (size_t)y * frame->width;
+    for (int x = 0; x < frame->width; ++x) shown[x] = cell_at(info, x, y);
+  }
+  frame->full = false;
+  return frame->len;
+}
+
+bool ansi_frame_flush(AnsiFrame *frame, int fd) {
+  size_t done = 0;
+  while (done < frame->len) {
+    ssize_t written = write(fd, frame->buf + done, frame->len - done);
+    frame->writes++;
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      frame->full = true;
+      return false;
+    }
+    done += (size_t)written;
+  }
+  if (frame->len > 0) {
+    frame->frames++;
+    frame->bytes += frame->len;
+  }
+  frame->len = 0;
+  return true;
+}
@@ -0,0 +1,411 @@
+/**
+ * @file frame_broadcast.c
+ * @brief Реализация рассылки кадров зрителям.
+ *
+ * Формат пакета (little-endian):
+ * - заголовок: тип (u8), seq (u32), ширина (u16), высота (u16),
+ *   score, high_score, level, speed, pause (i32);
+ * - keyframe: пары (значение u8, длина серии u8) по всем клеткам;
+ * - delta: число изменений (u32), затем пары (индекс, значение u8),
+ *   индекс u16 для полей до 65535 клеток, иначе u32.
+ *
+ * Клетки кадра — это поле width*height, за которым идут 4x4 клетки
+ * превью следующей фигуры.
+ *
+ * Кадр сначала кодируется дельтой прямо в пакет; RLE считается только
+ * для ключевого кадра или если дельта не уложилась в байт на клетку.
+ * Все пакеты рассыльщика одной ёмкости (заголовок и худший RLE), поэтому
+ * вытесненный из истории пакет, который уже отпустили зрители, идёт под
+ * новый кадр без malloc.
+ */
+#include "../../include/brickgame/common/frame_broadcast.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/// Вытесненных из истории пакетов, ждущих release зрителей.
+#define BROADCAST_SPARE_PACKETS 4
+
+struct FrameBroadcaster {
+  int width;
+  int height;
+  size_t cell_count;
+  int keyframe_interval;
+  int history;
+  uint8_t *prev_cells;
+  uint8_t *cur_cells;
+  size_t packet_size;  ///< Ёмкость data любого пакета
+  BroadcastPacket **ring;
+  /// Пакеты вне истории, на которые рассыльщик ещё держит ссылку.
+  BroadcastPacket *spare[BROADCAST_SPARE_PACKETS];
+  int spare_count;
+  uint32_t next_seq;
+  uint32_t retained;
+  uint32_t last_keyframe_seq;
+  int frames_since_keyframe;
+};
+
+/**
+ * @brief Записывает 16-битное число в буфер (little-endian).
+ */
+static uint8_t *put_u16(uint8_t *p, uint32_t v) {
+  p[0] = (uint8_t)(v & 0xFF);
+  p[1] = (uint8_t)((v >> 8) & 0xFF);
+  return p + 2;
+}
+
+/**
+ * @brief Записывает 32-битное число в буфер (little-endian).
+ */
+static uint8_t *put_u32(uint8_t *p, uint32_t v) {
+  p[0] = (uint8_t)(v & 0xFF);
+  p[1] = (uint8_t)((v >> 8) & 0xFF);
+  p[2] = (uint8_t)((v >> 16) & 0xFF);
+  p[3] = (uint8_t)((v >> 24) & 0xFF);
+  return p + 4;
+}
+
+static uint32_t get_u16(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+         ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief Переводит значение клетки GameInfo_t в байт.
+ */
+static uint8_t clamp_cell(int value) {
+  if (value < 0) return 0;
+  if (value > 255) return 255;
+  return (uint8_t)value;
+}
+
+/**
+ * @brief Собирает клетки кадра (поле + next) из GameInfo_t.
+ */
+static void gather_cells(const FrameBroadcaster *b, const GameInfo_t *info,
+                         uint8_t *cells) {
+  size_t i = 0;
+  for (int y = 0; y < b->height; ++y) {
+    const int *row = (info->field) ? info->field[y] : NULL;
+    for (int x = 0; x < b->width; ++x) {
+      cells[i++] = row ? clamp_cell(row[x]) : 0;
+    }
+  }
+  for (int y = 0; y < BROADCAST_NEXT_SIZE; ++y) {
+    const int *row = (info->next) ? info->next[y] : NULL;
+    for (int x = 0; x < BROADCAST_NEXT_SIZE; ++x) {
+      cells[i++] = row ? clamp_cell(row[x]) : 0;
+    }
+  }
+}
+
+/**
+ * @brief Пишет заголовок пакета.
+ */
+static uint8_t *write_header(const FrameBroadcaster *b, uint8_t *p,
+                             BroadcastPacketType type, uint32_t seq,
+                             const GameInfo_t *info) {
+  *p++ = (uint8_t)type;
+  p = put_u32(p, seq);
+  p = put_u16(p, (uint32_t)b->width);
+  p = put_u16(p, (uint32_t)b->height);
+  p = put_u32(p, (uint32_t)info->score);
+  p = put_u32(p, (uint32_t)info->high_score);
+  p = put_u32(p, (uint32_t)info->level);
+  p = put_u32(p, (uint32_t)info->speed);
+  p = put_u32(p, (uint32_t)info->pause);
+  return p;
+}
+
+/**
+ * @brief Кодирует клетки в RLE (значение, длина серии).
+ * @return число записанных байт
+ */
+static size_t encode_rle(const uint8_t *cells, size_t count, uint8_t *out) {
+  size_t n = 0;
+  size_t i = 0;
+  while (i < count) {
+    uint8_t value = cells[i];
+    size_t run = 1;
+    while (i + run < count && run < 255 && cells[i + run] == value) ++run;
+    out[n++] = value;
+    out[n++] = (uint8_t)run;
+    i += run;
+  }
+  return n;
+}
+
+/**
+ * @brief Кодирует изменившиеся клетки.
+ * @return число записанных байт или 0, если дельта не короче limit
+ */
+static size_t encode_delta(const FrameBroadcaster *b, uint8_t *out,
+                           size_t limit) {
+  const int wide = b->cell_count > 0xFFFF;
+  const size_t entry = wide ? 5 : 3;
+  uint8_t *p = out + 4;
+  uint32_t changes = 0;
+  size_t size = 4;
+
+  for (size_t i = 0; i < b->cell_count; ++i) {
+    if (b->cur_cells[i] == b->prev_cells[i]) continue;
+    size += entry;
+    if (size >= limit) return 0;
+    p = wide ? put_u32(p, (uint32_t)i) : put_u16(p, (uint32_t)i);
+    *p++ = b->cur_cells[i];
+    ++changes;
+  }
+  put_u32(out, changes);
+  return size;
+}
+
+/**
+ * @brief Откладывает вытесненный из истории пакет.
+ *
+ * Если запас полон, отпускается самый старый отложенный: его дольше всех
+ * держит отставший зритель, а свежевытесненный скорее уже свободен.
+ */
+static void packet_retire(FrameBroadcaster *b, BroadcastPacket *packet) {
+  if (b->spare_count == BROADCAST_SPARE_PACKETS) {
+    broadcast_packet_release(b->spare[0]);
+    memmove(b->spare, b->spare + 1,
+            sizeof(b->spare[0]) * (BROADCAST_SPARE_PACKETS - 1));
+    b->spare_count--;
+  }
+  b->spare[b->spare_count++] = packet;
+}
+
+/**
+ * @brief Пакет под новый кадр с одной ссылкой: отложенный, который
+ *        зрители уже отпустили, или новый.
+ *
+ * Счётчик 1 значит, что ссылка осталась только у рассыльщика, а новых
+ * ссылок на пакет вне истории никто не возьмёт. Захват (acquire)
+ * упорядочивает запись кадра после чтений зрителя до его release.
+ */
+static BroadcastPacket *packet_acquire(FrameBroadcaster *b) {
+  for (int i = 0; i < b->spare_count; ++i) {
+    BroadcastPacket *packet = b->spare[i];
+    if (__atomic_load_n(&packet->refcount, __ATOMIC_ACQUIRE) == 1) {
+      memmove(b->spare + i, b->spare + i + 1,
+              sizeof(b->spare[0]) * (size_t)(b->spare_count - i - 1));
+      b->spare_count--;
+      return packet;
+    }
+  }
+  BroadcastPacket *packet =
+      (BroadcastPacket *)malloc(sizeof(BroadcastPacket) + b->packet_size);
+  if (packet) packet->refcount = 1;
+  return packet;
+}
+
+FrameBroadcaster *broadcaster_create(int width, int height,
+                                     int keyframe_interval, int history) {
+  if (width <= 0 || height <= 0 || width > 0xFFFF || height > 0xFFFF ||
+      keyframe_interval < 1 || history < keyframe_interval) {
+    return NULL;
+  }
+
+  FrameBroadcaster *b = (FrameBroadcaster *)calloc(1, sizeof(*b));
+  if (!b) return NULL;
+
+  b->width = width;
+  b->height = height;
+  b->cell_count = (size_t)width * (size_t)height +
+                  BROADCAST_NEXT_SIZE * BROADCAST_NEXT_SIZE;
+  b->keyframe_interval = keyframe_interval;
+  b->history = history;
+  b->prev_cells = (uint8_t *)calloc(b->cell_count, 1);
+  b->cur_cells = (uint8_t *)calloc(b->cell_count, 1);
+  b->packet_size = BROADCAST_HEADER_SIZE + 2 * b->cell_count;
+  b->ring = (BroadcastPacket **)calloc((size_t)history, sizeof(*b->ring));
+
+  if (!b->prev_cells || !b->cur_cells || !b->ring) {
+    broadcaster_destroy(b);
+    return NULL;
+  }
+  return b;
+}
+
+void broadcaster_destroy(FrameBroadcaster *b) {
+  if (!b) return;
+  if (b->ring) {
+    for (int i = 0; i < b->history; ++i) {
+      if (b->ring[i]) broadcast_packet_release(b->ring[i]);
+    }
+  }
+  for (int i = 0; i < b->spare_count; ++i) {
+    broadcast_packet_release(b->spare[i]);
+  }
+  free(b->ring);
+  free(b->cur_cells);
+  free(b->prev_cells);
+  free(b);
+}
+
+const BroadcastPacket *broadcaster_publish(FrameBroadcaster *b,
+                                           const GameInfo_t *info) {
+  if (!b || !info) return NULL;
+
+  gather_cells(b, info, b->cur_cells);
+
+  const uint32_t seq = b->next_seq;
+  BroadcastPacket *packet = packet_acquire(b);
+  if (!packet) return NULL;
+
+  uint8_t *body = packet->data + BROADCAST_HEADER_SIZE;
+  BroadcastPacketType type = BROADCAST_KEYFRAME;
+  size_t body_size = 0;
+
+  const int need_keyframe =
+      (seq == 0) || (b->frames_since_keyframe + 1 >= b->keyframe_interval);
+  if (!need_keyframe) {
+    /* Дельта длиннее байта на клетку — почти весь кадр сменился. */
+    body_size = encode_delta(b, body, b->cell_count);
+    if (body_size > 0) type = BROADCAST_DELTA;
+  }
+  if (type == BROADCAST_KEYFRAME) {
+    body_size = encode_rle(b->cur_cells, b->cell_count, body);
+  }
+
+  write_header(b, packet->data, type, seq, info);
+  packet->seq = seq;
+  packet->type = type;
+  packet->size = BROADCAST_HEADER_SIZE + body_size;
+
+  BroadcastPacket **slot = &b->ring[seq % (uint32_t)b->history];
+  if (*slot) packet_retire(b, *slot);
+  *slot = packet;
+
+  if (type == BROADCAST_KEYFRAME) {
+    b->last_keyframe_seq = seq;
+    b->frames_since_keyframe = 0;
+  } else {
+    b->frames_since_keyframe++;
+  }
+  if (b->retained < (uint32_t)b->history) b->retained++;
+  b->next_seq = seq + 1;
+
+  uint8_t *tmp = b->prev_cells;
+  b->prev_cells = b->cur_cells;
+  b->cur_cells = tmp;
+
+  return packet;
+}
+
+BroadcastCursor broadcaster_subscribe(const FrameBroadcaster *b) {
+  BroadcastCursor cursor = {0, true};
+  if (b && b->next_seq > 0) cursor.next_seq = b->last_keyframe_seq;
+  return cursor;
+}
+
+const BroadcastPacket *broadcaster_poll(const FrameBroadcaster *b,
+                                        BroadcastCursor *cursor) {
+  if (!b || !cursor || cursor->next_seq >= b->next_seq) return NULL;
+
+  const uint32_t oldest = b->next_seq - b->retained;
+  if (!cursor->synced || cursor->next_seq < oldest) {
+    cursor->next_seq = b->last_keyframe_seq;
+    cursor->synced = true;
+  }
+
+  const BroadcastPacket *packet =
+      b->ring[cursor->next_seq % (uint32_t)b->history];
+  broadcast_packet_retain(packet);
+  cursor->next_seq++;
+  return packet;
+}
+
+void broadcast_packet_retain(const BroadcastPacket *packet) {
+  if (!packet) return;
+  __atomic_add_fetch(&((BroadcastPacket *)packet)->refcount, 1,
+                     __ATOMIC_RELAXED);
+}
+
+void broadcast_packet_release(const BroadcastPacket *packet) {
+  if (!packet) return;
+  if (__atomic_sub_fetch(&((BroadcastPacket *)packet)->refcount, 1,
+                         __ATOMIC_ACQ_REL) == 0) {
+    free((void *)packet);
+  }
+}
+
+bool broadcast_frame_init(BroadcastFrame *frame, int width, int height) {
+  if (!frame || width <= 0 || height <= 0) return false;
+  memset(frame, 0, sizeof(*frame));
+  frame->width = width;
+  frame->height = height;
+  frame->cells = (uint8_t *)calloc(
+      (size_t)width * (size_t)height + BROADCAST_NEXT_SIZE * BROADCAST_NEXT_SIZE,
+      1);
+  frame->seq = UINT32_MAX;
+  return frame->cells != NULL;
+}
+
+void broadcast_frame_free(BroadcastFrame *frame) {
+  if (!frame) return;
+  free(frame->cells);
+  frame->cells = NULL;
+}
+
+bool broadcast_frame_apply(BroadcastFrame *frame,
+                           const BroadcastPacket *packet) {
+  if (!frame || !frame->cells || !packet ||
+      packet->size < BROADCAST_HEADER_SIZE) {
+    return false;
+  }
+
+  const uint8_t *p = packet->data;
+  const uint8_t *end = packet->data + packet->size;
+  BroadcastPacketType type = (BroadcastPacketType)p[0];
+  uint32_t seq = get_u32(p + 1);
+  if ((int)get_u16(p + 5) != frame->width ||
+      (int)get_u16(p + 7) != frame->height) {
+    return false;
+  }
+  if (type == BROADCAST_DELTA && seq != frame->seq + 1) return false;
+
+  const size_t count = (size_t)frame->width * (size_t)frame->height +
+                       BROADCAST_NEXT_SIZE * BROADCAST_NEXT_SIZE;
+  p += BROADCAST_HEADER_SIZE;
+
+  if (type == BROADCAST_KEYFRAME) {
+    size_t i = 0;
+    while (p + 2 <= end && i < count) {
+      size_t run = p[1];
+      if (i + run > count) return false;
+      memset(frame->cells + i, p[0], run);
+      i += run;
+      p += 2;
+    }
+    if (i != count) return false;
+  } else if (type == BROADCAST_DELTA) {
+    if (p + 4 > end) return false;
+    const int wide = count > 0xFFFF;
+    const size_t entry = wide ? 5 : 3;
+    uint32_t changes = get_u32(p);
+    p += 4;
+    if ((size_t)(end - p) < (size_t)changes * entry) return false;
+    for (uint32_t c = 0; c < changes; ++c) {
+      size_t index = wide ? get_u32(p) : get_u16(p);
+      if (index >= count) return false;
+      frame->cells[index] = p[entry - 1];
+      p += entry;
+    }
+  } else {
+    return false;
+  }
+
+  const uint8_t *h = packet->data + 9;
+  frame->score = (int)get_u32(h);
+  frame->high_score = (int)get_u32(h + 4);
+  frame->level = (int)get_u32(h + 8);
+  frame->speed = (int)get_u32(h + 12);
+  frame->pause = (int)get_u32(h + 16);
+  frame->seq = seq;
+  return true;
+}
@@ -0,0 +1,354 @@
+/**
+ * @file frame_ring.c
+ * @brief Реализация кольца кадров в разделяемой памяти.
+ *
+ * Сегмент состоит из заголовка (параметры поля, счётчик кадров, очередь
+ * ввода) и массива слотов кадров. Каждый слот защищён seqlock: нечётное
+ * значение — слот переписывается, чётное 2n+2 — в слоте кадр n.
+ * Очередь ввода — ограниченная MPMC-очередь на последовательностях
+ * ячеек, все операции без блокировок.
+ */
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#include "../../include/brickgame/common/frame_ring.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define FRAME_RING_MAGIC 0x42474652u /* "BGFR" */
+#define FRAME_RING_VERSION 1u
+#define FRAME_RING_ALIGN 64
+
+typedef struct {
+  uint64_t sequence;
+  int32_t action;
+  int32_t hold;
+} RingInputCell;
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  int32_t width;
+  int32_t height;
+  int32_t capacity;
+  uint32_t slot_size;
+  uint32_t shutdown;
+  uint32_t reserved;
+  uint64_t write_seq;
+  uint64_t input_head __attribute__((aligned(FRAME_RING_ALIGN)));
+  uint64_t input_tail __attribute__((aligned(FRAME_RING_ALIGN)));
+  RingInputCell input[FRAME_RING_INPUT_CAPACITY]
+      __attribute__((aligned(FRAME_RING_ALIGN)));
+} RingHeader;
+
+typedef struct {
+  uint64_t seq;
+  int32_t score;
+  int32_t high_score;
+  int32_t level;
+  int32_t speed;
+  int32_t pause;
+  int32_t game_over;
+  int32_t cells[];
+} RingSlot;
+
+struct FrameRing {
+  RingHeader *header;
+  size_t map_size;
+  char *name;
+  int **rows;
+  int *next_rows[FRAME_RING_NEXT_SIZE];
+};
+
+/**
+ * @brief Размер слота для поля заданного размера (с выравниванием).
+ */
+static size_t slot_size_for(int width, int height) {
+  size_t cells = (size_t)width * (size_t)height +
+                 FRAME_RING_NEXT_SIZE * FRAME_RING_NEXT_SIZE;
+  size_t size = sizeof(RingSlot) + cells * sizeof(int32_t);
+  return (size + FRAME_RING_ALIGN - 1) & ~(size_t)(FRAME_RING_ALIGN - 1);
+}
+
+/**
+ * @brief Размер заголовка сегмента (с выравниванием).
+ */
+static size_t header_size(void) {
+  return (sizeof(RingHeader) + FRAME_RING_ALIGN - 1) &
+         ~(size_t)(FRAME_RING_ALIGN - 1);
+}
+
+static RingSlot *slot_at(const RingHeader *header, uint64_t index) {
+  return (RingSlot *)((char *)header + header_size() +
+                      (size_t)(index % (uint64_t)header->capacity) *
+                          header->slot_size);
+}
+
+/**
+ * @brief Создаёт локальный дескриптор поверх отображённого сегмента.
+ */
+static FrameRing *wrap_mapping(RingHeader *header, size_t map_size,
+                               const char *name) {
+  FrameRing *ring = (FrameRing *)calloc(1, sizeof(*ring));
+  if (!ring) return NULL;
+  ring->header = header;
+  ring->map_size = map_size;
+  ring->rows = (int **)calloc((size_t)header->height, sizeof(int *));
+  if (name) ring->name = strdup(name);
+  if (!ring->rows || (name && !ring->name)) {
+    free(ring->rows);
+    free(ring->name);
+    free(ring);
+    return NULL;
+  }
+  return ring;
+}
+
+FrameRing *frame_ring_create(const char *name, int width, int height,
+                             int capacity) {
+  if (width <= 0 || height <= 0 || capacity < 2) return NULL;
+
+  size_t slot_size = slot_size_for(width, height);
+  size_t map_size = header_size() + slot_size * (size_t)capacity;
+  void *mem = MAP_FAILED;
+
+  if (name) {
+    /* Существующий сегмент может быть отображён другим движком: не
+     * обрезаем его, а отказываемся создавать кольцо. */
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) return NULL;
+    if (ftruncate(fd, (off_t)map_size) == 0) {
+      mem = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+  } else {
+    mem = mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  }
+  if (mem == MAP_FAILED) {
+    if (name) shm_unlink(name);
+    return NULL;
+  }
+
+  memset(mem, 0, map_size);
+  RingHeader *header = (RingHeader *)mem;
+  header->version = FRAME_RING_VERSION;
+  header->width = width;
+  header->height = height;
+  header->capacity = capacity;
+  header->slot_size = (uint32_t)slot_size;
+  for (uint64_t i = 0; i < FRAME_RING_INPUT_CAPACITY; ++i) {
+    header->input[i].sequence = i;
+  }
+  __atomic_store_n(&header->magic, FRAME_RING_MAGIC, __ATOMIC_RELEASE);
+
+  FrameRing *ring = wrap_mapping(header, map_size, name);
+  if (!ring) {
+    munmap(mem, map_size);
+    if (name) shm_unlink(name);
+  }
+  return ring;
+}
+
+FrameRing *frame_ring_open(const char *name) {
+  if (!name) return NULL;
+
+  int fd = shm_open(name, O_RDWR, 0600);
+  if (fd < 0) return NULL;
+
+  struct stat st;
+  void *mem = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(RingHeader)) {
+    mem = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+               fd, 0);
+  }
+  close(fd);
+  if (mem == MAP_FAILED) return NULL;
+
+  RingHeader *header = (RingHeader *)mem;
+  size_t expected = 0;
+  if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) == FRAME_RING_MAGIC &&
+      header->version == FRAME_RING_VERSION && header->width > 0 &&
+      header->height > 0 && header->capacity >= 2 &&
+      header->slot_size >= slot_size_for(header->width, header->height)) {
+    expected = header_size() +
+               (size_t)header->slot_size * (size_t)header->capacity;
+  }
+  if (expected == 0 || expected > (size_t)st.st_size) {
+    munmap(mem, (size_t)st.st_size);
+    return NULL;
+  }
+
+  FrameRing *ring = wrap_mapping(header, (size_t)st.st_size, NULL);
+  if (!ring) munmap(mem, (size_t)st.st_size);
+  return ring;
+}
+
+void frame_ring_close(FrameRing *ring, bool unlink) {
+  if (!ring) return;
+  munmap(ring->header, ring->map_size);
+  if (unlink && ring->name) shm_unlink(ring->name);
+  free(ring->name);
+  free(ring->rows);
+  free(ring);
+}
+
+void frame_ring_publish(FrameRing *ring, const GameInfo_t *info,
+                        bool game_over) {
+  if (!ring || !info) return;
+
+  RingHeader *header = ring->header;
+  const uint64_t n = __atomic_load_n(&header->write_seq, __ATOMIC_RELAXED);
+  RingSlot *slot = slot_at(header, n);
+
+  __atomic_store_n(&slot->seq, 2 * n + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  slot->score = info->score;
+  slot->high_score = info->high_score;
+  slot->level = info->level;
+  slot->speed = info->speed;
+  slot->pause = info->pause;
+  slot->game_over = game_over ? 1 : 0;
+
+  int32_t *cells = slot->cells;
+  for (int y = 0; y < header->height; ++y) {
+    if (info->field && info->field[y]) {
+      memcpy(cells, info->field[y], (size_t)header->width * sizeof(int32_t));
+    } else {
+      memset(cells, 0, (size_t)header->width * sizeof(int32_t));
+    }
+    cells += header->width;
+  }
+  for (int y = 0; y < FRAME_RING_NEXT_SIZE; ++y) {
+    if (info->next && info->next[y]) {
+      memcpy(cells, info->next[y], FRAME_RING_NEXT_SIZE * sizeof(int32_t));
+    } else {
+      memset(cells, 0, FRAME_RING_NEXT_SIZE * sizeof(int32_t));
+    }
+    cells += FRAME_RING_NEXT_SIZE;
+  }
+
+  __atomic_store_n(&slot->seq, 2 * n + 2, __ATOMIC_RELEASE);
+  __atomic_store_n(&header->write_seq, n + 1, __ATOMIC_RELEASE);
+}
+
+bool frame_ring_read_latest(FrameRing *ring, FrameRingView *view) {
+  if (!ring || !view) return false;
+
+  RingHeader *header = ring->header;
+  const uint64_t written =
+      __atomic_load_n(&header->write_seq, __ATOMIC_ACQUIRE);
+  if (written == 0) return false;
+
+  const uint64_t n = written - 1;
+  RingSlot *slot = slot_at(header, n);
+  const uint64_t stamp = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+  if (stamp != 2 * n + 2) return false;
+
+  int32_t *cells = slot->cells;
+  for (int y = 0; y < header->height; ++y) {
+    ring->rows[y] = cells + (size_t)y * (size_t)header->width;
+  }
+  cells += (size_t)header->width * (size_t)header->height;
+  for (int y = 0; y < FRAME_RING_NEXT_SIZE; ++y) {
+    ring->next_rows[y] = cells + y * FRAME_RING_NEXT_SIZE;
+  }
+
+  view->info.field = ring->rows;
+  view->info.next = ring->next_rows;
+  view->info.score = slot->score;
+  view->info.high_score = slot->high_score;
+  view->info.level = slot->level;
+  view->info.speed = slot->speed;
+  view->info.pause = slot->pause;
+  view->game_over = slot->game_over != 0;
+  view->seq = n;
+  view->slot = slot;
+  view->stamp = stamp;
+
+  return frame_ring_view_valid(view);
+}
+
+bool frame_ring_view_valid(const FrameRingView *view) {
+  if (!view || !view->slot) return false;
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  const RingSlot *slot = (const RingSlot *)view->slot;
+  return __atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == view->stamp;
+}
+
+uint64_t frame_ring_frames(const FrameRing *ring) {
+  if (!ring) return 0;
+  return __atomic_load_n(&ring->header->write_seq, __ATOMIC_ACQUIRE);
+}
+
+bool frame_ring_push_input(FrameRing *ring, UserAction_t action, bool hold) {
+  if (!ring) return false;
+
+  RingHeader *header = ring->header;
+  const uint64_t mask = FRAME_RING_INPUT_CAPACITY - 1;
+  uint64_t pos = __atomic_load_n(&header->input_tail, __ATOMIC_RELAXED);
+
+  for (;;) {
+    RingInputCell *cell = &header->input[pos & mask];
+    uint64_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+    int64_t dif = (int64_t)seq - (int64_t)pos;
+    if (dif == 0) {
+      if (__atomic_compare_exchange_n(&header->input_tail, &pos, pos + 1,
+                                      true, __ATOMIC_RELAXED,
+                                      __ATOMIC_RELAXED)) {
+        cell->action = (int32_t)action;
+        cell->hold = hold ? 1 : 0;
+        __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+        return true;
+      }
+    } else if (dif < 0) {
+      return false;
+    } else {
+      pos = __atomic_load_n(&header->input_tail, __ATOMIC_RELAXED);
+    }
+  }
+}
+
+bool frame_ring_pop_input(FrameRing *ring, UserAction_t *action, bool *hold) {
+  if (!ring || !action || !hold) return false;
+
+  RingHeader *header = ring->header;
+  const uint64_t mask = FRAME_RING_INPUT_CAPACITY - 1;
+  uint64_t pos = __atomic_load_n(&header->input_head, __ATOMIC_RELAXED);
+
+  for (;;) {
+    RingInputCell *cell = &header->input[pos & mask];
+    uint64_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+    int64_t dif = (int64_t)seq - (int64_t)(pos + 1);
+    if (dif == 0) {
+      if (__atomic_compare_exchange_n(&header->input_head, &pos, pos + 1,
+                                      true, __ATOMIC_RELAXED,
+                                      __ATOMIC_RELAXED)) {
+        *action = (UserAction_t)cell->action;
+        *hold = cell->hold != 0;
+        __atomic_store_n(&cell->sequence, pos + mask + 1, __ATOMIC_RELEASE);
+        return true;
+      }
+    } else if (dif < 0) {
+      return false;
+    } else {
+      pos = __atomic_load_n(&header->input_head, __ATOMIC_RELAXED);
+    }
+  }
+}
+
+void frame_ring_request_shutdown(FrameRing *ring) {
+  if (!ring) return;
+  __atomic_store_n(&ring->header->shutdown, 1u, __ATOMIC_RELEASE);
+}
+
+bool frame_ring_shutdown_requested(const FrameRing *ring) {
+  if (!ring) return true;
+  return __atomic_load_n(&ring->header->shutdown, __ATOMIC_ACQUIRE) != 0;
+}
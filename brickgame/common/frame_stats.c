@@ -0,0 +1,139 @@
+/**
+ * @file frame_stats.c
+ * @brief Реализация гистограмм темпа кадров.
+ */
+#include "../../include/brickgame/common/frame_stats.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/// Ширина корзин по умолчанию: отрисовка, шаг движка, дрожание.
+#define PAINT_BUCKET_US 250
+#define STEP_BUCKET_US 100
+#define JITTER_BUCKET_US 500
+
+void frame_histogram_init(FrameHistogram *histogram, uint32_t bucket_us) {
+  memset(histogram, 0, sizeof(*histogram));
+  histogram->bucket_us = bucket_us ? bucket_us : 1;
+}
+
+void frame_histogram_add(FrameHistogram *histogram, uint64_t value_us) {
+  uint64_t index = value_us / histogram->bucket_us;
+  if (index < FRAME_HISTOGRAM_BUCKETS) {
+    histogram->buckets[index]++;
+  } else {
+    histogram->overflow++;
+  }
+  histogram->count++;
+  histogram->sum_us += value_us;
+  if (value_us > histogram->max_us) histogram->max_us = value_us;
+}
+
+uint64_t frame_histogram_percentile(const FrameHistogram *histogram,
+                                    double p) {
+  if (histogram->count == 0) return 0;
+  if (p < 0) p = 0;
+  if (p > 1) p = 1;
+
+  uint64_t rank = (uint64_t)(p * (double)histogram->count);
+  if (rank == 0) rank = 1;
+  uint64_t seen = 0;
+  for (int i = 0; i < FRAME_HISTOGRAM_BUCKETS; ++i) {
+    seen += histogram->buckets[i];
+    if (seen >= rank) {
+      uint64_t upper = (uint64_t)(i + 1) * histogram->bucket_us;
+      return upper < histogram->max_us ? upper : histogram->max_us;
+    }
+  }
+  return histogram->max_us;
+}
+
+uint64_t frame_histogram_peak(const FrameHistogram *histogram) {
+  uint64_t peak = histogram->overflow;
+  for (int i = 0; i < FRAME_HISTOGRAM_BUCKETS; ++i) {
+    if (histogram->buckets[i] > peak) peak = histogram->buckets[i];
+  }
+  return peak;
+}
+
+void frame_stats_init(FrameStats *stats, uint32_t target_us) {
+  memset(stats, 0, sizeof(*stats));
+  frame_histogram_init(&stats->paint, PAINT_BUCKET_US);
+  frame_histogram_init(&stats->step, STEP_BUCKET_US);
+  frame_histogram_init(&stats->jitter, JITTER_BUCKET_US);
+  stats->target_us = target_us;
+}
+
+void frame_stats_set_target(FrameStats *stats, uint32_t target_us) {
+  stats->target_us = target_us;
+}
+
+void frame_stats_resume(FrameStats *stats) { stats->has_last_tick = false; }
+
+void frame_stats_tick(FrameStats *stats, uint64_t now_us, uint64_t step_us) {
+  frame_histogram_add(&stats->step, step_us);
+
+  if (stats->has_last_tick && now_us >= stats->last_tick_us &&
+      stats->target_us > 0) {
+    uint64_t interval = now_us - stats->last_tick_us;
+    uint64_t target = stats->target_us;
+    frame_histogram_add(&stats->jitter, interval > target
+                                            ? interval - target
+                                            : target - interval);
+    stats->ticks++;
+    if (2 * interval > 3 * target) {
+      stats->late_ticks++;
+      /* Интервал, округлённый до целых кадров, минус сам этот кадр. */
+      uint64_t frames = (interval + target / 2) / target;
+      if (frames > 1) stats->dropped_frames += frames - 1;
+    }
+  }
+  stats->last_tick_us = now_us;
+  stats->has_last_tick = true;
+}
+
+void frame_stats_paint(FrameStats *stats, uint64_t paint_us) {
+  frame_histogram_add(&stats->paint, paint_us);
+}
+
+/**
+ * @brief Пишет сводку и корзины одной гистограммы.
+ */
+static void dump_histogram(FILE *file, const char *name,
+                           const FrameHistogram *histogram) {
+  fprintf(file,
+          "# %s: count=%llu mean_us=%llu p50_us=%llu p99_us=%llu "
+          "max_us=%llu\n",
+          name, (unsigned long long)histogram->count,
+          (unsigned long long)(histogram->count
+                                   ? histogram->sum_us / histogram->count
+                                   : 0),
+          (unsigned long long)frame_histogram_percentile(histogram, 0.5),
+          (unsigned long long)frame_histogram_percentile(histogram, 0.99),
+          (unsigned long long)histogram->max_us);
+  for (int i = 0; i < FRAME_HISTOGRAM_BUCKETS; ++i) {
+    fprintf(file, "%s,%llu,%llu,%llu\n", name,
+            (unsigned long long)i * histogram->bucket_us,
+            (unsigned long long)(i + 1) * histogram->bucket_us,
+            (unsigned long long)histogram->buckets[i]);
+  }
+  fprintf(file, "%s,%llu,-1,%llu\n", name,
+          (unsigned long long)FRAME_HISTOGRAM_BUCKETS * histogram->bucket_us,
+          (unsigned long long)histogram->overflow);
+}
+
+bool frame_stats_dump(const FrameStats *stats, const char *path) {
+  if (!path || !*path) return false;
+  FILE *file = fopen(path, "w");
+  if (!file) return false;
+
+  fprintf(file, "# target_us=%u ticks=%llu late=%llu dropped=%llu\n",
+          stats->target_us, (unsigned long long)stats->ticks,
+          (unsigned long long)stats->late_ticks,
+          (unsigned long long)stats->dropped_frames);
+  fprintf(file, "metric,bucket_start_us,bucket_end_us,count\n");
+  dump_histogram(file, "paint", &stats->paint);
+  dump_histogram(file, "step", &stats->step);
+  dump_histogram(file, "jitter", &stats->jitter);
+  return fclose(file) == 0;
+}
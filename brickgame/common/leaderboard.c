@@ -0,0 +1,598 @@
+/**
+ * @file leaderboard.c
+ * @brief Реализация таблицы лидеров в отображаемом в память файле.
+ *
+ * Файл — страницы по PAGE_SIZE_BYTES байт: заголовок и узлы B+-дерева.
+ * Листья хранят записи по убыванию счёта и связаны в список для
+ * leaderboard_top(). Внутренний узел хранит для каждого потомка номер
+ * страницы, число записей в его поддереве и счёт его первой записи:
+ * по счётам ищется место вставки, по числам записей — ранг и запись с
+ * данным рангом. Каждая операция читает по одной странице на уровень.
+ *
+ * Файл растёт удвоением (ftruncate) и отображается целиком через
+ * MAP_SHARED. Процесс, увидевший в заголовке больший размер файла,
+ * отображает его заново под блокировкой. Страницы, освободившиеся при
+ * вытеснении, идут в список свободных.
+ */
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+
+#include "../../include/brickgame/common/leaderboard.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LEADERBOARD_MAGIC 0x42474c42u /* "BGLB" */
+#define LEADERBOARD_VERSION 2u
+
+/// Размер страницы файла.
+#define PAGE_SIZE_BYTES 4096u
+/// Страниц в новом файле: заголовок, корень и запас.
+#define INITIAL_PAGES 4u
+/// Предел высоты дерева (2^32 записей укладываются в пять уровней).
+#define MAX_HEIGHT 16u
+
+/// Записей в листе.
+#define LEAF_RECORDS ((PAGE_SIZE_BYTES - 16) / sizeof(LeaderboardRecord))
+/// Потомков во внутреннем узле (номер страницы, размер, первый счёт).
+#define BRANCH_CHILDREN ((PAGE_SIZE_BYTES - 16) / 12)
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t record_size;
+  uint32_t page_size;
+  uint32_t capacity;
+  uint32_t count;
+  uint32_t root;        ///< Страница корня
+  uint32_t height;      ///< Уровней дерева (1 — корень является листом)
+  uint32_t page_count;  ///< Размеченных страниц, включая заголовок
+  uint32_t file_pages;  ///< Страниц в файле
+  uint32_t free_page;   ///< Первая свободная страница (0 — нет)
+  uint32_t reserved[5];
+} LeaderboardHeader;
+
+typedef struct {
+  uint32_t count;
+  uint32_t next;  ///< Следующий лист (у последнего не используется)
+  uint32_t reserved[2];
+  LeaderboardRecord records[LEAF_RECORDS];
+} LeafPage;
+
+typedef struct {
+  uint32_t count;
+  uint32_t reserved[3];
+  uint32_t child[BRANCH_CHILDREN];  ///< Страницы потомков
+  uint32_t size[BRANCH_CHILDREN];   ///< Записей в поддереве потомка
+  int32_t first[BRANCH_CHILDREN];   ///< Счёт первой записи потомка
+} BranchPage;
+
+struct Leaderboard {
+  int fd;
+  char *mem;
+  size_t map_size;
+};
+
+/**
+ * @brief Путь от корня к листу: страница и выбранная позиция на уровне.
+ */
+typedef struct {
+  uint32_t page[MAX_HEIGHT];
+  uint32_t index[MAX_HEIGHT];
+} TreePath;
+
+/**
+ * @brief Правый сосед, появившийся при разделении узла.
+ */
+typedef struct {
+  uint32_t page;  ///< 0 — узел не разделялся
+  uint32_t size;  ///< Записей в поддереве соседа
+  int32_t first;  ///< Счёт первой записи соседа
+} Split;
+
+static LeaderboardHeader *header_of(const Leaderboard *board) {
+  return (LeaderboardHeader *)board->mem;
+}
+
+static void *page_at(Leaderboard *board, uint32_t page) {
+  return board->mem + (size_t)page * PAGE_SIZE_BYTES;
+}
+
+static LeafPage *leaf_at(Leaderboard *board, uint32_t page) {
+  return (LeafPage *)page_at(board, page);
+}
+
+static BranchPage *branch_at(Leaderboard *board, uint32_t page) {
+  return (BranchPage *)page_at(board, page);
+}
+
+static bool map_pages(Leaderboard *board, uint32_t pages) {
+  size_t size = (size_t)pages * PAGE_SIZE_BYTES;
+  void *mem =
+      mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, board->fd, 0);
+  if (mem == MAP_FAILED) return false;
+  if (board->mem) munmap(board->mem, board->map_size);
+  board->mem = (char *)mem;
+  board->map_size = size;
+  return true;
+}
+
+/**
+ * @brief Отображает файл заново, если другой процесс его увеличил.
+ */
+static bool sync_mapping(Leaderboard *board) {
+  uint32_t pages = header_of(board)->file_pages;
+  if ((size_t)pages * PAGE_SIZE_BYTES == board->map_size) return true;
+  return map_pages(board, pages);
+}
+
+/**
+ * @brief Гарантирует need неразмеченных страниц в конце файла.
+ *
+ * Отображение может смениться, поэтому вызывается до того, как взяты
+ * указатели на страницы.
+ */
+static bool reserve_pages(Leaderboard *board, uint32_t need) {
+  LeaderboardHeader *header = header_of(board);
+  if (header->file_pages - header->page_count >= need) return true;
+
+  uint64_t pages = (uint64_t)header->file_pages * 2;
+  if (pages < (uint64_t)header->page_count + need) {
+    pages = (uint64_t)header->page_count + need;
+  }
+  if (pages > UINT32_MAX ||
+      ftruncate(board->fd, (off_t)(pages * PAGE_SIZE_BYTES)) != 0) {
+    return false;
+  }
+  header->file_pages = (uint32_t)pages;
+  return map_pages(board, (uint32_t)pages);
+}
+
+/**
+ * @brief Берёт страницу (свободную или из запаса reserve_pages()).
+ */
+static uint32_t alloc_page(Leaderboard *board) {
+  LeaderboardHeader *header = header_of(board);
+  uint32_t page = header->free_page;
+  if (page) {
+    header->free_page = *(uint32_t *)page_at(board, page);
+  } else {
+    page = header->page_count++;
+  }
+  memset(page_at(board, page), 0, PAGE_SIZE_BYTES);
+  return page;
+}
+
+static void release_page(Leaderboard *board, uint32_t page) {
+  LeaderboardHeader *header = header_of(board);
+  *(uint32_t *)page_at(board, page) = header->free_page;
+  header->free_page = page;
+}
+
+/**
+ * @brief Первая позиция листа, счёт в которой строго меньше score.
+ *
+ * Все записи до неё имеют счёт >= score, поэтому новая запись с равным
+ * счётом встаёт после них.
+ */
+static uint32_t leaf_upper_bound(const LeafPage *leaf, int32_t score) {
+  uint32_t lo = 0;
+  uint32_t hi = leaf->count;
+  while (lo < hi) {
+    uint32_t mid = lo + (hi - lo) / 2;
+    if (leaf->records[mid].score >= score) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+/**
+ * @brief Потомок, куда встанет запись со счётом score: последний, чья
+ *        первая запись имеет счёт не ниже score (или нулевой).
+ */
+static uint32_t branch_child_for(const BranchPage *branch, int32_t score) {
+  uint32_t lo = 1;
+  uint32_t hi = branch->count;
+  while (lo < hi) {
+    uint32_t mid = lo + (hi - lo) / 2;
+    if (branch->first[mid] >= score) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo - 1;
+}
+
+/**
+ * @brief Спускается к листу, куда встанет запись со счётом score.
+ *
+ * @return число записей со счётом не ниже score
+ */
+static uint32_t descend_score(Leaderboard *board, int32_t score,
+                              TreePath *path) {
+  const LeaderboardHeader *header = header_of(board);
+  uint32_t page = header->root;
+  uint32_t rank = 0;
+  for (uint32_t level = 0; level + 1 < header->height; ++level) {
+    const BranchPage *branch = branch_at(board, page);
+    uint32_t i = branch_child_for(branch, score);
+    for (uint32_t k = 0; k < i; ++k) rank += branch->size[k];
+    path->page[level] = page;
+    path->index[level] = i;
+    page = branch->child[i];
+  }
+  uint32_t pos = leaf_upper_bound(leaf_at(board, page), score);
+  path->page[header->height - 1] = page;
+  path->index[header->height - 1] = pos;
+  return rank + pos;
+}
+
+/**
+ * @brief Лист с записью ранга rank (rank < count).
+ *
+ * @param[out] pos позиция записи в листе
+ */
+static LeafPage *leaf_for_rank(Leaderboard *board, uint32_t rank,
+                               uint32_t *pos) {
+  const LeaderboardHeader *header = header_of(board);
+  uint32_t page = header->root;
+  for (uint32_t level = 0; level + 1 < header->height; ++level) {
+    const BranchPage *branch = branch_at(board, page);
+    uint32_t i = 0;
+    while (i + 1 < branch->count && rank >= branch->size[i]) {
+      rank -= branch->size[i++];
+    }
+    page = branch->child[i];
+  }
+  *pos = rank;
+  return leaf_at(board, page);
+}
+
+/**
+ * @brief Вставляет запись в лист; полный лист делится пополам.
+ */
+static Split leaf_insert(Leaderboard *board, uint32_t page, uint32_t pos,
+                         const LeaderboardRecord *record) {
+  Split split = {0, 0, 0};
+  LeafPage *leaf = leaf_at(board, page);
+  LeafPage *target = leaf;
+  if (leaf->count == LEAF_RECORDS) {
+    split.page = alloc_page(board);
+    LeafPage *sibling = leaf_at(board, split.page);
+    uint32_t keep = (LEAF_RECORDS + 1) / 2;
+    sibling->count = leaf->count - keep;
+    memcpy(sibling->records, &leaf->records[keep],
+           sibling->count * sizeof(LeaderboardRecord));
+    leaf->count = keep;
+    sibling->next = leaf->next;
+    leaf->next = split.page;
+    if (pos > keep) {
+      target = sibling;
+      pos -= keep;
+    }
+  }
+
+  memmove(&target->records[pos + 1], &target->records[pos],
+          (target->count - pos) * sizeof(LeaderboardRecord));
+  target->records[pos] = *record;
+  target->count++;
+
+  if (split.page) {
+    const LeafPage *sibling = leaf_at(board, split.page);
+    split.size = sibling->count;
+    split.first = sibling->records[0].score;
+  }
+  return split;
+}
+
+/**
+ * @brief Вставляет потомка entry в узел на позицию at; полный узел
+ *        делится пополам.
+ */
+static Split branch_insert(Leaderboard *board, uint32_t page, uint32_t at,
+                           Split entry) {
+  Split split = {0, 0, 0};
+  BranchPage *branch = branch_at(board, page);
+  BranchPage *target = branch;
+  if (branch->count == BRANCH_CHILDREN) {
+    split.page = alloc_page(board);
+    BranchPage *sibling = branch_at(board, split.page);
+    uint32_t keep = (BRANCH_CHILDREN + 1) / 2;
+    sibling->count = branch->count - keep;
+    memcpy(sibling->child, &branch->child[keep],
+           sibling->count * sizeof(uint32_t));
+    memcpy(sibling->size, &branch->size[keep],
+           sibling->count * sizeof(uint32_t));
+    memcpy(sibling->first, &branch->first[keep],
+           sibling->count * sizeof(int32_t));
+    branch->count = keep;
+    if (at > keep) {
+      target = sibling;
+      at -= keep;
+    }
+  }
+
+  uint32_t tail = target->count - at;
+  memmove(&target->child[at + 1], &target->child[at],
+          tail * sizeof(uint32_t));
+  memmove(&target->size[at + 1], &target->size[at], tail * sizeof(uint32_t));
+  memmove(&target->first[at + 1], &target->first[at],
+          tail * sizeof(int32_t));
+  target->child[at] = entry.page;
+  target->size[at] = entry.size;
+  target->first[at] = entry.first;
+  target->count++;
+
+  if (split.page) {
+    const BranchPage *sibling = branch_at(board, split.page);
+    for (uint32_t i = 0; i < sibling->count; ++i) {
+      split.size += sibling->size[i];
+    }
+    split.first = sibling->first[0];
+  }
+  return split;
+}
+
+/**
+ * @brief Вставляет запись в позицию, найденную descend_score().
+ *
+ * Нужно не больше height + 1 новых страниц (reserve_pages()).
+ */
+static void tree_insert(Leaderboard *board, const TreePath *path,
+                        const LeaderboardRecord *record) {
+  LeaderboardHeader *header = header_of(board);
+  uint32_t leaf_level = header->height - 1;
+  uint32_t pos = path->index[leaf_level];
+  Split split = leaf_insert(board, path->page[leaf_level], pos, record);
+  bool first_changed = pos == 0;
+
+  for (uint32_t level = leaf_level; level-- > 0;) {
+    BranchPage *branch = branch_at(board, path->page[level]);
+    uint32_t i = path->index[level];
+    branch->size[i]++;
+    if (first_changed) branch->first[i] = record->score;
+    first_changed = first_changed && i == 0;
+    if (split.page) {
+      branch->size[i] -= split.size;
+      split = branch_insert(board, path->page[level], i + 1, split);
+    }
+  }
+  header->count++;
+
+  if (split.page) {
+    uint32_t root = alloc_page(board);
+    BranchPage *branch = branch_at(board, root);
+    branch->count = 2;
+    branch->child[0] = header->root;
+    branch->size[0] = header->count - split.size;
+    uint32_t pos0;
+    branch->first[0] = leaf_for_rank(board, 0, &pos0)->records[0].score;
+    branch->child[1] = split.page;
+    branch->size[1] = split.size;
+    branch->first[1] = split.first;
+    header->root = root;
+    header->height++;
+  }
+}
+
+/**
+ * @brief Удаляет последнюю запись (с наименьшим счётом).
+ *
+ * Опустевшие узлы правого края освобождаются, корень с единственным
+ * потомком заменяется им.
+ */
+static void tree_remove_last(Leaderboard *board) {
+  LeaderboardHeader *header = header_of(board);
+  TreePath path;
+  uint32_t page = header->root;
+  for (uint32_t level = 0; level + 1 < header->height; ++level) {
+    BranchPage *branch = branch_at(board, page);
+    path.page[level] = page;
+    path.index[level] = branch->count - 1;
+    branch->size[branch->count - 1]--;
+    page = branch->child[branch->count - 1];
+  }
+  LeafPage *leaf = leaf_at(board, page);
+  leaf->count--;
+  header->count--;
+
+  bool emptied = leaf->count == 0;
+  bool leaf_removed = false;
+  for (uint32_t level = header->height - 1; emptied && level-- > 0;) {
+    BranchPage *branch = branch_at(board, path.page[level]);
+    release_page(board, page);
+    leaf_removed = true;
+    branch->count--;
+    emptied = branch->count == 0;
+    page = path.page[level];
+  }
+
+  while (header->height > 1 && branch_at(board, header->root)->count == 1) {
+    uint32_t root = header->root;
+    header->root = branch_at(board, root)->child[0];
+    header->height--;
+    release_page(board, root);
+  }
+
+  if (leaf_removed) {
+    uint32_t pos;
+    leaf_for_rank(board, header->count - 1, &pos)->next = 0;
+  }
+}
+
+/**
+ * @brief Проверяет заголовок существующего файла.
+ */
+static bool header_valid(const LeaderboardHeader *header, size_t file_size) {
+  return header->magic == LEADERBOARD_MAGIC &&
+         header->version == LEADERBOARD_VERSION &&
+         header->record_size == sizeof(LeaderboardRecord) &&
+         header->page_size == PAGE_SIZE_BYTES && header->capacity > 0 &&
+         header->count <= header->capacity && header->height >= 1 &&
+         header->height <= MAX_HEIGHT && header->page_count >= 2 &&
+         header->page_count <= header->file_pages && header->root > 0 &&
+         header->root < header->page_count &&
+         header->free_page < header->page_count &&
+         file_size >= (size_t)header->file_pages * PAGE_SIZE_BYTES;
+}
+
+Leaderboard *leaderboard_open(const char *path, uint32_t capacity) {
+  if (!path || capacity == 0) return NULL;
+
+  int fd = open(path, O_RDWR | O_CREAT, 0644);
+  if (fd < 0) return NULL;
+
+  /* Инициализация нового файла — под эксклюзивной блокировкой, чтобы два
+   * процесса не разметили его одновременно. */
+  flock(fd, LOCK_EX);
+
+  struct stat st;
+  LeaderboardHeader header;
+  bool ok = fstat(fd, &st) == 0;
+  if (ok && st.st_size == 0) {
+    /* Корень — пустой лист на странице 1 (ftruncate заполняет нулями). */
+    memset(&header, 0, sizeof(header));
+    header.magic = LEADERBOARD_MAGIC;
+    header.version = LEADERBOARD_VERSION;
+    header.record_size = sizeof(LeaderboardRecord);
+    header.page_size = PAGE_SIZE_BYTES;
+    header.capacity = capacity;
+    header.root = 1;
+    header.height = 1;
+    header.page_count = 2;
+    header.file_pages = INITIAL_PAGES;
+    ok = ftruncate(fd, (off_t)INITIAL_PAGES * PAGE_SIZE_BYTES) == 0 &&
+         pwrite(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header);
+  } else if (ok) {
+    ok = pread(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header) &&
+         header_valid(&header, (size_t)st.st_size);
+  }
+
+  flock(fd, LOCK_UN);
+
+  Leaderboard *board = NULL;
+  if (ok) board = (Leaderboard *)calloc(1, sizeof(*board));
+  if (board) {
+    board->fd = fd;
+    if (!map_pages(board, header.file_pages)) {
+      free(board);
+      board = NULL;
+    }
+  }
+  if (!board) close(fd);
+  return board;
+}
+
+void leaderboard_close(Leaderboard *board) {
+  if (!board) return;
+  munmap(board->mem, board->map_size);
+  close(board->fd);
+  free(board);
+}
+
+int64_t leaderboard_submit(Leaderboard *board,
+                           const LeaderboardRecord *record) {
+  if (!board || !record) return -1;
+
+  flock(board->fd, LOCK_EX);
+
+  int64_t rank = -1;
+  if (sync_mapping(board) && header_of(board)->height < MAX_HEIGHT &&
+      reserve_pages(board, header_of(board)->height + 1)) {
+    LeaderboardHeader *header = header_of(board);
+    TreePath path;
+    uint32_t pos = descend_score(board, record->score, &path);
+    /* В заполненной таблице последняя запись вытесняется. */
+    if (pos < header->capacity) {
+      LeaderboardRecord copy = *record;
+      copy.reserved = 0;
+      tree_insert(board, &path, &copy);
+      if (header->count > header->capacity) tree_remove_last(board);
+      rank = pos;
+    }
+  }
+
+  flock(board->fd, LOCK_UN);
+  return rank;
+}
+
+uint32_t leaderboard_count(Leaderboard *board) {
+  if (!board) return 0;
+  flock(board->fd, LOCK_SH);
+  uint32_t count = header_of(board)->count;
+  flock(board->fd, LOCK_UN);
+  return count;
+}
+
+uint32_t leaderboard_capacity(const Leaderboard *board) {
+  return board ? header_of(board)->capacity : 0;
+}
+
+bool leaderboard_get(Leaderboard *board, uint32_t rank,
+                     LeaderboardRecord *out) {
+  if (!board || !out) return false;
+  flock(board->fd, LOCK_SH);
+  bool found = sync_mapping(board) && rank < header_of(board)->count;
+  if (found) {
+    uint32_t pos;
+    *out = leaf_for_rank(board, rank, &pos)->records[pos];
+  }
+  flock(board->fd, LOCK_UN);
+  return found;
+}
+
+uint32_t leaderboard_top(Leaderboard *board, LeaderboardRecord *out,
+                         uint32_t max) {
+  if (!board || !out) return 0;
+  flock(board->fd, LOCK_SH);
+  uint32_t n = 0;
+  if (sync_mapping(board)) {
+    uint32_t count = header_of(board)->count;
+    uint32_t total = count < max ? count : max;
+    uint32_t pos;
+    const LeafPage *leaf = total > 0 ? leaf_for_rank(board, 0, &pos) : NULL;
+    while (n < total) {
+      uint32_t take = total - n < leaf->count ? total - n : leaf->count;
+      memcpy(out + n, leaf->records, take * sizeof(LeaderboardRecord));
+      n += take;
+      if (n < total) leaf = leaf_at(board, leaf->next);
+    }
+  }
+  flock(board->fd, LOCK_UN);
+  return n;
+}
+
+uint32_t leaderboard_rank_of(Leaderboard *board, int32_t score) {
+  if (!board) return 0;
+  flock(board->fd, LOCK_SH);
+  uint32_t rank = 0;
+  if (sync_mapping(board)) {
+    TreePath path;
+    rank = descend_score(board, score, &path);
+  }
+  flock(board->fd, LOCK_UN);
+  return rank;
+}
+
+void leaderboard_record_init(LeaderboardRecord *record, const char *player,
+                             int32_t score, int32_t level,
+                             uint32_t duration_ms, uint64_t replay_id) {
+  if (!record) return;
+  memset(record, 0, sizeof(*record));
+  if (player) strncpy(record->player, player, LEADERBOARD_NAME_SIZE - 1);
+  record->score = score;
+  record->level = level;
+  record->duration_ms = duration_ms;
+  record->replay_id = replay_id;
+  record->timestamp = (int64_t)time(NULL);
+}
@@ -0,0 +1,204 @@
+/**
+ * @file plugin_loader.c
+ * @brief Реализация поиска и загрузки игровых плагинов.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "../../include/brickgame/common/plugin_loader.h"
+
+#include <dirent.h>
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef BRICKGAME_STATIC_ENGINES
+#include "../../include/brickgame/snake/snake_api.h"
+#include "../../include/brickgame/tetris/game.h"
+
+/// Реестр игр, слинкованных прямо в приложение.
+static const BrickGameGetApiFn builtin_games[] = {brickgame_snake_get_api,
+                                                  brickgame_tetris_get_api};
+#endif
+
+/// Путь-метка встроенных игр в BrickGamePlugin::path.
+#define BUILTIN_PATH_PREFIX "builtin:"
+
+#ifdef __APPLE__
+#define PLUGIN_EXTENSION ".dylib"
+#else
+#define PLUGIN_EXTENSION ".so"
+#endif
+
+/**
+ * @brief Записывает сообщение об ошибке в буфер.
+ */
+static void set_error(char *error, size_t error_size, const char *message) {
+  if (error && error_size > 0) {
+    snprintf(error, error_size, "%s", message ? message : "unknown error");
+  }
+}
+
+/**
+ * @brief Проверяет, похоже ли имя файла на игровой плагин.
+ */
+static bool is_plugin_file(const char *name) {
+  size_t len = strlen(name);
+  size_t ext_len = strlen(PLUGIN_EXTENSION);
+  return len > 3 + ext_len && strncmp(name, "lib", 3) == 0 &&
+         strcmp(name + len - ext_len, PLUGIN_EXTENSION) == 0;
+}
+
+bool plugin_api_compatible(const BrickGameApi *api) {
+  return api && api->abi_version == BRICKGAME_ABI_VERSION &&
+         BRICKGAME_API_HAS(api, isVictory) && api->id && api->name &&
+         api->field_width > 0 && api->field_height > 0 && api->userInput &&
+         api->updateCurrentState && api->isGameOver;
+}
+
+/**
+ * @brief Открывает библиотеку и проверяет таблицу, не запуская игру.
+ */
+static bool plugin_open(const char *path, BrickGamePlugin *plugin,
+                        char *error, size_t error_size) {
+  if (!path || !plugin) {
+    set_error(error, error_size, "Invalid plugin path");
+    return false;
+  }
+  memset(plugin, 0, sizeof(*plugin));
+
+  void *handle = dlopen(path, RTLD_LAZY | RTLD_LOCAL);
+  if (!handle) {
+    set_error(error, error_size, dlerror());
+    return false;
+  }
+
+  BrickGameGetApiFn get_api =
+      (BrickGameGetApiFn)dlsym(handle, BRICKGAME_ENTRY_SYMBOL);
+  const BrickGameApi *api = get_api ? get_api() : NULL;
+  if (!plugin_api_compatible(api)) {
+    dlclose(handle);
+    set_error(error, error_size,
+              get_api ? "Incompatible plugin ABI" : "Not a BrickGame plugin");
+    return false;
+  }
+
+  plugin->handle = handle;
+  plugin->api = api;
+  snprintf(plugin->path, sizeof(plugin->path), "%s", path);
+  return true;
+}
+
+bool plugin_load(const char *path, BrickGamePlugin *plugin, char *error,
+                 size_t error_size) {
+  if (!plugin_open(path, plugin, error, error_size)) return false;
+  plugin_start(plugin);
+  return true;
+}
+
+void plugin_start(BrickGamePlugin *plugin) {
+  if (!plugin || !plugin->api || plugin->started) return;
+  if (plugin->api->init) plugin->api->init();
+  plugin->started = true;
+}
+
+void plugin_stop(BrickGamePlugin *plugin) {
+  if (!plugin || !plugin->started) return;
+  if (plugin->api->shutdown) plugin->api->shutdown();
+  plugin->started = false;
+}
+
+void plugin_unload(BrickGamePlugin *plugin) {
+  if (!plugin) return;
+  plugin_stop(plugin);
+  if (plugin->handle) dlclose(plugin->handle);
+  memset(plugin, 0, sizeof(*plugin));
+}
+
+/**
+ * @brief Сравнивает плагины по имени игры (для qsort).
+ */
+static int compare_plugins(const void *a, const void *b) {
+  const BrickGamePlugin *pa = (const BrickGamePlugin *)a;
+  const BrickGamePlugin *pb = (const BrickGamePlugin *)b;
+  return strcmp(pa->api->name, pb->api->name);
+}
+
+/**
+ * @brief Добавляет плагины каталога к уже найденным (без повторов по id).
+ *
+ * @return новое число плагинов в массиве
+ */
+static int scan_directory(const char *dir, BrickGamePlugin *plugins,
+                          int count, int max_plugins) {
+  DIR *d = opendir(dir);
+  if (!d) return count;
+
+  struct dirent *entry;
+  while (count < max_plugins && (entry = readdir(d)) != NULL) {
+    if (!is_plugin_file(entry->d_name)) continue;
+
+    char path[BRICKGAME_PLUGIN_PATH_MAX];
+    snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name);
+
+    BrickGamePlugin plugin;
+    if (!plugin_open(path, &plugin, NULL, 0)) continue;
+    if (plugin_find(plugins, count, plugin.api->id) >= 0) {
+      plugin_unload(&plugin);
+      continue;
+    }
+    plugins[count++] = plugin;
+  }
+  closedir(d);
+  return count;
+}
+
+int plugin_scan(const char *dir, BrickGamePlugin *plugins, int max_plugins) {
+  if (!dir || !plugins || max_plugins <= 0) return 0;
+
+  int count = scan_directory(dir, plugins, 0, max_plugins);
+  qsort(plugins, (size_t)count, sizeof(*plugins), compare_plugins);
+  return count;
+}
+
+int plugin_scan_builtin(BrickGamePlugin *plugins, int max_plugins) {
+  if (!plugins || max_plugins <= 0) return 0;
+
+  int count = 0;
+#ifdef BRICKGAME_STATIC_ENGINES
+  size_t total = sizeof(builtin_games) / sizeof(builtin_games[0]);
+  for (size_t i = 0; i < total && count < max_plugins; ++i) {
+    const BrickGameApi *api = builtin_games[i]();
+    if (!plugin_api_compatible(api)) continue;
+
+    BrickGamePlugin *plugin = &plugins[count++];
+    memset(plugin, 0, sizeof(*plugin));
+    plugin->api = api;
+    snprintf(plugin->path, sizeof(plugin->path), BUILTIN_PATH_PREFIX "%s",
+             api->id);
+  }
+#endif
+  return count;
+}
+
+int plugin_scan_all(const char *dir, BrickGamePlugin *plugins,
+                    int max_plugins) {
+  if (!plugins || max_plugins <= 0) return 0;
+
+  int count = plugin_scan_builtin(plugins, max_plugins);
+  if (dir) count = scan_directory(dir, plugins, count, max_plugins);
+  qsort(plugins, (size_t)count, sizeof(*plugins), compare_plugins);
+  return count;
+}
+
+bool plugin_is_builtin(const BrickGamePlugin *plugin) {
+  return plugin && plugin->api && !plugin->handle;
+}
+
+int plugin_find(const BrickGamePlugin *plugins, int count, const char *id) {
+  if (!plugins || !id) return -1;
+  for (int i = 0; i < count; ++i) {
+    if (plugins[i].api && strcmp(plugins[i].api->id, id) == 0) return i;
+  }
+  return -1;
+}
@@ -0,0 +1,277 @@
+/**
+ * @file trace.c
+ * @brief Реализация записи трассы в формате Chrome trace-event.
+ *
+ * Буфер потока заводится при первом событии: свободный буфер из общего
+ * односвязного списка захватывается CAS-ом состояния, иначе новый
+ * добавляется в начало списка через CAS. Поток-владелец пишет событие и
+ * публикует новое число событий release-записью; trace_stop() читает
+ * его acquire-загрузкой, поэтому видит только полностью записанные
+ * события, даже если потоки ещё работают.
+ *
+ * Когда поток завершается, деструктор ключа pthread помечает его буфер
+ * завершённым; после выгрузки в trace_stop() (или сброса в
+ * trace_start()) буфер становится свободным и достаётся следующему
+ * потоку. Список поэтому не растёт с каждым новым потоком.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "../../include/brickgame/common/trace.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+  const char *name;
+  const char *category;
+  uint64_t start_us;
+  uint64_t duration_us;
+} TraceEvent;
+
+/**
+ * @brief Состояние буфера потока.
+ */
+enum {
+  TRACE_BUFFER_OWNED,   ///< Пишет живой поток
+  TRACE_BUFFER_EXITED,  ///< Поток завершился, события ждут выгрузки
+  TRACE_BUFFER_FREE     ///< Можно отдать новому потоку
+};
+
+typedef struct TraceBuffer {
+  struct TraceBuffer *next;
+  int state;
+  uint32_t tid;
+  const char *thread_name;
+  uint32_t count;
+  TraceEvent events[TRACE_BUFFER_EVENTS];
+} TraceBuffer;
+
+static int trace_active = 0;
+static uint64_t trace_origin_ns = 0;
+static uint64_t dropped_events = 0;
+static uint32_t next_tid = 1;
+static TraceBuffer *buffers = NULL;
+static char trace_path[512];
+
+static pthread_key_t buffer_key;
+static pthread_once_t buffer_key_once = PTHREAD_ONCE_INIT;
+
+static __thread TraceBuffer *local_buffer = NULL;
+/// Имя потока до первого события: без записи буфер не заводится.
+static __thread const char *local_thread_name = NULL;
+
+static uint64_t monotonic_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Деструктор ключа: буфер завершившегося потока ждёт выгрузки
+ *        (или сразу свободен, если событий нет).
+ */
+static void release_buffer(void *value) {
+  TraceBuffer *buffer = (TraceBuffer *)value;
+  int state = __atomic_load_n(&buffer->count, __ATOMIC_ACQUIRE)
+                  ? TRACE_BUFFER_EXITED
+                  : TRACE_BUFFER_FREE;
+  __atomic_store_n(&buffer->state, state, __ATOMIC_RELEASE);
+}
+
+static void create_buffer_key(void) {
+  pthread_key_create(&buffer_key, release_buffer);
+}
+
+/**
+ * @brief Свободный буфер из списка или NULL.
+ */
+static TraceBuffer *claim_free_buffer(void) {
+  for (TraceBuffer *b = __atomic_load_n(&buffers, __ATOMIC_ACQUIRE); b;
+       b = b->next) {
+    int expected = TRACE_BUFFER_FREE;
+    if (__atomic_compare_exchange_n(&b->state, &expected, TRACE_BUFFER_OWNED,
+                                    false, __ATOMIC_ACQUIRE,
+                                    __ATOMIC_RELAXED)) {
+      return b;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief Буфер текущего потока (заводится при первом обращении).
+ */
+static TraceBuffer *thread_buffer(void) {
+  if (local_buffer) return local_buffer;
+
+  pthread_once(&buffer_key_once, create_buffer_key);
+  TraceBuffer *buffer = claim_free_buffer();
+  if (!buffer) {
+    buffer = (TraceBuffer *)calloc(1, sizeof(TraceBuffer));
+    if (!buffer) return NULL;
+    buffer->state = TRACE_BUFFER_OWNED;
+
+    TraceBuffer *head = __atomic_load_n(&buffers, __ATOMIC_ACQUIRE);
+    do {
+      buffer->next = head;
+    } while (!__atomic_compare_exchange_n(&buffers, &head, buffer, true,
+                                          __ATOMIC_RELEASE,
+                                          __ATOMIC_ACQUIRE));
+  }
+  buffer->tid = __atomic_fetch_add(&next_tid, 1, __ATOMIC_RELAXED);
+  buffer->thread_name = local_thread_name;
+  __atomic_store_n(&buffer->count, 0, __ATOMIC_RELEASE);
+  pthread_setspecific(buffer_key, buffer);
+  local_buffer = buffer;
+  return buffer;
+}
+
+/**
+ * @brief Освобождает буферы завершившихся потоков (их события выгружены
+ *        или больше не нужны); с all обнуляет и буферы живых потоков.
+ */
+static void reset_buffers(bool all) {
+  for (TraceBuffer *b = __atomic_load_n(&buffers, __ATOMIC_ACQUIRE); b;
+       b = b->next) {
+    int expected = TRACE_BUFFER_EXITED;
+    if (__atomic_compare_exchange_n(&b->state, &expected, TRACE_BUFFER_FREE,
+                                    false, __ATOMIC_ACQ_REL,
+                                    __ATOMIC_RELAXED) ||
+        all) {
+      __atomic_store_n(&b->count, 0, __ATOMIC_RELEASE);
+    }
+  }
+}
+
+bool trace_enabled(void) {
+  return __atomic_load_n(&trace_active, __ATOMIC_RELAXED) != 0;
+}
+
+uint64_t trace_now_us(void) {
+  return (monotonic_ns() - trace_origin_ns) / 1000u;
+}
+
+bool trace_start(const char *path) {
+  if (!path || !*path) return false;
+  snprintf(trace_path, sizeof(trace_path), "%s", path);
+
+  reset_buffers(true);
+  __atomic_store_n(&dropped_events, 0, __ATOMIC_RELAXED);
+  trace_origin_ns = monotonic_ns();
+  __atomic_store_n(&trace_active, 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+bool trace_start_from_env(void) { return trace_start(getenv(TRACE_ENV)); }
+
+void trace_after_fork(void) {
+  /* В ребёнке живёт только вызвавший поток: буферы остальных свободны. */
+  for (TraceBuffer *b = __atomic_load_n(&buffers, __ATOMIC_ACQUIRE); b;
+       b = b->next) {
+    if (b != local_buffer) {
+      __atomic_store_n(&b->state, TRACE_BUFFER_FREE, __ATOMIC_RELEASE);
+    }
+  }
+  if (!trace_enabled()) return;
+  reset_buffers(true);
+  size_t len = strlen(trace_path);
+  snprintf(trace_path + len, sizeof(trace_path) - len, ".%ld",
+           (long)getpid());
+}
+
+void trace_complete(const char *name, const char *category,
+                    uint64_t start_us, uint64_t end_us) {
+  if (!trace_enabled()) return;
+  TraceBuffer *buffer = thread_buffer();
+  if (!buffer) return;
+
+  uint32_t count = buffer->count;
+  if (count >= TRACE_BUFFER_EVENTS) {
+    __atomic_fetch_add(&dropped_events, 1, __ATOMIC_RELAXED);
+    return;
+  }
+  TraceEvent *event = &buffer->events[count];
+  event->name = name;
+  event->category = category;
+  event->start_us = start_us;
+  event->duration_us = end_us > start_us ? end_us - start_us : 0;
+  __atomic_store_n(&buffer->count, count + 1, __ATOMIC_RELEASE);
+}
+
+void trace_set_thread_name(const char *name) {
+  local_thread_name = name;
+  if (local_buffer) local_buffer->thread_name = name;
+}
+
+uint64_t trace_dropped(void) {
+  return __atomic_load_n(&dropped_events, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Пишет строку JSON с экранированием.
+ */
+static void write_json_string(FILE *file, const char *text) {
+  fputc('"', file);
+  for (const char *c = text ? text : ""; *c; ++c) {
+    if (*c == '"' || *c == '\\') {
+      fputc('\\', file);
+      fputc(*c, file);
+    } else if ((unsigned char)*c < 0x20) {
+      fprintf(file, "\\u%04x", (unsigned)(unsigned char)*c);
+    } else {
+      fputc(*c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+bool trace_stop(void) {
+  if (!__atomic_exchange_n(&trace_active, 0, __ATOMIC_ACQ_REL)) return false;
+
+  FILE *file = fopen(trace_path, "w");
+  if (!file) return false;
+
+  long pid = (long)getpid();
+  bool first = true;
+  fputs("{\"traceEvents\":[\n", file);
+  for (TraceBuffer *b = __atomic_load_n(&buffers, __ATOMIC_ACQUIRE); b;
+       b = b->next) {
+    if (__atomic_load_n(&b->state, __ATOMIC_ACQUIRE) == TRACE_BUFFER_FREE) {
+      continue;
+    }
+    if (b->thread_name) {
+      fprintf(file,
+              "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%ld,"
+              "\"tid\":%u,\"args\":{\"name\":",
+              first ? "" : ",\n", pid, b->tid);
+      write_json_string(file, b->thread_name);
+      fputs("}}", file);
+      first = false;
+    }
+
+    uint32_t count = __atomic_load_n(&b->count, __ATOMIC_ACQUIRE);
+    for (uint32_t i = 0; i < count; ++i) {
+      const TraceEvent *event = &b->events[i];
+      fputs(first ? "{\"name\":" : ",\n{\"name\":", file);
+      write_json_string(file, event->name);
+      fputs(",\"cat\":", file);
+      write_json_string(file, event->category);
+      fprintf(file,
+              ",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":%ld,"
+              "\"tid\":%u}",
+              (unsigned long long)event->start_us,
+              (unsigned long long)event->duration_us, pid, b->tid);
+      first = false;
+    }
+  }
+  fprintf(file, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":"
+                "{\"dropped_events\":%llu}}\n",
+          (unsigned long long)trace_dropped());
+  bool written = fclose(file) == 0;
+  reset_buffers(false);
+  return written;
+}
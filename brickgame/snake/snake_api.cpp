@@ -14,6 +14,7 @@
  */
 #include "../../include/brickgame/snake/snake_api.h"
 
+#include "../../include/brickgame/common/plugin_api.h"
 #include "../../include/brickgame/snake/snake_fsm.hpp"
 #include "../../include/brickgame/snake/snake_game.hpp"
 
@@ -30,7 +31,7 @@ static SnakeFSM fsm(game);  ///< FSM для обработки ввода
  * @param action действие пользователя (Up, Down, Left, Right, Pause и т.д.)
  * @param hold   признак удержания кнопки
  */
-extern "C" EXPORT void userInput(UserAction_t action, bool hold) {
+extern "C" EXPORT void SNAKE_API(userInput)(UserAction_t action, bool hold) {
   s21::fsm.HandleInput(action, hold);
 }
 /**
@@ -40,16 +41,34 @@ extern "C" EXPORT void userInput(UserAction_t action, bool hold) {
  *
  * @return GameInfo_t структура с данными для отрисовки.
  */
-extern "C" EXPORT GameInfo_t updateCurrentState() {
+extern "C" EXPORT GameInfo_t SNAKE_API(updateCurrentState)() {
+  AllocHooks& hooks = s21::SnakeAllocHooks();
+  alloc_hooks_begin_tick(&hooks);
   s21::game.Tick();
-  return s21::game.GetGameInfo();
+  GameInfo_t info = s21::game.GetFrame();
+  alloc_hooks_end_tick(&hooks);
+  return info;
+}
+/**
+ * @brief Продвигает игру на прошедшее реальное время.
+ *
+ * @param elapsed_ms время с предыдущего вызова, мс
+ * @return GameInfo_t структура с данными для отрисовки.
+ */
+extern "C" EXPORT GameInfo_t SNAKE_API(advanceState)(int elapsed_ms) {
+  AllocHooks& hooks = s21::SnakeAllocHooks();
+  alloc_hooks_begin_tick(&hooks);
+  s21::game.Advance(elapsed_ms);
+  GameInfo_t info = s21::game.GetFrame();
+  alloc_hooks_end_tick(&hooks);
+  return info;
 }
 /**
  * @brief Проверяет, окончена ли игра (поражение или победа).
  *
  * @return true если Snake проиграл или победил, иначе false.
  */
-extern "C" EXPORT bool isGameOver() {
+extern "C" EXPORT bool SNAKE_API(isGameOver)() {
   auto state = s21::game.GetState();
   return state == s21::SnakeGameState::Lost ||
          state == s21::SnakeGameState::Won;
@@ -60,9 +79,144 @@ extern "C" EXPORT bool isGameOver() {
  * @return true если игра окончилась победой, иначе false.
  */
 
-extern "C" EXPORT bool isVictory() {
+extern "C" EXPORT bool SNAKE_API(isVictory)() {
   return s21::game.GetState() == s21::SnakeGameState::Won;
 }
+/**
+ * @brief Отпускает кадр, полученный из updateCurrentState().
+ *
+ * Кадр лежит в постоянном буфере игры, поэтому память не освобождается:
+ * обнуляются только указатели.
+ *
+ * @param info структура, полученная из updateCurrentState().
+ */
+extern "C" EXPORT void SNAKE_API(freeGameInfo)(GameInfo_t* info) {
+  if (info) {
+    info->field = nullptr;
+    info->next = nullptr;
+  }
+}
+/**
+ * @brief Сохраняет полное состояние сессии в бинарный снимок.
+ *
+ * @param buf  буфер (NULL — только подсчёт размера)
+ * @param size размер буфера
+ * @return полный размер снимка
+ */
+extern "C" EXPORT size_t SNAKE_API(saveGameState)(void* buf,
+                                                   size_t size) {
+  return s21::game.SaveState(buf, size);
+}
+/**
+ * @brief Восстанавливает сессию из снимка saveGameState().
+ *
+ * @param buf  снимок
+ * @param size размер снимка
+ * @return true при успехе
+ */
+extern "C" EXPORT bool SNAKE_API(loadGameState)(const void* buf,
+                                                 size_t size) {
+  return s21::game.LoadState(buf, size);
+}
+/**
+ * @brief Пишет поле в упакованном виде (2 бита на клетку).
+ *
+ * @param buf  буфер (NULL — только подсчёт размера)
+ * @param size размер буфера
+ * @return размер упакованного поля
+ */
+extern "C" EXPORT size_t SNAKE_API(exportPackedField)(void* buf,
+                                                       size_t size) {
+  return s21::game.ExportPackedField(buf, size);
+}
+/**
+ * @brief Устанавливает аллокатор для выделений игры.
+ *
+ * @param allocator аллокатор (NULL — malloc/free)
+ */
+extern "C" EXPORT void SNAKE_API(setAllocator)(
+    const BrickGameAllocator* allocator) {
+  alloc_hooks_set(&s21::SnakeAllocHooks(), allocator);
+}
+/**
+ * @brief Выделения памяти за последний updateCurrentState()/advanceState().
+ *
+ * @return счётчики выделений последнего тика
+ */
+extern "C" EXPORT BrickGameAllocStats SNAKE_API(tickAllocStats)() {
+  return s21::SnakeAllocHooks().last_tick;
+}
+/**
+ * @brief Записывает рекорд в файл, если он вырос.
+ */
+extern "C" EXPORT void SNAKE_API(flushHighScore)() {
+  s21::game.FlushHighScore();
+}
 
+namespace {
+/**
+ * @brief Хук инициализации плагина: сбрасывает игру в состояние Ready.
+ *
+ * Число поворотов за шаг берётся из BRICKGAME_INPUTS_PER_TICK.
+ */
+void SnakeInit() {
+  s21::game.SetTurnsPerTick(
+      static_cast<int>(input_queue_per_tick_from_env(1)));
+  s21::game.Reset();
+}
 
+/**
+ * @brief Хук завершения плагина: записывает рекорд и останавливает
+ *        текущую игру.
+ */
+void SnakeShutdown() {
+  s21::game.FlushHighScore();
+  s21::game.Reset();
+}
+
+/**
+ * @brief Таблица функций плагина Snake.
+ */
+const BrickGameApi kSnakeApi = {
+    .abi_version = BRICKGAME_ABI_VERSION,
+    .struct_size = sizeof(BrickGameApi),
+    .id = "snake",
+    .name = "Snake",
+    .capabilities = BRICKGAME_CAP_VICTORY | BRICKGAME_CAP_HOLD_ACCELERATE |
+                    BRICKGAME_CAP_SAVE_STATE | BRICKGAME_CAP_TIMED_ADVANCE,
+    .field_width = kGameWidth,
+    .field_height = kGameHeight,
+    .idle_action = Action,
+    .init = SnakeInit,
+    .shutdown = SnakeShutdown,
+    .userInput = SNAKE_API(userInput),
+    .updateCurrentState = SNAKE_API(updateCurrentState),
+    .isGameOver = SNAKE_API(isGameOver),
+    .freeGameInfo = SNAKE_API(freeGameInfo),
+    .isVictory = SNAKE_API(isVictory),
+    .saveState = SNAKE_API(saveGameState),
+    .loadState = SNAKE_API(loadGameState),
+    .advance = SNAKE_API(advanceState),
+    .setAllocator = SNAKE_API(setAllocator),
+    .tickAllocStats = SNAKE_API(tickAllocStats),
+    .flushHighScore = SNAKE_API(flushHighScore),
+};
+}  // namespace
+
+/**
+ * @brief Таблица функций Snake (для реестра встроенных игр).
+ *
+ * @return таблица функций игры
+ */
+extern "C" EXPORT const BrickGameApi* brickgame_snake_get_api() {
+  return &kSnakeApi;
+}
 
+#ifndef BRICKGAME_STATIC_ENGINES
+/**
+ * @brief Точка входа плагина Snake.
+ *
+ * @return таблица функций игры
+ */
+extern "C" EXPORT const BrickGameApi* brickgame_get_api() { return &kSnakeApi; }
+#endif
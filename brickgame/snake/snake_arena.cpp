@@ -0,0 +1,309 @@
+/**
+ * @file snake_arena.cpp
+ * @brief Реализация арены с множеством змеек.
+ */
+#include "../../include/brickgame/snake/snake_arena.hpp"
+
+#include <algorithm>
+
+namespace s21 {
+
+namespace {
+
+/// Попыток найти место для случайной змейки.
+constexpr int kSpawnAttempts = 64;
+
+constexpr SnakeDirection kDirections[] = {
+    SnakeDirection::Up, SnakeDirection::Down, SnakeDirection::Left,
+    SnakeDirection::Right};
+
+/**
+ * @brief Противоположное направление.
+ */
+SnakeDirection Opposite(SnakeDirection direction) {
+  switch (direction) {
+    case SnakeDirection::Up:
+      return SnakeDirection::Down;
+    case SnakeDirection::Down:
+      return SnakeDirection::Up;
+    case SnakeDirection::Left:
+      return SnakeDirection::Right;
+    case SnakeDirection::Right:
+      break;
+  }
+  return SnakeDirection::Left;
+}
+
+/**
+ * @brief Направления после поворота налево и направо.
+ */
+void SideDirections(SnakeDirection direction, SnakeDirection& left,
+                    SnakeDirection& right) {
+  switch (direction) {
+    case SnakeDirection::Up:
+      left = SnakeDirection::Left;
+      right = SnakeDirection::Right;
+      break;
+    case SnakeDirection::Down:
+      left = SnakeDirection::Right;
+      right = SnakeDirection::Left;
+      break;
+    case SnakeDirection::Left:
+      left = SnakeDirection::Down;
+      right = SnakeDirection::Up;
+      break;
+    case SnakeDirection::Right:
+      left = SnakeDirection::Up;
+      right = SnakeDirection::Down;
+      break;
+  }
+}
+
+}  // namespace
+
+SnakeArena::SnakeArena(int width, int height, int apples, std::uint32_t seed)
+    : width_(std::max(width, 1)),
+      height_(std::max(height, 1)),
+      apple_target_(std::max(apples, 0)),
+      gen_(seed) {
+  std::size_t cells = static_cast<std::size_t>(width_) * height_;
+  owner_.assign(cells, kEmpty);
+  free_cells_.resize(cells);
+  free_pos_.resize(cells);
+  for (std::size_t i = 0; i < cells; ++i) {
+    free_cells_[i] = static_cast<std::uint32_t>(i);
+    free_pos_[i] = static_cast<std::uint32_t>(i);
+  }
+  claim_tick_.assign(cells, 0);
+  claim_by_.assign(cells, 0);
+  RefillApples();
+}
+
+/**
+ * @brief Отдаёт свободную клетку владельцу и убирает её из индекса.
+ */
+void SnakeArena::Occupy(std::uint32_t cell, std::uint32_t owner) {
+  std::uint32_t pos = free_pos_[cell];
+  if (pos != kNotFree) {
+    std::uint32_t last = free_cells_.back();
+    free_cells_[pos] = last;
+    free_pos_[last] = pos;
+    free_cells_.pop_back();
+    free_pos_[cell] = kNotFree;
+  }
+  owner_[cell] = owner;
+}
+
+/**
+ * @brief Освобождает клетку и возвращает её в индекс.
+ */
+void SnakeArena::Release(std::uint32_t cell) {
+  if (owner_[cell] == kApple) --apples_;
+  owner_[cell] = kEmpty;
+  if (free_pos_[cell] == kNotFree) {
+    free_pos_[cell] = static_cast<std::uint32_t>(free_cells_.size());
+    free_cells_.push_back(cell);
+  }
+}
+
+/**
+ * @brief Добавляет голову в кольцо тела, расширяя его при необходимости.
+ */
+void SnakeArena::PushFront(Snake& snake, std::uint32_t cell) {
+  std::size_t capacity = snake.body.size();
+  if (snake.size == capacity) {
+    std::vector<std::uint32_t> grown(std::max<std::size_t>(capacity * 2, 4));
+    for (std::size_t i = 0; i < snake.size; ++i) {
+      grown[i + 1] = snake.body[(snake.head + i) % capacity];
+    }
+    snake.body.swap(grown);
+    snake.head = 1;
+    capacity = snake.body.size();
+  }
+  snake.head = (snake.head + capacity - 1) % capacity;
+  snake.body[snake.head] = cell;
+  ++snake.size;
+}
+
+std::uint32_t SnakeArena::Tail(const Snake& snake) const {
+  return snake.body[(snake.head + snake.size - 1) % snake.body.size()];
+}
+
+SnakeSegment SnakeArena::Head(int id) const {
+  const Snake& snake = snakes_[id];
+  return CellAt(snake.body[snake.head]);
+}
+
+int SnakeArena::AddSnake(SnakeSegment head, SnakeDirection direction,
+                         int length) {
+  length = std::max(length, 1);
+  SnakeDirection back = Opposite(direction);
+
+  SnakeSegment tail = head;
+  for (int i = 0; i < length; ++i) {
+    if (!Inside(tail) || owner_[CellIndex(tail)] != kEmpty) return -1;
+    if (i + 1 < length) tail = NextHeadPosition(tail, back);
+  }
+
+  int id = static_cast<int>(snakes_.size());
+  snakes_.emplace_back();
+  Snake& snake = snakes_.back();
+  snake.direction = direction;
+  snake.next_direction = direction;
+  snake.body.resize(static_cast<std::size_t>(length) + 1);
+
+  // Тело добавляется с хвоста, последней — голова.
+  SnakeSegment cell = tail;
+  for (int i = 0; i < length; ++i) {
+    std::uint32_t index = CellIndex(cell);
+    PushFront(snake, index);
+    Occupy(index, static_cast<std::uint32_t>(id) + 1);
+    cell = NextHeadPosition(cell, direction);
+  }
+
+  targets_.push_back(kOutside);
+  dying_.push_back(0);
+  ++alive_;
+  return id;
+}
+
+int SnakeArena::AddRandomSnake(int length) {
+  std::uniform_int_distribution<int> pick_direction(0, 3);
+  for (int attempt = 0; attempt < kSpawnAttempts; ++attempt) {
+    if (free_cells_.empty()) return -1;
+    std::uniform_int_distribution<std::size_t> pick(0, free_cells_.size() - 1);
+    SnakeSegment head = CellAt(free_cells_[pick(gen_)]);
+    int id = AddSnake(head, kDirections[pick_direction(gen_)], length);
+    if (id >= 0) return id;
+  }
+  return -1;
+}
+
+bool SnakeArena::PlaceApple(SnakeSegment cell) {
+  if (!Inside(cell) || owner_[CellIndex(cell)] != kEmpty) return false;
+  Occupy(CellIndex(cell), kApple);
+  ++apples_;
+  return true;
+}
+
+void SnakeArena::Steer(int id, SnakeDirection direction) {
+  Snake& snake = snakes_[id];
+  if (!AreOppositeDirections(snake.direction, direction)) {
+    snake.next_direction = direction;
+  }
+}
+
+void SnakeArena::SteerBots() {
+  for (Snake& snake : snakes_) {
+    if (!snake.alive) continue;
+    SnakeSegment head = CellAt(snake.body[snake.head]);
+    auto open = [&](SnakeDirection direction) {
+      SnakeSegment next = NextHeadPosition(head, direction);
+      if (!Inside(next)) return false;
+      std::uint32_t owner = owner_[CellIndex(next)];
+      return owner == kEmpty || owner == kApple;
+    };
+
+    if (open(snake.direction)) {
+      snake.next_direction = snake.direction;
+      continue;
+    }
+    SnakeDirection left = snake.direction, right = snake.direction;
+    SideDirections(snake.direction, left, right);
+    bool left_open = open(left);
+    bool right_open = open(right);
+    if (left_open && right_open) {
+      snake.next_direction = (gen_() & 1) ? left : right;
+    } else if (left_open) {
+      snake.next_direction = left;
+    } else if (right_open) {
+      snake.next_direction = right;
+    }
+  }
+}
+
+/**
+ * @brief Убирает погибшую змейку с поля.
+ */
+void SnakeArena::Kill(int id) {
+  Snake& snake = snakes_[id];
+  for (std::size_t i = 0; i < snake.size; ++i) {
+    Release(snake.body[(snake.head + i) % snake.body.size()]);
+  }
+  snake.size = 0;
+  snake.alive = false;
+  --alive_;
+}
+
+/**
+ * @brief Доводит число яблок до заданного.
+ */
+void SnakeArena::RefillApples() {
+  while (apples_ < apple_target_ && !free_cells_.empty()) {
+    std::uniform_int_distribution<std::size_t> pick(0, free_cells_.size() - 1);
+    Occupy(free_cells_[pick(gen_)], kApple);
+    ++apples_;
+  }
+}
+
+void SnakeArena::Tick() {
+  ++ticks_;
+  const std::uint32_t stamp = static_cast<std::uint32_t>(ticks_);
+  const int count = static_cast<int>(snakes_.size());
+
+  // Цели ходов: выход за поле, занятая клетка и встречные головы.
+  for (int id = 0; id < count; ++id) {
+    Snake& snake = snakes_[id];
+    dying_[id] = 0;
+    targets_[id] = kOutside;
+    if (!snake.alive) continue;
+
+    snake.direction = snake.next_direction;
+    SnakeSegment head =
+        NextHeadPosition(CellAt(snake.body[snake.head]), snake.direction);
+    if (!Inside(head)) {
+      dying_[id] = 1;
+      continue;
+    }
+
+    std::uint32_t cell = CellIndex(head);
+    targets_[id] = cell;
+    std::uint32_t owner = owner_[cell];
+    if (owner != kEmpty && owner != kApple) dying_[id] = 1;
+
+    if (claim_tick_[cell] == stamp) {
+      dying_[id] = 1;
+      dying_[claim_by_[cell]] = 1;
+    } else {
+      claim_tick_[cell] = stamp;
+      claim_by_[cell] = static_cast<std::uint32_t>(id);
+    }
+  }
+
+  for (int id = 0; id < count; ++id) {
+    if (dying_[id]) Kill(id);
+  }
+
+  // Выжившие: хвост освобождается (если не было яблока), голова занимает
+  // цель. Цели выживших на начало тика были свободны, поэтому порядок
+  // обработки змеек не влияет на результат.
+  for (int id = 0; id < count; ++id) {
+    Snake& snake = snakes_[id];
+    if (!snake.alive) continue;
+
+    std::uint32_t cell = targets_[id];
+    if (owner_[cell] == kApple) {
+      --apples_;
+      ++snake.score;
+    } else {
+      Release(Tail(snake));
+      --snake.size;
+    }
+    PushFront(snake, cell);
+    Occupy(cell, static_cast<std::uint32_t>(id) + 1);
+  }
+
+  RefillApples();
+}
+
+}  // namespace s21
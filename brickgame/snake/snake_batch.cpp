@@ -0,0 +1,125 @@
+/**
+ * @file snake_batch.cpp
+ * @brief Реализация пакета сред Snake.
+ */
+#include "../../include/brickgame/snake/snake_batch.h"
+
+#include <new>
+#include <vector>
+
+#include "../../include/brickgame/snake/snake_game.hpp"
+
+static_assert(SNAKE_BATCH_WIDTH == kGameWidth &&
+                  SNAKE_BATCH_HEIGHT == kGameHeight,
+              "snake batch uses the classic board");
+
+struct SnakeBatch {
+  std::vector<s21::SnakeGame> games;
+  std::vector<int> steps;  ///< Шагов текущего эпизода
+  int max_steps = 0;
+};
+
+namespace {
+
+constexpr int kCells = SNAKE_BATCH_WIDTH * SNAKE_BATCH_HEIGHT;
+
+/**
+ * @brief Начинает партию: из Ready игра сразу переходит в Running.
+ */
+void Restart(s21::SnakeGame& game) {
+  game.Reset();
+  game.Resume();
+}
+
+/**
+ * @brief Пишет наблюдение одной игры (см. snake_batch.h).
+ */
+void Observe(const s21::SnakeGame& game, float* obs) {
+  float* body = obs;
+  float* head = obs + kCells;
+  float* apple = obs + 2 * kCells;
+  float* features = obs + SNAKE_BATCH_PLANES * kCells;
+
+  const std::uint8_t* cells = game.Field().data();
+  for (int i = 0; i < kCells; ++i) {
+    unsigned cell = packed_grid_get(cells, static_cast<std::size_t>(i));
+    body[i] = cell == static_cast<unsigned>(CellType::Snake) ? 1.0f : 0.0f;
+    apple[i] = cell == static_cast<unsigned>(CellType::Apple) ? 1.0f : 0.0f;
+    head[i] = 0.0f;
+  }
+  s21::SnakeSegment position = game.Head();
+  if (game.Field().Contains(position)) {
+    head[position.y * SNAKE_BATCH_WIDTH + position.x] = 1.0f;
+  }
+
+  features[0] = static_cast<float>(game.Length()) / kCells;
+  for (int d = 0; d < 4; ++d) {
+    features[1 + d] = static_cast<int>(game.Direction()) == d ? 1.0f : 0.0f;
+  }
+}
+
+}  // namespace
+
+extern "C" EXPORT SnakeBatch* snake_batch_create(int count, uint32_t seed,
+                                                 int max_steps) {
+  if (count <= 0) return nullptr;
+  SnakeBatch* batch = new (std::nothrow) SnakeBatch;
+  if (!batch) return nullptr;
+
+  // Рекорд читается из файла один раз, остальные игры — копии.
+  s21::SnakeGame prototype;
+  prototype.SetHighScoreFile(false);
+  batch->games.assign(static_cast<std::size_t>(count), prototype);
+  batch->steps.assign(static_cast<std::size_t>(count), 0);
+  batch->max_steps = max_steps > 0 ? max_steps : 0;
+  for (int i = 0; i < count; ++i) {
+    batch->games[i].Seed(seed + static_cast<uint32_t>(i));
+    Restart(batch->games[i]);
+  }
+  return batch;
+}
+
+extern "C" EXPORT void snake_batch_destroy(SnakeBatch* batch) {
+  delete batch;
+}
+
+extern "C" EXPORT int snake_batch_count(const SnakeBatch* batch) {
+  return batch ? static_cast<int>(batch->games.size()) : 0;
+}
+
+extern "C" EXPORT void snake_batch_reset(SnakeBatch* batch,
+                                         float* observations) {
+  for (std::size_t i = 0; i < batch->games.size(); ++i) {
+    Restart(batch->games[i]);
+    batch->steps[i] = 0;
+    if (observations) {
+      Observe(batch->games[i], observations + i * SNAKE_BATCH_OBS_SIZE);
+    }
+  }
+}
+
+extern "C" EXPORT void snake_batch_step(SnakeBatch* batch,
+                                        const int32_t* actions,
+                                        float* observations, float* rewards,
+                                        uint8_t* dones) {
+  for (std::size_t i = 0; i < batch->games.size(); ++i) {
+    s21::SnakeGame& game = batch->games[i];
+    int score = game.Score();
+
+    if (actions[i] >= Left && actions[i] <= Down) {
+      game.ChangeDirection(static_cast<UserAction_t>(actions[i]));
+    }
+    game.Update();
+
+    int steps = ++batch->steps[i];
+    bool done = game.GetState() != s21::SnakeGameState::Running ||
+                (batch->max_steps > 0 && steps >= batch->max_steps);
+    if (rewards) rewards[i] = static_cast<float>(game.Score() - score);
+    if (dones) dones[i] = done ? 1 : 0;
+    if (done) {
+      Restart(game);
+      batch->steps[i] = 0;
+    }
+    if (observations) Observe(game, observations + i * SNAKE_BATCH_OBS_SIZE);
+  }
+}
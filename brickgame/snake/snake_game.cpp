@@ -12,6 +12,7 @@
 #include "../../include/brickgame/snake/snake_game.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <random>
 #include <string>
@@ -21,84 +22,133 @@
 namespace s21 {
 
 /**
- * @brief Конструктор SnakeGame.
+ * @brief Аллокатор библиотеки Snake (один на библиотеку).
+ */
+AllocHooks& SnakeAllocHooks() {
+  static AllocHooks hooks;
+  return hooks;
+}
+
+/**
+ * @brief Конструктор игры на поле фиксированного размера.
  *
  * Загружает сохранённый рекорд и инициализирует состояние игры.
  */
-SnakeGame::SnakeGame() : gen_(std::random_device{}()) {
-  high_score_ = LoadHighScore();
+template <int Width, int Height>
+BasicSnakeGame<Width, Height>::BasicSnakeGame()
+  requires(kFixed)
+{
+  Init();
+}
+
+/**
+ * @brief Конструктор игры на поле заданного размера.
+ */
+template <int Width, int Height>
+BasicSnakeGame<Width, Height>::BasicSnakeGame(int width, int height)
+  requires(!kFixed)
+    : session_(std::clamp(width, kMinBoardSide, kMaxBoardSide),
+               std::clamp(height, kMinBoardSide, kMaxBoardSide)),
+      frame_cells_(static_cast<std::size_t>(session_.field.cells())),
+      frame_rows_(static_cast<std::size_t>(session_.field.height())) {
+  Init();
+}
+
+/**
+ * @brief Загружает рекорд, задаёт случайное зерно генератора яблок и
+ *        приводит игру в начальное состояние.
+ */
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::Init() {
+  std::random_device device;
+  session_.rng.state = (std::uint64_t{device()} << 32) | device();
+  session_.high_score = LoadHighScore();
+  input_queue_init(&session_.turns, 1);
   Reset();
 }
 
 /**
  * @brief Полная перезагрузка игры (сброс счёта, уровня, змейки и поля).
  */
-void SnakeGame::Reset() {
-  state_ = SnakeGameState::Ready;
-  direction_ = SnakeDirection::Right;
-  next_direction_ = SnakeDirection::Right;
-  length_ = 4;
-  score_ = 0;
-  level_ = 1;
-  speed_ = 600;
-  accelerated_ = false;
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::Reset() {
+  session_.state = SnakeGameState::Ready;
+  session_.direction = SnakeDirection::Right;
+  session_.next_direction = SnakeDirection::Right;
+  session_.length = 4;
+  session_.score = 0;
+  session_.level = 1;
+  session_.speed = 600;
+  session_.accelerated = false;
+  session_.pending_ms = 0;
+  input_queue_clear(&session_.turns);
+  session_.clock_ms = 0;
 
   ClearField();
 }
 /**
  * @brief Очистка игрового поля (все клетки → пустые).
  */
-void SnakeGame::ClearField() {
-  for (int y = 0; y < kGameHeight; ++y) {
-    for (int x = 0; x < kGameWidth; ++x) {
-      field_[y][x] = static_cast<int>(CellType::Empty);
-    }
-  }
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::ClearField() {
+  session_.field.fill(CellType::Empty);
 }
 /**
  * @brief Размещение змейки в начальном положении.
  */
-void SnakeGame::InitializeSnake() {
-  snake_.clear();
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::InitializeSnake() {
+  session_.body.clear();
   int start_x = 0;
-  int start_y = kGameHeight / 2;
+  int start_y = session_.field.height() / 2;
 
-  for (int i = length_ - 1; i >= 0; --i) {
-    snake_.push_back({start_x + i, start_y});
-    field_[start_y][start_x + i] = static_cast<int>(CellType::Snake);
+  for (int i = session_.length - 1; i >= 0; --i) {
+    session_.body.push_back({start_x + i, start_y});
+    session_.field.set(start_x + i, start_y, CellType::Snake);
   }
 }
 /**
  * @brief Основное обновление логики (ход змейки, генерация яблок, ускорение).
  */
-void SnakeGame::Update() {
-  if (state_ == SnakeGameState::Ready) {
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::Update() {
+  if (session_.state == SnakeGameState::Ready) {
     InitializeSnake();
     PlaceApple();
-    state_ = SnakeGameState::Running;
+    session_.state = SnakeGameState::Running;
     return;
   }
 
-  if (state_ != SnakeGameState::Running) return;
+  if (session_.state != SnakeGameState::Running) return;
+
+  QueuedInput turn;
+  for (std::uint32_t i = 0; i < session_.turns.per_tick &&
+                            input_queue_pop(&session_.turns, &turn);
+       ++i) {
+    auto dir = static_cast<SnakeDirection>(turn.action);
+    if (!IsOppositeDirection(dir)) session_.next_direction = dir;
+  }
 
-  direction_ = next_direction_;
+  session_.direction = session_.next_direction;
   Move();
 
-  int baseSpeed = 600 - (level_ - 1) * 40;
+  int baseSpeed = 600 - (session_.level - 1) * 40;
 
-  if (accelerated_) {
-    speed_ = baseSpeed / 2;
+  if (session_.accelerated) {
+    session_.speed = baseSpeed / 2;
   } else {
-    speed_ = baseSpeed;
+    session_.speed = baseSpeed;
   }
 }
 /**
  * @brief Изменить направление движения змейки (с проверкой на валидность).
  */
-void SnakeGame::ChangeDirection(UserAction_t action, bool hold) {
-  if (state_ != SnakeGameState::Running) return;
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::ChangeDirection(UserAction_t action,
+                                                    bool hold) {
+  if (session_.state != SnakeGameState::Running) return;
 
-  SnakeDirection new_direction = direction_;
+  SnakeDirection new_direction = session_.direction;
 
   switch (action) {
     case Up:
@@ -117,23 +167,36 @@ void SnakeGame::ChangeDirection(UserAction_t action, bool hold) {
       return;
   }
 
-  if (!IsOppositeDirection(new_direction)) {
-    next_direction_ = new_direction;
-
-    if (hold) {
-      accelerated_ = true;
-    } else {
-      accelerated_ = false;
-    }
+  // Поворот сравнивается с направлением, которое змейка будет иметь
+  // после всех уже поставленных в очередь поворотов.
+  const QueuedInput* last = input_queue_back(&session_.turns);
+  SnakeDirection current = last ? static_cast<SnakeDirection>(last->action)
+                                : session_.next_direction;
+  if (AreOppositeDirections(current, new_direction)) return;
+
+  session_.accelerated = hold;
+  if (new_direction != current) {
+    input_queue_push(&session_.turns,
+                     static_cast<std::int32_t>(new_direction), hold,
+                     session_.clock_ms);
   }
 }
+/**
+ * @brief Задаёт число поворотов из очереди, применяемых за шаг.
+ */
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::SetTurnsPerTick(int turns) {
+  session_.turns.per_tick = static_cast<std::uint32_t>(
+      std::clamp(turns, 1, static_cast<int>(INPUT_QUEUE_CAPACITY)));
+}
 /**
  * @brief Передвигает змейку на один шаг.
  *
  * Проверяет столкновения, поедание яблок, рост змейки и победу.
  */
-void SnakeGame::Move() {
-  if (snake_.empty()) return;
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::Move() {
+  if (session_.body.empty()) return;
 
   SnakeSegment head = CalculateNewHeadPosition();
 
@@ -153,51 +216,91 @@ void SnakeGame::Move() {
 /**
  * @brief Разместить яблоко в случайной пустой клетке.
  */
-void SnakeGame::PlaceApple() {
-  std::uniform_int_distribution<int> dist_x(0, kGameWidth - 1);
-  std::uniform_int_distribution<int> dist_y(0, kGameHeight - 1);
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::PlaceApple() {
+  std::uniform_int_distribution<int> dist_x(0, session_.field.width() - 1);
+  std::uniform_int_distribution<int> dist_y(0, session_.field.height() - 1);
 
   int x, y;
   do {
-    x = dist_x(gen_);
-    y = dist_y(gen_);
-  } while (field_[y][x] != static_cast<int>(CellType::Empty));
+    x = dist_x(session_.rng);
+    y = dist_y(session_.rng);
+  } while (session_.field.get(x, y) != CellType::Empty);
 
-  apple_x_ = x;
-  apple_y_ = y;
-  field_[y][x] = static_cast<int>(CellType::Apple);
+  session_.apple_x = x;
+  session_.apple_y = y;
+  session_.field.set(x, y, CellType::Apple);
 }
 
 /**
- * @brief Обновить и сохранить рекорд, если текущий счёт выше.
+ * @brief Обновить рекорд в памяти, если текущий счёт выше.
  */
-void SnakeGame::UpdateHighScore() {
-  if (score_ > high_score_) {
-    high_score_ = score_;
-    SaveHighScore();
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::UpdateHighScore() {
+  if (session_.score > session_.high_score) {
+    session_.high_score = session_.score;
+    high_score_dirty_ = true;
   }
 }
+
+/**
+ * @brief Записать рекорд в файл, если он вырос с прошлой записи.
+ */
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::FlushHighScore() {
+  if (!high_score_dirty_) return;
+  if (high_score_file_) SaveHighScore();
+  high_score_dirty_ = false;
+}
 /**
  * @brief Получить текущее состояние игры в формате GameInfo_t.
  *
  * Память для поля выделяется динамически. Освобождение через FreeGameInfo().
  */
-GameInfo_t SnakeGame::GetGameInfo() const {
+template <int Width, int Height>
+GameInfo_t BasicSnakeGame<Width, Height>::GetGameInfo() const {
   GameInfo_t info{};
 
-  info.field = new int*[kGameHeight];
-  for (int y = 0; y < kGameHeight; ++y) {
-    info.field[y] = new int[kGameWidth];
-    for (int x = 0; x < kGameWidth; ++x) {
-      info.field[y][x] = field_[y][x];
-    }
+  AllocHooks& hooks = SnakeAllocHooks();
+  info.field = static_cast<int**>(
+      alloc_hooks_alloc(&hooks, session_.field.height() * sizeof(int*)));
+  for (int y = 0; y < session_.field.height(); ++y) {
+    info.field[y] = static_cast<int*>(
+        alloc_hooks_alloc(&hooks, session_.field.width() * sizeof(int)));
+    session_.field.UnpackRow(y, info.field[y]);
   }
 
-  info.score = score_;
-  info.high_score = high_score_;
-  info.level = level_;
-  info.speed = speed_;
-  info.pause = (state_ == SnakeGameState::Paused) ? 1 : 0;
+  info.score = session_.score;
+  info.high_score = std::max(session_.score, session_.high_score);
+  info.level = session_.level;
+  info.speed = session_.speed;
+  info.pause = (session_.state == SnakeGameState::Paused) ? 1 : 0;
+  info.next = nullptr;
+
+  return info;
+}
+
+/**
+ * @brief Получить кадр игры без выделения памяти.
+ *
+ * Поле копируется в постоянный буфер объекта; кадр действителен до
+ * следующего вызова GetFrame().
+ */
+template <int Width, int Height>
+GameInfo_t BasicSnakeGame<Width, Height>::GetFrame() {
+  GameInfo_t info{};
+
+  for (int y = 0; y < session_.field.height(); ++y) {
+    frame_rows_[y] = frame_cells_.data() + y * session_.field.width();
+    session_.field.UnpackRow(y, frame_rows_[y]);
+  }
+  info.field = frame_rows_.data();
+
+  info.score = session_.score;
+  info.high_score = std::max(session_.score, session_.high_score);
+  info.level = session_.level;
+  info.speed = session_.speed;
+  info.pause = (session_.state == SnakeGameState::Paused) ? 1 : 0;
   info.next = nullptr;
 
   return info;
@@ -206,12 +309,14 @@ GameInfo_t SnakeGame::GetGameInfo() const {
 /**
  * @brief Освобождает память, выделенную для GameInfo_t::field.
  */
-void SnakeGame::FreeGameInfo(GameInfo_t& info) const {
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::FreeGameInfo(GameInfo_t& info) const {
   if (info.field) {
-    for (int y = 0; y < kGameHeight; ++y) {
-      delete[] info.field[y];
+    AllocHooks& hooks = SnakeAllocHooks();
+    for (int y = 0; y < session_.field.height(); ++y) {
+      alloc_hooks_free(&hooks, info.field[y]);
     }
-    delete[] info.field;
+    alloc_hooks_free(&hooks, info.field);
     info.field = nullptr;
   }
 }
@@ -221,66 +326,111 @@ void SnakeGame::FreeGameInfo(GameInfo_t& info) const {
  * \param y Координата Y.
  * \return true, если в ячейке находится часть змейки.
  */
-bool SnakeGame::CheckCollision(int x, int y) const {
-  return field_[y][x] == static_cast<int>(CellType::Snake);
+template <int Width, int Height>
+bool BasicSnakeGame<Width, Height>::CheckCollision(int x, int y) const {
+  return session_.field.get(x, y) == CellType::Snake;
 }
 /**
  * \brief Проверяет, является ли новое направление противоположным текущему.
  * \param dir Новое направление.
  * \return true, если направление противоположно текущему.
  */
-bool SnakeGame::IsOppositeDirection(SnakeDirection dir) const {
-  return (direction_ == SnakeDirection::Up && dir == SnakeDirection::Down) ||
-         (direction_ == SnakeDirection::Down && dir == SnakeDirection::Up) ||
-         (direction_ == SnakeDirection::Left && dir == SnakeDirection::Right) ||
-         (direction_ == SnakeDirection::Right && dir == SnakeDirection::Left);
+template <int Width, int Height>
+bool BasicSnakeGame<Width, Height>::IsOppositeDirection(
+    SnakeDirection dir) const {
+  return AreOppositeDirections(session_.direction, dir);
 }
 /**
  * \brief Получает текущее состояние игры.
  * \return Состояние игры (Ready, Running, Paused, Won, Lost).
  */
-SnakeGameState SnakeGame::GetState() const { return state_; }
+template <int Width, int Height>
+SnakeGameState BasicSnakeGame<Width, Height>::GetState() const {
+  return session_.state;
+}
 /**
  * \brief Возобновляет игру после паузы или из состояния Ready.
  * Если состояние Ready, то выполняет первый Update().
  */
-void SnakeGame::Resume() {
-  if (state_ == SnakeGameState::Paused || state_ == SnakeGameState::Ready) {
-    if (state_ == SnakeGameState::Ready) {
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::Resume() {
+  if (session_.state == SnakeGameState::Paused ||
+      session_.state == SnakeGameState::Ready) {
+    if (session_.state == SnakeGameState::Ready) {
       Update();
     }
-    state_ = SnakeGameState::Running;
+    session_.state = SnakeGameState::Running;
   }
 }
 /**
  * \brief Ставит игру на паузу.
  */
-void SnakeGame::Pause() {
-  if (state_ == SnakeGameState::Running) state_ = SnakeGameState::Paused;
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::Pause() {
+  if (session_.state == SnakeGameState::Running) {
+    session_.state = SnakeGameState::Paused;
+  }
 }
 /**
  * \brief Принудительно завершает игру (состояние Lost).
  */
-void SnakeGame::Terminate() { state_ = SnakeGameState::Lost; }
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::Terminate() {
+  session_.state = SnakeGameState::Lost;
+  UpdateHighScore();
+}
 /**
  * \brief Управляет ускорением змейки.
  * \param enable true — включить ускорение, false — выключить.
  */
-void SnakeGame::Accelerate(bool enable) { accelerated_ = enable; }
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::Accelerate(bool enable) {
+  session_.accelerated = enable;
+}
 /**
  * \brief Обрабатывает один игровой тик.
  * Если игра в состоянии Running — выполняет Update().
  */
-void SnakeGame::Tick() {
-  if (state_ == SnakeGameState::Running) {
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::Tick() {
+  if (session_.state == SnakeGameState::Running) {
+    session_.clock_ms += static_cast<std::uint32_t>(session_.speed);
+    Update();
+  }
+}
+/**
+ * \brief Продвигает игру на прошедшее реальное время.
+ * \param elapsed_ms Время с предыдущего вызова, мс.
+ * \return Число выполненных шагов.
+ */
+template <int Width, int Height>
+int BasicSnakeGame<Width, Height>::Advance(int elapsed_ms) {
+  if (session_.state != SnakeGameState::Running) {
+    session_.pending_ms = 0;
+    return 0;
+  }
+
+  session_.pending_ms += std::max(elapsed_ms, 0);
+  session_.clock_ms += static_cast<std::uint32_t>(std::max(elapsed_ms, 0));
+  int steps = 0;
+  while (session_.state == SnakeGameState::Running && session_.speed > 0 &&
+         session_.pending_ms >= session_.speed) {
+    if (steps == kMaxCatchUpSteps) {
+      session_.pending_ms = 0;
+      break;
+    }
+    session_.pending_ms -= session_.speed;
     Update();
+    ++steps;
   }
+  return steps;
 }
 /**
  * \brief Загружает рекорд из файла snake_highscore.txt.
  * \return Сохранённый high score или 0, если файла нет.
  */
-int SnakeGame::LoadHighScore() {
+template <int Width, int Height>
+int BasicSnakeGame<Width, Height>::LoadHighScore() {
   std::ifstream file("snake_highscore.txt");
   int hs = 0;
   if (file.is_open()) {
@@ -292,10 +442,11 @@ int SnakeGame::LoadHighScore() {
 /**
  * \brief Сохраняет текущий рекорд в файл snake_highscore.txt.
  */
-void SnakeGame::SaveHighScore() const {
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::SaveHighScore() const {
   std::ofstream file("snake_highscore.txt");
   if (file.is_open()) {
-    file << high_score_;
+    file << session_.high_score;
     file.close();
   }
 }
@@ -306,29 +457,13 @@ void SnakeGame::SaveHighScore() const {
  * Смещает голову в зависимости от текущего направления движения.
  * Если змейка пуста, возвращает (0,0).
  */
-SnakeSegment SnakeGame::CalculateNewHeadPosition() const {
-  if (snake_.empty()) {
+template <int Width, int Height>
+SnakeSegment BasicSnakeGame<Width, Height>::CalculateNewHeadPosition() const {
+  if (session_.body.empty()) {
     return {0, 0};
   }
 
-  SnakeSegment head = snake_.front();
-
-  switch (direction_) {
-    case SnakeDirection::Up:
-      head.y -= 1;
-      break;
-    case SnakeDirection::Down:
-      head.y += 1;
-      break;
-    case SnakeDirection::Left:
-      head.x -= 1;
-      break;
-    case SnakeDirection::Right:
-      head.x += 1;
-      break;
-  }
-
-  return head;
+  return NextHeadPosition(session_.body.front(), session_.direction);
 }
 /**
  * @brief Проверяет столкновения головы змейки.
@@ -338,11 +473,10 @@ SnakeSegment SnakeGame::CalculateNewHeadPosition() const {
  * @param head новая позиция головы
  * @return true если произошло столкновение, иначе false
  */
-bool SnakeGame::CheckCollisions(const SnakeSegment& head) const {
-  if (head.x < 0 || head.x >= kGameWidth || head.y < 0 ||
-      head.y >= kGameHeight) {
-    return true;
-  }
+template <int Width, int Height>
+bool BasicSnakeGame<Width, Height>::CheckCollisions(
+    const SnakeSegment& head) const {
+  if (!session_.field.Contains(head)) return true;
 
   return CheckCollision(head.x, head.y);
 }
@@ -351,8 +485,9 @@ bool SnakeGame::CheckCollisions(const SnakeSegment& head) const {
  *
  * Переводит игру в состояние проигрыша и обновляет рекорд.
  */
-void SnakeGame::HandleCollision() {
-  state_ = SnakeGameState::Lost;
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::HandleCollision() {
+  session_.state = SnakeGameState::Lost;
   UpdateHighScore();
 }
 /**
@@ -363,28 +498,30 @@ void SnakeGame::HandleCollision() {
  * @param head новая позиция головы змейки
  * @return true если яблоко съедено, иначе false
  */
-bool SnakeGame::CheckAppleEaten(const SnakeSegment& head) const {
-  return (head.x == apple_x_ && head.y == apple_y_);
+template <int Width, int Height>
+bool BasicSnakeGame<Width, Height>::CheckAppleEaten(
+    const SnakeSegment& head) const {
+  return (head.x == session_.apple_x && head.y == session_.apple_y);
 }
 /**
  * @brief Обрабатывает событие съедания яблока.
  *
- * Увеличивает длину змейки, добавляет очки, обновляет рекорд,
+ * Увеличивает длину змейки, добавляет очки,
  * проверяет условие победы и устанавливает новый уровень.
  * При необходимости размещает новое яблоко.
  */
-void SnakeGame::HandleAppleEaten() {
-  ++length_;
-  score_ += 1;
-  UpdateHighScore();
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::HandleAppleEaten() {
+  ++session_.length;
+  session_.score += 1;
 
-  if (length_ >= kMaxSnakeLength) {
-    state_ = SnakeGameState::Won;
+  if (session_.length >= session_.field.cells()) {
+    session_.state = SnakeGameState::Won;
     UpdateHighScore();
     return;
   }
 
-  level_ = std::min(1 + score_ / 5, 10);
+  session_.level = std::min(1 + session_.score / 5, 10);
   PlaceApple();
 }
 /**
@@ -397,15 +534,201 @@ void SnakeGame::HandleAppleEaten() {
  * @param grow Флаг, указывающий, нужно ли увеличить длину змейки
  *             (true при поедании яблока).
  */
-void SnakeGame::UpdateSnake(const SnakeSegment& head, bool grow) {
-  snake_.push_front(head);
-  field_[head.y][head.x] = static_cast<int>(CellType::Snake);
+template <int Width, int Height>
+void BasicSnakeGame<Width, Height>::UpdateSnake(const SnakeSegment& head,
+                                                bool grow) {
+  session_.body.push_front(head);
+  session_.field.set(head.x, head.y, CellType::Snake);
 
   if (!grow) {
-    SnakeSegment tail = snake_.back();
-    field_[tail.y][tail.x] = static_cast<int>(CellType::Empty);
-    snake_.pop_back();
+    SnakeSegment tail = session_.body.back();
+    session_.field.set(tail.x, tail.y, CellType::Empty);
+    session_.body.pop_back();
+  }
+}
+
+/**
+ * @brief Сохраняет полное состояние сессии в бинарный снимок.
+ *
+ * Координаты сегментов пишутся по байту, поле — упакованным по 2 бита
+ * на клетку (как в ExportPackedField()), генератор яблок — одним
+ * 64-битным словом.
+ */
+template <int Width, int Height>
+std::size_t BasicSnakeGame<Width, Height>::SaveState(void* buf,
+                                                     std::size_t size) const {
+  StateWriter writer;
+  state_blob_begin(&writer, buf, size);
+
+  state_write_u8(&writer, static_cast<std::uint8_t>(session_.field.width()));
+  state_write_u8(&writer, static_cast<std::uint8_t>(session_.field.height()));
+  state_write_u8(&writer, static_cast<std::uint8_t>(session_.state));
+  state_write_u8(&writer, static_cast<std::uint8_t>(session_.direction));
+  state_write_u8(&writer, static_cast<std::uint8_t>(session_.next_direction));
+  state_write_u8(&writer, session_.accelerated ? 1 : 0);
+  state_write_i32(&writer, session_.length);
+  state_write_u8(&writer, static_cast<std::uint8_t>(session_.apple_x));
+  state_write_u8(&writer, static_cast<std::uint8_t>(session_.apple_y));
+  state_write_i32(&writer, session_.score);
+  state_write_i32(&writer, session_.level);
+  state_write_i32(&writer, session_.speed);
+  state_write_i32(&writer, session_.pending_ms);
+  state_write_u32(&writer, session_.clock_ms);
+
+  state_write_u8(&writer, static_cast<std::uint8_t>(session_.turns.per_tick));
+  state_write_u8(&writer, static_cast<std::uint8_t>(session_.turns.count));
+  for (std::uint32_t i = 0; i < session_.turns.count; ++i) {
+    const QueuedInput& turn =
+        session_.turns.items[(session_.turns.head + i) % INPUT_QUEUE_CAPACITY];
+    state_write_u8(&writer, static_cast<std::uint8_t>(turn.action));
+    state_write_u8(&writer, static_cast<std::uint8_t>(turn.hold));
+    state_write_u32(&writer, turn.time_ms);
+  }
+
+  state_write_u16(&writer, static_cast<std::uint16_t>(session_.body.size()));
+  for (std::size_t i = 0; i < session_.body.size(); ++i) {
+    state_write_u8(&writer, static_cast<std::uint8_t>(session_.body[i].x));
+    state_write_u8(&writer, static_cast<std::uint8_t>(session_.body[i].y));
+  }
+
+  state_write(&writer, session_.field.data(), session_.field.size());
+
+  state_write_u64(&writer, session_.rng.state);
+
+  return state_blob_end(&writer, BRICKGAME_STATE_SNAKE, kSnakeStateVersion);
+}
+
+/**
+ * @brief Восстанавливает сессию из снимка SaveState().
+ *
+ * Снимок сначала разбирается и проверяется целиком, и только затем
+ * заменяет текущее состояние.
+ */
+template <int Width, int Height>
+bool BasicSnakeGame<Width, Height>::LoadState(const void* buf,
+                                              std::size_t size) {
+  StateReader reader;
+  if (!state_blob_open(&reader, buf, size, BRICKGAME_STATE_SNAKE,
+                       kSnakeStateVersion)) {
+    return false;
   }
+  if (state_read_u8(&reader) != session_.field.width() ||
+      state_read_u8(&reader) != session_.field.height()) {
+    return false;
+  }
+
+  std::uint8_t state = state_read_u8(&reader);
+  std::uint8_t direction = state_read_u8(&reader);
+  std::uint8_t next_direction = state_read_u8(&reader);
+  bool accelerated = state_read_u8(&reader) != 0;
+  int length = state_read_i32(&reader);
+  int apple_x = state_read_u8(&reader);
+  int apple_y = state_read_u8(&reader);
+  int score = state_read_i32(&reader);
+  int level = state_read_i32(&reader);
+  int speed = state_read_i32(&reader);
+  int pending_ms = state_read_i32(&reader);
+  std::uint32_t clock_ms = state_read_u32(&reader);
+
+  std::uint8_t per_tick = state_read_u8(&reader);
+  std::uint8_t turn_count = state_read_u8(&reader);
+  if (!reader.ok || per_tick == 0 || per_tick > INPUT_QUEUE_CAPACITY ||
+      turn_count > INPUT_QUEUE_CAPACITY) {
+    return false;
+  }
+  InputQueue turns;
+  input_queue_init(&turns, per_tick);
+  turns.dropped = session_.turns.dropped;
+  for (std::uint8_t i = 0; i < turn_count; ++i) {
+    std::uint8_t action = state_read_u8(&reader);
+    bool hold = state_read_u8(&reader) != 0;
+    std::uint32_t time_ms = state_read_u32(&reader);
+    if (action > static_cast<std::uint8_t>(SnakeDirection::Right)) {
+      return false;
+    }
+    input_queue_push(&turns, action, hold, time_ms);
+  }
+
+  std::uint16_t body_size = state_read_u16(&reader);
+  if (!reader.ok || body_size > session_.field.cells() ||
+      state > static_cast<std::uint8_t>(SnakeGameState::Lost) ||
+      direction > static_cast<std::uint8_t>(SnakeDirection::Right) ||
+      next_direction > static_cast<std::uint8_t>(SnakeDirection::Right)) {
+    return false;
+  }
+
+  SnakeBody<Width, Height> body = session_.body;
+  body.clear();
+  for (std::uint16_t i = 0; i < body_size; ++i) {
+    int x = state_read_u8(&reader);
+    int y = state_read_u8(&reader);
+    if (x >= session_.field.width() || y >= session_.field.height()) {
+      return false;
+    }
+    body.push_back({x, y});
+  }
+
+  SnakeGrid<Width, Height> field = session_.field;
+  state_read(&reader, field.data(), field.size());
+  for (int y = 0; y < field.height(); ++y) {
+    for (int x = 0; x < field.width(); ++x) {
+      if (field.get(x, y) > CellType::Apple) return false;
+    }
+  }
+
+  std::uint64_t rng_state = state_read_u64(&reader);
+  if (!reader.ok || reader.pos != reader.size) return false;
+
+  State loaded = session_;
+  loaded.state = static_cast<SnakeGameState>(state);
+  loaded.direction = static_cast<SnakeDirection>(direction);
+  loaded.next_direction = static_cast<SnakeDirection>(next_direction);
+  loaded.accelerated = accelerated;
+  loaded.length = length;
+  loaded.apple_x = apple_x;
+  loaded.apple_y = apple_y;
+  loaded.score = score;
+  loaded.level = level;
+  loaded.speed = speed;
+  loaded.pending_ms = pending_ms;
+  loaded.clock_ms = clock_ms;
+  loaded.turns = turns;
+  loaded.body = body;
+  loaded.field = field;
+  loaded.rng.state = rng_state;
+  return RestoreSession(loaded);
+}
+
+/**
+ * @brief Заменяет состояние партии (клон из Session() или снимок).
+ *
+ * Рекорд объекта только растёт и в файл не записывается.
+ */
+template <int Width, int Height>
+bool BasicSnakeGame<Width, Height>::RestoreSession(const State& session) {
+  if (session.field.width() != session_.field.width() ||
+      session.field.height() != session_.field.height()) {
+    return false;
+  }
+  int high_score = std::max(session_.high_score, session.high_score);
+  session_ = session;
+  session_.high_score = std::max(high_score, session_.score);
+  return true;
 }
 
+/**
+ * @brief Пишет поле в упакованном виде (2 бита на клетку).
+ */
+template <int Width, int Height>
+std::size_t BasicSnakeGame<Width, Height>::ExportPackedField(
+    void* buf, std::size_t size) const {
+  if (buf && size >= session_.field.size()) {
+    std::memcpy(buf, session_.field.data(), session_.field.size());
+  }
+  return session_.field.size();
+}
+
+template class BasicSnakeGame<kGameWidth, kGameHeight>;
+template class BasicSnakeGame<kDynamicExtent, kDynamicExtent>;
+
 }  // namespace s21
\ No newline at end of file
@@ -0,0 +1,542 @@
+/**
+ * @file snake_soa.cpp
+ * @brief Реализация пакета партий Snake в виде структуры массивов.
+ */
+#include "../../include/brickgame/snake/snake_soa.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define S21_SNAKE_SOA_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+
+namespace {
+
+/// Длина змейки в начале партии.
+constexpr int kStartLength = 4;
+
+/// SnakeDirection для Left, Right, Up, Down (по порядку UserAction_t).
+constexpr std::int32_t kActionDirection[4] = {
+    static_cast<std::int32_t>(SnakeDirection::Left),
+    static_cast<std::int32_t>(SnakeDirection::Right),
+    static_cast<std::int32_t>(SnakeDirection::Up),
+    static_cast<std::int32_t>(SnakeDirection::Down)};
+
+/// Хвост массива меток: метка-заглушка и запас в одну метку, потому
+/// что выборка читает 32 бита с адреса 16-битной метки.
+constexpr int kStampPadding = 2;
+
+static_assert(SnakeSoaBatch::kWidth == kGameWidth &&
+                  SnakeSoaBatch::kHeight == kGameHeight,
+              "SoA batch mirrors the classic board");
+static_assert(Left + 1 == Right && Right + 1 == Up && Up + 1 == Down,
+              "action-to-direction table order");
+static_assert(kActionDirection[0] == 2 && kActionDirection[1] == 3 &&
+                  kActionDirection[2] == 0 && kActionDirection[3] == 1,
+              "vector kernel turns with (action - Left) ^ 2");
+static_assert(SnakeSoaBatch::kCells >= kStartLength,
+              "start body fits the board");
+
+}  // namespace
+
+SnakeSoaBatch::SnakeSoaBatch(int count, std::uint32_t seed)
+    : count_(std::max(count, 0)),
+      lanes_((count_ + kLanes - 1) / kLanes * kLanes),
+      status_(lanes_, kLost),
+      head_x_(lanes_),
+      head_y_(lanes_),
+      direction_(lanes_),
+      apple_(lanes_),
+      length_(lanes_),
+      score_(lanes_),
+      level_(lanes_),
+      clock_(lanes_, kClockStart),
+      stamp_(static_cast<std::size_t>(lanes_) * kCells + kStampPadding),
+      apple_queue_(static_cast<std::size_t>(count_) * kAppleQueue),
+      apple_next_(count_, kAppleQueue),
+      refill_pending_(count_) {
+  gen_.reserve(count_);
+  refill_.reserve(count_);
+  for (int env = 0; env < count_; ++env) {
+    gen_.push_back({seed + static_cast<std::uint32_t>(env)});
+    Reset(env);
+  }
+  RefillApples();
+  simd_ = SimdAvailable();
+}
+
+bool SnakeSoaBatch::SimdAvailable() {
+#ifdef S21_SNAKE_SOA_AVX2
+  static const bool available = __builtin_cpu_supports("avx2");
+  return available;
+#else
+  return false;
+#endif
+}
+
+void SnakeSoaBatch::SetSimd(bool enabled) {
+  simd_ = enabled && SimdAvailable();
+}
+
+/**
+ * @brief Стартовое положение SnakeGame: змейка из 4 клеток в строке
+ *        kHeight / 2, голова в x = 3, движение вправо.
+ *
+ * Карта не чистится: часы уходят вперёд на стартовую длину, и все
+ * метки прошлой партии становятся старше тела новой.
+ */
+void SnakeSoaBatch::Reset(int env) {
+  clock_[env] += kStartLength;
+  length_[env] = kStartLength;
+  PlaceStartBody(env);
+  if (clock_[env] >= kClockLimit) Rebase(env);
+  head_x_[env] = kStartLength - 1;
+  head_y_[env] = kHeight / 2;
+  direction_[env] = static_cast<std::int16_t>(SnakeDirection::Right);
+  score_[env] = 0;
+  level_[env] = 1;
+  status_[env] = kRunning;
+  PlaceApple(env);
+}
+
+/**
+ * @brief Метки стартового тела: хвост в x = 0 старше всех, голова в
+ *        x = kStartLength - 1 — текущие часы. Одна 64-битная запись.
+ */
+void SnakeSoaBatch::PlaceStartBody(int env) {
+  static_assert(kStartLength == 4, "start body is one 64-bit store");
+  std::uint64_t body = 0;
+  for (int i = 0; i < kStartLength; ++i) {
+    auto stamp = static_cast<std::uint16_t>(clock_[env] - kStartLength + 1 + i);
+    body |= static_cast<std::uint64_t>(stamp) << (16 * i);
+  }
+  std::memcpy(&stamp_[Stamp(env, kHeight / 2 * kWidth)], &body, sizeof(body));
+}
+
+/**
+ * @brief Переносит часы партии к kClockStart, пока метки не вышли за
+ *        16 бит: метки тела сдвигаются вместе с часами, остальные
+ *        обнуляются.
+ */
+void SnakeSoaBatch::Rebase(int env) {
+  const std::int32_t clock = clock_[env];
+  const std::int32_t delta = clock - kClockStart;
+  const std::int32_t length = length_[env];
+  std::uint16_t* stamp = &stamp_[Stamp(env, 0)];
+  for (int cell = 0; cell < kCells; ++cell) {
+    stamp[cell] = clock - stamp[cell] < length
+                      ? static_cast<std::uint16_t>(stamp[cell] - delta)
+                      : 0;
+  }
+  clock_[env] = kClockStart;
+}
+
+int SnakeSoaBatch::ResetFinished() {
+  int reset = 0;
+  if (simd_) {
+    reset = ResetFinishedSimd();
+  } else {
+    for (int env = 0; env < count_; ++env) {
+      if (status_[env] != kRunning) {
+        Reset(env);
+        ++reset;
+      }
+    }
+    finished_ = false;
+  }
+  RefillApples();
+  return reset;
+}
+
+/**
+ * @brief Вытягивает из генератора kAppleQueue кандидатов — те же
+ *        распределения и тот же порядок выборки, что в
+ *        SnakeGame::PlaceApple().
+ */
+void SnakeSoaBatch::DrawApples(int env) {
+  std::uniform_int_distribution<int> dist_x(0, kWidth - 1);
+  std::uniform_int_distribution<int> dist_y(0, kHeight - 1);
+  std::uint8_t* queue =
+      &apple_queue_[static_cast<std::size_t>(env) * kAppleQueue];
+  for (int i = 0; i < kAppleQueue; ++i) {
+    int x = dist_x(gen_[env]);
+    int y = dist_y(gen_[env]);
+    queue[i] = static_cast<std::uint8_t>(y * kWidth + x);
+  }
+  apple_next_[env] = 0;
+}
+
+/**
+ * @brief Новое яблоко: первый свободный кандидат из очереди.
+ *
+ * Опустевшая очередь ставится на пополнение после шага; если кандидаты
+ * кончились раньше (много промахов подряд), они вытягиваются сразу —
+ * последовательность от этого не меняется.
+ */
+void SnakeSoaBatch::PlaceApple(int env) {
+  const std::uint8_t* queue =
+      &apple_queue_[static_cast<std::size_t>(env) * kAppleQueue];
+  int cell;
+  do {
+    if (apple_next_[env] == kAppleQueue) DrawApples(env);
+    cell = queue[apple_next_[env]++];
+  } while (Occupied(env, cell));
+  apple_[env] = static_cast<std::int16_t>(cell);
+
+  if (apple_next_[env] == kAppleQueue && !refill_pending_[env]) {
+    refill_pending_[env] = 1;
+    refill_.push_back(env);
+  }
+}
+
+void SnakeSoaBatch::RefillApples() {
+  for (std::int32_t env : refill_) {
+    refill_pending_[env] = 0;
+    if (apple_next_[env] == kAppleQueue) DrawApples(env);
+  }
+  refill_.clear();
+}
+
+CellType SnakeSoaBatch::Cell(int env, int x, int y) const {
+  int cell = y * kWidth + x;
+  if (Occupied(env, cell)) return CellType::Snake;
+  return cell == apple_[env] ? CellType::Apple : CellType::Empty;
+}
+
+/**
+ * @brief Сегмент index — клетка с меткой «часы - index»: метки тела
+ *        различны, а все прочие старше хвоста.
+ */
+SnakeSegment SnakeSoaBatch::Segment(int env, int index) const {
+  const std::int32_t wanted = clock_[env] - index;
+  const std::uint16_t* stamp = &stamp_[Stamp(env, 0)];
+  int cell = 0;
+  while (cell < kCells - 1 && stamp[cell] != wanted) ++cell;
+  return {cell % kWidth, cell / kWidth};
+}
+
+/**
+ * @brief Съеденное яблоко: рост, счёт, уровень и новое яблоко или победа.
+ */
+void SnakeSoaBatch::Grow(int env) {
+  ++length_[env];
+  ++score_[env];
+  if (length_[env] >= kCells) {
+    status_[env] = kWon;
+    finished_ = true;
+    return;
+  }
+  level_[env] = static_cast<std::int16_t>(std::min(1 + score_[env] / 5, 10));
+  PlaceApple(env);
+}
+
+/**
+ * @brief Шаг без векторного ядра: та же логика по одной партии.
+ *
+ * Указатели на массивы вынесены в локальные переменные: запись метки
+ * (uint16_t) иначе заставляет компилятор перечитывать их после каждой
+ * записи.
+ */
+void SnakeSoaBatch::StepScalar(const std::int32_t* actions) {
+  std::int16_t* status = status_.data();
+  std::int16_t* head_x = head_x_.data();
+  std::int16_t* head_y = head_y_.data();
+  std::int16_t* directions = direction_.data();
+  std::int16_t* clocks = clock_.data();
+  const std::int16_t* length = length_.data();
+  const std::int16_t* apple = apple_.data();
+  std::uint16_t* stamps = stamp_.data();
+
+  for (int env = 0; env < count_; ++env) {
+    if (status[env] != kRunning) continue;
+
+    int direction = directions[env];
+    if (actions && actions[env] >= Left && actions[env] <= Down) {
+      int turn = kActionDirection[actions[env] - Left];
+      // Противоположные направления отличаются только младшим битом.
+      if ((turn ^ direction) != 1) direction = turn;
+    }
+    directions[env] = static_cast<std::int16_t>(direction);
+
+    int x = head_x[env] + (direction == 3) - (direction == 2);
+    int y = head_y[env] + (direction == 1) - (direction == 0);
+    std::uint16_t* stamp =
+        stamps + static_cast<std::size_t>(env) * kCells + y * kWidth + x;
+    // Хвост ещё занят: шаг в его клетку — столкновение, как в SnakeGame.
+    if (x < 0 || x >= kWidth || y < 0 || y >= kHeight ||
+        clocks[env] - *stamp < length[env]) {
+      status[env] = kLost;
+      finished_ = true;
+      continue;
+    }
+    head_x[env] = static_cast<std::int16_t>(x);
+    head_y[env] = static_cast<std::int16_t>(y);
+
+    int clock = ++clocks[env];
+    *stamp = static_cast<std::uint16_t>(clock);
+    if (y * kWidth + x == apple[env]) Grow(env);
+    if (clock >= kClockLimit) Rebase(env);
+  }
+}
+
+#ifdef S21_SNAKE_SOA_AVX2
+namespace {
+
+__attribute__((target("avx2"))) inline __m256i Load(const void* p) {
+  return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+}
+
+__attribute__((target("avx2"))) inline void Store(void* p, __m256i value) {
+  _mm256_storeu_si256(static_cast<__m256i*>(p), value);
+}
+
+/// Пишет value в дорожки mask шестнадцати слов по адресу p.
+__attribute__((target("avx2"))) inline void StoreWhere(std::int16_t* p,
+                                                       int value,
+                                                       __m256i mask) {
+  Store(p, _mm256_blendv_epi8(
+               Load(p), _mm256_set1_epi16(static_cast<short>(value)), mask));
+}
+
+/// Бит на 16-битную дорожку маски.
+__attribute__((target("avx2"))) inline unsigned LaneMask(__m256i mask) {
+  // packs сводит дорожки к байтам по 128-битным половинам: биты 0-7 —
+  // дорожки 0-7, биты 16-23 — дорожки 8-15.
+  auto bytes = static_cast<unsigned>(
+      _mm256_movemask_epi8(_mm256_packs_epi16(mask, mask)));
+  return (bytes & 0xFFu) | ((bytes >> 8) & 0xFF00u);
+}
+
+/// Дорожки 0-3 и 8-11 (Low32) и 4-7 и 12-15 (High32), расширенные до
+/// 32 бит копией слова: маски остаются масками, а младшие 16 бит — тем же
+/// значением. Такой порядок packus возвращает без перестановки.
+__attribute__((target("avx2"))) inline __m256i Low32(__m256i v) {
+  return _mm256_unpacklo_epi16(v, v);
+}
+
+__attribute__((target("avx2"))) inline __m256i High32(__m256i v) {
+  return _mm256_unpackhi_epi16(v, v);
+}
+
+}  // namespace
+
+/**
+ * @brief Шаг векторным ядром AVX2: группа из шестнадцати партий за
+ *        итерацию.
+ *
+ * Повторяет StepScalar(). Метки новых клеток берутся двумя выборками
+ * (gather) по восемь 32-битных адресов; ветвлений по дорожкам нет: новые
+ * метки пишут все дорожки (стоящие — в метку-заглушку), проигрыш гасит
+ * дорожку маской. Скалярно обрабатываются только съеденное яблоко и
+ * перенос часов.
+ */
+__attribute__((target("avx2"))) void SnakeSoaBatch::StepSimd(
+    const std::int32_t* actions) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i one = _mm256_set1_epi16(1);
+  const __m256i two = _mm256_set1_epi16(2);
+  const __m256i three = _mm256_set1_epi16(3);
+  const __m256i left = _mm256_set1_epi16(Left);
+  const __m256i width = _mm256_set1_epi16(kWidth);
+  const __m256i max_x = _mm256_set1_epi16(kWidth - 1);
+  const __m256i max_y = _mm256_set1_epi16(kHeight - 1);
+  const __m256i last_clock = _mm256_set1_epi16(kClockLimit - 1);
+  // Доски дорожек в порядке Low32() и High32().
+  const __m256i boards_low =
+      _mm256_setr_epi32(0, kCells, 2 * kCells, 3 * kCells, 8 * kCells,
+                        9 * kCells, 10 * kCells, 11 * kCells);
+  const __m256i boards_high =
+      _mm256_add_epi32(boards_low, _mm256_set1_epi32(4 * kCells));
+  const __m256i low16 = _mm256_set1_epi32(0xFFFF);
+  const __m256i scratch = _mm256_set1_epi32(lanes_ * kCells);
+  std::uint16_t* stamps = stamp_.data();
+
+  alignas(32) std::int32_t padded[kLanes];
+  alignas(32) std::int32_t low[kLanes / 2];   ///< Адреса дорожек Low32()
+  alignas(32) std::int32_t high[kLanes / 2];  ///< и High32()
+  alignas(32) std::int16_t values[kLanes];
+  __m256i lost = zero;
+
+  for (int env = 0; env < lanes_; env += kLanes) {
+    __m256i status = Load(&status_[env]);
+    __m256i live = _mm256_cmpeq_epi16(status, one);
+    if (_mm256_testz_si256(live, live)) continue;
+
+    __m256i direction = Load(&direction_[env]);
+    if (actions) {
+      const std::int32_t* group = actions + env;
+      if (env + kLanes > count_) {
+        std::fill_n(padded, kLanes, static_cast<std::int32_t>(Start));
+        std::copy(actions + env, actions + count_, padded);
+        group = padded;
+      }
+      // Сужение с насыщением: значения вне Left..Down там и остаются.
+      __m256i action = _mm256_sub_epi16(
+          _mm256_permute4x64_epi64(
+              _mm256_packs_epi32(Load(group), Load(group + 8)), 0xD8),
+          left);
+      // Поворот — Left..Down: action без знака не больше 3.
+      __m256i valid =
+          _mm256_cmpeq_epi16(action, _mm256_min_epu16(action, three));
+      __m256i turn = _mm256_xor_si256(action, two);
+      __m256i opposite =
+          _mm256_cmpeq_epi16(_mm256_xor_si256(turn, direction), one);
+      __m256i take =
+          _mm256_and_si256(_mm256_andnot_si256(opposite, valid), live);
+      direction = _mm256_blendv_epi8(direction, turn, take);
+      Store(&direction_[env], direction);
+    }
+
+    // dx = (d == Right) - (d == Left), dy = (d == Down) - (d == Up);
+    // маски сравнения равны -1, поэтому знаки вычитания обратные.
+    __m256i dx = _mm256_sub_epi16(_mm256_cmpeq_epi16(direction, two),
+                                  _mm256_cmpeq_epi16(direction, three));
+    __m256i dy = _mm256_sub_epi16(_mm256_cmpeq_epi16(direction, zero),
+                                  _mm256_cmpeq_epi16(direction, one));
+    __m256i head_x = Load(&head_x_[env]);
+    __m256i head_y = Load(&head_y_[env]);
+    __m256i x = _mm256_add_epi16(head_x, dx);
+    __m256i y = _mm256_add_epi16(head_y, dy);
+
+    // Внутри поля: x <= max_x без знака (отрицательные — огромные).
+    __m256i inside = _mm256_and_si256(
+        _mm256_cmpeq_epi16(x, _mm256_min_epu16(x, max_x)),
+        _mm256_cmpeq_epi16(y, _mm256_min_epu16(y, max_y)));
+    __m256i open = _mm256_and_si256(inside, live);
+    __m256i cell = _mm256_add_epi16(_mm256_mullo_epi16(y, width), x);
+
+    // Метки новых клеток: 32 бита с адреса метки, старшая половина —
+    // соседняя клетка.
+    __m256i base = _mm256_set1_epi32(env * kCells);
+    __m256i offset_low = _mm256_add_epi32(
+        _mm256_add_epi32(base, boards_low),
+        _mm256_and_si256(Low32(cell), low16));
+    __m256i offset_high = _mm256_add_epi32(
+        _mm256_add_epi32(base, boards_high),
+        _mm256_and_si256(High32(cell), low16));
+    __m256i open_low = Low32(open);
+    __m256i open_high = High32(open);
+    const auto* words = reinterpret_cast<const int*>(stamps);
+    __m256i stamp = _mm256_packus_epi32(
+        _mm256_and_si256(_mm256_mask_i32gather_epi32(zero, words, offset_low,
+                                                     open_low, 2),
+                         low16),
+        _mm256_and_si256(_mm256_mask_i32gather_epi32(zero, words, offset_high,
+                                                     open_high, 2),
+                         low16));
+    __m256i clock = Load(&clock_[env]);
+    __m256i hit = _mm256_cmpgt_epi16(Load(&length_[env]),
+                                     _mm256_sub_epi16(clock, stamp));
+
+    __m256i advance = _mm256_and_si256(_mm256_andnot_si256(hit, inside), live);
+    __m256i die = _mm256_andnot_si256(advance, live);
+    __m256i eat = _mm256_and_si256(
+        advance, _mm256_cmpeq_epi16(cell, Load(&apple_[env])));
+
+    Store(&head_x_[env], _mm256_blendv_epi8(head_x, x, advance));
+    Store(&head_y_[env], _mm256_blendv_epi8(head_y, y, advance));
+    Store(&status_[env], _mm256_andnot_si256(die, status));
+    lost = _mm256_or_si256(lost, die);
+    clock = _mm256_sub_epi16(clock, advance);
+    Store(&clock_[env], clock);
+
+    // Адреса записей не зависят от выборки: иначе выборка следующей
+    // группы ждёт их вычисления. Столкнувшаяся дорожка пишет в свою
+    // клетку прежнюю метку.
+    Store(values, _mm256_blendv_epi8(stamp, clock, advance));
+    Store(low, _mm256_blendv_epi8(scratch, offset_low, open_low));
+    Store(high, _mm256_blendv_epi8(scratch, offset_high, open_high));
+    for (int i = 0; i < 4; ++i) {
+      stamps[low[i]] = static_cast<std::uint16_t>(values[i]);
+      stamps[high[i]] = static_cast<std::uint16_t>(values[i + 4]);
+      stamps[low[i + 4]] = static_cast<std::uint16_t>(values[i + 8]);
+      stamps[high[i + 4]] = static_cast<std::uint16_t>(values[i + 12]);
+    }
+
+    __m256i rebase = _mm256_and_si256(advance,
+                                      _mm256_cmpgt_epi16(clock, last_clock));
+    __m256i rare = _mm256_or_si256(eat, rebase);
+    if (_mm256_testz_si256(rare, rare)) continue;
+    const unsigned eaten = LaneMask(eat);
+    for (unsigned mask = LaneMask(rare); mask; mask &= mask - 1) {
+      int bit = __builtin_ctz(mask);
+      if ((eaten >> bit) & 1) Grow(env + bit);
+      if (clock_[env + bit] >= kClockLimit) Rebase(env + bit);
+    }
+  }
+  if (!_mm256_testz_si256(lost, lost)) finished_ = true;
+}
+
+/**
+ * @brief ResetFinished() векторно: стартовое состояние и часы пишутся
+ *        смесью (blend) во все массивы группы, скалярно остаются только
+ *        метки тела и яблоко.
+ */
+__attribute__((target("avx2"))) int SnakeSoaBatch::ResetFinishedSimd() {
+  const __m256i one = _mm256_set1_epi16(1);
+  const __m256i lanes = _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+                                          11, 12, 13, 14, 15);
+  const __m256i start_length = _mm256_set1_epi16(kStartLength);
+
+  // Шаги с последнего вызова никого не остановили: группы не
+  // просматриваются.
+  if (!finished_) return 0;
+  finished_ = false;
+
+  int reset = 0;
+  for (int env = 0; env < lanes_; env += kLanes) {
+    // Хвостовые дорожки за count_ стоят всегда и не перезапускаются.
+    __m256i finished = _mm256_andnot_si256(
+        _mm256_cmpeq_epi16(Load(&status_[env]), one),
+        _mm256_cmpgt_epi16(
+            _mm256_set1_epi16(
+                static_cast<short>(std::min(count_ - env, kLanes))),
+            lanes));
+    unsigned mask = LaneMask(finished);
+    if (!mask) continue;
+
+    const auto right = static_cast<int>(SnakeDirection::Right);
+    StoreWhere(&status_[env], kRunning, finished);
+    StoreWhere(&head_x_[env], kStartLength - 1, finished);
+    StoreWhere(&head_y_[env], kHeight / 2, finished);
+    StoreWhere(&direction_[env], right, finished);
+    StoreWhere(&length_[env], kStartLength, finished);
+    StoreWhere(&score_[env], 0, finished);
+    StoreWhere(&level_[env], 1, finished);
+    Store(&clock_[env],
+          _mm256_add_epi16(Load(&clock_[env]),
+                           _mm256_and_si256(start_length, finished)));
+
+    for (; mask; mask &= mask - 1) {
+      int lane = env + __builtin_ctz(mask);
+      PlaceStartBody(lane);
+      if (clock_[lane] >= kClockLimit) Rebase(lane);
+      PlaceApple(lane);
+      ++reset;
+    }
+  }
+  return reset;
+}
+#else
+void SnakeSoaBatch::StepSimd(const std::int32_t* actions) {
+  StepScalar(actions);
+}
+
+int SnakeSoaBatch::ResetFinishedSimd() { return 0; }
+#endif
+
+void SnakeSoaBatch::Step(const std::int32_t* actions) {
+  if (simd_) {
+    StepSimd(actions);
+  } else {
+    StepScalar(actions);
+  }
+  RefillApples();
+}
+
+}  // namespace s21
@@ -4,22 +4,26 @@
  *
  * Этот файл содержит реализацию основной игровой логики Tetris,
  * включая управление фигурами, поле игры, подсчет очков и уровней.
+ *
+ * Вся механика работает с явно переданным TetrisBoard; функции
+ * backend_* обслуживают поле одиночной игры (board) и буферы её кадра.
  */
 
 #include "../../include/brickgame/tetris/backend.h"
 
+#include "../../include/brickgame/common/splitmix64.h"
+#include "../../include/brickgame/tetris/game.h"
+
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
-#define FIELD_WIDTH 10
-#define FIELD_HEIGHT 20
-#define FIGURE_SIZE 4
+#define FIELD_WIDTH TETRIS_FIELD_WIDTH
+#define FIELD_HEIGHT TETRIS_FIELD_HEIGHT
+#define FIGURE_SIZE TETRIS_FIGURE_SIZE
 
-typedef struct {
-  int shape[FIGURE_SIZE][FIGURE_SIZE];
-  int x, y;
-} Tetromino;
+/// Начальное состояние генератора фигур одиночной игры.
+#define DEFAULT_RNG_STATE SPLITMIX64_GAMMA
 
 static const int FIGURES[7][FIGURE_SIZE][FIGURE_SIZE] = {
     {{0, 0, 0, 0}, {1, 1, 1, 1}, {0, 0, 0, 0}, {0, 0, 0, 0}},
@@ -30,17 +34,44 @@ static const int FIGURES[7][FIGURE_SIZE][FIGURE_SIZE] = {
     {{0, 0, 0, 0}, {1, 1, 1, 0}, {0, 0, 1, 0}, {0, 0, 0, 0}},
     {{0, 0, 0, 0}, {1, 1, 1, 0}, {1, 0, 0, 0}, {0, 0, 0, 0}}};
 
-static int field[FIELD_HEIGHT][FIELD_WIDTH];
-static Tetromino current_piece;
-static Tetromino next_piece;
+/// Поле одиночной игры.
+static TetrisBoard board = {.rng_state = DEFAULT_RNG_STATE, .level = 1};
+/// Буферы кадра одиночной игры и рекорд.
 static GameInfo_t info;
+/// Аллокатор буферов кадра.
+static AllocHooks alloc_hooks;
+
+/**
+ * @brief Следующее псевдослучайное число генератора фигур.
+ * @param b Поле, чей генератор используется
+ * @return 64-битное псевдослучайное значение
+ */
+static uint64_t next_random(TetrisBoard *b) {
+  return splitmix64_next(&b->rng_state);
+}
+
+/**
+ * @brief Строка поля по логическому номеру.
+ */
+static uint32_t *row_at(TetrisBoard *b, int y) {
+  return &b->rows[tetris_board_row(b, y)];
+}
+
+/**
+ * @brief Распаковывает строку поля в TETRIS_FIELD_WIDTH клеток int.
+ */
+static void unpack_row(uint32_t row, int *dst) {
+  const uint8_t bytes[4] = {(uint8_t)row, (uint8_t)(row >> 8),
+                            (uint8_t)(row >> 16), (uint8_t)(row >> 24)};
+  packed_grid_unpack_row(bytes, 0, FIELD_WIDTH, dst);
+}
 
 /**
  * @brief Поворачивает фигуру по часовой стрелке.
  * @param src Исходная фигура для поворота
  * @param dst Результирующая повернутая фигура
  */
-static void rotate_clockwise(int src[FIGURE_SIZE][FIGURE_SIZE],
+static void rotate_clockwise(const int src[FIGURE_SIZE][FIGURE_SIZE],
                              int dst[FIGURE_SIZE][FIGURE_SIZE]) {
   for (int y = 0; y < FIGURE_SIZE; ++y) {
     for (int x = 0; x < FIGURE_SIZE; ++x) {
@@ -51,178 +82,200 @@ static void rotate_clockwise(int src[FIGURE_SIZE][FIGURE_SIZE],
 
 /**
  * @brief Создает новую случайную фигуру.
+ * @param b Поле, чей генератор используется
  * @param dst Указатель на структуру для новой фигуры
  */
-static void spawn_piece(Tetromino *dst) {
-  int id = rand() % 7;
+static void spawn_piece(TetrisBoard *b, Tetromino *dst) {
+  int id = (int)(next_random(b) % 7);
   memcpy(dst->shape, FIGURES[id], sizeof(dst->shape));
   dst->x = 3;
   dst->y = -2;
 }
 
 /**
- * @brief Очищает заполненные линии и обновляет счет.
+ * @brief Проверяет, пересекает ли фигура границы или занятые клетки.
+ * @param b Поле
+ * @param piece Фигура в проверяемой позиции
+ * @return 1 если есть коллизия, 0 если нет
  */
-static void clear_lines() {
-  int lines_cleared = 0;
-  for (int y = FIELD_HEIGHT - 1; y >= 0; --y) {
-    int full = 1;
-    for (int x = 0; x < FIELD_WIDTH; ++x) {
-      if (!field[y][x]) {
-        full = 0;
-        break;
+static int piece_collides(const TetrisBoard *b, const Tetromino *piece) {
+  for (int y = 0; y < FIGURE_SIZE; ++y) {
+    for (int x = 0; x < FIGURE_SIZE; ++x) {
+      if (piece->shape[y][x]) {
+        int fx = piece->x + x;
+        int fy = piece->y + y;
+
+        if (fx < 0 || fx >= FIELD_WIDTH || fy >= FIELD_HEIGHT) return 1;
+        if (fy >= 0 && tetris_board_cell(b, fx, fy)) return 1;
       }
     }
+  }
+  return 0;
+}
 
-    if (full) {
-      lines_cleared++;
-      for (int ty = y; ty > 0; --ty) {
-        memcpy(field[ty], field[ty - 1], sizeof(field[0]));
+/**
+ * @brief Проверяет коллизию текущей фигуры со смещением.
+ * @param b Поле
+ * @param dx Смещение по X
+ * @param dy Смещение по Y
+ * @return 1 если есть коллизия, 0 если нет
+ */
+static int check_collision(const TetrisBoard *b, int dx, int dy) {
+  Tetromino moved = b->current;
+  moved.x += dx;
+  moved.y += dy;
+  return piece_collides(b, &moved);
+}
+
+/**
+ * @brief Проверяет возможность появления новой фигуры.
+ * @param b Поле
+ * @return 1 если появление невозможно (игра окончена), 0 если возможно
+ */
+static int check_spawn_failure(const TetrisBoard *b) {
+  for (int y = 0; y < FIGURE_SIZE; ++y) {
+    for (int x = 0; x < FIGURE_SIZE; ++x) {
+      if (b->current.shape[y][x]) {
+        int fx = b->current.x + x;
+        int fy = b->current.y + y;
+        if (fy >= 0 && tetris_board_cell(b, fx, fy)) return 1;
       }
-      memset(field[0], 0, sizeof(field[0]));
-      y++;
     }
   }
+  return 0;
+}
+
+/**
+ * @brief Очищает заполненные линии и обновляет счет.
+ *
+ * Непустые строки за один проход сдвигаются вниз на место очищенных,
+ * сколько бы линий ни было заполнено.
+ *
+ * @param b Поле
+ * @return Число очищенных линий
+ */
+static int clear_lines(TetrisBoard *b) {
+  int lines_cleared = 0;
+  int write = FIELD_HEIGHT - 1;
+  for (int y = FIELD_HEIGHT - 1; y >= 0; --y) {
+    uint32_t row = *row_at(b, y);
+    if (row == TETRIS_ROW_FULL) {
+      lines_cleared++;
+    } else {
+      if (write != y) *row_at(b, write) = row;
+      write--;
+    }
+  }
+  for (int y = write; y >= 0; --y) *row_at(b, y) = 0;
 
   if (lines_cleared > 0) {
     switch (lines_cleared) {
       case 1:
-        info.score += 100;
+        b->score += 100;
         break;
       case 2:
-        info.score += 300;
+        b->score += 300;
         break;
       case 3:
-        info.score += 700;
+        b->score += 700;
         break;
       case 4:
-        info.score += 1500;
+        b->score += 1500;
         break;
     }
 
-    if (info.score > info.high_score) {
-      info.high_score = info.score;
-      save_high_score(info.high_score);
+    int new_level = 1 + b->score / 600;
+    if (new_level > tetris_board_max_level(b)) {
+      new_level = tetris_board_max_level(b);
     }
-
-    int new_level = 1 + info.score / 600;
-    if (new_level > 10) new_level = 10;
-    if (new_level != info.level) {
-      info.level = new_level;
+    if (new_level != b->level) {
+      b->level = new_level;
     }
-    info.speed = get_level_speed(info.level);
+    b->speed = b->frame_ms > 0 ? b->frame_ms : get_level_speed(b->level);
   }
+  return lines_cleared;
 }
 
-/**
- * @brief Сохраняет рекордный счет в файл.
- * @param high_score Рекордный счет для сохранения
- */
-void save_high_score(int high_score) {
-  FILE *file = fopen("tetris_highscore.txt", "w");
-  if (file) {
-    fprintf(file, "%d", high_score);
-    fclose(file);
-  }
+void tetris_board_init(TetrisBoard *b, uint64_t seed) {
+  memset(b, 0, sizeof(*b));
+  b->rng_state = seed;
+  tetris_board_reset(b);
 }
+
 /**
- * @brief Загружает рекордный счет из файла.
- * @return Загруженный рекордный счет или 0 если файл не найден
+ * @brief Очищает поле, выбирает первые две фигуры и сбрасывает счёт.
+ * @param b Поле
  */
-static int load_high_score() {
-  FILE *file = fopen(SCORE_FILE, "r");
-  int high_score = 0;
-  if (file) {
-    fscanf(file, "%d", &high_score);
-    fclose(file);
+void tetris_board_reset(TetrisBoard *b) {
+  memset(b->rows, 0, sizeof(b->rows));
+  b->top = 0;
+  spawn_piece(b, &b->current);
+  spawn_piece(b, &b->next);
+  b->score = 0;
+  b->level = 1;
+  b->speed = b->frame_ms > 0 ? b->frame_ms : get_level_speed(b->level);
+  b->gravity_acc = 0;
+  b->lock_frames = 0;
+  b->lock_resets = 0;
+  b->last_cleared = 0;
+  b->locks = 0;
+}
+
+void tetris_board_set_timing(TetrisBoard *b, int ms, int lock_delay) {
+  b->frame_ms = ms > 0 ? ms : 0;
+  b->lock_delay = lock_delay > 0 ? lock_delay : 0;
+  b->gravity_acc = 0;
+  b->lock_frames = 0;
+  b->lock_resets = 0;
+  if (b->level > tetris_board_max_level(b)) {
+    b->level = tetris_board_max_level(b);
   }
-  return high_score;
+  b->speed = b->frame_ms > 0 ? b->frame_ms : get_level_speed(b->level);
 }
 
 /**
- * @brief Инициализирует игру Tetris.
- * @return Структура GameInfo_t с начальным состоянием игры
+ * @brief Обновляет физику игры (падение фигуры).
+ * @param b Поле
+ * @return Статус обновления (OK или GAME_OVER)
  */
-GameInfo_t backend_init_game(void) {
-  for (int y = 0; y < FIELD_HEIGHT; ++y) {
-    for (int x = 0; x < FIELD_WIDTH; ++x) {
-      field[y][x] = 0;
+BackendStatus tetris_board_physics(TetrisBoard *b) {
+  if (b->frame_ms <= 0) {
+    if (!check_collision(b, 0, 1)) {
+      b->current.y += 1;
+      return BACKEND_OK;
     }
+    return tetris_board_fix_piece(b);
   }
-  spawn_piece(&current_piece);
-  spawn_piece(&next_piece);
 
-  info.field = (int **)malloc(FIELD_HEIGHT * sizeof(int *));
-  for (int i = 0; i < FIELD_HEIGHT; ++i) {
-    info.field[i] = (int *)malloc(FIELD_WIDTH * sizeof(int));
-    memcpy(info.field[i], field[i], FIELD_WIDTH * sizeof(int));
-  }
-
-  info.next = (int **)malloc(FIGURE_SIZE * sizeof(int *));
-  for (int i = 0; i < FIGURE_SIZE; ++i) {
-    info.next[i] = (int *)malloc(FIGURE_SIZE * sizeof(int));
-    memcpy(info.next[i], next_piece.shape[i], FIGURE_SIZE * sizeof(int));
+  if (check_collision(b, 0, 1)) {
+    b->gravity_acc = 0;
+    if (++b->lock_frames > b->lock_delay) return tetris_board_fix_piece(b);
+    return BACKEND_OK;
   }
 
-  info.score = 0;
-  info.high_score = load_high_score();
-  info.level = 1;
-  info.speed = get_level_speed(info.level);
-  info.pause = 0;
-
-  return info;
-}
-
-/**
- * @brief Проверяет коллизию фигуры с полем или границами.
- * @param dx Смещение по X
- * @param dy Смещение по Y
- * @return 1 если есть коллизия, 0 если нет
- */
-static int check_collision(int dx, int dy) {
-  for (int y = 0; y < FIGURE_SIZE; ++y) {
-    for (int x = 0; x < FIGURE_SIZE; ++x) {
-      if (current_piece.shape[y][x]) {
-        int nx = current_piece.x + x + dx;
-        int ny = current_piece.y + y + dy;
-
-        if (nx < 0 || nx >= FIELD_WIDTH || ny >= FIELD_HEIGHT) return 1;
-        if (ny >= 0 && field[ny][nx]) return 1;
-      }
-    }
-  }
-  return 0;
-}
-/**
- * @brief Проверяет возможность появления новой фигуры.
- * @return 1 если появление невозможно (игра окончена), 0 если возможно
- */
-static int check_spawn_failure() {
-  for (int y = 0; y < FIGURE_SIZE; ++y) {
-    for (int x = 0; x < FIGURE_SIZE; ++x) {
-      if (current_piece.shape[y][x]) {
-        int fx = current_piece.x + x;
-        int fy = current_piece.y + y;
-        if (fy >= 0 && field[fy][fx]) return 1;
-      }
+  b->lock_frames = 0;
+  b->gravity_acc += tetris_board_gravity(b, b->level);
+  while (b->gravity_acc >= TETRIS_GRAVITY_ONE) {
+    if (check_collision(b, 0, 1)) {
+      b->gravity_acc = 0;
+      break;
     }
+    b->current.y += 1;
+    b->gravity_acc -= TETRIS_GRAVITY_ONE;
   }
-  return 0;
+  return BACKEND_OK;
 }
 
 /**
- * @brief Обновляет физику игры (падение фигуры).
- * @param info_ptr Указатель на структуру игровой информации
- * @return Статус обновления (OK или GAME_OVER)
+ * @brief Сбрасывает задержку фиксации после успешного движения фигуры.
+ *
+ * Число сбросов ограничено TETRIS_MAX_LOCK_RESETS, чтобы фигуру нельзя
+ * было двигать по опоре бесконечно.
  */
-BackendStatus backend_update_physics(GameInfo_t *info_ptr) {
-  (void)info_ptr;
-  if (!check_collision(0, 1)) {
-    current_piece.y += 1;
-    info.score += 0;
-    return BACKEND_OK;
-  } else {
-    return backend_fix_piece();
+static void on_piece_moved(TetrisBoard *b) {
+  if (b->lock_frames > 0 && b->lock_resets < TETRIS_MAX_LOCK_RESETS) {
+    b->lock_frames = 0;
+    ++b->lock_resets;
   }
 }
 
@@ -230,38 +283,18 @@ BackendStatus backend_update_physics(GameInfo_t *info_ptr) {
  * @brief Пытается повернуть текущую фигуру с проверкой коллизий.
  * @return 1 если поворот успешен, 0 если невозможно
  */
-static int try_rotate() {
+static int try_rotate(TetrisBoard *b) {
   int rotated[FIGURE_SIZE][FIGURE_SIZE];
-  rotate_clockwise(current_piece.shape, rotated);
+  rotate_clockwise(b->current.shape, rotated);
 
   const int offsets[] = {0, -1, 1, -2, 2};
   for (size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); ++i) {
-    int dx = offsets[i];
-    Tetromino temp = current_piece;
-    temp.x += dx;
+    Tetromino temp = b->current;
+    temp.x += offsets[i];
     memcpy(temp.shape, rotated, sizeof(rotated));
 
-    int collision = 0;
-    for (int y = 0; y < FIGURE_SIZE; ++y) {
-      for (int x = 0; x < FIGURE_SIZE; ++x) {
-        if (temp.shape[y][x]) {
-          int fx = temp.x + x;
-          int fy = temp.y + y;
-          if (fx < 0 || fx >= FIELD_WIDTH || fy >= FIELD_HEIGHT) {
-            collision = 1;
-            break;
-          }
-          if (fy >= 0 && field[fy][fx]) {
-            collision = 1;
-            break;
-          }
-        }
-      }
-      if (collision) break;
-    }
-
-    if (!collision) {
-      current_piece = temp;
+    if (!piece_collides(b, &temp)) {
+      b->current = temp;
       return 1;
     }
   }
@@ -271,33 +304,41 @@ static int try_rotate() {
 
 /**
  * @brief Обрабатывает пользовательский ввод для управления фигурой.
+ * @param b Поле
  * @param action Действие пользователя
  * @param hold Флаг удержания клавиши
  * @return Статус обработки ввода
  */
-BackendStatus backend_handle_input(UserAction_t action, bool hold) {
+BackendStatus tetris_board_input(TetrisBoard *b, UserAction_t action,
+                                 bool hold) {
   switch (action) {
     case Left:
-      if (!check_collision(-1, 0)) current_piece.x -= 1;
+      if (!check_collision(b, -1, 0)) {
+        b->current.x -= 1;
+        on_piece_moved(b);
+      }
       break;
     case Right:
-      if (!check_collision(1, 0)) current_piece.x += 1;
+      if (!check_collision(b, 1, 0)) {
+        b->current.x += 1;
+        on_piece_moved(b);
+      }
       break;
     case Down:
       if (hold) {
         for (int i = 0; i < 3; i++) {
-          if (!check_collision(0, 1)) {
-            current_piece.y += 1;
+          if (!check_collision(b, 0, 1)) {
+            b->current.y += 1;
           } else {
             break;
           }
         }
       } else {
-        if (!check_collision(0, 1)) current_piece.y += 1;
+        if (!check_collision(b, 0, 1)) b->current.y += 1;
       }
       break;
     case Action:
-      try_rotate();
+      if (try_rotate(b)) on_piece_moved(b);
       break;
     default:
       break;
@@ -306,67 +347,424 @@ BackendStatus backend_handle_input(UserAction_t action, bool hold) {
 }
 
 /**
- * @brief Накладывает текущую фигуру на поле для отображения.
- * @param info_ptr Указатель на структуру игровой информации
+ * @brief Фиксирует текущую фигуру на поле и создает новую.
+ * @param b Поле
+ * @return Статус операции (OK или GAME_OVER)
  */
-void backend_overlay_piece(GameInfo_t *info_ptr) {
-  static int temp_field[FIELD_HEIGHT][FIELD_WIDTH];
+BackendStatus tetris_board_fix_piece(TetrisBoard *b) {
+  for (int y = 0; y < FIGURE_SIZE; ++y) {
+    for (int x = 0; x < FIGURE_SIZE; ++x) {
+      if (b->current.shape[y][x]) {
+        int fx = b->current.x + x;
+        int fy = b->current.y + y;
+        if (fy >= 0 && fy < FIELD_HEIGHT && fx >= 0 && fx < FIELD_WIDTH) {
+          *row_at(b, fy) |= 1u << (PACKED_CELL_BITS * fx);
+        }
+      }
+    }
+  }
 
-  if (!info_ptr || !info_ptr->field) {
-    return;
+  b->last_cleared = clear_lines(b);
+  b->locks++;
+
+  b->gravity_acc = 0;
+  b->lock_frames = 0;
+  b->lock_resets = 0;
+
+  b->current = b->next;
+  spawn_piece(b, &b->next);
+
+  if (check_spawn_failure(b)) {
+    return BACKEND_GAME_OVER;
+  }
+  return BACKEND_OK;
+}
+
+/**
+ * @brief Вставляет строки мусора снизу поля.
+ *
+ * Логическая строка 0 уходит за верх и становится новой нижней
+ * строкой кольца, поэтому строка вставляется за O(1).
+ *
+ * @param b Поле
+ * @param rows Число строк
+ * @param hole Столбец без блока
+ * @return false, если блоки ушли за верх поля
+ */
+bool tetris_board_add_garbage(TetrisBoard *b, int rows, int hole) {
+  bool fits = true;
+  if (hole < 0 || hole >= FIELD_WIDTH) hole = 0;
+  for (int i = 0; i < rows; ++i) {
+    if (*row_at(b, 0)) fits = false;
+
+    b->top = tetris_board_row(b, 1);
+    *row_at(b, FIELD_HEIGHT - 1) =
+        TETRIS_ROW_FULL & ~(PACKED_CELL_MASK << (PACKED_CELL_BITS * hole));
+  }
+
+  for (int i = 0; i < rows && check_collision(b, 0, 0); ++i) {
+    b->current.y -= 1;
   }
+  return fits;
+}
 
+/**
+ * @brief Копирует поле с наложенной фигурой в строки кадра.
+ * @param b Поле
+ * @param field Строки кадра
+ */
+void tetris_board_overlay(const TetrisBoard *b, int **field) {
   for (int y = 0; y < FIELD_HEIGHT; ++y) {
-    for (int x = 0; x < FIELD_WIDTH; ++x) {
-      temp_field[y][x] = field[y][x];
-    }
+    if (field[y]) unpack_row(b->rows[tetris_board_row(b, y)], field[y]);
   }
 
   for (int y = 0; y < FIGURE_SIZE; ++y) {
     for (int x = 0; x < FIGURE_SIZE; ++x) {
-      if (current_piece.shape[y][x]) {
-        int fx = current_piece.x + x;
-        int fy = current_piece.y + y;
-        if (fx >= 0 && fx < FIELD_WIDTH && fy >= 0 && fy < FIELD_HEIGHT) {
-          temp_field[fy][fx] = 1;
+      if (b->current.shape[y][x]) {
+        int fx = b->current.x + x;
+        int fy = b->current.y + y;
+        if (fx >= 0 && fx < FIELD_WIDTH && fy >= 0 && fy < FIELD_HEIGHT &&
+            field[fy]) {
+          field[fy][fx] = 1;
         }
       }
     }
   }
+}
 
-  for (int i = 0; i < FIELD_HEIGHT; ++i) {
-    if (info_ptr->field[i]) {
-      memcpy(info_ptr->field[i], temp_field[i], FIELD_WIDTH * sizeof(int));
+/**
+ * @brief Упаковывает поле по 2 бита на клетку.
+ *
+ * Строки по 2 * TETRIS_FIELD_WIDTH бит склеиваются в один поток, так
+ * что клетка (x, y) получает индекс y * TETRIS_FIELD_WIDTH + x.
+ *
+ * @param b Поле
+ * @param with_piece Наложить падающую фигуру
+ * @param out Буфер на TETRIS_PACKED_FIELD_BYTES байт
+ */
+void tetris_board_pack(const TetrisBoard *b, bool with_piece, uint8_t *out) {
+  uint32_t rows[FIELD_HEIGHT];
+  for (int y = 0; y < FIELD_HEIGHT; ++y) {
+    rows[y] = b->rows[tetris_board_row(b, y)];
+  }
+  for (int y = 0; with_piece && y < FIGURE_SIZE; ++y) {
+    for (int x = 0; x < FIGURE_SIZE; ++x) {
+      int fx = b->current.x + x;
+      int fy = b->current.y + y;
+      if (b->current.shape[y][x] && fx >= 0 && fx < FIELD_WIDTH && fy >= 0 &&
+          fy < FIELD_HEIGHT) {
+        rows[fy] |= 1u << (PACKED_CELL_BITS * fx);
+      }
     }
   }
+
+  uint64_t acc = 0;
+  int bits = 0;
+  size_t n = 0;
+  for (int y = 0; y < FIELD_HEIGHT; ++y) {
+    acc |= (uint64_t)rows[y] << bits;
+    bits += PACKED_CELL_BITS * FIELD_WIDTH;
+    for (; bits >= 8; bits -= 8, acc >>= 8) out[n++] = (uint8_t)acc;
+  }
+  if (bits > 0) out[n] = (uint8_t)acc;
 }
 
 /**
- * @brief Фиксирует текущую фигуру на поле и создает новую.
- * @return Статус операции (OK или GAME_OVER)
+ * @brief Максимальный уровень в текущем режиме.
+ * @return 10 в классическом режиме, TETRIS_MAX_LEVEL — в режиме кадров
  */
-BackendStatus backend_fix_piece(void) {
+int tetris_board_max_level(const TetrisBoard *b) {
+  return b->frame_ms > 0 ? TETRIS_MAX_LEVEL : 10;
+}
+
+/**
+ * @brief Гравитация уровня в клетках за кадр (фиксированная точка).
+ *
+ * Уровни 1–10 повторяют классический темп get_level_speed(), дальше
+ * гравитация растёт в 1.6 раза за уровень вплоть до 20G.
+ *
+ * @param b Поле (задаёт длительность кадра)
+ * @param level Уровень игры
+ * @return Гравитация в единицах TETRIS_GRAVITY_ONE
+ */
+int32_t tetris_board_gravity(const TetrisBoard *b, int level) {
+  if (b->frame_ms <= 0) return TETRIS_GRAVITY_ONE;
+  if (level < 1) level = 1;
+  if (level >= TETRIS_MAX_LEVEL) return TETRIS_GRAVITY_20G;
+
+  int base = level < 10 ? level : 10;
+  int64_t gravity =
+      (int64_t)b->frame_ms * TETRIS_GRAVITY_ONE / get_level_speed(base);
+  for (int l = 10; l < level; ++l) gravity = gravity * 8 / 5;
+  if (gravity > TETRIS_GRAVITY_20G) gravity = TETRIS_GRAVITY_20G;
+  return (int32_t)gravity;
+}
+
+/**
+ * @brief Возвращает скорость игры для заданного уровня.
+ * @param level Уровень игры
+ * @return Скорость в миллисекундах
+ */
+int get_level_speed(int level) {
+  int speed = 600 - (level - 1) * 60;
+  if (speed < 80) speed = 80;
+  return speed;
+}
+
+/**
+ * @brief Записывает фигуру в снимок (форма — по байту на клетку).
+ */
+static void save_piece(StateWriter *w, const Tetromino *piece) {
   for (int y = 0; y < FIGURE_SIZE; ++y) {
     for (int x = 0; x < FIGURE_SIZE; ++x) {
-      if (current_piece.shape[y][x]) {
-        int fx = current_piece.x + x;
-        int fy = current_piece.y + y;
-        if (fy >= 0 && fy < FIELD_HEIGHT && fx >= 0 && fx < FIELD_WIDTH) {
-          field[fy][fx] = 1;
-        }
+      state_write_u8(w, (uint8_t)piece->shape[y][x]);
+    }
+  }
+  state_write_i32(w, piece->x);
+  state_write_i32(w, piece->y);
+}
+
+/**
+ * @brief Читает фигуру из снимка.
+ */
+static void load_piece(StateReader *r, Tetromino *piece) {
+  for (int y = 0; y < FIGURE_SIZE; ++y) {
+    for (int x = 0; x < FIGURE_SIZE; ++x) {
+      piece->shape[y][x] = state_read_u8(r) ? 1 : 0;
+    }
+  }
+  piece->x = state_read_i32(r);
+  piece->y = state_read_i32(r);
+}
+
+/**
+ * @brief Записывает поле в снимок (упаковано, строки — в логическом
+ *        порядке).
+ * @param w Писатель снимка
+ * @param b Поле
+ */
+void tetris_board_save(StateWriter *w, const TetrisBoard *b) {
+  state_write_u8(w, FIELD_WIDTH);
+  state_write_u8(w, FIELD_HEIGHT);
+  uint8_t packed[TETRIS_PACKED_FIELD_BYTES];
+  tetris_board_pack(b, false, packed);
+  state_write(w, packed, sizeof(packed));
+  save_piece(w, &b->current);
+  save_piece(w, &b->next);
+  state_write_i32(w, b->score);
+  state_write_i32(w, b->level);
+  state_write_i32(w, b->speed);
+  state_write_u64(w, b->rng_state);
+  state_write_i32(w, b->gravity_acc);
+  state_write_i32(w, b->lock_frames);
+  state_write_i32(w, b->lock_resets);
+}
+
+/**
+ * @brief Читает поле из снимка.
+ *
+ * Темп поля (frame_ms, lock_delay) в снимок не входит и сохраняется.
+ *
+ * @param r Читатель снимка
+ * @param b Поле
+ * @return true при успехе
+ */
+bool tetris_board_load(StateReader *r, TetrisBoard *b) {
+  if (state_read_u8(r) != FIELD_WIDTH || state_read_u8(r) != FIELD_HEIGHT) {
+    return false;
+  }
+
+  TetrisBoard loaded = *b;
+  uint8_t packed[TETRIS_PACKED_FIELD_BYTES];
+  state_read(r, packed, sizeof(packed));
+  loaded.top = 0;
+  for (int y = 0; y < FIELD_HEIGHT; ++y) {
+    loaded.rows[y] = 0;
+    for (int x = 0; x < FIELD_WIDTH; ++x) {
+      if (packed_grid_get(packed, (size_t)y * FIELD_WIDTH + (size_t)x)) {
+        loaded.rows[y] |= 1u << (PACKED_CELL_BITS * x);
       }
     }
   }
+  load_piece(r, &loaded.current);
+  load_piece(r, &loaded.next);
+  loaded.score = state_read_i32(r);
+  loaded.level = state_read_i32(r);
+  loaded.speed = state_read_i32(r);
+  loaded.rng_state = state_read_u64(r);
+  loaded.gravity_acc = state_read_i32(r);
+  loaded.lock_frames = state_read_i32(r);
+  loaded.lock_resets = state_read_i32(r);
+  if (!r->ok) return false;
+
+  *b = loaded;
+  return true;
+}
 
-  clear_lines();
+/* === Одиночная игра === */
 
-  current_piece = next_piece;
-  spawn_piece(&next_piece);
+/// Рекорд прочитан из файла (читается один раз за процесс).
+static bool high_score_loaded;
+/// Рекорд в памяти новее файла.
+static bool high_score_dirty;
 
-  if (check_spawn_failure()) {
-    return BACKEND_GAME_OVER;
+/**
+ * @brief Переносит счёт поля в info и обновляет рекорд в памяти.
+ *
+ * Файл здесь не трогается: тик не делает ввода-вывода, рекорд пишет
+ * backend_flush_high_score().
+ */
+static void sync_info(void) {
+  info.score = board.score;
+  info.level = board.level;
+  info.speed = board.speed;
+  if (info.score > info.high_score) {
+    info.high_score = info.score;
+    high_score_dirty = true;
   }
-  return BACKEND_OK;
+}
+
+/**
+ * @brief Сохраняет рекордный счет в файл.
+ * @param high_score Рекордный счет для сохранения
+ */
+void save_high_score(int high_score) {
+  FILE *file = fopen("tetris_highscore.txt", "w");
+  if (file) {
+    fprintf(file, "%d", high_score);
+    fclose(file);
+  }
+}
+/**
+ * @brief Загружает рекордный счет из файла.
+ * @return Загруженный рекордный счет или 0 если файл не найден
+ */
+static int load_high_score() {
+  FILE *file = fopen(SCORE_FILE, "r");
+  int high_score = 0;
+  if (file) {
+    fscanf(file, "%d", &high_score);
+    fclose(file);
+  }
+  return high_score;
+}
+
+void backend_load_high_score(void) {
+  if (high_score_loaded) return;
+  int stored = load_high_score();
+  if (stored > info.high_score) info.high_score = stored;
+  high_score_loaded = true;
+}
+
+void backend_flush_high_score(void) {
+  if (!high_score_dirty) return;
+  save_high_score(info.high_score);
+  high_score_dirty = false;
+}
+
+/**
+ * @brief Сбрасывает счёт, уровень и таймеры падения.
+ * @return Структура GameInfo_t с начальным состоянием игры
+ */
+static GameInfo_t reset_stats(void) {
+  backend_load_high_score();
+  info.pause = 0;
+  sync_info();
+  return info;
+}
+
+/**
+ * @brief Выделяет буферы кадра и копирует в них поле и следующую фигуру.
+ * @return Структура GameInfo_t с новыми буферами
+ */
+GameInfo_t backend_alloc_info(void) {
+  info.field = (int **)alloc_hooks_alloc(&alloc_hooks,
+                                         FIELD_HEIGHT * sizeof(int *));
+  for (int i = 0; i < FIELD_HEIGHT; ++i) {
+    info.field[i] =
+        (int *)alloc_hooks_alloc(&alloc_hooks, FIELD_WIDTH * sizeof(int));
+    unpack_row(board.rows[tetris_board_row(&board, i)], info.field[i]);
+  }
+
+  info.next = (int **)alloc_hooks_alloc(&alloc_hooks,
+                                        FIGURE_SIZE * sizeof(int *));
+  for (int i = 0; i < FIGURE_SIZE; ++i) {
+    info.next[i] =
+        (int *)alloc_hooks_alloc(&alloc_hooks, FIGURE_SIZE * sizeof(int));
+    memcpy(info.next[i], board.next.shape[i], FIGURE_SIZE * sizeof(int));
+  }
+  return info;
+}
+
+/**
+ * @brief Инициализирует игру Tetris.
+ * @return Структура GameInfo_t с начальным состоянием игры
+ */
+GameInfo_t backend_init_game(void) {
+  tetris_board_reset(&board);
+  backend_alloc_info();
+  return reset_stats();
+}
+
+/**
+ * @brief Рестарт игры в буферах предыдущей партии.
+ * @param frame Кадр с уже выделенными буферами
+ * @return Структура GameInfo_t с начальным состоянием игры
+ */
+GameInfo_t backend_restart_game(const GameInfo_t *frame) {
+  tetris_board_reset(&board);
+  info.field = frame->field;
+  info.next = frame->next;
+  for (int i = 0; i < FIELD_HEIGHT; ++i) {
+    unpack_row(board.rows[tetris_board_row(&board, i)], info.field[i]);
+  }
+  for (int i = 0; i < FIGURE_SIZE; ++i) {
+    memcpy(info.next[i], board.next.shape[i], FIGURE_SIZE * sizeof(int));
+  }
+  return reset_stats();
+}
+
+/**
+ * @brief Обновляет физику игры (падение фигуры).
+ * @param info_ptr Указатель на структуру игровой информации
+ * @return Статус обновления (OK или GAME_OVER)
+ */
+BackendStatus backend_update_physics(GameInfo_t *info_ptr) {
+  (void)info_ptr;
+  BackendStatus status = tetris_board_physics(&board);
+  sync_info();
+  return status;
+}
+
+/**
+ * @brief Обрабатывает пользовательский ввод для управления фигурой.
+ * @param action Действие пользователя
+ * @param hold Флаг удержания клавиши
+ * @return Статус обработки ввода
+ */
+BackendStatus backend_handle_input(UserAction_t action, bool hold) {
+  return tetris_board_input(&board, action, hold);
+}
+
+/**
+ * @brief Накладывает текущую фигуру на поле для отображения.
+ * @param info_ptr Указатель на структуру игровой информации
+ */
+void backend_overlay_piece(GameInfo_t *info_ptr) {
+  if (!info_ptr || !info_ptr->field) {
+    return;
+  }
+  tetris_board_overlay(&board, info_ptr->field);
+}
+
+/**
+ * @brief Фиксирует текущую фигуру на поле и создает новую.
+ * @return Статус операции (OK или GAME_OVER)
+ */
+BackendStatus backend_fix_piece(void) {
+  BackendStatus status = tetris_board_fix_piece(&board);
+  sync_info();
+  return status;
 }
 
 /**
@@ -376,7 +774,7 @@ BackendStatus backend_fix_piece(void) {
 GameInfo_t backend_get_info(void) {
   for (int i = 0; i < FIGURE_SIZE; ++i) {
     if (info.next[i]) {
-      memcpy(info.next[i], next_piece.shape[i], FIGURE_SIZE * sizeof(int));
+      memcpy(info.next[i], board.next.shape[i], FIGURE_SIZE * sizeof(int));
     }
   }
   return info;
@@ -389,37 +787,113 @@ GameInfo_t backend_get_info(void) {
 void backend_free_game_info(GameInfo_t *game_info) {
   if (game_info->field) {
     for (int i = 0; i < FIELD_HEIGHT; ++i) {
-      if (game_info->field[i]) {
-        free(game_info->field[i]);
-      }
+      alloc_hooks_free(&alloc_hooks, game_info->field[i]);
     }
-    free(game_info->field);
+    alloc_hooks_free(&alloc_hooks, game_info->field);
     game_info->field = NULL;
   }
 
   if (game_info->next) {
     for (int i = 0; i < FIGURE_SIZE; ++i) {
-      if (game_info->next[i]) {
-        free(game_info->next[i]);
-      }
+      alloc_hooks_free(&alloc_hooks, game_info->next[i]);
     }
-    free(game_info->next);
+    alloc_hooks_free(&alloc_hooks, game_info->next);
     game_info->next = NULL;
   }
 }
 
 /**
- * @brief Возвращает скорость игры для заданного уровня.
+ * @brief Аллокатор и счётчики выделений библиотеки.
+ * @return Указатель на состояние аллокатора
+ */
+AllocHooks *backend_alloc_hooks(void) { return &alloc_hooks; }
+
+/**
+ * @brief Включает режим фиксированного кадра.
+ * @param ms Длительность кадра в мс (0 — классический режим)
+ * @param lock_delay Задержка фиксации в кадрах
+ */
+void backend_set_timing(int ms, int lock_delay) {
+  tetris_board_set_timing(&board, ms, lock_delay);
+  info.level = board.level;
+  info.speed = board.speed;
+}
+
+/**
+ * @brief Максимальный уровень в текущем режиме.
+ * @return 10 в классическом режиме, TETRIS_MAX_LEVEL — в режиме кадров
+ */
+int backend_max_level(void) { return tetris_board_max_level(&board); }
+
+/**
+ * @brief Гравитация уровня в клетках за кадр (фиксированная точка).
  * @param level Уровень игры
- * @return Скорость в миллисекундах
+ * @return Гравитация в единицах TETRIS_GRAVITY_ONE
  */
-int get_level_speed(int level) {
-  int speed = 600 - (level - 1) * 60;
-  if (speed < 80) speed = 80;
-  return speed;
+int32_t backend_gravity_for_level(int level) {
+  return tetris_board_gravity(&board, level);
 }
 
 /**
  * @brief Освобождает память, выделенную для GameInfo_t::field.
  */
-EXPORT void freeGameInfo(GameInfo_t *info) { backend_free_game_info(info); }
+EXPORT void TETRIS_API(freeGameInfo)(GameInfo_t *info) {
+  backend_free_game_info(info);
+}
+
+/**
+ * @brief Записывает состояние backend в снимок.
+ * @param w Писатель снимка
+ */
+void backend_save_state(StateWriter *w) { tetris_board_save(w, &board); }
+
+/**
+ * @brief Упаковывает кадр одиночной игры.
+ * @param buf Буфер (NULL — только размер)
+ * @param size Размер буфера
+ * @return TETRIS_PACKED_FIELD_BYTES
+ */
+size_t backend_export_packed(void *buf, size_t size) {
+  if (buf && size >= TETRIS_PACKED_FIELD_BYTES) {
+    tetris_board_pack(&board, true, (uint8_t *)buf);
+  }
+  return TETRIS_PACKED_FIELD_BYTES;
+}
+
+/**
+ * @brief Восстанавливает состояние backend из снимка.
+ *
+ * Состояние меняется только если снимок прочитан целиком.
+ *
+ * @param r Читатель снимка
+ * @return true при успехе
+ */
+bool backend_load_state(StateReader *r) {
+  TetrisBoard loaded = board;
+  if (!tetris_board_load(r, &loaded) || r->pos != r->size) return false;
+
+  backend_restore_board(&loaded);
+  return true;
+}
+
+/**
+ * @brief Копирует поле одиночной игры.
+ * @param out Поле-приёмник
+ */
+void backend_copy_board(TetrisBoard *out) { *out = board; }
+
+/**
+ * @brief Заменяет поле одиночной игры и синхронизирует кадр.
+ *
+ * Рекорд только растёт: файл рекорда не переписывается, как и при
+ * загрузке снимка.
+ *
+ * @param b Новое состояние поля
+ */
+void backend_restore_board(const TetrisBoard *b) {
+  board = *b;
+  info.score = board.score;
+  if (board.score > info.high_score) info.high_score = board.score;
+  info.level = board.level;
+  info.speed = board.speed;
+}
@@ -17,6 +17,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../../include/brickgame/common/input_queue.h"
+#include "../../include/brickgame/common/plugin_api.h"
 #include "../../include/brickgame/common/types.h"
 #include "../../include/brickgame/tetris/backend.h"
 #include "../../include/brickgame/tetris/fsm.h"
@@ -24,14 +26,54 @@
 
 static GameInfo_t game_info;
 static GameState_t previous_state = STATE_INIT;
+/// Ввод, ожидающий тика (per_tick == 0 — ввод применяется сразу).
+static InputQueue pending_input;
+/// Часы сессии для отметок времени ввода, мс.
+static uint32_t session_ms;
+
+/**
+ * @brief Действия, которые двигают фигуру и могут ждать тика.
+ */
+static bool is_piece_action(UserAction_t action) {
+  return action == Left || action == Right || action == Down ||
+         action == Action;
+}
+
+/**
+ * @brief Применяет действие к фигуре.
+ */
+static void apply_input(UserAction_t action, bool hold) {
+  BackendStatus status = backend_handle_input(action, hold);
+  if (status == BACKEND_GAME_OVER) {
+    fsm_set_state(STATE_GAME_OVER);
+  }
+}
+
+/**
+ * @brief Применяет не больше per_tick действий из очереди.
+ */
+static void apply_pending_input(void) {
+  QueuedInput input;
+  for (uint32_t i = 0; i < pending_input.per_tick &&
+                       fsm_get_state() == STATE_RUNNING &&
+                       input_queue_pop(&pending_input, &input);
+       ++i) {
+    apply_input((UserAction_t)input.action, input.hold != 0);
+  }
+}
 
 /**
  * @brief Сбрасывает текущее состояние игры и инициализирует новое.
+ *
+ * Буферы кадра выделяются один раз и переживают рестарты партии.
  */
 static void reset_game_info(void) {
-  backend_free_game_info(&game_info);
-
-  backend_init_game();
+  if (game_info.field && game_info.next) {
+    backend_restart_game(&game_info);
+  } else {
+    backend_free_game_info(&game_info);
+    backend_init_game();
+  }
 
   GameInfo_t backend_info = backend_get_info();
 
@@ -43,23 +85,31 @@ static void reset_game_info(void) {
 
   game_info.field = backend_info.field;
   game_info.next = backend_info.next;
+  input_queue_clear(&pending_input);
+  session_ms = 0;
 }
 
 /**
  * @brief Обрабатывает ввод игрока.
  *
+ * В режиме очереди (setInputsPerTick() > 0) движения фигуры
+ * откладываются до следующего updateCurrentState().
+ *
  * @param action действие пользователя (влево, вправо, поворот и т.д.)
  * @param hold   признак удержания кнопки
  */
-EXPORT void userInput(UserAction_t action, bool hold) {
+EXPORT void TETRIS_API(userInput)(UserAction_t action, bool hold) {
   fsm_process_input(action);
   GameState_t state = fsm_get_state();
 
-  if (state == STATE_RUNNING) {
-    BackendStatus status = backend_handle_input(action, hold);
-    if (status == BACKEND_GAME_OVER) {
-      fsm_set_state(STATE_GAME_OVER);
+  if (state != STATE_RUNNING) {
+    input_queue_clear(&pending_input);
+  } else if (pending_input.per_tick > 0) {
+    if (is_piece_action(action)) {
+      input_queue_push(&pending_input, action, hold, session_ms);
     }
+  } else {
+    apply_input(action, hold);
   }
 }
 
@@ -71,7 +121,8 @@ EXPORT void userInput(UserAction_t action, bool hold) {
  *
  * @return текущее состояние GameInfo_t для отрисовки.
  */
-EXPORT GameInfo_t updateCurrentState() {
+EXPORT GameInfo_t TETRIS_API(updateCurrentState)() {
+  alloc_hooks_begin_tick(backend_alloc_hooks());
   GameState_t state = fsm_get_state();
 
   if (previous_state == STATE_GAME_OVER && state == STATE_RUNNING) {
@@ -80,15 +131,22 @@ EXPORT GameInfo_t updateCurrentState() {
     reset_game_info();
   }
 
-  previous_state = state;
-
   if (state == STATE_RUNNING) {
-    BackendStatus status = backend_update_physics(&game_info);
-    if (status == BACKEND_GAME_OVER) {
-      fsm_set_state(STATE_GAME_OVER);
+    /* Ввод, пришедший до тика, применяется раньше гравитации. */
+    apply_pending_input();
+    if (fsm_get_state() == STATE_RUNNING) {
+      BackendStatus status = backend_update_physics(&game_info);
+      if (status == BACKEND_GAME_OVER) {
+        fsm_set_state(STATE_GAME_OVER);
+      }
     }
+    session_ms += (uint32_t)game_info.speed;
   }
 
+  /* Состояние после физики: Start сразу после проигрыша тоже должен
+   * начать новую партию. */
+  previous_state = fsm_get_state();
+
   GameInfo_t backend_info = backend_get_info();
   game_info.score = backend_info.score;
   game_info.high_score = backend_info.high_score;
@@ -100,6 +158,7 @@ EXPORT GameInfo_t updateCurrentState() {
     backend_overlay_piece(&game_info);
   }
 
+  alloc_hooks_end_tick(backend_alloc_hooks());
   return game_info;
 }
 /**
@@ -107,4 +166,236 @@ EXPORT GameInfo_t updateCurrentState() {
  *
  * @return true если игра завершена, иначе false.
  */
-EXPORT bool isGameOver(void) { return fsm_get_state() == STATE_GAME_OVER; }
+EXPORT bool TETRIS_API(isGameOver)(void) {
+  return fsm_get_state() == STATE_GAME_OVER;
+}
+
+/**
+ * @brief Сохраняет полное состояние сессии в бинарный снимок.
+ *
+ * Кроме данных backend в снимок входят состояния FSM, так что
+ * восстановленная сессия продолжается с того же тика.
+ *
+ * @param buf  буфер для снимка (NULL — только подсчёт размера)
+ * @param size размер буфера
+ * @return полный размер снимка
+ */
+EXPORT size_t TETRIS_API(saveGameState)(void *buf, size_t size) {
+  StateWriter writer;
+  state_blob_begin(&writer, buf, size);
+  state_write_u8(&writer, (uint8_t)fsm_get_state());
+  state_write_u8(&writer, (uint8_t)previous_state);
+  state_write_u8(&writer, game_info.field != NULL);
+  state_write_u32(&writer, session_ms);
+  state_write_u8(&writer, (uint8_t)pending_input.per_tick);
+  state_write_u8(&writer, (uint8_t)pending_input.count);
+  for (uint32_t i = 0; i < pending_input.count; ++i) {
+    const QueuedInput *input =
+        &pending_input.items[(pending_input.head + i) % INPUT_QUEUE_CAPACITY];
+    state_write_u8(&writer, (uint8_t)input->action);
+    state_write_u8(&writer, (uint8_t)input->hold);
+    state_write_u32(&writer, input->time_ms);
+  }
+  backend_save_state(&writer);
+  return state_blob_end(&writer, BRICKGAME_STATE_TETRIS, TETRIS_STATE_VERSION);
+}
+
+/**
+ * @brief Пишет кадр поля в упакованном виде (2 бита на клетку).
+ *
+ * @param buf  буфер (NULL — только подсчёт размера)
+ * @param size размер буфера
+ * @return размер упакованного поля
+ */
+EXPORT size_t TETRIS_API(exportPackedField)(void *buf, size_t size) {
+  return backend_export_packed(buf, size);
+}
+
+/**
+ * @brief Копирует поле текущей партии.
+ *
+ * @param out Поле-приёмник
+ */
+EXPORT void TETRIS_API(copyBoard)(TetrisBoard *out) { backend_copy_board(out); }
+
+/**
+ * @brief Восстанавливает сессию из снимка saveGameState().
+ *
+ * @param buf  снимок
+ * @param size размер снимка
+ * @return true при успехе
+ */
+EXPORT bool TETRIS_API(loadGameState)(const void *buf, size_t size) {
+  StateReader reader;
+  if (!state_blob_open(&reader, buf, size, BRICKGAME_STATE_TETRIS,
+                       TETRIS_STATE_VERSION)) {
+    return false;
+  }
+
+  uint8_t state = state_read_u8(&reader);
+  uint8_t previous = state_read_u8(&reader);
+  uint8_t has_field = state_read_u8(&reader);
+  uint32_t clock_ms = state_read_u32(&reader);
+  uint8_t per_tick = state_read_u8(&reader);
+  uint8_t count = state_read_u8(&reader);
+  if (!reader.ok || state > STATE_GAME_OVER || previous > STATE_GAME_OVER ||
+      per_tick > INPUT_QUEUE_CAPACITY || count > INPUT_QUEUE_CAPACITY) {
+    return false;
+  }
+
+  InputQueue input;
+  input_queue_init(&input, per_tick);
+  input.dropped = pending_input.dropped;
+  for (uint8_t i = 0; i < count; ++i) {
+    uint8_t action = state_read_u8(&reader);
+    bool hold = state_read_u8(&reader) != 0;
+    uint32_t time_ms = state_read_u32(&reader);
+    if (!is_piece_action((UserAction_t)action)) return false;
+    input_queue_push(&input, action, hold, time_ms);
+  }
+
+  if (!backend_load_state(&reader)) return false;
+
+  if (has_field && !game_info.field) {
+    GameInfo_t buffers = backend_alloc_info();
+    game_info.field = buffers.field;
+    game_info.next = buffers.next;
+  }
+
+  fsm_set_state((GameState_t)state);
+  previous_state = (GameState_t)previous;
+  pending_input = input;
+  session_ms = clock_ms;
+
+  if (game_info.field) {
+    GameInfo_t backend_info = backend_get_info();
+    game_info.score = backend_info.score;
+    game_info.high_score = backend_info.high_score;
+    game_info.level = backend_info.level;
+    game_info.speed = backend_info.speed;
+    game_info.pause = (state == STATE_PAUSED);
+    backend_overlay_piece(&game_info);
+  }
+  return true;
+}
+
+/**
+ * @brief Переключает игру в режим фиксированного кадра.
+ *
+ * @param frame_ms          длительность кадра в мс (0 — классический режим)
+ * @param lock_delay_frames задержка фиксации в кадрах
+ */
+EXPORT void TETRIS_API(setTetrisTiming)(int frame_ms,
+                                        int lock_delay_frames) {
+  backend_set_timing(frame_ms, lock_delay_frames);
+}
+
+/**
+ * @brief Включает применение ввода на границе тика.
+ *
+ * @param per_tick действий за тик (0 — ввод применяется сразу)
+ */
+EXPORT void TETRIS_API(setInputsPerTick)(int per_tick) {
+  if (per_tick < 0) per_tick = 0;
+  if (per_tick > INPUT_QUEUE_CAPACITY) per_tick = INPUT_QUEUE_CAPACITY;
+  input_queue_clear(&pending_input);
+  pending_input.per_tick = (uint32_t)per_tick;
+}
+
+/**
+ * @brief Устанавливает аллокатор для буферов игры.
+ *
+ * @param allocator аллокатор (NULL — malloc/free)
+ */
+EXPORT void TETRIS_API(setAllocator)(const BrickGameAllocator *allocator) {
+  alloc_hooks_set(backend_alloc_hooks(), allocator);
+}
+
+/**
+ * @brief Выделения памяти за последний updateCurrentState().
+ *
+ * @return счётчики выделений последнего тика
+ */
+EXPORT BrickGameAllocStats TETRIS_API(tickAllocStats)(void) {
+  return backend_alloc_hooks()->last_tick;
+}
+
+/**
+ * @brief Записывает рекорд в файл, если он вырос.
+ */
+EXPORT void TETRIS_API(flushHighScore)(void) { backend_flush_high_score(); }
+
+/**
+ * @brief Хук инициализации плагина: возвращает игру в начальное состояние.
+ *
+ * Режим фиксированного кадра включается переменными окружения
+ * BRICKGAME_TETRIS_FRAME_MS и BRICKGAME_TETRIS_LOCK_DELAY (в кадрах),
+ * очередь ввода — BRICKGAME_INPUTS_PER_TICK.
+ */
+static void tetris_init(void) {
+  const char *frame = getenv("BRICKGAME_TETRIS_FRAME_MS");
+  const char *lock = getenv("BRICKGAME_TETRIS_LOCK_DELAY");
+  if (frame) {
+    backend_set_timing(atoi(frame), lock ? atoi(lock) : 30);
+  }
+  input_queue_init(&pending_input, input_queue_per_tick_from_env(0));
+  backend_load_high_score();
+  session_ms = 0;
+  fsm_set_state(STATE_INIT);
+  previous_state = STATE_INIT;
+}
+
+/**
+ * @brief Хук завершения плагина: записывает рекорд и освобождает буферы
+ *        игрового поля.
+ */
+static void tetris_shutdown(void) {
+  backend_flush_high_score();
+  backend_free_game_info(&game_info);
+  fsm_set_state(STATE_INIT);
+  previous_state = STATE_INIT;
+}
+
+/**
+ * @brief Таблица функций плагина Tetris.
+ */
+static const BrickGameApi tetris_api = {
+    BRICKGAME_ABI_VERSION,
+    sizeof(BrickGameApi),
+    "tetris",
+    "Tetris",
+    BRICKGAME_CAP_NEXT_PREVIEW | BRICKGAME_CAP_SAVE_STATE,
+    TETRIS_FIELD_WIDTH,
+    TETRIS_FIELD_HEIGHT,
+    Up,
+    tetris_init,
+    tetris_shutdown,
+    TETRIS_API(userInput),
+    TETRIS_API(updateCurrentState),
+    TETRIS_API(isGameOver),
+    TETRIS_API(freeGameInfo),
+    NULL,
+    TETRIS_API(saveGameState),
+    TETRIS_API(loadGameState),
+    NULL,
+    TETRIS_API(setAllocator),
+    TETRIS_API(tickAllocStats),
+    TETRIS_API(flushHighScore)};
+
+/**
+ * @brief Таблица функций Tetris (для реестра встроенных игр).
+ *
+ * @return таблица функций игры
+ */
+EXPORT const BrickGameApi *brickgame_tetris_get_api(void) {
+  return &tetris_api;
+}
+
+#ifndef BRICKGAME_STATIC_ENGINES
+/**
+ * @brief Точка входа плагина Tetris.
+ *
+ * @return таблица функций игры
+ */
+EXPORT const BrickGameApi *brickgame_get_api(void) { return &tetris_api; }
+#endif
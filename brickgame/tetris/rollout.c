@@ -0,0 +1,391 @@
+/**
+ * @file rollout.c
+ * @brief Реализация оценки установок методом Монте-Карло.
+ *
+ * Работа — пары (установка, номер продолжения), всего count * rollouts;
+ * каждый поток берёт непрерывный отрезок и копит суммы в свой массив,
+ * суммы потоков складываются после join.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "../../include/brickgame/tetris/rollout.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../../include/brickgame/common/splitmix64.h"
+
+/// Левый край матрицы фигуры, ещё касающейся поля.
+#define MIN_X (1 - TETRIS_FIGURE_SIZE)
+/// Возможных столбцов левого края матрицы.
+#define COLUMNS (TETRIS_FIELD_WIDTH - MIN_X)
+/// Предел потоков одной оценки.
+#define MAX_THREADS 64
+
+/// Веса жадной политики (x100): высота, линии, дыры, неровность.
+#define WEIGHT_HEIGHT (-51)
+#define WEIGHT_LINES 76
+#define WEIGHT_HOLES (-36)
+#define WEIGHT_BUMPINESS (-18)
+
+/**
+ * @brief Установка: повороты и фигура в месте фиксации.
+ */
+typedef struct {
+  int rotation;
+  Tetromino piece;
+} Placement;
+
+/**
+ * @brief Суммы по продолжениям одной установки.
+ */
+typedef struct {
+  int64_t survived;
+  int64_t lines;
+  int64_t score;
+  int64_t pieces;
+} Sums;
+
+/**
+ * @brief Общие данные оценки.
+ */
+typedef struct {
+  const TetrisBoard *board;
+  const TetrisRolloutConfig *config;
+  const Placement *placements;
+  int count;
+} Job;
+
+/**
+ * @brief Отрезок работы одного потока.
+ */
+typedef struct {
+  const Job *job;
+  int64_t begin;
+  int64_t end;
+  Sums *sums;  ///< job->count сумм потока
+} Worker;
+
+/**
+ * @brief Сбрасывает падающую фигуру до опоры.
+ *
+ * То же, что Down до упора, но за один проход: фигура опускается на
+ * наименьший по её столбцам зазор между нижней клеткой и блоком (или
+ * дном) под ней.
+ */
+static void drop_piece(TetrisBoard *b) {
+  Tetromino *piece = &b->current;
+  int fall = TETRIS_FIELD_HEIGHT;
+  for (int x = 0; x < TETRIS_FIGURE_SIZE; ++x) {
+    int bottom = TETRIS_FIGURE_SIZE - 1;
+    while (bottom >= 0 && !piece->shape[bottom][x]) --bottom;
+    if (bottom < 0) continue;
+
+    int fx = piece->x + x;
+    int below = piece->y + bottom + 1;
+    int gap = 0;
+    while (below + gap < TETRIS_FIELD_HEIGHT &&
+           (below + gap < 0 || !tetris_board_cell(b, fx, below + gap))) {
+      ++gap;
+    }
+    if (gap < fall) fall = gap;
+  }
+  piece->y += fall;
+}
+
+/**
+ * @brief Сдвигает падающую фигуру на столбец (Left или Right).
+ *
+ * @return false, если сдвиг упёрся в стену или блоки
+ */
+static bool shift_piece(TetrisBoard *b, UserAction_t action) {
+  int before = b->current.x;
+  tetris_board_input(b, action, false);
+  return b->current.x != before;
+}
+
+/**
+ * @brief Поворачивает, сдвигает к столбцу x и сбрасывает до опоры
+ *        падающую фигуру тем же вводом, что у игрока.
+ */
+static void move_piece(TetrisBoard *b, int rotation, int x) {
+  for (int i = 0; i < rotation; ++i) tetris_board_input(b, Action, false);
+  while (b->current.x != x) {
+    if (!shift_piece(b, b->current.x < x ? Right : Left)) break;
+  }
+  drop_piece(b);
+}
+
+/**
+ * @brief Занятые фигурой клетки поля (y * ширина + x) по строкам.
+ *
+ * Повороты одной фигуры лежат в матрице по-разному, поэтому установки
+ * сравниваются по клеткам, а не по матрице и её позиции.
+ */
+static void piece_cells(const Tetromino *piece, int cells[4]) {
+  int n = 0;
+  for (int y = 0; y < TETRIS_FIGURE_SIZE; ++y) {
+    for (int x = 0; x < TETRIS_FIGURE_SIZE; ++x) {
+      if (piece->shape[y][x] && n < 4) {
+        cells[n++] = (piece->y + y) * TETRIS_FIELD_WIDTH + piece->x + x;
+      }
+    }
+  }
+  while (n < 4) cells[n++] = -1;
+}
+
+/**
+ * @brief Все различные установки падающей фигуры.
+ *
+ * @return число установок в out
+ */
+static int enumerate(const TetrisBoard *b, Placement *out) {
+  int count = 0;
+  int cells[TETRIS_ROLLOUT_MAX_PLACEMENTS][4];
+  for (int rotation = 0; rotation < 4; ++rotation) {
+    TetrisBoard rotated = *b;
+    for (int i = 0; i < rotation; ++i) {
+      tetris_board_input(&rotated, Action, false);
+    }
+
+    // Сдвиг влево, затем вправо от места поворота: по пути фигура
+    // проходит те же столбцы, что и в move_piece(), так что сброс с
+    // каждого даёт ту же установку.
+    Tetromino landed[COLUMNS];
+    bool reached[COLUMNS] = {false};
+    for (int side = 0; side < 2; ++side) {
+      UserAction_t action = side == 0 ? Left : Right;
+      TetrisBoard slid = rotated;
+      if (side == 1 && !shift_piece(&slid, Right)) continue;
+      do {
+        Tetromino piece = slid.current;
+        drop_piece(&slid);
+        landed[piece.x - MIN_X] = slid.current;
+        reached[piece.x - MIN_X] = true;
+        slid.current = piece;
+      } while (shift_piece(&slid, action));
+    }
+
+    for (int column = 0; column < COLUMNS; ++column) {
+      if (!reached[column]) continue;
+      piece_cells(&landed[column], cells[count]);
+      bool seen = false;
+      for (int i = 0; i < count && !seen; ++i) {
+        seen = memcmp(cells[i], cells[count], sizeof(cells[i])) == 0;
+      }
+      if (!seen) {
+        out[count].rotation = rotation;
+        out[count].piece = landed[column];
+        ++count;
+      }
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief Фиксирует фигуру piece на поле.
+ */
+static BackendStatus place(TetrisBoard *b, const Tetromino *piece) {
+  b->current = *piece;
+  return tetris_board_fix_piece(b);
+}
+
+/**
+ * @brief Оценка поля для жадной политики (больше — лучше).
+ *
+ * Столбец занят от верхней клетки; дыра — пустая клетка под занятой.
+ */
+static int evaluate(const TetrisBoard *b) {
+  int heights[TETRIS_FIELD_WIDTH] = {0};
+  uint32_t covered = 0;
+  int holes = 0;
+  for (int y = 0; y < TETRIS_FIELD_HEIGHT; ++y) {
+    uint32_t row = b->rows[tetris_board_row(b, y)];
+    // Младший бит каждой клетки — признак занятости.
+    uint32_t occupied = (row | (row >> 1)) & TETRIS_ROW_FULL;
+    for (uint32_t hole = covered & ~occupied; hole; hole &= hole - 1) {
+      ++holes;
+    }
+    uint32_t fresh = occupied & ~covered;
+    for (int x = 0; fresh && x < TETRIS_FIELD_WIDTH; ++x) {
+      if ((fresh >> (PACKED_CELL_BITS * x)) & 1u) {
+        heights[x] = TETRIS_FIELD_HEIGHT - y;
+      }
+    }
+    covered |= occupied;
+  }
+
+  int height = heights[0];
+  int bumpiness = 0;
+  for (int x = 1; x < TETRIS_FIELD_WIDTH; ++x) {
+    height += heights[x];
+    bumpiness += abs(heights[x] - heights[x - 1]);
+  }
+  return WEIGHT_HEIGHT * height + WEIGHT_LINES * b->last_cleared +
+         WEIGHT_HOLES * holes + WEIGHT_BUMPINESS * bumpiness;
+}
+
+/**
+ * @brief Ставит падающую фигуру по политике продолжения.
+ */
+static BackendStatus policy_step(TetrisBoard *b, TetrisRolloutPolicy policy,
+                                 uint64_t *rng) {
+  Placement moves[TETRIS_ROLLOUT_MAX_PLACEMENTS];
+  int count = enumerate(b, moves);
+  if (count == 0) return BACKEND_GAME_OVER;
+  if (policy == TETRIS_ROLLOUT_RANDOM) {
+    return place(b, &moves[splitmix64_next(rng) % (uint64_t)count].piece);
+  }
+
+  TetrisBoard best;
+  int best_score = 0;
+  bool found = false;
+  for (int i = 0; i < count; ++i) {
+    TetrisBoard trial = *b;
+    if (place(&trial, &moves[i].piece) == BACKEND_GAME_OVER) continue;
+    int score = evaluate(&trial);
+    if (!found || score > best_score) {
+      best = trial;
+      best_score = score;
+      found = true;
+    }
+  }
+  if (!found) return place(b, &moves[0].piece);
+  *b = best;
+  return BACKEND_OK;
+}
+
+/**
+ * @brief Продолжение index из установки candidate.
+ */
+static void run_rollout(const Job *job, int candidate, int index,
+                        Sums *sums) {
+  const TetrisRolloutConfig *config = job->config;
+  TetrisBoard b = *job->board;
+  b.rng_state = splitmix64_mix(config->seed +
+                               SPLITMIX64_GAMMA * (uint64_t)(index + 1));
+  uint64_t policy_rng = splitmix64_mix(b.rng_state);
+
+  BackendStatus status = place(&b, &job->placements[candidate].piece);
+  int lines = b.last_cleared;
+  int pieces = 1;
+  for (int d = 0; d < config->depth && status == BACKEND_OK; ++d) {
+    status = policy_step(&b, config->policy, &policy_rng);
+    lines += b.last_cleared;
+    ++pieces;
+  }
+
+  sums->survived += status == BACKEND_OK;
+  sums->lines += lines;
+  sums->score += b.score - job->board->score;
+  sums->pieces += pieces;
+}
+
+static void *run_worker(void *arg) {
+  Worker *w = arg;
+  int rollouts = w->job->config->rollouts;
+  for (int64_t item = w->begin; item < w->end; ++item) {
+    int candidate = (int)(item / rollouts);
+    run_rollout(w->job, candidate, (int)(item % rollouts),
+                &w->sums[candidate]);
+  }
+  return NULL;
+}
+
+/**
+ * @brief Число потоков: из настроек или по числу ядер.
+ */
+static int thread_count(const TetrisRolloutConfig *config, int64_t items) {
+  long threads = config->threads;
+  if (threads <= 0) threads = sysconf(_SC_NPROCESSORS_ONLN);
+  if (threads < 1) threads = 1;
+  if (threads > MAX_THREADS) threads = MAX_THREADS;
+  if (threads > items) threads = (long)items;
+  return (int)threads;
+}
+
+EXPORT int tetris_rollout_evaluate(const TetrisBoard *board,
+                                   const TetrisRolloutConfig *config,
+                                   TetrisPlacementStats *out, int max_count) {
+  if (!board || !config || !out || config->rollouts <= 0 ||
+      config->depth < 0) {
+    return -1;
+  }
+
+  Placement placements[TETRIS_ROLLOUT_MAX_PLACEMENTS];
+  int count = enumerate(board, placements);
+  if (count > max_count) count = max_count;
+  if (count <= 0) return 0;
+
+  Job job = {board, config, placements, count};
+  int64_t items = (int64_t)count * config->rollouts;
+  int threads = thread_count(config, items);
+  Sums *sums = calloc((size_t)threads * (size_t)count, sizeof(*sums));
+  if (!sums) return -1;
+
+  Worker workers[MAX_THREADS];
+  pthread_t ids[MAX_THREADS];
+  bool started[MAX_THREADS] = {false};
+  for (int t = 0; t < threads; ++t) {
+    workers[t].job = &job;
+    workers[t].begin = items * t / threads;
+    workers[t].end = items * (t + 1) / threads;
+    workers[t].sums = sums + (size_t)t * (size_t)count;
+    // Первый отрезок считает сам вызывающий поток.
+    if (t > 0) {
+      started[t] = pthread_create(&ids[t], NULL, run_worker, &workers[t]) == 0;
+    }
+  }
+  for (int t = 0; t < threads; ++t) {
+    if (!started[t]) run_worker(&workers[t]);
+  }
+  for (int t = 1; t < threads; ++t) {
+    if (started[t]) pthread_join(ids[t], NULL);
+  }
+
+  for (int i = 0; i < count; ++i) {
+    Sums total = {0, 0, 0, 0};
+    for (int t = 0; t < threads; ++t) {
+      const Sums *part = &sums[(size_t)t * (size_t)count + (size_t)i];
+      total.survived += part->survived;
+      total.lines += part->lines;
+      total.score += part->score;
+      total.pieces += part->pieces;
+    }
+
+    TetrisBoard placed = *board;
+    place(&placed, &placements[i].piece);
+    double n = (double)config->rollouts;
+    out[i].rotation = placements[i].rotation;
+    out[i].x = placements[i].piece.x;
+    out[i].y = placements[i].piece.y;
+    out[i].lines = placed.last_cleared;
+    out[i].survival = (double)total.survived / n;
+    out[i].mean_lines = (double)total.lines / n;
+    out[i].mean_score = (double)total.score / n;
+    out[i].mean_pieces = (double)total.pieces / n;
+  }
+  free(sums);
+  return count;
+}
+
+EXPORT int tetris_rollout_best(const TetrisPlacementStats *stats, int count) {
+  int best = -1;
+  for (int i = 0; i < count; ++i) {
+    if (best < 0 || stats[i].survival > stats[best].survival ||
+        (stats[i].survival == stats[best].survival &&
+         stats[i].mean_score > stats[best].mean_score)) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+EXPORT BackendStatus tetris_rollout_place(TetrisBoard *board, int rotation,
+                                          int x) {
+  move_piece(board, rotation, x);
+  return tetris_board_fix_piece(board);
+}
@@ -0,0 +1,133 @@
+/**
+ * @file tetris_batch.c
+ * @brief Реализация пакета сред Tetris.
+ */
+
+#include "../../include/brickgame/tetris/tetris_batch.h"
+
+#include <stdlib.h>
+
+#include "../../include/brickgame/common/splitmix64.h"
+
+/// Клеток поля.
+#define CELLS (TETRIS_FIELD_WIDTH * TETRIS_FIELD_HEIGHT)
+
+struct TetrisBatch {
+  TetrisBoard *boards;
+  int *steps;  ///< Шагов текущего эпизода
+  int count;
+  int max_steps;
+};
+
+/**
+ * @brief Зерно среды: финализатор SplitMix64 от seed и номера.
+ *
+ * Генератор поля сам идёт шагами SplitMix64, поэтому зёрна seed + i
+ * дали бы средам сдвинутые копии одной последовательности.
+ */
+static uint64_t env_seed(uint64_t seed, int index) {
+  return splitmix64_mix(seed + SPLITMIX64_GAMMA * (uint64_t)(index + 1));
+}
+
+/**
+ * @brief Пишет наблюдение одного поля (см. tetris_batch.h).
+ */
+static void observe(const TetrisBoard *b, float *obs) {
+  float *locked = obs;
+  float *piece = obs + CELLS;
+  float *features = obs + TETRIS_BATCH_PLANES * CELLS;
+
+  for (int y = 0; y < TETRIS_FIELD_HEIGHT; ++y) {
+    uint32_t row = b->rows[tetris_board_row(b, y)];
+    for (int x = 0; x < TETRIS_FIELD_WIDTH; ++x) {
+      locked[y * TETRIS_FIELD_WIDTH + x] =
+          (float)((row >> (PACKED_CELL_BITS * x)) & PACKED_CELL_MASK);
+      piece[y * TETRIS_FIELD_WIDTH + x] = 0.0f;
+    }
+  }
+
+  for (int y = 0; y < TETRIS_FIGURE_SIZE; ++y) {
+    for (int x = 0; x < TETRIS_FIGURE_SIZE; ++x) {
+      int fx = b->current.x + x;
+      int fy = b->current.y + y;
+      if (b->current.shape[y][x] && fx >= 0 && fx < TETRIS_FIELD_WIDTH &&
+          fy >= 0 && fy < TETRIS_FIELD_HEIGHT) {
+        piece[fy * TETRIS_FIELD_WIDTH + fx] = 1.0f;
+      }
+      features[y * TETRIS_FIGURE_SIZE + x] = b->next.shape[y][x] ? 1.0f : 0.0f;
+    }
+  }
+  features[TETRIS_FIGURE_SIZE * TETRIS_FIGURE_SIZE] =
+      (float)b->level / TETRIS_MAX_LEVEL;
+}
+
+EXPORT TetrisBatch *tetris_batch_create(int count, uint64_t seed,
+                                        int max_steps) {
+  if (count <= 0) return NULL;
+  TetrisBatch *batch = calloc(1, sizeof(*batch));
+  if (!batch) return NULL;
+  batch->boards = calloc((size_t)count, sizeof(*batch->boards));
+  batch->steps = calloc((size_t)count, sizeof(*batch->steps));
+  if (!batch->boards || !batch->steps) {
+    tetris_batch_destroy(batch);
+    return NULL;
+  }
+
+  batch->count = count;
+  batch->max_steps = max_steps > 0 ? max_steps : 0;
+  for (int i = 0; i < count; ++i) {
+    tetris_board_init(&batch->boards[i], env_seed(seed, i));
+  }
+  return batch;
+}
+
+EXPORT void tetris_batch_destroy(TetrisBatch *batch) {
+  if (!batch) return;
+  free(batch->boards);
+  free(batch->steps);
+  free(batch);
+}
+
+EXPORT int tetris_batch_count(const TetrisBatch *batch) {
+  return batch ? batch->count : 0;
+}
+
+EXPORT void tetris_batch_reset(TetrisBatch *batch, float *observations) {
+  for (int i = 0; i < batch->count; ++i) {
+    tetris_board_reset(&batch->boards[i]);
+    batch->steps[i] = 0;
+    if (observations) {
+      observe(&batch->boards[i],
+              observations + (size_t)i * TETRIS_BATCH_OBS_SIZE);
+    }
+  }
+}
+
+EXPORT void tetris_batch_step(TetrisBatch *batch, const int32_t *actions,
+                              float *observations, float *rewards,
+                              uint8_t *dones) {
+  for (int i = 0; i < batch->count; ++i) {
+    TetrisBoard *b = &batch->boards[i];
+    int score = b->score;
+
+    int32_t action = actions[i];
+    if (action == Left || action == Right || action == Down ||
+        action == Action) {
+      tetris_board_input(b, (UserAction_t)action, false);
+    }
+    BackendStatus status = tetris_board_physics(b);
+
+    int steps = ++batch->steps[i];
+    bool done = status == BACKEND_GAME_OVER ||
+                (batch->max_steps > 0 && steps >= batch->max_steps);
+    if (rewards) rewards[i] = (float)(b->score - score);
+    if (dones) dones[i] = done ? 1 : 0;
+    if (done) {
+      tetris_board_reset(b);
+      batch->steps[i] = 0;
+    }
+    if (observations) {
+      observe(b, observations + (size_t)i * TETRIS_BATCH_OBS_SIZE);
+    }
+  }
+}
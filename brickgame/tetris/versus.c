@@ -0,0 +1,195 @@
+/**
+ * @file versus.c
+ * @brief Матч Tetris на несколько игроков с обменом мусором.
+ */
+
+#include "../../include/brickgame/tetris/versus.h"
+
+#include <string.h>
+
+#include "../../include/brickgame/common/splitmix64.h"
+
+/// Атака за 0..4 очищенные линии.
+static const int ATTACK[5] = {0, 0, 1, 2, 4};
+
+static bool valid_player(const TetrisVersus *versus, int player) {
+  return player >= 0 && player < versus->count;
+}
+
+/**
+ * @brief Выбывание игрока; матч заканчивается, когда играть некому.
+ */
+static void knock_out(TetrisVersus *versus, TetrisVersusPlayer *player) {
+  if (!player->alive) return;
+  player->alive = false;
+  input_queue_clear(&player->input);
+  versus->alive--;
+}
+
+/**
+ * @brief Учитывает фиксацию фигуры: атака или вставка мусора.
+ * @return false, если мусор вытолкнул блоки за верх поля
+ */
+static bool on_lock(TetrisVersusPlayer *player) {
+  int cleared = player->board.last_cleared;
+  if (cleared > 0) {
+    int attack = ATTACK[cleared > 4 ? 4 : cleared];
+    int cancel =
+        attack < player->pending_garbage ? attack : player->pending_garbage;
+    player->pending_garbage -= cancel;
+    player->outgoing += attack - cancel;
+    return true;
+  }
+  if (player->pending_garbage == 0) return true;
+
+  int rows = player->pending_garbage;
+  int hole = (int)(splitmix64_next(&player->garbage_rng) %
+                   TETRIS_FIELD_WIDTH);
+  player->pending_garbage = 0;
+  player->lines_received += rows;
+  return tetris_board_add_garbage(&player->board, rows, hole);
+}
+
+/**
+ * @brief Кадр одного игрока: ввод, падение, фиксация.
+ */
+static void step_player(TetrisVersus *versus, TetrisVersusPlayer *player) {
+  TetrisBoard *board = &player->board;
+  QueuedInput input;
+  while (input_queue_pop(&player->input, &input)) {
+    tetris_board_input(board, (UserAction_t)input.action, input.hold != 0);
+  }
+
+  uint32_t locks = board->locks;
+  BackendStatus status = tetris_board_physics(board);
+  if (board->locks != locks && !on_lock(player)) status = BACKEND_GAME_OVER;
+  if (status == BACKEND_GAME_OVER) knock_out(versus, player);
+}
+
+/**
+ * @brief Следующий живой соперник по кругу после последнего адресата.
+ * @return номер соперника или -1
+ */
+static int next_target(const TetrisVersus *versus, int from) {
+  const TetrisVersusPlayer *sender = &versus->players[from];
+  for (int i = 1; i < versus->count; ++i) {
+    int candidate = (sender->target + i) % versus->count;
+    if (candidate != from && versus->players[candidate].alive) {
+      return candidate;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Доставляет атаку, набранную за кадр.
+ */
+static void deliver_attacks(TetrisVersus *versus) {
+  for (int i = 0; i < versus->count; ++i) {
+    TetrisVersusPlayer *sender = &versus->players[i];
+    if (sender->outgoing == 0) continue;
+
+    int target = next_target(versus, i);
+    if (target >= 0) {
+      tetris_versus_send_garbage(versus, target, sender->outgoing);
+      sender->lines_sent += sender->outgoing;
+      sender->target = target;
+    }
+    sender->outgoing = 0;
+  }
+}
+
+void tetris_versus_init(TetrisVersus *versus, int players, uint64_t seed,
+                        int frame_ms, int lock_delay) {
+  memset(versus, 0, sizeof(*versus));
+  if (players < 1) players = 1;
+  if (players > TETRIS_VERSUS_MAX_PLAYERS) players = TETRIS_VERSUS_MAX_PLAYERS;
+  if (frame_ms <= 0) frame_ms = TETRIS_VERSUS_FRAME_MS;
+  if (lock_delay < 0) lock_delay = TETRIS_VERSUS_LOCK_DELAY;
+
+  versus->count = players;
+  versus->alive = players;
+  versus->winner = -1;
+  versus->frame_ms = frame_ms;
+  for (int i = 0; i < players; ++i) {
+    TetrisVersusPlayer *player = &versus->players[i];
+    tetris_board_init(&player->board, seed);
+    tetris_board_set_timing(&player->board, frame_ms, lock_delay);
+    input_queue_init(&player->input, INPUT_QUEUE_CAPACITY);
+    player->garbage_rng = seed ^ 0xD1B54A32D192ED03ull;
+    player->target = i;
+    player->alive = true;
+  }
+}
+
+void tetris_versus_input(TetrisVersus *versus, int player,
+                         UserAction_t action, bool hold) {
+  if (!valid_player(versus, player) || !versus->players[player].alive) return;
+  if (action != Left && action != Right && action != Down &&
+      action != Action) {
+    return;
+  }
+  input_queue_push(&versus->players[player].input, action, hold,
+                   (uint32_t)(versus->frame * (uint64_t)versus->frame_ms));
+}
+
+void tetris_versus_send_garbage(TetrisVersus *versus, int player, int rows) {
+  if (!valid_player(versus, player) || rows <= 0) return;
+  TetrisVersusPlayer *target = &versus->players[player];
+  target->pending_garbage += rows;
+  if (target->pending_garbage > TETRIS_FIELD_HEIGHT) {
+    target->pending_garbage = TETRIS_FIELD_HEIGHT;
+  }
+}
+
+bool tetris_versus_step(TetrisVersus *versus) {
+  if (versus->finished) return false;
+
+  for (int i = 0; i < versus->count; ++i) {
+    if (versus->players[i].alive) step_player(versus, &versus->players[i]);
+  }
+  deliver_attacks(versus);
+  versus->frame++;
+
+  int last = versus->count > 1 ? 1 : 0;
+  if (versus->alive <= last) {
+    versus->finished = true;
+    for (int i = 0; i < versus->count; ++i) {
+      if (versus->players[i].alive) versus->winner = i;
+    }
+  }
+  return true;
+}
+
+int tetris_versus_advance(TetrisVersus *versus, uint32_t elapsed_ms) {
+  versus->clock_ms += elapsed_ms;
+  int frames = 0;
+  while (versus->clock_ms >= (uint32_t)versus->frame_ms &&
+         frames < TETRIS_VERSUS_MAX_CATCHUP && tetris_versus_step(versus)) {
+    versus->clock_ms -= (uint32_t)versus->frame_ms;
+    frames++;
+  }
+  /* Отставание больше догоняемого отбрасывается, иначе матч
+   * ускорялся бы рывками после долгой паузы фронтенда. */
+  if (versus->clock_ms >= (uint32_t)versus->frame_ms || versus->finished) {
+    versus->clock_ms %= (uint32_t)versus->frame_ms;
+  }
+  return frames;
+}
+
+void tetris_versus_view(const TetrisVersus *versus, int player,
+                        GameInfo_t *info) {
+  if (!valid_player(versus, player)) return;
+  const TetrisBoard *board = &versus->players[player].board;
+  info->score = board->score;
+  info->level = board->level;
+  info->speed = board->speed;
+  info->pause = 0;
+  if (info->field) tetris_board_overlay(board, info->field);
+  if (info->next) {
+    for (int y = 0; y < TETRIS_FIGURE_SIZE; ++y) {
+      memcpy(info->next[y], board->next.shape[y],
+             TETRIS_FIGURE_SIZE * sizeof(int));
+    }
+  }
+}
@@ -5,80 +5,79 @@
  * Управляет жизненным циклом приложения, загрузкой игровых библиотек
  * и общим игровым циклом.
  */
+#define _POSIX_C_SOURCE 200809L
 
 #include "../../include/gui/cli/app_controller.h"
 
+#include "../../include/brickgame/common/leaderboard.h"
+#include "../../include/brickgame/common/trace.h"
+#include "../../include/gui/cli/engine_process.h"
 #include "../../include/gui/cli/input.h"
 #include "../../include/gui/cli/render.h"
-#define _POSIX_C_SOURCE 200809L
+
 #include <dlfcn.h>
 #include <ncurses.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
 
 /**
- * @brief Загружает игровую библиотеку и инициализирует API.
+ * @brief Заполняет GameAPI из таблицы загруженного плагина.
  *
- * @param game Тип игры для загрузки
- * @return GameAPI структура с функциями API или ошибкой
+ * @param plugin Загруженный плагин
+ * @return GameAPI структура с функциями API
  */
-GameAPI load_game_lib(GameType game) {
+GameAPI game_api_from_plugin(const BrickGamePlugin* plugin) {
   GameAPI api = {0};
-  const char* lib_name = NULL;
-
-#ifdef __APPLE__
-  const char* lib_extension = ".dylib";
-#else
-  const char* lib_extension = ".so";
-#endif
-
-  char lib_path[256];
-  switch (game) {
-    case GAME_TETRIS:
-      snprintf(lib_path, sizeof(lib_path), "./libtetris%s", lib_extension);
-      lib_name = lib_path;
-      break;
-    case GAME_SNAKE:
-      snprintf(lib_path, sizeof(lib_path), "./libsnake%s", lib_extension);
-      lib_name = lib_path;
-      break;
-    default:
-      api.error = strdup("Unknown game type");
-      return api;
-  }
-
-  api.lib_handle = dlopen(lib_name, RTLD_LAZY);
-  if (!api.lib_handle) {
-    api.error = strdup(dlerror());
+  if (!plugin || !plugin->api) {
+    api.error = strdup("Plugin is not loaded");
     return api;
   }
 
-  api.userInput =
-      (void (*)(UserAction_t, bool))dlsym(api.lib_handle, "userInput");
-  api.updateState =
-      (GameInfo_t(*)(void))dlsym(api.lib_handle, "updateCurrentState");
-  api.isOver = (bool (*)(void))dlsym(api.lib_handle, "isGameOver");
-  api.freeGameInfo =
-      (void (*)(GameInfo_t*))dlsym(api.lib_handle, "freeGameInfo");
-
-  if (!api.userInput || !api.updateState || !api.isOver) {
-    dlclose(api.lib_handle);
-    api.lib_handle = NULL;
-    api.error = strdup("Failed to load required functions");
-    return api;
+  api.lib_handle = plugin->handle;
+  api.table = plugin->api;
+  api.userInput = plugin->api->userInput;
+  api.updateState = plugin->api->updateCurrentState;
+  api.isOver = plugin->api->isGameOver;
+  api.freeGameInfo = plugin->api->freeGameInfo;
+  if (BRICKGAME_API_HAS(plugin->api, advance) &&
+      (plugin->api->capabilities & BRICKGAME_CAP_TIMED_ADVANCE)) {
+    api.advance = plugin->api->advance;
   }
-
   api.valid = true;
   return api;
 }
 
+/**
+ * @brief Загружает игровую библиотеку и инициализирует API.
+ *
+ * @param path Путь к библиотеке плагина
+ * @return GameAPI структура с функциями API или ошибкой
+ */
+GameAPI load_game_lib(const char* path) {
+  char error[256];
+  BrickGamePlugin plugin;
+  if (!plugin_load(path, &plugin, error, sizeof(error))) {
+    GameAPI api = {0};
+    api.error = strdup(error);
+    return api;
+  }
+  return game_api_from_plugin(&plugin);
+}
+
 /**
  * @brief Выгружает игровую библиотеку и освобождает ресурсы.
  *
  * @param api Структура API для выгрузки
  */
 void unload_game_lib(GameAPI api) {
+  if (api.table && api.table->shutdown) {
+    api.table->shutdown();
+  }
   if (api.lib_handle) {
     dlclose(api.lib_handle);
   }
@@ -87,6 +86,43 @@ void unload_game_lib(GameAPI api) {
   }
 }
 
+/**
+ * @brief Определяет схему ввода по возможностям плагина.
+ *
+ * @param api Загруженное API игры
+ * @return GAME_SNAKE для игр с ускорением удержанием, иначе GAME_TETRIS
+ */
+GameType game_type_for_api(const GameAPI* api) {
+  if (api && api->table &&
+      (api->table->capabilities & BRICKGAME_CAP_HOLD_ACCELERATE)) {
+    return GAME_SNAKE;
+  }
+  return GAME_TETRIS;
+}
+
+/**
+ * @brief Проверяет, должен ли вызывающий освобождать кадры игры.
+ *
+ * @param api Загруженное API игры
+ * @return true, если плагин выделяет GameInfo_t на каждый кадр
+ */
+bool game_api_caller_frees_info(const GameAPI* api) {
+  return api->freeGameInfo && api->table &&
+         (api->table->capabilities & BRICKGAME_CAP_CALLER_FREES_INFO);
+}
+
+/**
+ * @brief Записывает рекорд игры в конце партии (вне тика).
+ *
+ * @param api Загруженное API игры
+ */
+void game_api_flush_high_score(const GameAPI* api) {
+  if (api->table && BRICKGAME_API_HAS(api->table, flushHighScore) &&
+      api->table->flushHighScore) {
+    api->table->flushHighScore();
+  }
+}
+
 /**
  * @brief Инициализирует ncurses с оптимальными настройками.
  */
@@ -99,6 +135,79 @@ static void init_ncurses() {
   curs_set(0);
 }
 
+/**
+ * @brief Монотонное время в миллисекундах.
+ */
+static uint64_t monotonic_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+}
+
+/**
+ * @brief Записывает результат завершённой партии в таблицу лидеров.
+ *
+ * Файл таблицы — "<id>_leaderboard.dat" в каталоге
+ * BRICKGAME_LEADERBOARD_DIR (по умолчанию текущий).
+ *
+ * @param api Структура API игры
+ * @param info Последний кадр партии
+ * @param started_ms Момент старта партии (monotonic_ms)
+ */
+static void record_result(const GameAPI* api, const GameInfo_t* info,
+                          uint64_t started_ms) {
+  TraceSpan span = trace_begin("leaderboard.write", "io");
+  const char* dir = getenv("BRICKGAME_LEADERBOARD_DIR");
+  char path[512];
+  snprintf(path, sizeof(path), "%s/%s_leaderboard.dat", dir ? dir : ".",
+           api->table->id);
+
+  Leaderboard* board = leaderboard_open(path, LEADERBOARD_DEFAULT_CAPACITY);
+  if (!board) {
+    trace_end(&span);
+    return;
+  }
+
+  const char* player = getenv("USER");
+  LeaderboardRecord record;
+  leaderboard_record_init(&record, player ? player : "player", info->score,
+                          info->level,
+                          (uint32_t)(monotonic_ms() - started_ms), 0);
+  leaderboard_submit(board, &record);
+  leaderboard_close(board);
+  trace_end(&span);
+}
+
+/**
+ * @brief Учитывает действие в состоянии сессии фронтенда.
+ *
+ * @param action Действие пользователя
+ * @param paused Игра на паузе
+ * @param started Партия начата
+ * @param recorded Результат партии записан
+ * @param started_ms Момент старта партии
+ * @return false для Terminate (выход из цикла)
+ */
+static bool track_session(UserAction_t action, bool* paused, bool* started,
+                          bool* recorded, uint64_t* started_ms) {
+  switch (action) {
+    case Pause:
+      *paused = !*paused;
+      break;
+    case Start:
+      /* Start после окончания партии начинает новую. */
+      if (!*started || *recorded) *started_ms = monotonic_ms();
+      *started = true;
+      *recorded = false;
+      break;
+    case Terminate:
+      return false;
+    default:
+      break;
+  }
+  return true;
+}
+
 /**
  * @brief Основной игровой цикл.
  *
@@ -109,68 +218,195 @@ static void game_loop(GameAPI api, GameType game_type) {
   bool running = true;
   bool paused = false;
   bool started = false;
+  bool recorded = false;
+  uint64_t started_ms = 0;
+  uint64_t last_frame_ms = monotonic_ms();
 
   while (running) {
-    bool hold = false;
-    UserAction_t action = read_input(&hold, game_type);
-
-    switch (action) {
-      case Pause:
-        paused = !paused;
-        break;
-      case Start:
-        started = true;
-        break;
-      case Terminate:
+    TraceSpan input_span = trace_begin("input", "input");
+    InputFrame input;
+    read_inputs(&input, game_type);
+    for (int i = 0; i < input.count && running; ++i) {
+      UserAction_t action = input.events[i].action;
+      if (!track_session(action, &paused, &started, &recorded, &started_ms)) {
         running = false;
-        continue;
-      default:
-        break;
+      } else {
+        api.userInput(action, input.events[i].hold);
+      }
     }
+    trace_end(&input_span);
+    if (!running) break;
 
-    api.userInput(action, hold);
-
-    GameInfo_t info = api.updateState();
+    /* Игры с advance идут по реальному времени при постоянном кадре,
+     * остальные — тик за итерацию с интервалом info.speed. */
+    TraceSpan tick_span = trace_begin("tick", "engine");
+    uint64_t now = monotonic_ms();
+    GameInfo_t info = api.advance ? api.advance((int)(now - last_frame_ms))
+                                  : api.updateState();
+    last_frame_ms = now;
+    trace_end(&tick_span);
 
+    TraceSpan render_span = trace_begin("render", "render");
     if (!started) {
       renderStartScreen();
     } else if (api.isOver()) {
+      if (!recorded) {
+        record_result(&api, &info, started_ms);
+        game_api_flush_high_score(&api);
+      }
+      recorded = true;
       flushinp();
       renderGameOverScreen();
     } else if (!paused) {
-      flushinp();
       render_game(&info);
     }
+    trace_end(&render_span);
 
-    napms(info.speed);
+    napms(api.advance ? GAME_FRAME_MS : info.speed);
 
-    if (game_type == GAME_SNAKE && api.freeGameInfo) {
+    if (game_api_caller_frees_info(&api)) {
       api.freeGameInfo(&info);
     }
   }
 }
 
+/**
+ * @brief Игровой цикл фронтенда при движке в отдельном процессе.
+ *
+ * Ввод отправляется в очередь кольца, отрисовывается последний
+ * опубликованный кадр.
+ *
+ * @param api Структура API игры (для записи результата)
+ * @param ring Кольцо кадров, общее с процессом движка
+ * @param game_type Тип игры для передачи в input
+ */
+static void game_loop_remote(const GameAPI* api, FrameRing* ring,
+                             GameType game_type) {
+  bool running = true;
+  bool paused = false;
+  bool started = false;
+  bool recorded = false;
+  uint64_t started_ms = 0;
+  uint64_t start_seq = 0;
+  uint64_t last_seq = UINT64_MAX;
+
+  while (running) {
+    TraceSpan input_span = trace_begin("input", "input");
+    InputFrame input;
+    read_inputs(&input, game_type);
+    for (int i = 0; i < input.count && running; ++i) {
+      UserAction_t action = input.events[i].action;
+      if (!track_session(action, &paused, &started, &recorded, &started_ms)) {
+        running = false;
+        continue;
+      }
+      frame_ring_push_input(ring, action, input.events[i].hold);
+      if (action == Start) start_seq = frame_ring_frames(ring);
+    }
+    trace_end(&input_span);
+    if (!running) break;
+
+    TraceSpan render_span = trace_begin("render", "render");
+    FrameRingView view;
+    if (!started) {
+      renderStartScreen();
+    } else if (frame_ring_read_latest(ring, &view) && view.seq != last_seq) {
+      if (view.game_over) {
+        /* Кадры до обработки Start ещё могут нести старый game over. */
+        if (!recorded && view.seq > start_seq) {
+          record_result(api, &view.info, started_ms);
+          recorded = true;
+        }
+        flushinp();
+        renderGameOverScreen();
+      } else if (!paused) {
+        render_game(&view.info);
+      }
+      /* Кадр перезаписан во время отрисовки — перерисуем на следующей
+       * итерации. */
+      last_seq = frame_ring_view_valid(&view) ? view.seq : UINT64_MAX;
+    }
+    trace_end(&render_span);
+
+    napms(ENGINE_PROCESS_POLL_MS);
+  }
+}
+
+/**
+ * @brief Запускает движок в дочернем процессе и цикл отрисовки в текущем.
+ *
+ * @param api Структура API загруженной игры
+ * @param game_type Тип игры
+ * @return false, если не удалось создать кольцо или процесс
+ */
+static bool run_split_process(GameAPI api, GameType game_type) {
+  const char* ring_name = engine_process_ring_name();
+  FrameRing* ring = frame_ring_create(ring_name, api.table->field_width,
+                                      api.table->field_height, 4);
+  if (!ring) return false;
+
+  pid_t parent = getpid();
+  pid_t pid = fork();
+  if (pid < 0) {
+    frame_ring_close(ring, true);
+    return false;
+  }
+  if (pid == 0) {
+    trace_after_fork();
+    engine_process_run(api, ring, parent);
+    trace_stop();
+    _exit(0);
+  }
+
+  game_loop_remote(&api, ring, game_type);
+
+  frame_ring_request_shutdown(ring);
+  waitpid(pid, NULL, 0);
+  frame_ring_close(ring, true);
+  return true;
+}
+
 /**
  * @brief Запускает приложение BrickGame.
  *
  * Инициализирует ncurses, показывает меню выбора игры,
  * загружает соответствующую библиотеку и запускает игровой цикл.
+ * Если задана переменная BRICKGAME_TRACE, временная шкала кадров
+ * сохраняется в указанный файл (движок в отдельном процессе пишет
+ * "<файл>.<pid>").
  */
 void run_app(void) {
+  trace_start_from_env();
+  trace_set_thread_name("cli");
   init_ncurses();
 
-  GameType selected_game = render_game_selection();
-
-  GameAPI api = load_game_lib(selected_game);
-  if (!api.valid) {
-    render_loading_error(api.error);
+  const char* plugin_dir = getenv("BRICKGAME_PLUGIN_DIR");
+  BrickGamePlugin plugins[BRICKGAME_MAX_PLUGINS];
+  int count = plugin_scan_all(plugin_dir ? plugin_dir : ".", plugins,
+                              BRICKGAME_MAX_PLUGINS);
+  if (count == 0) {
+    render_loading_error("No game plugins found");
     endwin();
-    unload_game_lib(api);
+    trace_stop();
     return;
   }
 
-  game_loop(api, selected_game);
+  int selected = render_game_selection(plugins, count);
+  for (int i = 0; i < count; ++i) {
+    if (i != selected) plugin_unload(&plugins[i]);
+  }
+  plugin_start(&plugins[selected]);
+
+  GameAPI api = game_api_from_plugin(&plugins[selected]);
+  GameType game_type = game_type_for_api(&api);
+  render_set_field_size(api.table->field_width, api.table->field_height);
 
+  if (!engine_process_enabled() || !run_split_process(api, game_type)) {
+    game_loop(api, game_type);
+  }
+
+  render_shutdown();
   endwin();
   unload_game_lib(api);
-}
\ No newline at end of file
+  trace_stop();
+}
@@ -0,0 +1,129 @@
+/**
+ * @file engine_process.c
+ * @brief Цикл движка, работающего в отдельном процессе.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "../../include/gui/cli/engine_process.h"
+
+#include "../../include/brickgame/common/trace.h"
+
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+/// Взводится по SIGTERM: цикл движка завершается на ближайшей проверке.
+static volatile sig_atomic_t terminate_requested;
+
+bool engine_process_enabled(void) {
+  const char* value = getenv("BRICKGAME_ENGINE_PROCESS");
+  return value && *value && strcmp(value, "0") != 0;
+}
+
+const char* engine_process_ring_name(void) {
+  const char* value = getenv("BRICKGAME_FRAME_RING");
+  return (value && *value == '/') ? value : NULL;
+}
+
+/**
+ * @brief Засыпает на заданное число миллисекунд.
+ */
+static void sleep_ms(int ms) {
+  if (ms <= 0) return;
+  struct timespec ts;
+  ts.tv_sec = ms / 1000;
+  ts.tv_nsec = (long)(ms % 1000) * 1000000L;
+  nanosleep(&ts, NULL);
+}
+
+/**
+ * @brief Монотонное время в миллисекундах.
+ */
+static uint64_t monotonic_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+}
+
+static void on_terminate(int signo) {
+  (void)signo;
+  terminate_requested = 1;
+}
+
+/**
+ * @brief Подписывает процесс на смерть родителя.
+ *
+ * На Linux ядро пришлёт SIGTERM, когда родитель завершится; обработчик
+ * лишь взводит флаг, чтобы движок успел записать рекорд. Повторная
+ * проверка getppid() закрывает гонку: родитель мог умереть между fork()
+ * и prctl(). На других системах остаётся опрос getppid() в цикле.
+ */
+static void watch_parent(pid_t parent) {
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = on_terminate;
+  sigemptyset(&sa.sa_mask);
+  sigaction(SIGTERM, &sa, NULL);
+#ifdef __linux__
+  prctl(PR_SET_PDEATHSIG, SIGTERM);
+#endif
+  if (getppid() != parent) terminate_requested = 1;
+}
+
+/**
+ * @brief Продолжать ли цикл: фронтенд жив и не просил завершения.
+ */
+static bool engine_should_run(FrameRing* ring, pid_t parent) {
+  return !terminate_requested && getppid() == parent &&
+         !frame_ring_shutdown_requested(ring);
+}
+
+void engine_process_run(GameAPI api, FrameRing* ring, pid_t parent) {
+  uint64_t last_frame_ms = monotonic_ms();
+  bool was_over = false;
+  trace_set_thread_name("engine");
+  watch_parent(parent);
+  while (engine_should_run(ring, parent)) {
+    TraceSpan input_span = trace_begin("input.drain", "input");
+    UserAction_t action;
+    bool hold;
+    while (frame_ring_pop_input(ring, &action, &hold)) {
+      api.userInput(action, hold);
+    }
+    trace_end(&input_span);
+
+    TraceSpan tick_span = trace_begin("tick", "engine");
+    uint64_t now = monotonic_ms();
+    GameInfo_t info = api.advance ? api.advance((int)(now - last_frame_ms))
+                                  : api.updateState();
+    last_frame_ms = now;
+    trace_end(&tick_span);
+
+    TraceSpan snapshot_span = trace_begin("snapshot", "engine");
+    bool over = api.isOver();
+    frame_ring_publish(ring, &info, over);
+    trace_end(&snapshot_span);
+    /* Рекорд пишется один раз в конце партии, а не внутри тика. */
+    if (over && !was_over) game_api_flush_high_score(&api);
+    was_over = over;
+    int delay = api.advance ? GAME_FRAME_MS : info.speed;
+
+    if (game_api_caller_frees_info(&api)) {
+      api.freeGameInfo(&info);
+    }
+
+    /* Спим короткими интервалами, чтобы быстро реагировать на выход. */
+    if (delay <= 0) delay = ENGINE_PROCESS_POLL_MS;
+    while (delay > 0 && engine_should_run(ring, parent)) {
+      int step = delay < ENGINE_PROCESS_POLL_MS ? delay : ENGINE_PROCESS_POLL_MS;
+      sleep_ms(step);
+      delay -= step;
+    }
+  }
+  game_api_flush_high_score(&api);
+}
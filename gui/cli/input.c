@@ -1,68 +1,123 @@
 /**
  * @brief Считывает пользовательский ввод с клавиатуры (ncurses)
- *        и преобразует его в действие игры.
+ *        и преобразует его в действия игры.
  *
- * Функция обрабатывает нажатия клавиш и возвращает соответствующее
- * значение перечисления UserAction_t для дальнейшей обработки в FSM.
- * Поддерживаются стандартные клавиши управления, пауза, выход и старт.
- * Для Snake поддерживается удержание клавиш для ускорения.
- *
- * @param hold Указатель на флаг удержания клавиши.
- * @param game_type Тип игры (GAME_TETRIS или GAME_SNAKE), влияет на поведение
- * по умолчанию.
- *
- * @return UserAction_t — действие пользователя (Left, Right, Down, Up, Action,
- * Pause, Terminate, Start).
+ * За вызов из буфера терминала забираются все нажатия, и каждое
+ * становится отдельным действием UserAction_t для FSM. Поддерживаются
+ * стандартные клавиши управления, пауза, выход и старт. Для Snake
+ * удержание клавиши (автоповтор) включает ускорение.
  */
+#define _POSIX_C_SOURCE 200809L
+
 #include "../../include/gui/cli/input.h"
 
 #include <ncurses.h>
+#include <stdint.h>
+#include <time.h>
 
-static int last_key = 0;
-static int key_repeat_count = 0;
-static int key_repeat_threshold = 3;
-
-UserAction_t read_input(bool *hold, GameType game_type) {
-  int ch = getch();
-  *hold = false;
-
-  if (ch == ERR) {
-    key_repeat_count = 0;
-    return (game_type == GAME_TETRIS) ? Up : Action;
-  }
+/**
+ * @brief Состояние последней нажатой клавиши.
+ */
+typedef struct {
+  int key;               /**< Код клавиши (ERR — нет) */
+  int repeats;           /**< Нажатий подряд без паузы */
+  uint64_t last_ms;      /**< Время последнего нажатия */
+  bool held;             /**< Клавиша считается зажатой */
+} KeyState;
 
-  if (ch == last_key) {
-    key_repeat_count++;
-  } else {
-    key_repeat_count = 1;
-    last_key = ch;
-  }
+static KeyState key_state = {ERR, 0, 0, false};
 
-  if (game_type == GAME_SNAKE && key_repeat_count >= key_repeat_threshold) {
-    *hold = true;
-  }
+/**
+ * @brief Монотонное время в миллисекундах.
+ */
+static uint64_t monotonic_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+}
 
+/**
+ * @brief Переводит код клавиши в действие.
+ * @return false для клавиш без действия
+ */
+static bool map_key(int ch, UserAction_t *action) {
   switch (ch) {
     case KEY_LEFT:
-      return Left;
+      *action = Left;
+      return true;
     case KEY_RIGHT:
-      return Right;
+      *action = Right;
+      return true;
     case KEY_DOWN:
-      return Down;
+      *action = Down;
+      return true;
     case KEY_UP:
-      return Up;
+      *action = Up;
+      return true;
     case ' ':
-      return Action;
+      *action = Action;
+      return true;
     case 'p':
     case 'P':
-      return Pause;
+      *action = Pause;
+      return true;
     case 'q':
     case 'Q':
-      return Terminate;
+      *action = Terminate;
+      return true;
     case 10:
     case KEY_ENTER:
-      return Start;
+      *action = Start;
+      return true;
     default:
-      return (game_type == GAME_TETRIS) ? Up : Action;
+      return false;
+  }
+}
+
+/**
+ * @brief Учитывает нажатие в состоянии клавиши.
+ * @return true, если клавиша теперь считается зажатой
+ */
+static bool track_key(int ch, uint64_t now) {
+  if (ch == key_state.key && now - key_state.last_ms < INPUT_RELEASE_MS) {
+    key_state.repeats++;
+  } else {
+    key_state.key = ch;
+    key_state.repeats = 1;
+  }
+  key_state.last_ms = now;
+  key_state.held = key_state.repeats >= INPUT_HOLD_REPEATS;
+  return key_state.held;
+}
+
+static void push_event(InputFrame *frame, UserAction_t action, bool hold) {
+  if (frame->count == INPUT_MAX_ACTIONS) return;
+  frame->events[frame->count].action = action;
+  frame->events[frame->count].hold = hold;
+  frame->count++;
+}
+
+int read_inputs(InputFrame *frame, GameType game_type) {
+  uint64_t now = monotonic_ms();
+  frame->count = 0;
+
+  int ch;
+  while ((ch = getch()) != ERR) {
+    UserAction_t action;
+    bool held = track_key(ch, now);
+    if (!map_key(ch, &action)) continue;
+
+    bool hold = game_type == GAME_SNAKE && held &&
+                (action == Left || action == Right || action == Up ||
+                 action == Down || action == Action);
+    push_event(frame, action, hold);
+  }
+
+  /* Автоповтор пропал — клавиша отпущена. */
+  if (key_state.held && now - key_state.last_ms >= INPUT_RELEASE_MS) {
+    key_state.held = false;
+    key_state.repeats = 0;
+    if (game_type == GAME_SNAKE) push_event(frame, Action, false);
   }
+  return frame->count;
 }
@@ -4,35 +4,90 @@
  *
  * Содержит функции отрисовки основного игрового экрана,
  * стартового экрана, границ, поля, информации и состояния паузы.
+ *
+ * Игровой экран рисуется либо через ncurses, либо (RENDER_BACKEND_ENV
+ * равна "ansi") собирается в один буфер ANSI-последовательностей и
+ * выводится одним write() (см. ansi_frame.h).
  */
 
 #include "../../include/gui/cli/render.h"
 
 #include <ncurses.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../../include/brickgame/common/ansi_frame.h"
+#include "../../include/brickgame/common/trace.h"
 
-#define FIELD_WIDTH 10
-#define FIELD_HEIGHT 20
 #define FIELD_OFFSET_X 2
 #define FIELD_OFFSET_Y 1
 #define SCREEN_CENTER_X 20
 #define SCREEN_CENTER_Y 10
 
+static int field_width = 10;   ///< Ширина поля выбранной игры
+static int field_height = 20;  ///< Высота поля выбранной игры
+static AnsiFrame ansi;         ///< Буфер кадра ANSI-вывода
+static bool ansi_enabled;      ///< Игровой экран выводится через ansi
+static int ansi_cols;          ///< Размер терминала при сборке кадра
+static int ansi_rows;
+
+void render_set_field_size(int width, int height) {
+  render_shutdown();
+  field_width = width;
+  field_height = height;
+
+  const char *backend = getenv(RENDER_BACKEND_ENV);
+  if (backend && strcmp(backend, "ansi") == 0) {
+    ansi_cols = COLS;
+    ansi_rows = LINES;
+    ansi_enabled = ansi_frame_init(&ansi, width, height, COLS, LINES);
+  }
+}
+
+void render_shutdown(void) {
+  if (ansi_enabled) ansi_frame_free(&ansi);
+  ansi_enabled = false;
+}
+
+/**
+ * @brief Экран нарисован через ncurses: кадр ANSI перерисуется целиком.
+ */
+static void invalidate_ansi(void) {
+  if (ansi_enabled) ansi_frame_invalidate(&ansi);
+}
+
+/**
+ * @brief Выводит игровой экран одним write().
+ */
+static void render_game_ansi(const GameInfo_t *info) {
+  if (COLS != ansi_cols || LINES != ansi_rows) {
+    ansi_cols = COLS;
+    ansi_rows = LINES;
+    ansi_frame_resize(&ansi, COLS, LINES);
+  }
+  ansi_frame_compose(&ansi, info);
+  TraceSpan span = trace_begin("render.write", "render");
+  ansi_frame_flush(&ansi, STDOUT_FILENO);
+  trace_end(&span);
+}
+
 /**
  * @brief Очищает экран и рисует границы поля.
  */
 void drawFieldBorders() {
-  for (int y = 0; y <= FIELD_HEIGHT; ++y) {
+  for (int y = 0; y <= field_height; ++y) {
     mvprintw(FIELD_OFFSET_Y + y, FIELD_OFFSET_X - 1, "|");
-    mvprintw(FIELD_OFFSET_Y + y, FIELD_OFFSET_X + FIELD_WIDTH * 2, "|");
+    mvprintw(FIELD_OFFSET_Y + y, FIELD_OFFSET_X + field_width * 2, "|");
   }
-  for (int x = 0; x <= FIELD_WIDTH * 2; ++x) {
+  for (int x = 0; x <= field_width * 2; ++x) {
     mvprintw(FIELD_OFFSET_Y - 1, FIELD_OFFSET_X + x, "-");
-    mvprintw(FIELD_OFFSET_Y + FIELD_HEIGHT, FIELD_OFFSET_X + x, "-");
+    mvprintw(FIELD_OFFSET_Y + field_height, FIELD_OFFSET_X + x, "-");
   }
   mvprintw(FIELD_OFFSET_Y - 1, FIELD_OFFSET_X - 1, "+");
-  mvprintw(FIELD_OFFSET_Y - 1, FIELD_OFFSET_X + FIELD_WIDTH * 2, "+");
-  mvprintw(FIELD_OFFSET_Y + FIELD_HEIGHT, FIELD_OFFSET_X - 1, "+");
-  mvprintw(FIELD_OFFSET_Y + FIELD_HEIGHT, FIELD_OFFSET_X + FIELD_WIDTH * 2,
+  mvprintw(FIELD_OFFSET_Y - 1, FIELD_OFFSET_X + field_width * 2, "+");
+  mvprintw(FIELD_OFFSET_Y + field_height, FIELD_OFFSET_X - 1, "+");
+  mvprintw(FIELD_OFFSET_Y + field_height, FIELD_OFFSET_X + field_width * 2,
            "+");
 }
 
@@ -42,33 +97,40 @@ void drawFieldBorders() {
  * @param info Указатель на структуру GameInfo_t
  */
 void render_game(const GameInfo_t *info) {
+  if (ansi_enabled) {
+    render_game_ansi(info);
+    return;
+  }
+
   mvprintw(0, 0, "field ptr: %p", (void *)info->field);
   mvprintw(1, 0, "score: %d", info->score);
 
   clear();
   drawFieldBorders();
 
-  for (int y = 0; y < FIELD_HEIGHT; ++y) {
-    for (int x = 0; x < FIELD_WIDTH; ++x) {
+  for (int y = 0; y < field_height; ++y) {
+    for (int x = 0; x < field_width; ++x) {
       mvprintw(FIELD_OFFSET_Y + y, FIELD_OFFSET_X + x * 2, "%s",
                info->field && info->field[y][x] ? "[]" : "  ");
     }
   }
 
+  int panel_x = FIELD_OFFSET_X + field_width * 2 + 3;
   if (info->next) {
-    mvprintw(1, 25, "Next:");
+    mvprintw(1, panel_x, "Next:");
     for (int y = 0; y < 4; ++y) {
       for (int x = 0; x < 4; ++x) {
-        mvprintw(2 + y, 25 + x * 2, "%s", info->next[y][x] ? "[]" : "  ");
+        mvprintw(2 + y, panel_x + x * 2, "%s",
+                 info->next[y][x] ? "[]" : "  ");
       }
     }
   }
 
-  mvprintw(8, 25, "Score: %d", info->score);
-  mvprintw(9, 25, "High:  %d", info->high_score);
-  mvprintw(10, 25, "Level: %d", info->level);
+  mvprintw(8, panel_x, "Score: %d", info->score);
+  mvprintw(9, panel_x, "High:  %d", info->high_score);
+  mvprintw(10, panel_x, "Level: %d", info->level);
 
-  mvprintw(12, 25, "Speed: %d", info->speed);
+  mvprintw(12, panel_x, "Speed: %d", info->speed);
 
   refresh();
 }
@@ -77,6 +139,7 @@ void render_game(const GameInfo_t *info) {
  * @brief Отображает стартовый экран с правилами управления.
  */
 void renderStartScreen() {
+  invalidate_ansi();
   clear();
 
   mvprintw(SCREEN_CENTER_Y - 5, SCREEN_CENTER_X - 4, "BRICKGAME");
@@ -95,6 +158,7 @@ void renderStartScreen() {
   refresh();
 }
 void renderGameOverScreen() {
+  invalidate_ansi();
   clear();
   mvprintw(SCREEN_CENTER_Y - 5, SCREEN_CENTER_X - 8, "=== GAME OVER ===");
   mvprintw(SCREEN_CENTER_Y - 2, SCREEN_CENTER_X - 11, "Press ENTER to restart");
@@ -102,6 +166,7 @@ void renderGameOverScreen() {
   refresh();
 }
 void renderGameWonScreen() {
+  invalidate_ansi();
   clear();
   mvprintw(SCREEN_CENTER_Y - 5, SCREEN_CENTER_X - 8, "=== YOU WON! ===");
   mvprintw(SCREEN_CENTER_Y - 2, SCREEN_CENTER_X - 11, "Press ENTER to restart");
@@ -110,24 +175,27 @@ void renderGameWonScreen() {
 }
 
 /**
- * @brief Отображает экран выбора игры и возвращает выбранную игру.
+ * @brief Отображает экран выбора игры и возвращает индекс выбранной.
  */
-GameType render_game_selection() {
+int render_game_selection(const BrickGamePlugin *plugins, int count) {
+  if (count > 9) count = 9;
+
   clear();
   mvprintw(SCREEN_CENTER_Y - 5, SCREEN_CENTER_X - 4,
            "===== BRICKGAME COLLECTION =====");
   mvprintw(7, 12, "Select a game:");
-  mvprintw(9, 14, "1 - Tetris");
-  mvprintw(10, 14, "2 - Snake");
-  mvprintw(12, 12, "Press 1 or 2 to select");
+  for (int i = 0; i < count; ++i) {
+    mvprintw(9 + i, 14, "%d - %s", i + 1, plugins[i].api->name);
+  }
+  mvprintw(10 + count, 12, "Press 1-%d to select", count);
   refresh();
 
   int ch = 0;
-  while (ch != '1' && ch != '2') {
+  while (ch < '1' || ch >= '1' + count) {
     ch = getch();
   }
 
-  return (ch == '1') ? GAME_TETRIS : GAME_SNAKE;
+  return ch - '1';
 }
 
 /**
@@ -6,37 +6,69 @@
 #include "../../include/gui/desktop/gamecontroller.h"
 
 #include <QDebug>
+#include <QDir>
+
+#include "../../include/brickgame/common/frame_stats.h"
+#include "../../include/brickgame/common/leaderboard.h"
+#include "../../include/brickgame/common/trace.h"
 
 GameController::GameController(QObject* parent)
     : QObject(parent),
       m_libraryLoader(std::make_unique<LibraryLoader>(this)),
       m_inputHandler(std::make_unique<InputHandler>(this)),
       m_timerManager(std::make_unique<TimerManager>(this)),
+      m_simulation(std::make_unique<SimulationThread>()),
       m_currentGameType(GameType::TETRIS),
-      m_wasPaused(false) {
+      m_wasPaused(false),
+      m_started(false),
+      m_gameOverHandled(false),
+      m_startSeq(0) {
+  frame_stats_init(&m_frameStats, kFrameIntervalMs * 1000);
   setupConnections();
 }
 
-GameController::~GameController() { unloadGame(); }
+GameController::~GameController() {
+  unloadGame();
+  m_simulation->tickStats(m_frameStats);
+  QByteArray statsPath = qgetenv(FRAME_STATS_ENV);
+  if (!statsPath.isEmpty() &&
+      !frame_stats_dump(&m_frameStats, statsPath.constData())) {
+    qWarning() << "Failed to write frame stats to" << statsPath;
+  }
+}
 
-bool GameController::loadGame(GameType gameType) {
+bool GameController::loadGame(const QString& gameId) {
   unloadGame();
 
-  m_currentGameType = gameType;
-  m_inputHandler->setGameType(gameType);
   m_wasPaused = false;
+  m_started = false;
+  m_gameOverHandled = false;
+  m_snapshot.valid = false;
 
-  return m_libraryLoader->loadGame(gameType);
+  if (!m_libraryLoader->loadGame(gameId)) {
+    return false;
+  }
+  m_currentGameType =
+      LibraryLoader::gameTypeFor(m_libraryLoader->getAPI().table);
+  m_inputHandler->setGameType(m_currentGameType);
+  if (!m_simulation->start(m_libraryLoader->getAPI())) {
+    qWarning() << "Failed to start the simulation thread";
+    m_libraryLoader->unloadGame();
+    return false;
+  }
+  m_timerManager->start(kFrameIntervalMs);
+  return true;
 }
 
 void GameController::unloadGame() {
   m_timerManager->stop();
+  m_simulation->stop();
   m_inputHandler->clear();
   m_libraryLoader->unloadGame();
 }
 
 void GameController::handleKeyPress(int key) {
-  m_inputHandler->handleKeyPress(key, m_libraryLoader.get());
+  m_inputHandler->handleKeyPress(key, m_simulation.get());
 }
 
 void GameController::handleKeyRelease(int key) {
@@ -47,49 +79,29 @@ void GameController::handleKeyReleased(int key) {
   if (m_currentGameType == GameType::SNAKE) {
     UserAction_t action = m_inputHandler->mapKeyToAction(key);
     if (action == Up || action == Down || action == Left || action == Right) {
-      if (m_libraryLoader->isLoaded()) {
-        GameAPI api = m_libraryLoader->getAPI();
-        api.userInput(Action, false);
-      }
+      m_simulation->pushInput(Action, false);
     }
   }
 }
 
 void GameController::handleAction(UserAction_t action) {
-  if (!m_libraryLoader->isLoaded()) {
+  if (!m_simulation->isRunning()) {
     return;
   }
 
-  GameAPI api = m_libraryLoader->getAPI();
-
   switch (action) {
     case Start:
-      api.userInput(Start, false);
-      m_timerManager->start();
-      updateGameState();
+      m_simulation->pushInput(Start, false);
+      beginGame();
       break;
 
-    case Pause: {
-      api.userInput(Pause, false);
-
-      GameInfo_t currentState = api.updateCurrentState();
-
-      if (currentState.pause && !m_wasPaused) {
-        m_timerManager->stop();
-        emit gamePaused();
-        m_wasPaused = true;
-      } else if (!currentState.pause && m_wasPaused) {
-        m_timerManager->start();
-        emit gameResumed();
-        m_wasPaused = false;
-      }
-
-      emit gameStateChanged(currentState);
+    case Pause:
+      // Переход в паузу и обратно виден по следующему кадру (updateGame).
+      m_simulation->pushInput(Pause, false);
       break;
-    }
 
     case Terminate:
-      api.userInput(Terminate, false);
+      m_simulation->pushInput(Terminate, false);
       m_timerManager->stop();
       emit applicationCloseRequested();
       break;
@@ -100,65 +112,71 @@ void GameController::handleAction(UserAction_t action) {
 }
 
 GameInfo_t GameController::getCurrentState() const {
-  if (!m_libraryLoader->isLoaded()) {
+  if (!m_snapshot.valid) {
     GameInfo_t empty = {0};
     return empty;
   }
-  GameAPI api = m_libraryLoader->getAPI();
-  return api.updateCurrentState();
+  return m_snapshot.info;
 }
 
 bool GameController::isGameOver() const {
-  if (!m_libraryLoader->isLoaded()) return false;
-  GameAPI api = m_libraryLoader->getAPI();
-  return api.isOver();
+  return m_snapshot.valid && m_snapshot.gameOver;
 }
 
 bool GameController::isGameStarted() const {
-  if (!m_libraryLoader->isLoaded()) return false;
-  GameAPI api = m_libraryLoader->getAPI();
-  GameInfo_t state = api.updateCurrentState();
-  bool result = !state.pause && !api.isOver();
-  return result;
+  return m_started && m_snapshot.valid && !m_snapshot.info.pause &&
+         !m_snapshot.gameOver;
 }
 
 bool GameController::isGamePaused() const {
-  if (!m_libraryLoader->isLoaded()) return false;
-  GameAPI api = m_libraryLoader->getAPI();
-  GameInfo_t state = api.updateCurrentState();
-  bool result = state.pause;
-  return result;
+  return m_snapshot.valid && m_snapshot.info.pause;
 }
 
 GameType GameController::getCurrentGameType() const {
   return m_currentGameType;
 }
 
+FrameStats* GameController::frameStats() { return &m_frameStats; }
+
 void GameController::updateGame() {
-  if (!m_libraryLoader->isLoaded()) {
+  if (!m_simulation->isRunning()) {
     return;
   }
 
-  try {
-    GameAPI api = m_libraryLoader->getAPI();
-    GameInfo_t currentState = api.updateCurrentState();
+  TraceScope frameScope("frame", "controller");
+  if (!m_simulation->latestFrame(m_snapshot)) {
+    return;
+  }
 
-    if (!currentState.field) {
-      return;
-    }
+  // Темп тиков измеряет поток симуляции; здесь берётся его копия для
+  // оверлея (опрос раз в kFrameIntervalMs мерил бы биения таймеров).
+  m_simulation->tickStats(m_frameStats);
 
-    if (currentState.speed != m_timerManager->getInterval()) {
-      m_timerManager->setInterval(currentState.speed);
-    }
+  if (!m_started) {
+    return;
+  }
+
+  const GameInfo_t& currentState = m_snapshot.info;
+  if (currentState.pause && !m_wasPaused) {
+    m_wasPaused = true;
+    emit gamePaused();
+  } else if (!currentState.pause && m_wasPaused) {
+    m_wasPaused = false;
+    emit gameResumed();
+  }
 
+  {
+    TraceScope snapshotScope("snapshot", "controller");
     emit gameStateChanged(currentState);
+  }
 
-    if (api.isOver()) {
-      m_timerManager->stop();
-      emit gameOver();
-    }
-  } catch (...) {
-    m_timerManager->stop();
+  // Кадры, опубликованные до обработки Start, ещё могут нести старый
+  // game over.
+  if (m_snapshot.gameOver && !m_gameOverHandled &&
+      m_snapshot.seq > m_startSeq) {
+    m_gameOverHandled = true;
+    recordResult(currentState);
+    emit gameOver();
   }
 }
 
@@ -172,41 +190,58 @@ void GameController::setupConnections() {
           &GameController::updateGame);
 }
 
-void GameController::updateGameState() {
-  if (m_libraryLoader->isLoaded()) {
-    GameAPI api = m_libraryLoader->getAPI();
-    GameInfo_t initialState = api.updateCurrentState();
-    if (initialState.field) {
-      emit gameStateChanged(initialState);
-    }
-  }
+void GameController::beginGame() {
+  m_gameClock.start();
+  m_startSeq = m_simulation->frames();
+  m_started = true;
+  m_gameOverHandled = false;
+  m_wasPaused = false;
+}
+
+void GameController::recordResult(const GameInfo_t& state) {
+  const GameAPI api = m_libraryLoader->getAPI();
+  if (!api.table) return;
+
+  TraceScope scope("leaderboard.write", "io");
+  QString dir = qEnvironmentVariable("BRICKGAME_LEADERBOARD_DIR", ".");
+  QByteArray path =
+      QDir(dir).filePath(QString("%1_leaderboard.dat").arg(api.table->id))
+          .toLocal8Bit();
+
+  Leaderboard* board =
+      leaderboard_open(path.constData(), LEADERBOARD_DEFAULT_CAPACITY);
+  if (!board) return;
+
+  QByteArray player = qEnvironmentVariable("USER", "player").toLocal8Bit();
+  LeaderboardRecord record;
+  leaderboard_record_init(
+      &record, player.constData(), state.score, state.level,
+      m_gameClock.isValid() ? static_cast<uint32_t>(m_gameClock.elapsed())
+                            : 0,
+      0);
+  leaderboard_submit(board, &record);
+  leaderboard_close(board);
 }
 
 void GameController::showGameSelection() { emit showGameSelectionRequested(); }
 
 void GameController::stopGame() {
-  if (m_libraryLoader->isLoaded()) {
-    GameAPI api = m_libraryLoader->getAPI();
-    api.userInput(Terminate, false);
-  }
+  m_simulation->pushInput(Terminate, false);
   m_timerManager->stop();
 }
 
 void GameController::closeApplication() { emit applicationCloseRequested(); }
 
 void GameController::handleRestartGame() {
-  if (m_libraryLoader->isLoaded()) {
-    GameAPI api = m_libraryLoader->getAPI();
-    GameInfo_t state = api.updateCurrentState();
-    api.userInput(Start, false);
-    m_timerManager->start();
-    updateGameState();
+  if (m_simulation->pushInput(Start, false)) {
+    beginGame();
+    m_timerManager->start(kFrameIntervalMs);
   }
 }
 
-void GameController::handleGameSelection(GameType gameType) {
-  if (loadGame(gameType)) {
-    emit gameSelected(gameType);
+void GameController::handleGameSelection(const QString& gameId) {
+  if (loadGame(gameId)) {
+    emit gameSelected(m_currentGameType);
   }
 }
 
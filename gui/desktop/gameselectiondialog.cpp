@@ -5,11 +5,11 @@
  * В этом файле реализованы методы GameSelectionDialog:
  *  - Конструктор: создаёт кнопки, заголовок и подключает сигналы к слотам.
  *  - Деструктор: освобождает ресурсы виджетов.
- *  - setupUI(): настраивает виджет диалога, размеры, стили кнопок и меток.
+ *  - setupUI(): настраивает виджет диалога, размеры, стили меток и
+ * создаёт кнопку на каждую игру из LibraryLoader::availablePlugins();
+ * нажатие испускает gameSelected(id) и закрывает диалог.
  *  - closeEvent(): обрабатывает закрытие окна и генерирует сигнал
  * dialogRejected().
- *  - Слоты onTetrisSelected и onSnakeSelected: испускают сигнал gameSelected()
- * и закрывают диалог.
  *
  * Данный файл тесно связан с QDialog и QWidgets и используется в Desktop GUI
  * версии игры для выбора режима игры перед стартом.
@@ -21,16 +21,8 @@
 #include <QCloseEvent>
 
 GameSelectionDialog::GameSelectionDialog(QWidget* parent)
-    : QDialog(parent),
-      m_tetrisButton(new QPushButton("Tetris", this)),
-      m_snakeButton(new QPushButton("Snake", this)),
-      m_titleLabel(new QLabel("Select a Game", this)) {
+    : QDialog(parent), m_titleLabel(new QLabel("Select a Game", this)) {
   setupUI();
-
-  connect(m_tetrisButton, &QPushButton::clicked, this,
-          &GameSelectionDialog::onTetrisSelected);
-  connect(m_snakeButton, &QPushButton::clicked, this,
-          &GameSelectionDialog::onSnakeSelected);
 }
 
 GameSelectionDialog::~GameSelectionDialog() {}
@@ -43,7 +35,7 @@ void GameSelectionDialog::closeEvent(QCloseEvent* event) {
 
 void GameSelectionDialog::setupUI() {
   setWindowTitle("Game Selection");
-  setFixedSize(300, 200);
+  setMinimumSize(300, 200);
   setModal(true);
   setStyleSheet(
       "QDialog { "
@@ -83,25 +75,24 @@ void GameSelectionDialog::setupUI() {
       "    background-color: #1e8449; "
       "}";
 
-  m_tetrisButton->setFixedSize(100, 40);
-  m_tetrisButton->setStyleSheet(buttonStyle);
-
-  m_snakeButton->setFixedSize(100, 40);
-  m_snakeButton->setStyleSheet(buttonStyle);
-
-  buttonLayout->addWidget(m_tetrisButton);
-  buttonLayout->addWidget(m_snakeButton);
+  const std::vector<BrickGamePlugin>& plugins =
+      LibraryLoader::availablePlugins();
+  if (plugins.empty()) {
+    m_titleLabel->setText("No game plugins found");
+  }
+  for (const BrickGamePlugin& plugin : plugins) {
+    QString gameId = QString::fromUtf8(plugin.api->id);
+    QPushButton* button =
+        new QPushButton(QString::fromUtf8(plugin.api->name), this);
+    button->setFixedSize(100, 40);
+    button->setStyleSheet(buttonStyle);
+    connect(button, &QPushButton::clicked, this, [this, gameId]() {
+      emit gameSelected(gameId);
+      accept();
+    });
+    buttonLayout->addWidget(button);
+  }
 
   mainLayout->addLayout(buttonLayout);
   mainLayout->addStretch();
 }
-
-void GameSelectionDialog::onTetrisSelected() {
-  emit gameSelected(GameType::TETRIS);
-  accept();
-}
-
-void GameSelectionDialog::onSnakeSelected() {
-  emit gameSelected(GameType::SNAKE);
-  accept();
-}
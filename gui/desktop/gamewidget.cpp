@@ -18,15 +18,24 @@
 
 #include "../../include/gui/desktop/gamewidget.h"
 
+#include <QElapsedTimer>
 #include <QFont>
 #include <QFontMetrics>
 #include <QPainter>
 #include <QtMath>
 
+#include "../../include/brickgame/common/trace.h"
+
 GameWidget::GameWidget(QWidget* parent)
     : QWidget(parent),
       m_currentGameType(GameType::TETRIS),
-      m_currentScreen(ScreenType::START) {
+      m_currentScreen(ScreenType::START),
+      m_frameStats(nullptr),
+      m_hudVisible(qEnvironmentVariableIsSet("BRICKGAME_HUD")),
+      m_renderMode(qEnvironmentVariable("BRICKGAME_RENDER") == "vector"
+                       ? RenderMode::VECTOR
+                       : RenderMode::RASTER),
+      m_boardImage(kGameWidth, kGameHeight, QImage::Format_RGB32) {
   setFocusPolicy(Qt::StrongFocus);
   setStyleSheet("QWidget { background-color: black; }");
 }
@@ -54,7 +63,27 @@ void GameWidget::showGameWonScreen() {
   update();
 }
 
+void GameWidget::setFrameStats(FrameStats* stats) { m_frameStats = stats; }
+
+void GameWidget::toggleHud() {
+  m_hudVisible = !m_hudVisible;
+  update();
+}
+
+void GameWidget::setRenderMode(RenderMode mode) {
+  m_renderMode = mode;
+  update();
+}
+
+void GameWidget::toggleRenderMode() {
+  setRenderMode(m_renderMode == RenderMode::RASTER ? RenderMode::VECTOR
+                                                   : RenderMode::RASTER);
+}
+
 void GameWidget::paintEvent(QPaintEvent* event) {
+  TraceScope scope("paint", "render");
+  QElapsedTimer paintClock;
+  paintClock.start();
   QPainter painter(this);
   painter.setRenderHint(QPainter::Antialiasing);
 
@@ -74,11 +103,88 @@ void GameWidget::paintEvent(QPaintEvent* event) {
       drawGameWonScreen(painter);
       break;
   }
+
+  if (m_frameStats) {
+    // Оверлей показывает уже накопленные кадры; свой кадр учитывается
+    // вместе с временем рисования оверлея.
+    if (m_hudVisible) drawHud(painter);
+    frame_stats_paint(m_frameStats,
+                      static_cast<uint64_t>(paintClock.nsecsElapsed() / 1000));
+  }
+}
+
+void GameWidget::drawHud(QPainter& painter) {
+  const int margin = 8;
+  const int histogramHeight = 48;
+  QRect panel(margin, margin, width() - 2 * margin,
+              3 * (histogramHeight + 22) + 30);
+
+  painter.save();
+  painter.setRenderHint(QPainter::Antialiasing, false);
+  painter.fillRect(panel, QColor(0, 0, 0, 190));
+  painter.setFont(QFont("Monospace", 9));
+  painter.setPen(Qt::white);
+
+  const FrameStats& stats = *m_frameStats;
+  painter.drawText(panel.left() + 6, panel.top() + 16,
+                   QString("target %1 ms  ticks %2  late %3  dropped %4")
+                       .arg(stats.target_us / 1000.0, 0, 'f', 1)
+                       .arg(stats.ticks)
+                       .arg(stats.late_ticks)
+                       .arg(stats.dropped_frames));
+
+  QRect area(panel.left() + 6, panel.top() + 24, panel.width() - 12,
+             histogramHeight + 16);
+  drawHistogram(painter, area, "paint", stats.paint, QColor(46, 204, 113));
+  area.translate(0, histogramHeight + 22);
+  drawHistogram(painter, area, "step", stats.step, QColor(52, 152, 219));
+  area.translate(0, histogramHeight + 22);
+  drawHistogram(painter, area, "jitter", stats.jitter, QColor(231, 76, 60));
+  painter.restore();
+}
+
+void GameWidget::drawHistogram(QPainter& painter, const QRect& area,
+                               const QString& title,
+                               const FrameHistogram& histogram,
+                               const QColor& color) {
+  auto ms = [](uint64_t us) { return QString::number(us / 1000.0, 'f', 2); };
+  painter.setPen(Qt::white);
+  painter.drawText(
+      area.left(), area.top() + 12,
+      QString("%1 p50 %2 p99 %3 max %4 ms")
+          .arg(title, ms(frame_histogram_percentile(&histogram, 0.5)),
+               ms(frame_histogram_percentile(&histogram, 0.99)),
+               ms(histogram.max_us)));
+
+  // Корзины и отдельный столбец переполнения справа.
+  const int bars = FRAME_HISTOGRAM_BUCKETS + 1;
+  QRect plot(area.left(), area.top() + 16, area.width(), area.height() - 16);
+  painter.fillRect(plot, QColor(255, 255, 255, 25));
+
+  uint64_t peak = frame_histogram_peak(&histogram);
+  if (peak == 0) return;
+  double barWidth = static_cast<double>(plot.width()) / bars;
+  for (int i = 0; i < bars; ++i) {
+    uint64_t value = i < FRAME_HISTOGRAM_BUCKETS ? histogram.buckets[i]
+                                                 : histogram.overflow;
+    if (value == 0) continue;
+    int barHeight = static_cast<int>(plot.height() * value / peak);
+    if (barHeight < 1) barHeight = 1;
+    QRectF bar(plot.left() + i * barWidth, plot.bottom() - barHeight + 1,
+               barWidth - 1, barHeight);
+    painter.fillRect(bar,
+                     i < FRAME_HISTOGRAM_BUCKETS ? color : QColor(241, 196, 15));
+  }
 }
 
 void GameWidget::drawGameField(QPainter& painter) {
   if (!m_currentState.field) return;
 
+  if (m_renderMode == RenderMode::RASTER) {
+    drawGameFieldRaster(painter);
+    return;
+  }
+
   drawBorders(painter);
 
   for (int y = 0; y < kGameHeight; ++y) {
@@ -93,6 +199,32 @@ void GameWidget::drawGameField(QPainter& painter) {
   }
 }
 
+void GameWidget::drawGameFieldRaster(QPainter& painter) {
+  const QRgb background = QColor(44, 62, 80).rgb();
+  const QRgb palette[] = {background, getCellColor(1).rgb(),
+                          getCellColor(2).rgb(), getCellColor(3).rgb()};
+
+  for (int y = 0; y < kGameHeight; ++y) {
+    QRgb* pixels = reinterpret_cast<QRgb*>(m_boardImage.scanLine(y));
+    const int* row = m_currentState.field[y];
+    for (int x = 0; x < kGameWidth; ++x) {
+      int value = row ? row[x] : 0;
+      pixels[x] = palette[value >= 0 && value < 3 ? value : 3];
+    }
+  }
+
+  QRect board(getCellRect(0, 0).topLeft(),
+              getCellRect(kGameWidth - 1, kGameHeight - 1).bottomRight());
+  painter.save();
+  painter.setRenderHint(QPainter::Antialiasing, false);
+  painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
+  painter.drawImage(board, m_boardImage);
+  painter.restore();
+
+  // Сетка поверх растра заменяет рамки ячеек векторного режима.
+  drawBorders(painter);
+}
+
 void GameWidget::drawStartScreen(QPainter& painter) {
   painter.setPen(Qt::white);
   painter.setFont(QFont("Arial", 28, QFont::Bold));
@@ -7,6 +7,8 @@
 
 #include <QDebug>
 
+#include "../../include/brickgame/common/trace.h"
+
 InputHandler::InputHandler(QObject* parent)
     : QObject(parent), m_currentGameType(GameType::TETRIS) {}
 
@@ -15,7 +17,8 @@ void InputHandler::setGameType(GameType gameType) {
   clear();
 }
 
-void InputHandler::handleKeyPress(int key, LibraryLoader* libraryLoader) {
+void InputHandler::handleKeyPress(int key, SimulationThread* simulation) {
+  TraceScope scope("input", "input");
   m_pressedKeys.insert(key);
 
   UserAction_t action = mapKeyToAction(key);
@@ -37,23 +40,20 @@ void InputHandler::handleKeyPress(int key, LibraryLoader* libraryLoader) {
     return;
   }
 
-  if (libraryLoader && libraryLoader->isLoaded()) {
+  if (simulation && simulation->isRunning()) {
     bool hold = false;
     if (m_currentGameType == GameType::SNAKE) {
       hold = m_pressedKeys.contains(key);
 
       if (action == Up || action == Down || action == Left || action == Right) {
-        GameAPI api = libraryLoader->getAPI();
-        api.userInput(action, hold);
+        simulation->pushInput(action, hold);
 
-        api.userInput(Action, hold);
+        simulation->pushInput(Action, hold);
       } else {
-        GameAPI api = libraryLoader->getAPI();
-        api.userInput(action, hold);
+        simulation->pushInput(action, hold);
       }
     } else {
-      GameAPI api = libraryLoader->getAPI();
-      api.userInput(action, hold);
+      simulation->pushInput(action, hold);
     }
   }
 }
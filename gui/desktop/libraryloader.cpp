@@ -8,93 +8,127 @@
 #include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
-#include <QFile>
-
-#ifdef Q_OS_MACOS
-#define LIBRARY_EXTENSION ".dylib"
-#elif defined(Q_OS_LINUX)
-#define LIBRARY_EXTENSION ".so"
-#elif defined(Q_OS_WIN)
-#define LIBRARY_EXTENSION ".dll"
-#else
-#define LIBRARY_EXTENSION ".so"
-#endif
+#include <algorithm>
+#include <cstring>
 
 LibraryLoader::LibraryLoader(QObject *parent) : QObject(parent) {}
 
 LibraryLoader::~LibraryLoader() { unloadGame(); }
 
-bool LibraryLoader::loadGame(GameType gameType) {
+bool LibraryLoader::loadGame(const QString &gameId) {
   unloadGame();
 
-  QString libraryPath = getLibraryPath(gameType);
-
-  m_api.lib_handle = dlopen(libraryPath.toUtf8().constData(), RTLD_LAZY);
-  if (!m_api.lib_handle) {
-    m_api.error = QString("Failed to load library: %1").arg(dlerror());
-    qDebug() << "Error loading library:" << m_api.error;
+  std::vector<BrickGamePlugin> &plugins = pluginCache();
+  int index = plugin_find(plugins.data(), static_cast<int>(plugins.size()),
+                          gameId.toUtf8().constData());
+  if (index < 0) {
+    m_api.error = QString("Game not found: %1").arg(gameId);
+    qDebug() << "Error loading game:" << m_api.error;
     return false;
   }
 
-  m_api.userInput =
-      (void (*)(UserAction_t, bool))dlsym(m_api.lib_handle, "userInput");
-  m_api.updateCurrentState =
-      (GameInfo_t(*)())dlsym(m_api.lib_handle, "updateCurrentState");
-  m_api.isOver = (bool (*)())dlsym(m_api.lib_handle, "isGameOver");
-  
-  // freeGameInfo доступна только для тетриса
-  if (gameType == GameType::TETRIS) {
-    m_api.freeGameInfo =
-        (void (*)(GameInfo_t *))dlsym(m_api.lib_handle, "freeGameInfo");
-  } else {
-    m_api.freeGameInfo = nullptr;
-  }
+  m_active = &plugins[index];
+  plugin_start(m_active);
+  adoptPlugin();
+  return true;
+}
 
-  if (!m_api.userInput || !m_api.updateCurrentState || !m_api.isOver) {
-    m_api.error = "Failed to load required functions";
-    qDebug() << "Error loading functions:" << m_api.error;
-    unloadGame();
+bool LibraryLoader::loadPlugin(const QString &libraryPath) {
+  unloadGame();
+
+  char error[256] = {0};
+  if (!plugin_load(libraryPath.toUtf8().constData(), &m_plugin, error,
+                   sizeof(error))) {
+    m_api.error = QString("Failed to load library: %1").arg(error);
+    qDebug() << "Error loading library:" << m_api.error;
     return false;
   }
 
-  m_api.valid = true;
-
+  m_active = &m_plugin;
+  adoptPlugin();
   return true;
 }
 
+void LibraryLoader::adoptPlugin() {
+  const BrickGameApi *table = m_active->api;
+  m_api.lib_handle = m_active->handle;
+  m_api.table = table;
+  m_api.userInput = table->userInput;
+  m_api.updateCurrentState = table->updateCurrentState;
+  m_api.isOver = table->isGameOver;
+  m_api.freeGameInfo = table->freeGameInfo;
+  if (BRICKGAME_API_HAS(table, advance) &&
+      (table->capabilities & BRICKGAME_CAP_TIMED_ADVANCE)) {
+    m_api.advance = table->advance;
+  }
+  m_api.valid = true;
+}
+
 void LibraryLoader::unloadGame() {
-  if (m_api.lib_handle) {
-    dlclose(m_api.lib_handle);
-    m_api.lib_handle = nullptr;
+  if (m_active == &m_plugin) {
+    plugin_unload(&m_plugin);
+  } else if (m_active) {
+    plugin_stop(m_active);
   }
+  m_active = nullptr;
 
+  m_api.lib_handle = nullptr;
+  m_api.table = nullptr;
   m_api.userInput = nullptr;
   m_api.updateCurrentState = nullptr;
   m_api.isOver = nullptr;
+  m_api.freeGameInfo = nullptr;
+  m_api.advance = nullptr;
   m_api.valid = false;
   m_api.error.clear();
 }
 
-QString LibraryLoader::getLibraryPath(GameType gameType) const {
-  QString libraryName;
-  switch (gameType) {
-    case GameType::TETRIS:
-      libraryName = "libtetris" LIBRARY_EXTENSION;
-      break;
-    case GameType::SNAKE:
-      libraryName = "libsnake" LIBRARY_EXTENSION;
-      break;
+QStringList LibraryLoader::pluginDirectories() {
+  QStringList dirs;
+  QByteArray custom = qgetenv("BRICKGAME_PLUGIN_DIR");
+  if (!custom.isEmpty()) {
+    dirs << QString::fromLocal8Bit(custom);
   }
+  dirs << QDir::currentPath() << QCoreApplication::applicationDirPath();
+  return dirs;
+}
 
-  QString currentPath = QDir::currentPath() + "/" + libraryName;
-  if (QFile::exists(currentPath)) {
-    return currentPath;
-  }
+const std::vector<BrickGamePlugin> &LibraryLoader::availablePlugins() {
+  return pluginCache();
+}
 
-  QString appPath = QCoreApplication::applicationDirPath() + "/" + libraryName;
-  if (QFile::exists(appPath)) {
-    return appPath;
-  }
+std::vector<BrickGamePlugin> &LibraryLoader::pluginCache() {
+  static std::vector<BrickGamePlugin> plugins = [] {
+    std::vector<BrickGamePlugin> found(BRICKGAME_MAX_PLUGINS);
+    int count = plugin_scan_builtin(found.data(), BRICKGAME_MAX_PLUGINS);
+
+    for (const QString &dir : pluginDirectories()) {
+      BrickGamePlugin scanned[BRICKGAME_MAX_PLUGINS];
+      int scannedCount = plugin_scan(dir.toUtf8().constData(), scanned,
+                                     BRICKGAME_MAX_PLUGINS);
+      for (int i = 0; i < scannedCount; ++i) {
+        if (count < BRICKGAME_MAX_PLUGINS &&
+            plugin_find(found.data(), count, scanned[i].api->id) < 0) {
+          found[count++] = scanned[i];
+        } else {
+          plugin_unload(&scanned[i]);
+        }
+      }
+    }
+
+    found.resize(count);
+    std::sort(found.begin(), found.end(),
+              [](const BrickGamePlugin &a, const BrickGamePlugin &b) {
+                return std::strcmp(a.api->name, b.api->name) < 0;
+              });
+    return found;
+  }();
+  return plugins;
+}
 
-  return libraryName;
+GameType LibraryLoader::gameTypeFor(const BrickGameApi *table) {
+  if (table && (table->capabilities & BRICKGAME_CAP_HOLD_ACCELERATE)) {
+    return GameType::SNAKE;
+  }
+  return GameType::TETRIS;
 }
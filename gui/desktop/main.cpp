@@ -9,6 +9,7 @@
 #include <QApplication>
 #include <QStyleFactory>
 
+#include "../../include/brickgame/common/trace.h"
 #include "../../include/gui/desktop/mainwindow.h"
 /**
  * @brief Основная функция приложения.
@@ -17,13 +18,18 @@
  * @return Код завершения приложения
  *
  * Создает QApplication, главное окно MainWindow, показывает его и запускает
- * цикл обработки событий.
+ * цикл обработки событий. Если задана переменная BRICKGAME_TRACE,
+ * временная шкала кадров сохраняется в указанный файл при выходе.
  */
 int main(int argc, char *argv[]) {
   QApplication app(argc, argv);
+  trace_start_from_env();
+  trace_set_thread_name("gui");
 
   MainWindow window;
   window.show();
 
-  return app.exec();
+  int result = app.exec();
+  trace_stop();
+  return result;
 }
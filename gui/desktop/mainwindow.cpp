@@ -25,6 +25,7 @@ MainWindow::MainWindow(QWidget* parent)
       m_currentGameType(GameType::TETRIS) {
   setupUI();
   setupConnections();
+  m_gameWidget->setFrameStats(m_gameController->frameStats());
 
   hide();
 
@@ -180,6 +181,14 @@ void MainWindow::setupConnections() {
 }
 
 void MainWindow::keyPressEvent(QKeyEvent* event) {
+  if (event->key() == Qt::Key_F3) {
+    m_gameWidget->toggleHud();
+    return;
+  }
+  if (event->key() == Qt::Key_F4) {
+    m_gameWidget->toggleRenderMode();
+    return;
+  }
   m_gameController->handleKeyPress(event->key());
 }
 
@@ -0,0 +1,212 @@
+/**
+ * @file simulationthread.cpp
+ * @brief Реализация потока симуляции.
+ */
+
+#include "../../include/gui/desktop/simulationthread.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "../../include/brickgame/common/trace.h"
+
+namespace {
+
+/// Слоты кольца: пишущийся, последний опубликованный и читаемый GUI.
+constexpr int kRingSlots = 3;
+
+/// Попытки скопировать кадр, если движок перезаписал слот при чтении.
+constexpr int kCopyAttempts = 3;
+
+}  // namespace
+
+SimulationThread::SimulationThread() {
+  frame_stats_init(&m_stats, kFrameIntervalMs * 1000);
+  m_publishedStats = m_stats;
+}
+
+SimulationThread::~SimulationThread() { stop(); }
+
+bool SimulationThread::start(const GameAPI& api) {
+  if (m_ring || !api.valid || !api.table) return false;
+
+  m_ring = frame_ring_create(nullptr, api.table->field_width,
+                             api.table->field_height, kRingSlots);
+  if (!m_ring) return false;
+
+  m_api = api;
+  // Пауза между играми не засчитывается как потерянные тики.
+  frame_stats_resume(&m_stats);
+  m_thread = std::thread(&SimulationThread::run, this);
+  return true;
+}
+
+void SimulationThread::stop() {
+  if (!m_ring) return;
+
+  frame_ring_request_shutdown(m_ring);
+  if (m_thread.joinable()) m_thread.join();
+  // Поток завершён: ввод, пришедший после его последней итерации
+  // (например, Terminate при закрытии окна), применяется здесь.
+  drainInput();
+
+  frame_ring_close(m_ring, false);
+  m_ring = nullptr;
+}
+
+bool SimulationThread::pushInput(UserAction_t action, bool hold) {
+  return m_ring && frame_ring_push_input(m_ring, action, hold);
+}
+
+uint64_t SimulationThread::frames() const {
+  return m_ring ? frame_ring_frames(m_ring) : 0;
+}
+
+void SimulationThread::tickStats(FrameStats& stats) const {
+  FrameHistogram paint = stats.paint;
+  {
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    stats = m_publishedStats;
+  }
+  stats.paint = paint;
+}
+
+void SimulationThread::recordTick(std::chrono::steady_clock::time_point now,
+                                  uint64_t stepUs, uint32_t targetUs) {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+
+  frame_stats_set_target(&m_stats, targetUs);
+  frame_stats_tick(
+      &m_stats,
+      static_cast<uint64_t>(
+          duration_cast<microseconds>(now.time_since_epoch()).count()),
+      stepUs);
+  // Поток симуляции не ждёт GUI: если копия сейчас читается, она
+  // обновится на следующем тике.
+  std::unique_lock<std::mutex> lock(m_statsMutex, std::try_to_lock);
+  if (lock.owns_lock()) m_publishedStats = m_stats;
+}
+
+bool SimulationThread::latestFrame(FrameSnapshot& snapshot) const {
+  if (!m_ring) return false;
+
+  const int width = m_api.table->field_width;
+  const int height = m_api.table->field_height;
+  if (snapshot.m_rows.size() != static_cast<size_t>(height)) {
+    snapshot.m_cells.assign(static_cast<size_t>(width) * height, 0);
+    snapshot.m_rows.resize(height);
+    for (int y = 0; y < height; ++y) {
+      snapshot.m_rows[y] = snapshot.m_cells.data() + y * width;
+    }
+    for (int y = 0; y < FRAME_RING_NEXT_SIZE; ++y) {
+      snapshot.m_nextRows[y] = snapshot.m_next[y];
+    }
+  }
+
+  for (int attempt = 0; attempt < kCopyAttempts; ++attempt) {
+    FrameRingView view;
+    if (!frame_ring_read_latest(m_ring, &view)) return false;
+    if (snapshot.valid && view.seq == snapshot.seq) return false;
+
+    for (int y = 0; y < height; ++y) {
+      std::memcpy(snapshot.m_rows[y], view.info.field[y],
+                  sizeof(int) * width);
+    }
+    bool hasNext = view.info.next != nullptr;
+    if (hasNext) {
+      for (int y = 0; y < FRAME_RING_NEXT_SIZE; ++y) {
+        std::memcpy(snapshot.m_next[y], view.info.next[y],
+                    sizeof(snapshot.m_next[y]));
+      }
+    }
+    if (!frame_ring_view_valid(&view)) continue;
+
+    snapshot.info = view.info;
+    snapshot.info.field = snapshot.m_rows.data();
+    snapshot.info.next = hasNext ? snapshot.m_nextRows : nullptr;
+    snapshot.gameOver = view.game_over;
+    snapshot.seq = view.seq;
+    snapshot.valid = true;
+    return true;
+  }
+  return false;
+}
+
+void SimulationThread::drainInput() {
+  UserAction_t action;
+  bool hold;
+  while (frame_ring_pop_input(m_ring, &action, &hold)) {
+    m_api.userInput(action, hold);
+  }
+}
+
+void SimulationThread::run() {
+  using Clock = std::chrono::steady_clock;
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  using std::chrono::milliseconds;
+
+  trace_set_thread_name("simulation");
+  const bool callerFrees =
+      m_api.freeGameInfo &&
+      (m_api.table->capabilities & BRICKGAME_CAP_CALLER_FREES_INFO);
+
+  const bool canFlush = BRICKGAME_API_HAS(m_api.table, flushHighScore) &&
+                        m_api.table->flushHighScore;
+  bool wasOver = false;
+
+  Clock::time_point lastFrame = Clock::now();
+  Clock::time_point nextTick = lastFrame;
+  uint32_t targetUs = kFrameIntervalMs * 1000;
+  while (!frame_ring_shutdown_requested(m_ring)) {
+    {
+      TraceScope scope("input.drain", "input");
+      drainInput();
+    }
+
+    Clock::time_point now = Clock::now();
+    if (now >= nextTick) {
+      TraceSpan tickSpan = trace_begin("tick", "engine");
+      int elapsed = static_cast<int>(
+          duration_cast<milliseconds>(now - lastFrame).count());
+      GameInfo_t info = m_api.advance ? m_api.advance(elapsed)
+                                      : m_api.updateCurrentState();
+      Clock::time_point stepped = Clock::now();
+      trace_end(&tickSpan);
+      // Остаток миллисекунды не теряется: следующий кадр его досчитает.
+      lastFrame = m_api.advance ? lastFrame + milliseconds(elapsed) : now;
+
+      bool over = m_api.isOver();
+      {
+        TraceScope scope("snapshot", "engine");
+        frame_ring_publish(m_ring, &info, over);
+      }
+      // Рекорд пишется один раз в конце партии, вне тика движка.
+      if (over && !wasOver && canFlush) m_api.table->flushHighScore();
+      wasOver = over;
+
+      int interval = m_api.advance ? kFrameIntervalMs : info.speed;
+      if (interval <= 0) interval = kFrameIntervalMs;
+      if (callerFrees) m_api.freeGameInfo(&info);
+
+      // Интервал от прошлого тика сравнивается с тем, что был назначен
+      // на прошлом тике.
+      recordTick(now,
+                 static_cast<uint64_t>(
+                     duration_cast<microseconds>(stepped - now).count()),
+                 targetUs);
+      targetUs = static_cast<uint32_t>(interval * 1000);
+      nextTick = std::max(nextTick + milliseconds(interval),
+                          now + milliseconds(interval / 2));
+    }
+
+    // Между тиками очередь ввода опрашивается часто, чтобы нажатия
+    // применялись сразу, как раньше в потоке GUI.
+    Clock::duration wait =
+        std::min<Clock::duration>(nextTick - Clock::now(),
+                                  milliseconds(kPollIntervalMs));
+    if (wait > Clock::duration::zero()) std::this_thread::sleep_for(wait);
+  }
+}
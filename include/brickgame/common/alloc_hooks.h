@@ -0,0 +1,146 @@
+/**
+ * @file alloc_hooks.h
+ * @brief Подключаемый аллокатор игровых библиотек и учёт выделений.
+ *
+ * Фронтенд или тест передаёт игре BrickGameAllocator (например,
+ * считающий или арену), и все выделения игры идут через него.
+ * Каждая игра хранит собственный AllocHooks и отмечает границы тика,
+ * поэтому видно, сколько выделений сделал последний
+ * updateCurrentState(). Политика — ноль выделений за тик.
+ *
+ * Каждый блок хранит в заголовке аллокатор, которым он выделен, и
+ * освобождается им же: аллокатор можно сменить в любой момент.
+ */
+#ifndef BRICKGAME_COMMON_ALLOC_HOOKS_H
+#define BRICKGAME_COMMON_ALLOC_HOOKS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Аллокатор, который фронтенд передаёт игре.
+ */
+typedef struct {
+  /// Выделение size байт (выравнивание как у malloc); NULL — нет памяти.
+  void *(*allocate)(void *context, size_t size);
+  /// Освобождение блока, выделенного allocate с тем же size.
+  void (*deallocate)(void *context, void *ptr, size_t size);
+  void *context;  ///< Передаётся в оба вызова
+} BrickGameAllocator;
+
+/**
+ * @brief Счётчики выделений за интервал.
+ */
+typedef struct {
+  uint64_t allocations;  ///< Число выделений
+  uint64_t frees;        ///< Число освобождений
+  uint64_t bytes;        ///< Запрошено байт
+} BrickGameAllocStats;
+
+/**
+ * @brief Состояние аллокатора одной игры.
+ */
+typedef struct {
+  BrickGameAllocator allocator;   ///< Текущий аллокатор (NULL — malloc)
+  BrickGameAllocStats total;      ///< С загрузки библиотеки
+  BrickGameAllocStats tick;       ///< С начала текущего тика
+  BrickGameAllocStats last_tick;  ///< За последний завершённый тик
+} AllocHooks;
+
+/**
+ * @brief Заголовок блока: аллокатор-владелец и размер.
+ *
+ * Выровнен как самые строгие базовые типы, чтобы данные после него
+ * сохраняли выравнивание malloc.
+ */
+typedef union {
+  struct {
+    BrickGameAllocator owner;
+    size_t size;
+  } block;
+  long double align_ld;
+  long long align_ll;
+  void *align_ptr;
+} AllocHooksHeader;
+
+static inline void alloc_hooks_count(BrickGameAllocStats *stats,
+                                     uint64_t allocations, uint64_t frees,
+                                     uint64_t bytes) {
+  stats->allocations += allocations;
+  stats->frees += frees;
+  stats->bytes += bytes;
+}
+
+/**
+ * @brief Выделяет size байт текущим аллокатором игры.
+ */
+static inline void *alloc_hooks_alloc(AllocHooks *hooks, size_t size) {
+  size_t total = sizeof(AllocHooksHeader) + size;
+  AllocHooksHeader *header =
+      (AllocHooksHeader *)(hooks->allocator.allocate
+                               ? hooks->allocator.allocate(
+                                     hooks->allocator.context, total)
+                               : malloc(total));
+  if (!header) return NULL;
+  header->block.owner = hooks->allocator;
+  header->block.size = size;
+  alloc_hooks_count(&hooks->total, 1, 0, size);
+  alloc_hooks_count(&hooks->tick, 1, 0, size);
+  return header + 1;
+}
+
+/**
+ * @brief Освобождает блок alloc_hooks_alloc() его аллокатором-владельцем.
+ */
+static inline void alloc_hooks_free(AllocHooks *hooks, void *ptr) {
+  if (!ptr) return;
+  AllocHooksHeader *header = (AllocHooksHeader *)ptr - 1;
+  BrickGameAllocator owner = header->block.owner;
+  size_t total = sizeof(AllocHooksHeader) + header->block.size;
+  if (owner.deallocate) {
+    owner.deallocate(owner.context, header, total);
+  } else {
+    free(header);
+  }
+  alloc_hooks_count(&hooks->total, 0, 1, 0);
+  alloc_hooks_count(&hooks->tick, 0, 1, 0);
+}
+
+/**
+ * @brief Устанавливает аллокатор (NULL — вернуть malloc/free).
+ *
+ * Аллокатор без allocate или deallocate не принимается.
+ */
+static inline void alloc_hooks_set(AllocHooks *hooks,
+                                   const BrickGameAllocator *allocator) {
+  BrickGameAllocator heap = {NULL, NULL, NULL};
+  hooks->allocator =
+      (allocator && allocator->allocate && allocator->deallocate) ? *allocator
+                                                                  : heap;
+}
+
+/**
+ * @brief Начинает учёт тика.
+ */
+static inline void alloc_hooks_begin_tick(AllocHooks *hooks) {
+  BrickGameAllocStats zero = {0, 0, 0};
+  hooks->tick = zero;
+}
+
+/**
+ * @brief Завершает учёт тика: счётчики переходят в last_tick.
+ */
+static inline void alloc_hooks_end_tick(AllocHooks *hooks) {
+  hooks->last_tick = hooks->tick;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICKGAME_COMMON_ALLOC_HOOKS_H
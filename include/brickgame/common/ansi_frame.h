@@ -0,0 +1,115 @@
+/**
+ * @file ansi_frame.h
+ * @brief Сборка кадра терминала в один буфер ANSI-последовательностей.
+ *
+ * Кадр целиком собирается в буфере и выводится одним write(). Буфер
+ * рассчитан на худший кадр окна просмотра (а не всего поля) и растёт,
+ * когда окно увеличивается вместе с терминалом. Между кадрами
+ * выводятся только изменившиеся клетки: курсор переставляется
+ * (CSI row;col H) лишь там, где следующая клетка не стоит сразу за
+ * предыдущей. Панель счёта перерисовывается, только если изменились
+ * её значения. Счётчики frames, bytes и writes сравнивает с выводом
+ * ncurses замер render (make bench).
+ *
+ * Поле больше терминала показывается через окно просмотра: окно
+ * сдвигается так, чтобы в него попадала область последних изменений
+ * (голова змейки, падающая фигура). После сдвига окно перерисовывается
+ * целиком.
+ */
+#ifndef BRICKGAME_COMMON_ANSI_FRAME_H
+#define BRICKGAME_COMMON_ANSI_FRAME_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Ширина панели справа от поля (в колонках терминала).
+#define ANSI_FRAME_PANEL_COLS 18
+/// Размер превью следующей фигуры.
+#define ANSI_FRAME_NEXT_SIZE 4
+
+/**
+ * @brief Буфер кадра и то, что уже выведено на терминал.
+ */
+typedef struct {
+  char *buf;          ///< Буфер кадра
+  size_t capacity;    ///< Размер буфера
+  size_t len;         ///< Длина собранного кадра
+  int width;          ///< Ширина поля, клетки
+  int height;         ///< Высота поля, клетки
+  int view_x;         ///< Левая клетка окна просмотра
+  int view_y;         ///< Верхняя клетка окна просмотра
+  int view_w;         ///< Ширина окна, клетки
+  int view_h;         ///< Высота окна, клетки
+  uint8_t *shown;     ///< Поле на момент прошлого кадра (width*height)
+  int panel[5];       ///< Выведенные счёт, рекорд, уровень, скорость, пауза
+  uint16_t next_mask; ///< Выведенное превью (бит на клетку 4x4)
+  bool has_next;      ///< Превью выведено
+  bool full;          ///< Следующий кадр перерисовывается целиком
+  uint64_t frames;    ///< Выведено кадров
+  uint64_t bytes;     ///< Выведено байт
+  uint64_t writes;    ///< Вызовов write()
+} AnsiFrame;
+
+/**
+ * @brief Выделяет буферы кадра для поля width x height.
+ *
+ * @param frame     кадр
+ * @param width     ширина поля
+ * @param height    высота поля
+ * @param term_cols колонок в терминале
+ * @param term_rows строк в терминале
+ * @return false при неверных размерах или нехватке памяти
+ */
+bool ansi_frame_init(AnsiFrame *frame, int width, int height, int term_cols,
+                     int term_rows);
+
+/**
+ * @brief Освобождает буферы кадра.
+ */
+void ansi_frame_free(AnsiFrame *frame);
+
+/**
+ * @brief Подстраивает окно просмотра под новый размер терминала.
+ *
+ * Следующий кадр перерисовывается целиком. Буфер кадра при
+ * необходимости увеличивается.
+ *
+ * @return false при нехватке памяти (окно остаётся прежним)
+ */
+bool ansi_frame_resize(AnsiFrame *frame, int term_cols, int term_rows);
+
+/**
+ * @brief Требует полной перерисовки (экран изменён кем-то другим).
+ */
+void ansi_frame_invalidate(AnsiFrame *frame);
+
+/**
+ * @brief Собирает кадр в буфер frame->buf.
+ *
+ * @param frame кадр
+ * @param info  состояние игры (поле width x height)
+ * @return длина кадра (0 — на экране ничего не изменилось)
+ */
+size_t ansi_frame_compose(AnsiFrame *frame, const GameInfo_t *info);
+
+/**
+ * @brief Выводит собранный кадр в fd.
+ *
+ * Обычно это один write(); при частичной записи остаток дописывается.
+ *
+ * @return false при ошибке записи
+ */
+bool ansi_frame_flush(AnsiFrame *frame, int fd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICKGAME_COMMON_ANSI_FRAME_H
@@ -0,0 +1,173 @@
+/**
+ * @file frame_broadcast.h
+ * @brief Рассылка кадров игры зрителям (spectator fan-out).
+ *
+ * Модуль кодирует изменения кадра одной игровой сессии один раз и
+ * раздаёт получившийся буфер всем подписчикам без копирования:
+ * - ключевые кадры (keyframe) — всё поле в RLE-кодировке;
+ * - дельта-кадры — только изменившиеся клетки;
+ * - ключевой кадр вставляется периодически или если дельта длиннее
+ *   байта на клетку.
+ *
+ * Пакеты неизменяемы после публикации и защищены счётчиком ссылок,
+ * поэтому их можно отдавать сетевым потокам зрителей. Новый зритель
+ * начинает чтение с последнего ключевого кадра. Пакет, вытесненный из
+ * истории и отпущенный всеми зрителями, рассыльщик берёт под следующий
+ * кадр, так что в установившемся режиме публикация не выделяет память.
+ */
+#ifndef BRICKGAME_COMMON_FRAME_BROADCAST_H
+#define BRICKGAME_COMMON_FRAME_BROADCAST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Размер превью следующей фигуры (GameInfo_t::next) по каждой оси.
+#define BROADCAST_NEXT_SIZE 4
+
+/// Размер заголовка пакета в байтах.
+#define BROADCAST_HEADER_SIZE 29
+
+/**
+ * @brief Тип закодированного пакета.
+ */
+typedef enum {
+  BROADCAST_KEYFRAME = 0,  ///< Полный кадр (RLE)
+  BROADCAST_DELTA = 1      ///< Только изменённые клетки
+} BroadcastPacketType;
+
+/**
+ * @brief Закодированный кадр, общий для всех подписчиков.
+ *
+ * Данные только для чтения. Владение — через broadcast_packet_retain() /
+ * broadcast_packet_release().
+ */
+typedef struct BroadcastPacket {
+  int refcount;         ///< Счётчик ссылок (атомарный)
+  uint32_t seq;         ///< Порядковый номер кадра
+  BroadcastPacketType type;  ///< Ключевой или дельта-кадр
+  size_t size;          ///< Размер закодированных данных
+  uint8_t data[];       ///< Закодированные данные
+} BroadcastPacket;
+
+/**
+ * @brief Рассыльщик кадров одной сессии.
+ */
+typedef struct FrameBroadcaster FrameBroadcaster;
+
+/**
+ * @brief Курсор подписчика: номер следующего ожидаемого кадра.
+ */
+typedef struct {
+  uint32_t next_seq;  ///< Следующий кадр для чтения
+  bool synced;        ///< Получен ли хотя бы один ключевой кадр
+} BroadcastCursor;
+
+/**
+ * @brief Состояние кадра на стороне зрителя (результат декодирования).
+ */
+typedef struct {
+  int width;       ///< Ширина поля
+  int height;      ///< Высота поля
+  uint8_t *cells;  ///< width*height клеток поля + превью next
+  int score;       ///< Текущий счёт
+  int high_score;  ///< Рекорд
+  int level;       ///< Уровень
+  int speed;       ///< Скорость
+  int pause;       ///< Флаг паузы
+  uint32_t seq;    ///< Номер последнего применённого кадра
+} BroadcastFrame;
+
+/**
+ * @brief Создаёт рассыльщик для поля заданного размера.
+ *
+ * @param width ширина поля
+ * @param height высота поля
+ * @param keyframe_interval период ключевых кадров (в кадрах, >= 1)
+ * @param history ёмкость истории пакетов (>= keyframe_interval); каждый
+ *        пакет занимает BROADCAST_HEADER_SIZE + 2 байта на клетку
+ * @return указатель на рассыльщик или NULL при ошибке
+ */
+FrameBroadcaster *broadcaster_create(int width, int height,
+                                     int keyframe_interval, int history);
+
+/**
+ * @brief Уничтожает рассыльщик и отпускает свои ссылки на пакеты.
+ *
+ * Пакеты, удерживаемые зрителями, остаются валидными до release.
+ */
+void broadcaster_destroy(FrameBroadcaster *b);
+
+/**
+ * @brief Кодирует очередной кадр сессии (один раз на всех зрителей).
+ *
+ * @param b рассыльщик
+ * @param info кадр из updateCurrentState()
+ * @return опубликованный пакет (ссылка принадлежит рассыльщику) или NULL
+ */
+const BroadcastPacket *broadcaster_publish(FrameBroadcaster *b,
+                                           const GameInfo_t *info);
+
+/**
+ * @brief Возвращает курсор для нового зрителя (с последнего keyframe).
+ */
+BroadcastCursor broadcaster_subscribe(const FrameBroadcaster *b);
+
+/**
+ * @brief Выдаёт зрителю следующий пакет без копирования.
+ *
+ * Если зритель отстал дальше истории, курсор переводится на последний
+ * ключевой кадр.
+ *
+ * @param b рассыльщик
+ * @param cursor курсор зрителя
+ * @return пакет с захваченной ссылкой (освободить через
+ *         broadcast_packet_release) или NULL, если новых кадров нет
+ */
+const BroadcastPacket *broadcaster_poll(const FrameBroadcaster *b,
+                                        BroadcastCursor *cursor);
+
+/**
+ * @brief Захватывает дополнительную ссылку на пакет.
+ */
+void broadcast_packet_retain(const BroadcastPacket *packet);
+
+/**
+ * @brief Отпускает ссылку на пакет; последний release освобождает память.
+ */
+void broadcast_packet_release(const BroadcastPacket *packet);
+
+/**
+ * @brief Инициализирует состояние кадра зрителя.
+ *
+ * @return true при успехе
+ */
+bool broadcast_frame_init(BroadcastFrame *frame, int width, int height);
+
+/**
+ * @brief Освобождает состояние кадра зрителя.
+ */
+void broadcast_frame_free(BroadcastFrame *frame);
+
+/**
+ * @brief Применяет пакет к состоянию зрителя.
+ *
+ * Дельта-кадр применяется только поверх предыдущего кадра
+ * (seq == frame->seq + 1).
+ *
+ * @return true если пакет корректен и применён
+ */
+bool broadcast_frame_apply(BroadcastFrame *frame,
+                           const BroadcastPacket *packet);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICKGAME_COMMON_FRAME_BROADCAST_H
@@ -0,0 +1,142 @@
+/**
+ * @file frame_ring.h
+ * @brief Кольцевой буфер кадров в разделяемой памяти (engine ↔ frontend).
+ *
+ * Позволяет запускать игровой движок в отдельном процессе:
+ * - движок (единственный писатель) публикует кадры в кольцо слотов,
+ *   защищённых seqlock, и никогда не ждёт читателей;
+ * - фронтенды (любое число читателей) берут последний кадр прямо из
+ *   разделяемой памяти без копирования и без системных вызовов;
+ * - ввод от фронтендов передаётся движку через ограниченную очередь
+ *   в том же сегменте.
+ *
+ * Падение или медленная отрисовка фронтенда не останавливает симуляцию.
+ */
+#ifndef BRICKGAME_COMMON_FRAME_RING_H
+#define BRICKGAME_COMMON_FRAME_RING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Размер превью следующей фигуры по каждой оси.
+#define FRAME_RING_NEXT_SIZE 4
+
+/// Ёмкость очереди ввода (степень двойки).
+#define FRAME_RING_INPUT_CAPACITY 64
+
+/**
+ * @brief Дескриптор кольца кадров (локальный для процесса).
+ */
+typedef struct FrameRing FrameRing;
+
+/**
+ * @brief Кадр, прочитанный из кольца.
+ *
+ * Поля info.field и info.next указывают прямо в разделяемую память и
+ * действительны до следующего frame_ring_read_latest(). После отрисовки
+ * стоит проверить frame_ring_view_valid(): движок мог перезаписать слот.
+ */
+typedef struct {
+  GameInfo_t info;  ///< Данные кадра (указатели в разделяемую память)
+  bool game_over;   ///< Игра окончена
+  uint64_t seq;     ///< Номер кадра
+  const void *slot; ///< Слот, из которого прочитан кадр
+  uint64_t stamp;   ///< Значение seqlock на момент чтения
+} FrameRingView;
+
+/**
+ * @brief Создаёт кольцо кадров.
+ *
+ * @param name имя POSIX shm ("/brickgame") или NULL для анонимного
+ *             сегмента, наследуемого через fork()
+ * @param width ширина поля
+ * @param height высота поля
+ * @param capacity число слотов (>= 2)
+ * @return дескриптор или NULL при ошибке, в том числе если сегмент name
+ *         уже существует (устаревший удаляется явно, shm_unlink())
+ */
+FrameRing *frame_ring_create(const char *name, int width, int height,
+                             int capacity);
+
+/**
+ * @brief Подключается к существующему именованному кольцу.
+ *
+ * @param name имя POSIX shm
+ * @return дескриптор или NULL, если кольцо не найдено или заголовок
+ *         не согласован с размером сегмента
+ */
+FrameRing *frame_ring_open(const char *name);
+
+/**
+ * @brief Отключается от кольца.
+ *
+ * @param ring дескриптор
+ * @param unlink удалить именованный сегмент (делает создатель)
+ */
+void frame_ring_close(FrameRing *ring, bool unlink);
+
+/**
+ * @brief Публикует кадр (вызывается только движком).
+ *
+ * @param ring дескриптор
+ * @param info кадр из updateCurrentState()
+ * @param game_over признак окончания игры
+ */
+void frame_ring_publish(FrameRing *ring, const GameInfo_t *info,
+                        bool game_over);
+
+/**
+ * @brief Читает последний опубликованный кадр без копирования.
+ *
+ * @param ring дескриптор
+ * @param view результат
+ * @return false, если кадров ещё нет или слот переписывается
+ */
+bool frame_ring_read_latest(FrameRing *ring, FrameRingView *view);
+
+/**
+ * @brief Проверяет, что кадр не был перезаписан во время чтения.
+ */
+bool frame_ring_view_valid(const FrameRingView *view);
+
+/**
+ * @brief Возвращает число опубликованных кадров.
+ */
+uint64_t frame_ring_frames(const FrameRing *ring);
+
+/**
+ * @brief Отправляет действие пользователя движку.
+ *
+ * @return false, если очередь переполнена (действие отброшено)
+ */
+bool frame_ring_push_input(FrameRing *ring, UserAction_t action, bool hold);
+
+/**
+ * @brief Забирает очередное действие пользователя (вызывает движок).
+ *
+ * @return false, если очередь пуста
+ */
+bool frame_ring_pop_input(FrameRing *ring, UserAction_t *action, bool *hold);
+
+/**
+ * @brief Просит движок завершиться.
+ */
+void frame_ring_request_shutdown(FrameRing *ring);
+
+/**
+ * @brief Проверяет, запрошено ли завершение движка.
+ */
+bool frame_ring_shutdown_requested(const FrameRing *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICKGAME_COMMON_FRAME_RING_H
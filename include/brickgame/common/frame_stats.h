@@ -0,0 +1,133 @@
+/**
+ * @file frame_stats.h
+ * @brief Гистограммы темпа кадров: отрисовка, шаг движка, дрожание тика.
+ *
+ * Фронтенд сообщает длительность отрисовки (frame_stats_paint()) и
+ * каждого тика (frame_stats_tick()); интервал между тиками сравнивается
+ * с целевым. Тик, пришедший позже полутора интервалов, считается
+ * опоздавшим, а каждый целый пропущенный интервал — потерянным кадром.
+ *
+ * Гистограммы линейные, с фиксированным числом корзин и корзиной
+ * переполнения; запись не выделяет память.
+ */
+#ifndef BRICKGAME_COMMON_FRAME_STATS_H
+#define BRICKGAME_COMMON_FRAME_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Число корзин гистограммы (без корзины переполнения).
+#define FRAME_HISTOGRAM_BUCKETS 32
+
+/// Переменная окружения с путём файла для frame_stats_dump() при выходе.
+#define FRAME_STATS_ENV "BRICKGAME_FRAME_STATS"
+
+/**
+ * @brief Линейная гистограмма длительностей в микросекундах.
+ */
+typedef struct {
+  uint64_t buckets[FRAME_HISTOGRAM_BUCKETS];  ///< Корзины [i*w, (i+1)*w)
+  uint64_t overflow;  ///< Значения не меньше FRAME_HISTOGRAM_BUCKETS*w
+  uint64_t count;     ///< Всего значений
+  uint64_t sum_us;    ///< Сумма значений
+  uint64_t max_us;    ///< Максимум
+  uint32_t bucket_us; ///< Ширина корзины w
+} FrameHistogram;
+
+/**
+ * @brief Статистика темпа кадров фронтенда.
+ */
+typedef struct {
+  FrameHistogram paint;   ///< Длительность отрисовки
+  FrameHistogram step;    ///< Длительность шага движка
+  FrameHistogram jitter;  ///< |интервал между тиками - целевой|
+  uint64_t ticks;         ///< Тиков с измеренным интервалом
+  uint64_t late_ticks;    ///< Тиков позже 1.5 целевых интервалов
+  uint64_t dropped_frames;  ///< Пропущенных целых интервалов
+  uint32_t target_us;     ///< Целевой интервал тика
+  uint64_t last_tick_us;  ///< Момент предыдущего тика
+  bool has_last_tick;     ///< last_tick_us задан
+} FrameStats;
+
+/**
+ * @brief Очищает гистограмму.
+ *
+ * @param histogram гистограмма
+ * @param bucket_us ширина корзины (0 заменяется на 1)
+ */
+void frame_histogram_init(FrameHistogram *histogram, uint32_t bucket_us);
+
+/**
+ * @brief Добавляет значение в гистограмму.
+ */
+void frame_histogram_add(FrameHistogram *histogram, uint64_t value_us);
+
+/**
+ * @brief Оценка перцентиля — верхняя граница корзины с p-й долей значений.
+ *
+ * @param histogram гистограмма
+ * @param p доля от 0 до 1
+ * @return мкс; для переполнения — max_us, для пустой гистограммы — 0
+ */
+uint64_t frame_histogram_percentile(const FrameHistogram *histogram,
+                                    double p);
+
+/**
+ * @brief Наибольшее значение корзины (для масштаба графика).
+ */
+uint64_t frame_histogram_peak(const FrameHistogram *histogram);
+
+/**
+ * @brief Очищает статистику.
+ *
+ * @param stats статистика
+ * @param target_us целевой интервал тика
+ */
+void frame_stats_init(FrameStats *stats, uint32_t target_us);
+
+/**
+ * @brief Меняет целевой интервал тика (накопленное сохраняется).
+ */
+void frame_stats_set_target(FrameStats *stats, uint32_t target_us);
+
+/**
+ * @brief Забывает момент предыдущего тика.
+ *
+ * Вызывается при (пере)запуске таймера, чтобы пауза не засчитывалась
+ * как потерянные кадры.
+ */
+void frame_stats_resume(FrameStats *stats);
+
+/**
+ * @brief Учитывает тик.
+ *
+ * @param stats статистика
+ * @param now_us момент начала тика (монотонные мкс)
+ * @param step_us длительность шага движка
+ */
+void frame_stats_tick(FrameStats *stats, uint64_t now_us, uint64_t step_us);
+
+/**
+ * @brief Учитывает отрисовку кадра.
+ */
+void frame_stats_paint(FrameStats *stats, uint64_t paint_us);
+
+/**
+ * @brief Сохраняет статистику в текстовый файл (CSV с комментариями).
+ *
+ * Строки "metric,bucket_start_us,bucket_end_us,count"; корзина
+ * переполнения имеет bucket_end_us = -1.
+ *
+ * @return false, если файл не записан
+ */
+bool frame_stats_dump(const FrameStats *stats, const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICKGAME_COMMON_FRAME_STATS_H
@@ -0,0 +1,128 @@
+/**
+ * @file input_queue.h
+ * @brief Ограниченная очередь ввода, применяемого на границе тика.
+ *
+ * Игра складывает действия игрока в очередь вместе со временем их
+ * прихода (часы сессии игры, мс) и на каждом тике забирает не больше
+ * per_tick действий. Так два быстрых нажатия внутри одного тика не
+ * затирают друг друга, а порядок ввода относительно шагов игры не
+ * зависит от того, когда фронтенд вызвал userInput().
+ *
+ * Переполненная очередь отбрасывает новые действия и считает их.
+ */
+#ifndef BRICKGAME_COMMON_INPUT_QUEUE_H
+#define BRICKGAME_COMMON_INPUT_QUEUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Ёмкость очереди ввода одной сессии.
+#define INPUT_QUEUE_CAPACITY 16
+
+/// Переменная окружения: сколько действий применяется за тик.
+#define INPUT_QUEUE_ENV "BRICKGAME_INPUTS_PER_TICK"
+
+/**
+ * @brief Действие в очереди.
+ */
+typedef struct {
+  int32_t action;    ///< UserAction_t
+  int32_t hold;      ///< Признак удержания
+  uint32_t time_ms;  ///< Время прихода по часам сессии, мс
+} QueuedInput;
+
+/**
+ * @brief Кольцевая очередь действий.
+ */
+typedef struct {
+  QueuedInput items[INPUT_QUEUE_CAPACITY];  ///< Кольцевой буфер
+  uint32_t head;                            ///< Индекс первого действия
+  uint32_t count;                           ///< Число действий
+  uint32_t dropped;   ///< Отброшено из-за переполнения
+  uint32_t per_tick;  ///< Действий за тик
+} InputQueue;
+
+/**
+ * @brief Инициализирует пустую очередь.
+ * @param queue    очередь
+ * @param per_tick сколько действий применяется за тик
+ */
+static inline void input_queue_init(InputQueue *queue, uint32_t per_tick) {
+  queue->head = 0;
+  queue->count = 0;
+  queue->dropped = 0;
+  queue->per_tick = per_tick;
+}
+
+/**
+ * @brief Удаляет все действия (per_tick и счётчик потерь сохраняются).
+ */
+static inline void input_queue_clear(InputQueue *queue) {
+  queue->head = 0;
+  queue->count = 0;
+}
+
+/**
+ * @brief Добавляет действие в конец очереди.
+ * @return false, если очередь полна (действие отброшено)
+ */
+static inline bool input_queue_push(InputQueue *queue, int32_t action,
+                                    bool hold, uint32_t time_ms) {
+  if (queue->count == INPUT_QUEUE_CAPACITY) {
+    queue->dropped++;
+    return false;
+  }
+  QueuedInput *item =
+      &queue->items[(queue->head + queue->count) % INPUT_QUEUE_CAPACITY];
+  item->action = action;
+  item->hold = hold ? 1 : 0;
+  item->time_ms = time_ms;
+  queue->count++;
+  return true;
+}
+
+/**
+ * @brief Забирает первое действие.
+ * @return false, если очередь пуста
+ */
+static inline bool input_queue_pop(InputQueue *queue, QueuedInput *out) {
+  if (queue->count == 0) return false;
+  *out = queue->items[queue->head];
+  queue->head = (queue->head + 1) % INPUT_QUEUE_CAPACITY;
+  queue->count--;
+  return true;
+}
+
+/**
+ * @brief Последнее добавленное действие.
+ * @return NULL, если очередь пуста
+ */
+static inline const QueuedInput *input_queue_back(const InputQueue *queue) {
+  if (queue->count == 0) return NULL;
+  return &queue->items[(queue->head + queue->count - 1) %
+                       INPUT_QUEUE_CAPACITY];
+}
+
+/**
+ * @brief Число действий за тик из переменной INPUT_QUEUE_ENV.
+ * @param fallback значение, если переменная не задана или некорректна
+ */
+static inline uint32_t input_queue_per_tick_from_env(uint32_t fallback) {
+  const char *value = getenv(INPUT_QUEUE_ENV);
+  if (!value || !*value) return fallback;
+  int per_tick = atoi(value);
+  if (per_tick < 0) return fallback;
+  return per_tick > INPUT_QUEUE_CAPACITY ? INPUT_QUEUE_CAPACITY
+                                         : (uint32_t)per_tick;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICKGAME_COMMON_INPUT_QUEUE_H
@@ -0,0 +1,129 @@
+/**
+ * @file leaderboard.h
+ * @brief Таблица лидеров в отображаемом в память файле.
+ *
+ * Записи фиксированного размера хранятся по убыванию счёта в B+-дереве
+ * из страниц файла; узлы дерева помнят число записей в поддеревьях.
+ * Вставка, ранг счёта и запись по рангу стоят O(log n), поэтому таблица
+ * держит миллионы результатов. Хранится не более capacity лучших; файл
+ * растёт по мере заполнения, а не выделяется сразу на всю ёмкость.
+ *
+ * Несколько процессов могут писать в один файл одновременно:
+ * изменения выполняются под эксклюзивной блокировкой flock(),
+ * чтение — под разделяемой. flock() разграничивает только открытые
+ * файлы: потоки, разделяющие один Leaderboard*, друг от друга не
+ * защищены. Каждый поток открывает таблицу сам (leaderboard_open())
+ * либо вызовы сериализует вызывающий.
+ */
+#ifndef BRICKGAME_COMMON_LEADERBOARD_H
+#define BRICKGAME_COMMON_LEADERBOARD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Максимальная длина имени игрока (с завершающим нулём).
+#define LEADERBOARD_NAME_SIZE 32
+
+/// Ёмкость таблицы по умолчанию.
+#define LEADERBOARD_DEFAULT_CAPACITY 1024
+
+/**
+ * @brief Запись таблицы лидеров (64 байта).
+ */
+typedef struct {
+  char player[LEADERBOARD_NAME_SIZE];  ///< Имя игрока
+  int32_t score;                       ///< Счёт
+  int32_t level;                       ///< Достигнутый уровень
+  uint32_t duration_ms;                ///< Длительность партии (мс)
+  uint32_t reserved;                   ///< Выравнивание (всегда 0)
+  uint64_t replay_id;                  ///< Идентификатор записи партии
+  int64_t timestamp;                   ///< Время окончания (Unix, с)
+} LeaderboardRecord;
+
+/**
+ * @brief Открытая таблица лидеров.
+ */
+typedef struct Leaderboard Leaderboard;
+
+/**
+ * @brief Открывает (или создаёт) файл таблицы лидеров.
+ *
+ * Дескриптор нельзя без внешней синхронизации использовать из
+ * нескольких потоков (см. описание файла).
+ *
+ * @param path путь к файлу
+ * @param capacity ёмкость для нового файла, не меньше 1 (у
+ *                 существующего берётся сохранённая)
+ * @return дескриптор или NULL при ошибке
+ */
+Leaderboard *leaderboard_open(const char *path, uint32_t capacity);
+
+/**
+ * @brief Закрывает таблицу лидеров.
+ */
+void leaderboard_close(Leaderboard *board);
+
+/**
+ * @brief Добавляет результат с сохранением сортировки.
+ *
+ * При равном счёте новая запись встаёт после существующих. Стоит
+ * O(log n) под LOCK_EX; в заполненной таблице вытесняется последняя
+ * запись.
+ *
+ * @param board таблица
+ * @param record результат
+ * @return ранг записи (0 — первое место) или -1, если результат
+ *         не попал в таблицу
+ */
+int64_t leaderboard_submit(Leaderboard *board,
+                           const LeaderboardRecord *record);
+
+/**
+ * @brief Возвращает число записей в таблице.
+ */
+uint32_t leaderboard_count(Leaderboard *board);
+
+/**
+ * @brief Возвращает ёмкость таблицы.
+ */
+uint32_t leaderboard_capacity(const Leaderboard *board);
+
+/**
+ * @brief Читает запись с заданным рангом.
+ *
+ * @return false, если ранг вне таблицы
+ */
+bool leaderboard_get(Leaderboard *board, uint32_t rank,
+                     LeaderboardRecord *out);
+
+/**
+ * @brief Копирует до max лучших записей.
+ *
+ * @return число скопированных записей
+ */
+uint32_t leaderboard_top(Leaderboard *board, LeaderboardRecord *out,
+                         uint32_t max);
+
+/**
+ * @brief Ранг, который получил бы указанный счёт.
+ *
+ * @return число записей со счётом не ниже score
+ */
+uint32_t leaderboard_rank_of(Leaderboard *board, int32_t score);
+
+/**
+ * @brief Заполняет запись результата (имя обрезается до допустимой длины).
+ */
+void leaderboard_record_init(LeaderboardRecord *record, const char *player,
+                             int32_t score, int32_t level,
+                             uint32_t duration_ms, uint64_t replay_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICKGAME_COMMON_LEADERBOARD_H
@@ -0,0 +1,148 @@
+/**
+ * @file packed_grid.h
+ * @brief Поле с упаковкой клеток по 2 бита.
+ *
+ * Клетка поля принимает не больше четырёх значений (пусто, змейка,
+ * яблоко; у Tetris — 0/1), поэтому в байт укладываются четыре клетки.
+ * Клетки идут по строкам, клетка с индексом i = y * width + x лежит в
+ * байте i / 4, в битах 2 * (i % 4) и 2 * (i % 4) + 1 (младшие биты —
+ * первая клетка). Классическое поле 10x20 занимает 50 байт вместо 800
+ * в int[20][10].
+ *
+ * Этот же формат используют упакованные снимки поля
+ * (exportPackedField) — для кэшей, сетевых кадров, повторов и архивов.
+ * Для потребителей GameInfo_t::field (int**) есть распаковка по строке:
+ * каждые четыре выровненные клетки раскрываются одной 16-байтной
+ * записью из таблицы.
+ */
+#ifndef BRICKGAME_COMMON_PACKED_GRID_H
+#define BRICKGAME_COMMON_PACKED_GRID_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Бит на клетку.
+#define PACKED_CELL_BITS 2
+/// Маска значения клетки.
+#define PACKED_CELL_MASK 3u
+/// Клеток в байте.
+#define PACKED_CELLS_PER_BYTE 4
+
+/// Размер упакованного поля width x height в байтах.
+#define PACKED_GRID_BYTES(width, height) \
+  (((size_t)(width) * (size_t)(height) + 3) / 4)
+
+/**
+ * @brief Значение клетки с индексом index.
+ */
+static inline unsigned packed_grid_get(const uint8_t *grid, size_t index) {
+  return (grid[index >> 2] >> ((index & 3) * PACKED_CELL_BITS)) &
+         PACKED_CELL_MASK;
+}
+
+/**
+ * @brief Записывает значение (0..3) в клетку с индексом index.
+ */
+static inline void packed_grid_set(uint8_t *grid, size_t index,
+                                   unsigned value) {
+  unsigned shift = (unsigned)(index & 3) * PACKED_CELL_BITS;
+  uint8_t *byte = &grid[index >> 2];
+  *byte = (uint8_t)((*byte & ~(PACKED_CELL_MASK << shift)) |
+                    ((value & PACKED_CELL_MASK) << shift));
+}
+
+/**
+ * @brief Заполняет count клеток одним значением (хвост байта — тоже).
+ */
+static inline void packed_grid_fill(uint8_t *grid, size_t count,
+                                    unsigned value) {
+  memset(grid, (int)((value & PACKED_CELL_MASK) * 0x55u),
+         (count + 3) / 4);
+}
+
+#define PACKED_LUT_1(b) \
+  {(b) & 3, ((b) >> 2) & 3, ((b) >> 4) & 3, ((b) >> 6) & 3}
+#define PACKED_LUT_4(b)                                           \
+  PACKED_LUT_1(b), PACKED_LUT_1((b) + 1), PACKED_LUT_1((b) + 2), \
+      PACKED_LUT_1((b) + 3)
+#define PACKED_LUT_16(b)                                          \
+  PACKED_LUT_4(b), PACKED_LUT_4((b) + 4), PACKED_LUT_4((b) + 8), \
+      PACKED_LUT_4((b) + 12)
+#define PACKED_LUT_64(b)                                             \
+  PACKED_LUT_16(b), PACKED_LUT_16((b) + 16), PACKED_LUT_16((b) + 32), \
+      PACKED_LUT_16((b) + 48)
+
+/**
+ * @brief Таблица распаковки: байт -> четыре клетки типа int.
+ */
+static inline const int (*packed_grid_lut(void))[PACKED_CELLS_PER_BYTE] {
+  static const int lut[256][PACKED_CELLS_PER_BYTE] = {
+      PACKED_LUT_64(0), PACKED_LUT_64(64), PACKED_LUT_64(128),
+      PACKED_LUT_64(192)};
+  return lut;
+}
+
+#undef PACKED_LUT_64
+#undef PACKED_LUT_16
+#undef PACKED_LUT_4
+#undef PACKED_LUT_1
+
+/**
+ * @brief Распаковывает width клеток, начиная с индекса first, в row.
+ *
+ * Клетки до границы байта и после последнего полного байта читаются по
+ * одной, остальные — по четыре за запись.
+ */
+static inline void packed_grid_unpack_row(const uint8_t *grid, size_t first,
+                                          int width, int *row) {
+  const int(*lut)[PACKED_CELLS_PER_BYTE] = packed_grid_lut();
+  int x = 0;
+  for (; x < width && ((first + (size_t)x) & 3) != 0; ++x) {
+    row[x] = (int)packed_grid_get(grid, first + (size_t)x);
+  }
+  const uint8_t *bytes = grid + ((first + (size_t)x) >> 2);
+  for (; x + PACKED_CELLS_PER_BYTE <= width; x += PACKED_CELLS_PER_BYTE) {
+    memcpy(row + x, lut[*bytes++], sizeof(lut[0]));
+  }
+  for (; x < width; ++x) {
+    row[x] = (int)packed_grid_get(grid, first + (size_t)x);
+  }
+}
+
+/**
+ * @brief Распаковывает поле width x height в строки rows (GameInfo_t).
+ */
+static inline void packed_grid_unpack(const uint8_t *grid, int width,
+                                      int height, int **rows) {
+  for (int y = 0; y < height; ++y) {
+    packed_grid_unpack_row(grid, (size_t)y * (size_t)width, width, rows[y]);
+  }
+}
+
+/**
+ * @brief Упаковывает поле из строк rows (значения берутся по модулю 4).
+ *
+ * @param grid буфер на PACKED_GRID_BYTES(width, height) байт
+ */
+static inline void packed_grid_pack(uint8_t *grid, int width, int height,
+                                    const int *const *rows) {
+  memset(grid, 0, PACKED_GRID_BYTES(width, height));
+  size_t index = 0;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x, ++index) {
+      grid[index >> 2] |= (uint8_t)(((unsigned)rows[y][x] & PACKED_CELL_MASK)
+                                    << ((index & 3) * PACKED_CELL_BITS));
+    }
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICKGAME_COMMON_PACKED_GRID_H
@@ -0,0 +1,120 @@
+/**
+ * @file plugin_api.h
+ * @brief Версионированный ABI игровых плагинов BrickGame.
+ *
+ * Каждая игровая библиотека экспортирует единственную точку входа
+ * brickgame_get_api(), которая возвращает таблицу функций (vtable)
+ * с версией ABI, флагами возможностей, размерами поля и хуками
+ * жизненного цикла. Фронтенд один раз получает таблицу и дальше
+ * вызывает игру только через неё.
+ *
+ * Новые поля добавляются только в конец структуры; наличие поля
+ * проверяется по struct_size (см. BRICKGAME_API_HAS).
+ */
+#ifndef BRICKGAME_COMMON_PLUGIN_API_H
+#define BRICKGAME_COMMON_PLUGIN_API_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "alloc_hooks.h"
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Текущая версия ABI плагинов.
+#define BRICKGAME_ABI_VERSION 1u
+
+/// Имя экспортируемой точки входа.
+#define BRICKGAME_ENTRY_SYMBOL "brickgame_get_api"
+
+/**
+ * @brief Флаги возможностей плагина.
+ */
+enum {
+  /// GameInfo_t::next содержит превью следующей фигуры.
+  BRICKGAME_CAP_NEXT_PREVIEW = 1u << 0,
+  /// Игра может закончиться победой (см. isVictory).
+  BRICKGAME_CAP_VICTORY = 1u << 1,
+  /// Удержание клавиши ускоряет игру (Action + hold).
+  BRICKGAME_CAP_HOLD_ACCELERATE = 1u << 2,
+  /// Буферы GameInfo_t выделяются на каждый кадр; их освобождает
+  /// вызывающий через freeGameInfo.
+  BRICKGAME_CAP_CALLER_FREES_INFO = 1u << 3,
+  /// Поддерживаются снимки состояния (saveState/loadState).
+  BRICKGAME_CAP_SAVE_STATE = 1u << 4,
+  /// Игра продвигается по реальному времени (advance).
+  BRICKGAME_CAP_TIMED_ADVANCE = 1u << 5
+};
+
+/**
+ * @brief Таблица функций игрового плагина.
+ */
+typedef struct {
+  uint32_t abi_version;  ///< Версия ABI (BRICKGAME_ABI_VERSION)
+  uint32_t struct_size;  ///< sizeof(BrickGameApi) на стороне плагина
+  const char *id;        ///< Короткий идентификатор ("tetris", "snake")
+  const char *name;      ///< Отображаемое имя игры
+  uint32_t capabilities;  ///< Флаги BRICKGAME_CAP_*
+  int field_width;        ///< Ширина поля в клетках
+  int field_height;       ///< Высота поля в клетках
+  UserAction_t idle_action;  ///< Действие «без нажатия» (безопасный no-op)
+
+  void (*init)(void);      ///< Подготовка игры (может быть NULL)
+  void (*shutdown)(void);  ///< Освобождение ресурсов (может быть NULL)
+
+  void (*userInput)(UserAction_t action, bool hold);  ///< Обработка ввода
+  GameInfo_t (*updateCurrentState)(void);  ///< Тик и получение кадра
+  bool (*isGameOver)(void);                ///< Игра окончена
+  void (*freeGameInfo)(GameInfo_t *info);  ///< Освобождение кадра
+  bool (*isVictory)(void);  ///< Победа (BRICKGAME_CAP_VICTORY, иначе NULL)
+
+  /// Снимок сессии в buf; возвращает полный размер снимка (см. state_blob.h).
+  size_t (*saveState)(void *buf, size_t size);
+  /// Восстановление сессии из снимка; false — снимок не подходит.
+  bool (*loadState)(const void *buf, size_t size);
+
+  /// Продвижение на elapsed_ms реального времени и получение кадра
+  /// (BRICKGAME_CAP_TIMED_ADVANCE, иначе NULL). Вызывается вместо
+  /// updateCurrentState с постоянным интервалом таймера.
+  GameInfo_t (*advance)(int elapsed_ms);
+
+  /// Аллокатор для всех выделений игры (NULL — malloc/free), см.
+  /// alloc_hooks.h. Можно вызывать в любой момент.
+  void (*setAllocator)(const BrickGameAllocator *allocator);
+  /// Выделения за последний updateCurrentState()/advance().
+  BrickGameAllocStats (*tickAllocStats)(void);
+
+  /// Записывает рекорд, если он изменился (может быть NULL). Тики
+  /// обновляют рекорд только в памяти; фронтенд вызывает функцию в
+  /// конце партии, shutdown() записывает рекорд сам.
+  void (*flushHighScore)(void);
+} BrickGameApi;
+
+/**
+ * @brief Тип точки входа плагина.
+ */
+typedef const BrickGameApi *(*BrickGameGetApiFn)(void);
+
+/**
+ * @brief Проверяет, что поле member присутствует в таблице плагина.
+ */
+#define BRICKGAME_API_HAS(api, member)                   \
+  ((api)->struct_size >= offsetof(BrickGameApi, member) + \
+                             sizeof(((BrickGameApi *)0)->member))
+
+/**
+ * @brief Точка входа игрового плагина.
+ *
+ * @return указатель на статическую таблицу функций игры
+ */
+EXPORT const BrickGameApi *brickgame_get_api(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICKGAME_COMMON_PLUGIN_API_H
@@ -0,0 +1,134 @@
+/**
+ * @file plugin_loader.h
+ * @brief Поиск и загрузка игровых плагинов BrickGame.
+ *
+ * Фронтенды не знают имён библиотек заранее: они сканируют каталог,
+ * открывают каждую разделяемую библиотеку вида lib*.so (.dylib на macOS),
+ * ищут в ней точку входа brickgame_get_api() и проверяют версию ABI.
+ *
+ * Сканирование только открывает библиотеки и читает таблицу функций:
+ * init() не вызывается, пока фронтенд не выберет игру и не вызовет
+ * plugin_start(). Список найденных плагинов фронтенд строит один раз.
+ */
+#ifndef BRICKGAME_COMMON_PLUGIN_LOADER_H
+#define BRICKGAME_COMMON_PLUGIN_LOADER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "plugin_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Максимальная длина пути к плагину.
+#define BRICKGAME_PLUGIN_PATH_MAX 512
+
+/// Максимальное число плагинов в одном каталоге.
+#define BRICKGAME_MAX_PLUGINS 16
+
+/**
+ * @brief Загруженный плагин.
+ */
+typedef struct {
+  void *handle;             ///< Дескриптор dlopen
+  const BrickGameApi *api;  ///< Таблица функций игры (кэшируется)
+  char path[BRICKGAME_PLUGIN_PATH_MAX];  ///< Путь к библиотеке
+  bool started;  ///< Вызван init() и ещё не вызван shutdown()
+} BrickGamePlugin;
+
+/**
+ * @brief Проверяет совместимость таблицы плагина с фронтендом.
+ *
+ * @param api таблица, полученная из brickgame_get_api()
+ * @return true, если версия ABI совпадает и обязательные функции заданы
+ */
+bool plugin_api_compatible(const BrickGameApi *api);
+
+/**
+ * @brief Загружает плагин по пути и запускает его (plugin_start()).
+ *
+ * @param path путь к разделяемой библиотеке
+ * @param plugin результат
+ * @param error буфер для сообщения об ошибке (может быть NULL)
+ * @param error_size размер буфера
+ * @return true при успехе
+ */
+bool plugin_load(const char *path, BrickGamePlugin *plugin, char *error,
+                 size_t error_size);
+
+/**
+ * @brief Вызывает init() плагина, если он ещё не запущен.
+ */
+void plugin_start(BrickGamePlugin *plugin);
+
+/**
+ * @brief Вызывает shutdown() запущенного плагина; библиотека остаётся
+ *        открытой и может быть запущена снова.
+ */
+void plugin_stop(BrickGamePlugin *plugin);
+
+/**
+ * @brief Выгружает плагин (plugin_stop() и dlclose).
+ */
+void plugin_unload(BrickGamePlugin *plugin);
+
+/**
+ * @brief Сканирует каталог и открывает все совместимые плагины.
+ *
+ * Плагины не запускаются (см. plugin_start()) и сортируются по имени
+ * игры.
+ *
+ * @param dir каталог для поиска
+ * @param plugins массив для результатов
+ * @param max_plugins размер массива
+ * @return число загруженных плагинов
+ */
+int plugin_scan(const char *dir, BrickGamePlugin *plugins, int max_plugins);
+
+/**
+ * @brief Регистрирует игры, слинкованные прямо в приложение.
+ *
+ * Доступно при сборке с BRICKGAME_STATIC_ENGINES; иначе встроенных игр
+ * нет и функция возвращает 0. У встроенных игр handle == NULL, а path
+ * имеет вид "builtin:<id>"; запускаются и выгружаются они теми же
+ * plugin_start() и plugin_unload().
+ *
+ * @param plugins массив для результатов
+ * @param max_plugins размер массива
+ * @return число встроенных игр
+ */
+int plugin_scan_builtin(BrickGamePlugin *plugins, int max_plugins);
+
+/**
+ * @brief Встроенные игры плюс плагины из каталога.
+ *
+ * Плагин с тем же id, что и встроенная игра, пропускается.
+ * Результат сортируется по имени игры.
+ *
+ * @param dir каталог плагинов (может быть NULL)
+ * @param plugins массив для результатов
+ * @param max_plugins размер массива
+ * @return общее число игр
+ */
+int plugin_scan_all(const char *dir, BrickGamePlugin *plugins,
+                    int max_plugins);
+
+/**
+ * @brief Проверяет, встроена ли игра в приложение (не загружена dlopen).
+ */
+bool plugin_is_builtin(const BrickGamePlugin *plugin);
+
+/**
+ * @brief Ищет плагин с заданным идентификатором среди загруженных.
+ *
+ * @return индекс плагина или -1
+ */
+int plugin_find(const BrickGamePlugin *plugins, int count, const char *id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICKGAME_COMMON_PLUGIN_LOADER_H
@@ -0,0 +1,41 @@
+/**
+ * @file splitmix64.h
+ * @brief Генератор SplitMix64 — общий для движков.
+ *
+ * Состояние — одно 64-битное слово, поэтому генератор лежит прямо в
+ * структуре состояния игры: копия структуры копирует и генератор, а
+ * клон партии продолжает ту же последовательность.
+ */
+#ifndef BRICKGAME_COMMON_SPLITMIX64_H
+#define BRICKGAME_COMMON_SPLITMIX64_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Шаг состояния SplitMix64 (дробная часть золотого сечения).
+#define SPLITMIX64_GAMMA 0x9E3779B97F4A7C15ull
+
+/**
+ * @brief Финализатор SplitMix64: перемешивает биты слова.
+ */
+static inline uint64_t splitmix64_mix(uint64_t z) {
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+/**
+ * @brief Следующее число генератора с состоянием *state.
+ */
+static inline uint64_t splitmix64_next(uint64_t *state) {
+  return splitmix64_mix(*state += SPLITMIX64_GAMMA);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICKGAME_COMMON_SPLITMIX64_H
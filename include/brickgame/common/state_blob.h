@@ -0,0 +1,183 @@
+/**
+ * @file state_blob.h
+ * @brief Формат бинарных снимков состояния игровой сессии.
+ *
+ * Снимок — это заголовок StateBlobHeader и полезная нагрузка, формат
+ * которой определяет сама игра. Числа хранятся в порядке байтов
+ * процессора: снимок предназначен для приостановки/возобновления и
+ * ветвления симуляций на той же платформе.
+ *
+ * StateWriter и StateReader — минимальные помощники сериализации без
+ * выделения памяти. Писатель с data == NULL только считает размер.
+ */
+#ifndef BRICKGAME_COMMON_STATE_BLOB_H
+#define BRICKGAME_COMMON_STATE_BLOB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Сигнатура снимка ("BGSS").
+#define BRICKGAME_STATE_MAGIC 0x53534742u
+
+/**
+ * @brief Идентификаторы игр в заголовке снимка.
+ */
+enum { BRICKGAME_STATE_TETRIS = 1, BRICKGAME_STATE_SNAKE = 2 };
+
+/**
+ * @brief Заголовок снимка состояния (16 байт).
+ */
+typedef struct {
+  uint32_t magic;         ///< BRICKGAME_STATE_MAGIC
+  uint16_t game;          ///< BRICKGAME_STATE_*
+  uint16_t version;       ///< Версия формата полезной нагрузки
+  uint32_t payload_size;  ///< Размер данных после заголовка
+  uint32_t reserved;      ///< Всегда 0
+} StateBlobHeader;
+
+/**
+ * @brief Последовательная запись в буфер снимка.
+ */
+typedef struct {
+  uint8_t *data;  ///< Буфер (NULL — только подсчёт размера)
+  size_t size;    ///< Размер буфера
+  size_t pos;     ///< Сколько байт требуется на текущий момент
+} StateWriter;
+
+/**
+ * @brief Последовательное чтение снимка.
+ */
+typedef struct {
+  const uint8_t *data;  ///< Данные снимка
+  size_t size;          ///< Размер данных
+  size_t pos;           ///< Текущая позиция
+  bool ok;              ///< false после попытки чтения за концом
+} StateReader;
+
+static inline void state_write(StateWriter *w, const void *src, size_t n) {
+  if (w->data && w->pos + n <= w->size) memcpy(w->data + w->pos, src, n);
+  w->pos += n;
+}
+
+static inline void state_write_u8(StateWriter *w, uint8_t v) {
+  state_write(w, &v, sizeof(v));
+}
+
+static inline void state_write_u16(StateWriter *w, uint16_t v) {
+  state_write(w, &v, sizeof(v));
+}
+
+static inline void state_write_u32(StateWriter *w, uint32_t v) {
+  state_write(w, &v, sizeof(v));
+}
+
+static inline void state_write_i32(StateWriter *w, int32_t v) {
+  state_write(w, &v, sizeof(v));
+}
+
+static inline void state_write_u64(StateWriter *w, uint64_t v) {
+  state_write(w, &v, sizeof(v));
+}
+
+static inline bool state_read(StateReader *r, void *dst, size_t n) {
+  if (!r->ok || r->pos + n > r->size) {
+    r->ok = false;
+    return false;
+  }
+  memcpy(dst, r->data + r->pos, n);
+  r->pos += n;
+  return true;
+}
+
+static inline uint8_t state_read_u8(StateReader *r) {
+  uint8_t v = 0;
+  state_read(r, &v, sizeof(v));
+  return v;
+}
+
+static inline uint16_t state_read_u16(StateReader *r) {
+  uint16_t v = 0;
+  state_read(r, &v, sizeof(v));
+  return v;
+}
+
+static inline uint32_t state_read_u32(StateReader *r) {
+  uint32_t v = 0;
+  state_read(r, &v, sizeof(v));
+  return v;
+}
+
+static inline int32_t state_read_i32(StateReader *r) {
+  int32_t v = 0;
+  state_read(r, &v, sizeof(v));
+  return v;
+}
+
+static inline uint64_t state_read_u64(StateReader *r) {
+  uint64_t v = 0;
+  state_read(r, &v, sizeof(v));
+  return v;
+}
+
+/**
+ * @brief Начинает снимок: резервирует место под заголовок.
+ */
+static inline void state_blob_begin(StateWriter *w, void *buf, size_t size) {
+  w->data = (uint8_t *)buf;
+  w->size = buf ? size : 0;
+  w->pos = sizeof(StateBlobHeader);
+}
+
+/**
+ * @brief Завершает снимок: записывает заголовок.
+ *
+ * @return полный размер снимка (если он больше размера буфера,
+ *         содержимое буфера не определено)
+ */
+static inline size_t state_blob_end(StateWriter *w, uint16_t game,
+                                    uint16_t version) {
+  if (w->data && w->pos <= w->size) {
+    StateBlobHeader header = {BRICKGAME_STATE_MAGIC, game, version,
+                              (uint32_t)(w->pos - sizeof(StateBlobHeader)),
+                              0};
+    memcpy(w->data, &header, sizeof(header));
+  }
+  return w->pos;
+}
+
+/**
+ * @brief Проверяет заголовок снимка и готовит чтение полезной нагрузки.
+ *
+ * @param r читатель
+ * @param buf снимок
+ * @param size размер снимка
+ * @param game ожидаемая игра (BRICKGAME_STATE_*)
+ * @param version ожидаемая версия формата
+ * @return false, если снимок повреждён или от другой игры/версии
+ */
+static inline bool state_blob_open(StateReader *r, const void *buf,
+                                   size_t size, uint16_t game,
+                                   uint16_t version) {
+  StateBlobHeader header;
+  r->data = (const uint8_t *)buf;
+  r->size = size;
+  r->pos = 0;
+  r->ok = buf != NULL;
+  if (!state_read(r, &header, sizeof(header))) return false;
+  r->ok = header.magic == BRICKGAME_STATE_MAGIC && header.game == game &&
+          header.version == version &&
+          header.payload_size == size - sizeof(header);
+  return r->ok;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICKGAME_COMMON_STATE_BLOB_H
@@ -0,0 +1,153 @@
+/**
+ * @file trace.h
+ * @brief Запись временной шкалы в формате Chrome trace-event (Perfetto).
+ *
+ * Фронтенды отмечают интервалы ключевых событий (тик движка, ввод,
+ * построение кадра, запись рекордов, отрисовка), а trace_stop()
+ * сохраняет их в JSON, который открывается в chrome://tracing или
+ * ui.perfetto.dev.
+ *
+ * Каждый поток пишет в собственный буфер без блокировок; буферы
+ * регистрируются в общем списке (CAS), а буфер завершившегося потока
+ * после выгрузки достаётся следующему. Если запись выключена,
+ * trace_begin() сводится к одной атомарной загрузке, и буфер не
+ * заводится вовсе.
+ *
+ * Имена и категории событий хранятся по указателю и должны жить до
+ * trace_stop() (строковые литералы).
+ */
+#ifndef BRICKGAME_COMMON_TRACE_H
+#define BRICKGAME_COMMON_TRACE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Событий в буфере одного потока; лишние отбрасываются.
+#define TRACE_BUFFER_EVENTS 65536
+
+/// Переменная окружения с путём файла трассы.
+#define TRACE_ENV "BRICKGAME_TRACE"
+
+/**
+ * @brief Открытый интервал (см. trace_begin()).
+ */
+typedef struct {
+  const char *name;      ///< Имя события (NULL — запись выключена)
+  const char *category;  ///< Категория
+  uint64_t start_us;     ///< Начало, мкс от trace_start()
+} TraceSpan;
+
+/**
+ * @brief Включает запись трассы.
+ *
+ * @param path файл, в который trace_stop() запишет JSON
+ * @return false, если path пуст
+ */
+bool trace_start(const char *path);
+
+/**
+ * @brief Включает запись, если задана переменная BRICKGAME_TRACE.
+ *
+ * @return true, если запись включена
+ */
+bool trace_start_from_env(void);
+
+/**
+ * @brief Выключает запись и сохраняет события всех потоков.
+ *
+ * @return false, если запись не была включена или файл не записан
+ */
+bool trace_stop(void);
+
+/**
+ * @brief Вызывается в дочернем процессе после fork().
+ *
+ * Унаследованные события родителя отбрасываются, а трасса ребёнка
+ * пишется в "<path>.<pid>", чтобы не затереть файл родителя.
+ */
+void trace_after_fork(void);
+
+/**
+ * @brief Включена ли запись.
+ */
+bool trace_enabled(void);
+
+/**
+ * @brief Время трассы в микросекундах от trace_start().
+ */
+uint64_t trace_now_us(void);
+
+/**
+ * @brief Записывает завершённый интервал текущего потока.
+ *
+ * @param name имя события
+ * @param category категория
+ * @param start_us начало (trace_now_us())
+ * @param end_us конец (trace_now_us())
+ */
+void trace_complete(const char *name, const char *category,
+                    uint64_t start_us, uint64_t end_us);
+
+/**
+ * @brief Задаёт имя текущего потока на временной шкале.
+ *
+ * Память не выделяет: имя запоминается в потоке и попадает в буфер при
+ * первом событии.
+ *
+ * @param name имя потока (строковый литерал)
+ */
+void trace_set_thread_name(const char *name);
+
+/**
+ * @brief Число событий, не поместившихся в буферы потоков.
+ */
+uint64_t trace_dropped(void);
+
+/**
+ * @brief Начинает интервал; при выключенной записи ничего не делает.
+ */
+static inline TraceSpan trace_begin(const char *name, const char *category) {
+  TraceSpan span = {NULL, category, 0};
+  if (trace_enabled()) {
+    span.name = name;
+    span.start_us = trace_now_us();
+  }
+  return span;
+}
+
+/**
+ * @brief Завершает интервал trace_begin().
+ */
+static inline void trace_end(const TraceSpan *span) {
+  if (span->name) {
+    trace_complete(span->name, span->category, span->start_us,
+                   trace_now_us());
+  }
+}
+
+#ifdef __cplusplus
+}
+
+/**
+ * @brief Интервал трассы на время жизни объекта (RAII).
+ */
+class TraceScope {
+ public:
+  TraceScope(const char *name, const char *category)
+      : span_(trace_begin(name, category)) {}
+  ~TraceScope() { trace_end(&span_); }
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+ private:
+  TraceSpan span_;
+};
+#endif
+
+#endif  // BRICKGAME_COMMON_TRACE_H
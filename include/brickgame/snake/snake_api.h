@@ -15,36 +15,117 @@
 #define S21_SNAKE_API_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
+#include "../common/plugin_api.h"
 #include "../common/types.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * \brief Имя функции внешнего API Snake.
+ *
+ * При сборке со встроенными играми (BRICKGAME_STATIC_ENGINES) все движки
+ * линкуются в один бинарник, поэтому их C API получает префикс игры.
+ */
+#ifdef BRICKGAME_STATIC_ENGINES
+#define SNAKE_API(name) snake_##name
+#else
+#define SNAKE_API(name) name
+#endif
+
 /**
  * \brief Проверяет, выиграл ли игрок.
  * \return true, если игрок победил, иначе false.
  */
-EXPORT bool isVictory(void);
+EXPORT bool SNAKE_API(isVictory)(void);
 
 /**
  * \brief Обрабатывает ввод пользователя и передаёт его в игру.
  * \param action действие пользователя (клавиша).
  * \param hold   флаг удержания действия (например, ускорение).
  */
-EXPORT void userInput(UserAction_t action, bool hold);
+EXPORT void SNAKE_API(userInput)(UserAction_t action, bool hold);
 /**
  * \brief Обновляет текущее состояние игры и возвращает структуру для отрисовки.
- * \return GameInfo_t актуальное состояние игрового поля и статистики.
+ * \return GameInfo_t актуальное состояние игрового поля и статистики
+ *         (поле лежит в буфере игры и действительно до следующего кадра).
+ */
+EXPORT GameInfo_t SNAKE_API(updateCurrentState)();
+/**
+ * \brief Продвигает игру на прошедшее реальное время и возвращает кадр.
+ *
+ * Выполняет столько шагов змейки, сколько их набралось за elapsed_ms,
+ * поэтому фронтенд может вызывать функцию с постоянным интервалом.
+ *
+ * \param elapsed_ms время с предыдущего вызова, мс.
+ * \return GameInfo_t актуальное состояние (как у updateCurrentState()).
  */
-EXPORT GameInfo_t updateCurrentState();
+EXPORT GameInfo_t SNAKE_API(advanceState)(int elapsed_ms);
 /**
  * \brief Проверяет, окончена ли игра (проигрыш).
  * \return true, если игра окончена, иначе false.
  */
-EXPORT bool isGameOver();
-
+EXPORT bool SNAKE_API(isGameOver)();
+/**
+ * \brief Отпускает кадр updateCurrentState() (обнуляет указатели).
+ *
+ * Кадр принадлежит игре, поэтому вызов необязателен.
+ * \param info структура, полученная из updateCurrentState().
+ */
+EXPORT void SNAKE_API(freeGameInfo)(GameInfo_t* info);
+/**
+ * \brief Сохраняет полное состояние сессии в бинарный снимок.
+ * \param buf  буфер (NULL — только подсчёт размера).
+ * \param size размер буфера.
+ * \return полный размер снимка; если он больше size, снимок не записан.
+ */
+EXPORT size_t SNAKE_API(saveGameState)(void* buf, size_t size);
+/**
+ * \brief Восстанавливает сессию из снимка saveGameState().
+ * \param buf  снимок.
+ * \param size размер снимка.
+ * \return true при успехе; при ошибке состояние игры не меняется.
+ */
+EXPORT bool SNAKE_API(loadGameState)(const void* buf, size_t size);
+/**
+ * \brief Пишет поле в упакованном виде: 2 бита на клетку, формат
+ *        packed_grid.h (50 байт на поле 10x20).
+ * \param buf  буфер (NULL — только подсчёт размера).
+ * \param size размер буфера.
+ * \return размер упакованного поля; если он больше size, поле не записано.
+ */
+EXPORT size_t SNAKE_API(exportPackedField)(void* buf, size_t size);
+/**
+ * \brief Устанавливает аллокатор для выделений игры (см. alloc_hooks.h).
+ * \param allocator аллокатор (NULL — malloc/free).
+ */
+EXPORT void SNAKE_API(setAllocator)(const BrickGameAllocator* allocator);
+/**
+ * \brief Выделения памяти за последний updateCurrentState()/advanceState().
+ *
+ * Ход змейки и кадр не выделяют память: все счётчики равны нулю.
+ * \return счётчики выделений последнего тика.
+ */
+EXPORT BrickGameAllocStats SNAKE_API(tickAllocStats)(void);
+/**
+ * \brief Записывает рекорд в snake_highscore.txt, если он вырос.
+ *
+ * Тик обновляет рекорд только в памяти; фронтенд вызывает функцию в
+ * конце партии (завершение плагина тоже записывает рекорд).
+ */
+EXPORT void SNAKE_API(flushHighScore)(void);
+/**
+ * \brief Таблица функций Snake под уникальным именем.
+ *
+ * В отличие от brickgame_get_api() доступна и при сборке со встроенными
+ * играми.
+ *
+ * \return таблица функций игры.
+ */
+EXPORT const BrickGameApi* brickgame_snake_get_api(void);
 
 
 #ifdef __cplusplus
@@ -0,0 +1,175 @@
+/**
+ * @file snake_arena.hpp
+ * @brief Арена: много змеек на одном большом поле.
+ *
+ * Каждая клетка сетки хранит владельца: пусто, яблоко или номер змейки.
+ * Поэтому столкновение головы с телом проверяется одним чтением клетки,
+ * а встречные головы — по отметке «клетка занята в этом тике», и тик
+ * стоит O(число змеек), независимо от размера поля.
+ *
+ * Шаг, столкновение и рост устроены так же, как в SnakeGame: голова
+ * сдвигается на NextHeadPosition(), выход за поле или занятая на начало
+ * тика клетка — гибель, яблоко — рост на клетку. Все змейки ходят
+ * одновременно; две головы в одной клетке погибают обе. Тело погибшей
+ * змейки освобождает клетки.
+ *
+ * Яблоки ставятся в случайные свободные клетки из общего индекса
+ * свободных клеток (вставка, удаление и выбор — O(1)).
+ */
+#ifndef S21_SNAKE_ARENA_HPP
+#define S21_SNAKE_ARENA_HPP
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../common/types.h"
+#include "snake_game.hpp"
+
+namespace s21 {
+
+class EXPORT SnakeArena {
+ public:
+  /// Клетка свободна.
+  static constexpr std::uint32_t kEmpty = 0;
+  /// В клетке яблоко. Остальные значения — номер змейки + 1.
+  static constexpr std::uint32_t kApple = 0xFFFFFFFFu;
+
+  /**
+   * @brief Создаёт пустую арену.
+   * @param width Ширина поля.
+   * @param height Высота поля.
+   * @param apples Сколько яблок держать на поле.
+   * @param seed Зерно генератора (арена детерминирована).
+   */
+  SnakeArena(int width, int height, int apples, std::uint32_t seed);
+
+  /**
+   * @brief Добавляет змейку; тело тянется от головы против direction.
+   * @param head Позиция головы.
+   * @param direction Направление движения.
+   * @param length Длина (не меньше 1).
+   * @return Номер змейки или -1, если клетки заняты или вне поля.
+   */
+  int AddSnake(SnakeSegment head, SnakeDirection direction, int length);
+
+  /**
+   * @brief Добавляет змейку в случайное свободное место.
+   * @param length Длина змейки.
+   * @return Номер змейки или -1, если место не нашлось.
+   */
+  int AddRandomSnake(int length);
+
+  /**
+   * @brief Ставит яблоко в свободную клетку.
+   * @return false, если клетка занята или вне поля.
+   */
+  bool PlaceApple(SnakeSegment cell);
+
+  /**
+   * @brief Задаёт направление на следующий тик (разворот игнорируется).
+   */
+  void Steer(int id, SnakeDirection direction);
+
+  /**
+   * @brief Выбирает направления всех живых змеек простым ботом.
+   *
+   * Бот продолжает движение, если впереди свободно, иначе
+   * поворачивает в свободную сторону. O(1) на змейку.
+   */
+  void SteerBots();
+
+  /**
+   * @brief Один тик: все живые змейки делают шаг.
+   */
+  void Tick();
+
+  int Width() const { return width_; }
+  int Height() const { return height_; }
+  int SnakeCount() const { return static_cast<int>(snakes_.size()); }
+  int AliveCount() const { return alive_; }
+  int AppleCount() const { return apples_; }
+  std::uint64_t Ticks() const { return ticks_; }
+
+  /**
+   * @brief Число свободных клеток (размер индекса свободных клеток).
+   */
+  int FreeCellCount() const { return static_cast<int>(free_cells_.size()); }
+
+  /**
+   * @brief Владелец клетки: kEmpty, kApple или номер змейки + 1.
+   */
+  std::uint32_t Owner(int x, int y) const {
+    return owner_[static_cast<std::size_t>(y) * width_ + x];
+  }
+
+  bool IsAlive(int id) const { return snakes_[id].alive; }
+  int Length(int id) const { return static_cast<int>(snakes_[id].size); }
+  int Score(int id) const { return snakes_[id].score; }
+  SnakeDirection Direction(int id) const { return snakes_[id].direction; }
+
+  /**
+   * @brief Позиция головы змейки.
+   */
+  SnakeSegment Head(int id) const;
+
+ private:
+  /**
+   * @brief Змейка арены: тело — кольцевой буфер индексов клеток.
+   */
+  struct Snake {
+    std::vector<std::uint32_t> body;  ///< Кольцо; body[head] — голова
+    std::size_t head = 0;             ///< Индекс головы в кольце
+    std::size_t size = 0;             ///< Длина змейки
+    SnakeDirection direction = SnakeDirection::Right;
+    SnakeDirection next_direction = SnakeDirection::Right;
+    int score = 0;
+    bool alive = true;
+  };
+
+  /// Признак «клетки нет в индексе свободных».
+  static constexpr std::uint32_t kNotFree = 0xFFFFFFFFu;
+  /// Цель хода за пределами поля.
+  static constexpr std::uint32_t kOutside = 0xFFFFFFFFu;
+
+  std::uint32_t CellIndex(SnakeSegment cell) const {
+    return static_cast<std::uint32_t>(cell.y) * width_ + cell.x;
+  }
+  SnakeSegment CellAt(std::uint32_t index) const {
+    return {static_cast<int>(index % width_), static_cast<int>(index / width_)};
+  }
+  bool Inside(SnakeSegment cell) const {
+    return cell.x >= 0 && cell.x < width_ && cell.y >= 0 && cell.y < height_;
+  }
+
+  void Occupy(std::uint32_t cell, std::uint32_t owner);
+  void Release(std::uint32_t cell);
+  void PushFront(Snake& snake, std::uint32_t cell);
+  std::uint32_t Tail(const Snake& snake) const;
+  void Kill(int id);
+  void RefillApples();
+
+  int width_;
+  int height_;
+  int apple_target_;  ///< Сколько яблок держать на поле
+  int apples_ = 0;    ///< Яблок на поле
+  int alive_ = 0;     ///< Живых змеек
+  std::uint64_t ticks_ = 0;
+
+  std::vector<std::uint32_t> owner_;       ///< Владелец каждой клетки
+  std::vector<std::uint32_t> free_cells_;  ///< Индекс свободных клеток
+  std::vector<std::uint32_t> free_pos_;    ///< Позиция клетки в индексе
+  std::vector<Snake> snakes_;
+
+  /// Рабочие буферы тика (не выделяются заново каждый тик).
+  std::vector<std::uint32_t> targets_;
+  std::vector<std::uint8_t> dying_;
+  std::vector<std::uint32_t> claim_tick_;  ///< Тик последней заявки головы
+  std::vector<std::uint32_t> claim_by_;    ///< Чья голова подала заявку
+
+  std::mt19937 gen_;
+};
+
+}  // namespace s21
+
+#endif  // S21_SNAKE_ARENA_HPP
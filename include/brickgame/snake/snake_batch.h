@@ -0,0 +1,98 @@
+/**
+ * @file snake_batch.h
+ * @brief Пакет сред Snake для обучения с подкреплением.
+ *
+ * Один вызов snake_batch_step() делает шаг во всех N играх пакета:
+ * действия берутся из непрерывного массива, наблюдения, награды и
+ * признаки конца эпизода пишутся в непрерывные буферы вызывающего.
+ * Каждая игра — SnakeGame на классическом поле, шаг — ровно один
+ * SnakeGame::Update(); ни userInput(), ни кадров int** на пути нет.
+ *
+ * Наблюдение одной среды — SNAKE_BATCH_OBS_SIZE чисел float:
+ * - три плоскости 20x10 по строкам: тело, голова, яблоко (0 или 1);
+ * - признаки: длина / число клеток и направление (one-hot Up, Down,
+ *   Left, Right).
+ *
+ * Награда — число съеденных за шаг яблок. Закончившаяся игра (победа,
+ * поражение или max_steps шагов) сразу начинается заново: done = 1, а
+ * наблюдение уже относится к новой партии.
+ */
+#ifndef BRICKGAME_SNAKE_BATCH_H
+#define BRICKGAME_SNAKE_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../common/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Ширина и высота поля среды.
+#define SNAKE_BATCH_WIDTH 10
+#define SNAKE_BATCH_HEIGHT 20
+/// Плоскостей поля в наблюдении.
+#define SNAKE_BATCH_PLANES 3
+/// Скалярных признаков в наблюдении.
+#define SNAKE_BATCH_FEATURES 5
+/// Чисел в наблюдении одной среды.
+#define SNAKE_BATCH_OBS_SIZE                                          \
+  (SNAKE_BATCH_PLANES * SNAKE_BATCH_WIDTH * SNAKE_BATCH_HEIGHT + \
+   SNAKE_BATCH_FEATURES)
+
+typedef struct SnakeBatch SnakeBatch;
+
+/**
+ * @brief Создаёт пакет сред.
+ *
+ * Рекорд в файл не пишется. Среда i получает зерно seed + i.
+ *
+ * @param count     число сред (больше 0)
+ * @param seed      зерно пакета
+ * @param max_steps предел шагов эпизода (0 — без предела)
+ * @return пакет или NULL при ошибке
+ */
+EXPORT SnakeBatch *snake_batch_create(int count, uint32_t seed,
+                                      int max_steps);
+
+/**
+ * @brief Освобождает пакет.
+ */
+EXPORT void snake_batch_destroy(SnakeBatch *batch);
+
+/**
+ * @brief Число сред в пакете.
+ */
+EXPORT int snake_batch_count(const SnakeBatch *batch);
+
+/**
+ * @brief Начинает все эпизоды заново.
+ *
+ * @param batch        пакет
+ * @param observations count * SNAKE_BATCH_OBS_SIZE чисел (может быть
+ *                     NULL)
+ */
+EXPORT void snake_batch_reset(SnakeBatch *batch, float *observations);
+
+/**
+ * @brief Шаг всех сред пакета.
+ *
+ * @param batch        пакет
+ * @param actions      count действий UserAction_t: Up, Down, Left,
+ *                     Right поворачивают, остальные сохраняют
+ *                     направление
+ * @param observations count * SNAKE_BATCH_OBS_SIZE чисел (может быть
+ *                     NULL)
+ * @param rewards      count наград (может быть NULL)
+ * @param dones        count признаков конца эпизода (может быть NULL)
+ */
+EXPORT void snake_batch_step(SnakeBatch *batch, const int32_t *actions,
+                             float *observations, float *rewards,
+                             uint8_t *dones);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICKGAME_SNAKE_BATCH_H
@@ -10,17 +10,31 @@
  * - сохранение и загрузка рекордов;
  * - поддержка игровых состояний (Ready, Running, Paused, Won, Lost).
  *
+ * Игра — шаблон BasicSnakeGame<Width, Height>. При размерах, известных
+ * на этапе компиляции (классическое поле SnakeGame = 10x20), поле и
+ * тело змейки лежат прямо в объекте, а проверки границ и индексы клеток
+ * считаются с константами. DynamicSnakeGame
+ * (BasicSnakeGame<kDynamicExtent, kDynamicExtent>) получает размер поля
+ * в конструкторе и хранит клетки в куче.
  */
 #ifndef S21_SNAKE_GAME_HPP
 #define S21_SNAKE_GAME_HPP
 
+#include <algorithm>
 #include <array>
-#include <deque>
+#include <cstddef>
+#include <cstdint>
 #include <map>
-#include <random>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "../common/alloc_hooks.h"
 #include "../common/game_constants.h"
+#include "../common/input_queue.h"
+#include "../common/packed_grid.h"
+#include "../common/splitmix64.h"
+#include "../common/state_blob.h"
 #include "../common/types.h"
 
 namespace s21 {
@@ -34,21 +48,386 @@ struct SnakeSegment {
 };
 
 /**
- * @brief Максимальная длина змейки для победы.
+ * @brief Проверяет, противоположны ли два направления.
+ * @param from Исходное направление.
+ * @param to Новое направление.
+ * @return true, если противоположны.
+ */
+constexpr bool AreOppositeDirections(SnakeDirection from, SnakeDirection to) {
+  return (from == SnakeDirection::Up && to == SnakeDirection::Down) ||
+         (from == SnakeDirection::Down && to == SnakeDirection::Up) ||
+         (from == SnakeDirection::Left && to == SnakeDirection::Right) ||
+         (from == SnakeDirection::Right && to == SnakeDirection::Left);
+}
+
+/**
+ * @brief Клетка, в которую голова попадает за один шаг.
+ * @param head Текущая позиция головы.
+ * @param direction Направление движения.
+ * @return Новая позиция головы (может быть за пределами поля).
+ */
+constexpr SnakeSegment NextHeadPosition(SnakeSegment head,
+                                        SnakeDirection direction) {
+  switch (direction) {
+    case SnakeDirection::Up:
+      head.y -= 1;
+      break;
+    case SnakeDirection::Down:
+      head.y += 1;
+      break;
+    case SnakeDirection::Left:
+      head.x -= 1;
+      break;
+    case SnakeDirection::Right:
+      head.x += 1;
+      break;
+  }
+  return head;
+}
+
+/**
+ * @brief Максимальная длина змейки для победы на классическом поле.
+ *
+ * В общем случае змейка побеждает, заняв всё поле.
  */
 static constexpr int kMaxSnakeLength = 200;
 
-class SnakeGame {
+/**
+ * @brief Версия формата снимка состояния Snake.
+ */
+static constexpr std::uint16_t kSnakeStateVersion = 5;
+
+/**
+ * @brief Максимум шагов, которые Advance() догоняет за один вызов.
+ *
+ * После долгой остановки фронтенда остаток времени отбрасывается,
+ * чтобы змейка не «телепортировалась» через всё поле.
+ */
+static constexpr int kMaxCatchUpSteps = 32;
+
+/**
+ * @brief Аллокатор и счётчики выделений библиотеки Snake.
+ *
+ * Через него идут все выделения игры (см. alloc_hooks.h).
+ */
+AllocHooks& SnakeAllocHooks();
+
+/**
+ * @brief Размер поля, который задаётся при создании игры.
+ */
+inline constexpr int kDynamicExtent = -1;
+
+/**
+ * @brief Наименьшая сторона поля DynamicSnakeGame (стартовая змейка — 4).
+ */
+inline constexpr int kMinBoardSide = 5;
+
+/**
+ * @brief Наибольшая сторона поля (координаты в снимке — по байту).
+ */
+inline constexpr int kMaxBoardSide = 255;
+
+/**
+ * @brief Размер поля известен на этапе компиляции.
+ */
+template <int Width, int Height>
+inline constexpr bool kFixedBoard =
+    Width != kDynamicExtent && Height != kDynamicExtent;
+
+/**
+ * @brief Клетки поля Width x Height, по 2 бита (см. packed_grid.h).
+ *
+ * Для фиксированного размера байты лежат в std::array внутри объекта
+ * (50 байт на поле 10x20), для kDynamicExtent — в std::vector размера
+ * из конструктора.
+ */
+template <int Width, int Height>
+class SnakeGrid {
  public:
+  static constexpr bool kFixed = kFixedBoard<Width, Height>;
+
+  SnakeGrid()
+    requires(kFixed)
+  = default;
+  SnakeGrid(int width, int height)
+    requires(!kFixed)
+      : width_(width), height_(height),
+        bytes_(PACKED_GRID_BYTES(width, height)) {}
+
+  constexpr int width() const {
+    if constexpr (kFixed) {
+      return Width;
+    } else {
+      return width_;
+    }
+  }
+  constexpr int height() const {
+    if constexpr (kFixed) {
+      return Height;
+    } else {
+      return height_;
+    }
+  }
+  constexpr int cells() const { return width() * height(); }
+
+  /**
+   * @brief Лежит ли клетка на поле (одно беззнаковое сравнение на ось).
+   */
+  constexpr bool Contains(SnakeSegment cell) const {
+    return static_cast<unsigned>(cell.x) < static_cast<unsigned>(width()) &&
+           static_cast<unsigned>(cell.y) < static_cast<unsigned>(height());
+  }
+
+  CellType get(int x, int y) const {
+    return static_cast<CellType>(packed_grid_get(bytes_.data(), index(x, y)));
+  }
+  void set(int x, int y, CellType cell) {
+    packed_grid_set(bytes_.data(), index(x, y), static_cast<unsigned>(cell));
+  }
+  void fill(CellType cell) {
+    packed_grid_fill(bytes_.data(), static_cast<std::size_t>(cells()),
+                     static_cast<unsigned>(cell));
+  }
+
+  /**
+   * @brief Распаковывает строку y в row (width() значений int).
+   */
+  void UnpackRow(int y, int* row) const {
+    packed_grid_unpack_row(bytes_.data(), index(0, y), width(), row);
+  }
+
+  std::uint8_t* data() { return bytes_.data(); }
+  const std::uint8_t* data() const { return bytes_.data(); }
+  std::size_t size() const { return bytes_.size(); }
+
+ private:
+  std::size_t index(int x, int y) const {
+    return static_cast<std::size_t>(y) * width() + x;
+  }
+
+  int width_ = Width;
+  int height_ = Height;
+  std::conditional_t<
+      kFixed,
+      std::array<std::uint8_t, kFixed ? PACKED_GRID_BYTES(Width, Height) : 1>,
+      std::vector<std::uint8_t>>
+      bytes_{};
+};
+
+/**
+ * @brief Тело змейки: кольцевой буфер на всё поле.
+ *
+ * Ёмкость покрывает всё поле, поэтому ход змейки не выделяет память.
+ * Элемент 0 — голова, последний — хвост. Координаты хранятся по байту
+ * (сторона поля не больше kMaxBoardSide): тело змейки на поле 10x20
+ * занимает 402 байта.
+ */
+template <int Width, int Height>
+class SnakeBody {
+ public:
+  static constexpr bool kFixed = kFixedBoard<Width, Height>;
+
+  SnakeBody()
+    requires(kFixed)
+  = default;
+  explicit SnakeBody(int cells)
+    requires(!kFixed)
+      : cells_(static_cast<std::size_t>(cells) + 1) {}
+
+  constexpr std::size_t capacity() const {
+    if constexpr (kFixed) {
+      return static_cast<std::size_t>(Width) * Height + 1;
+    } else {
+      return cells_.size();
+    }
+  }
+
+  void clear() {
+    head_ = 0;
+    size_ = 0;
+  }
+  bool empty() const { return size_ == 0; }
+  std::size_t size() const { return size_; }
+  SnakeSegment operator[](std::size_t i) const {
+    return Unpack(cells_[(head_ + i) % capacity()]);
+  }
+  SnakeSegment front() const { return Unpack(cells_[head_]); }
+  SnakeSegment back() const { return (*this)[size_ - 1u]; }
+  void push_front(const SnakeSegment& segment) {
+    head_ = static_cast<std::uint16_t>((head_ + capacity() - 1) % capacity());
+    cells_[head_] = Pack(segment);
+    ++size_;
+  }
+  void push_back(const SnakeSegment& segment) {
+    cells_[(head_ + size_) % capacity()] = Pack(segment);
+    ++size_;
+  }
+  void pop_back() { --size_; }
+
+ private:
+  struct Cell {
+    std::uint8_t x;
+    std::uint8_t y;
+  };
+
+  static Cell Pack(const SnakeSegment& segment) {
+    return {static_cast<std::uint8_t>(segment.x),
+            static_cast<std::uint8_t>(segment.y)};
+  }
+  static SnakeSegment Unpack(Cell cell) { return {cell.x, cell.y}; }
+
+  std::conditional_t<kFixed,
+                     std::array<Cell, kFixed ? Width * Height + 1 : 1>,
+                     std::vector<Cell>>
+      cells_{};
+  std::uint16_t head_ = 0;
+  std::uint16_t size_ = 0;
+};
+
+/**
+ * @brief Генератор яблок: SplitMix64 (см. splitmix64.h).
+ *
+ * 8 байт состояния вместо 2,5 КБ у std::mt19937; подходит
+ * распределениям <random> как UniformRandomBitGenerator.
+ */
+struct SnakeRng {
+  using result_type = std::uint64_t;
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return UINT64_MAX; }
+  result_type operator()() { return splitmix64_next(&state); }
+
+  std::uint64_t state = 0;
+};
+
+/**
+ * @brief Всё состояние партии Snake одной структурой.
+ *
+ * Для поля фиксированного размера (SnakeState) структура тривиально
+ * копируема и не ссылается на кучу: клон партии для поиска — один
+ * memcpy нескольких сотен байт. Буферы кадра GetFrame() и настройки
+ * объекта (файл рекорда) в неё не входят.
+ */
+template <int Width, int Height>
+struct BasicSnakeState {
+  BasicSnakeState()
+    requires(kFixedBoard<Width, Height>)
+  = default;
+  BasicSnakeState(int width, int height)
+    requires(!kFixedBoard<Width, Height>)
+      : body(width * height), field(width, height) {}
+
+  SnakeBody<Width, Height> body;   ///< Элемент 0 — голова
+  SnakeGrid<Width, Height> field;  ///< Клетки: пусто, змейка, яблоко
+  InputQueue turns{};              ///< Повороты со временем прихода
+  SnakeRng rng;                    ///< Генератор яблок
+  SnakeDirection direction = SnakeDirection::Right;
+  /// Направление следующего шага (после поворотов из очереди).
+  SnakeDirection next_direction = SnakeDirection::Right;
+  SnakeGameState state = SnakeGameState::Ready;
+  int length = 0;
+  int apple_x = 0;
+  int apple_y = 0;
+  int score = 0;
+  int high_score = 0;
+  int level = 1;
+  int speed = 0;  ///< Длительность шага, мс (меньше — быстрее)
+  /// Накопленное, но ещё не отыгранное время для Advance(), мс.
+  int pending_ms = 0;
+  /// Часы сессии для отметок времени ввода, мс (идут только в Running).
+  std::uint32_t clock_ms = 0;
+  bool accelerated = false;  ///< Ускорение по удержанию клавиши
+};
+
+/**
+ * @brief Состояние классической партии 10x20.
+ */
+using SnakeState = BasicSnakeState<kGameWidth, kGameHeight>;
+
+static_assert(std::is_trivially_copyable_v<SnakeState>,
+              "SnakeState is cloned with memcpy");
+
+template <int Width, int Height>
+class EXPORT BasicSnakeGame {
+ public:
+  static constexpr bool kFixed = kFixedBoard<Width, Height>;
+  using State = BasicSnakeState<Width, Height>;
+
   /**
    * @brief Конструктор. Загружает рекорд и инициализирует игру.
    */
-  SnakeGame();
+  BasicSnakeGame()
+    requires kFixed;
+
+  /**
+   * @brief Конструктор игры на поле заданного размера.
+   *
+   * Стороны ограничиваются диапазоном [kMinBoardSide, kMaxBoardSide].
+   *
+   * @param width Ширина поля.
+   * @param height Высота поля.
+   */
+  BasicSnakeGame(int width, int height)
+    requires(!kFixed);
 
   /**
    * @brief Деструктор.
    */
-  ~SnakeGame() = default;
+  ~BasicSnakeGame() = default;
+
+  int FieldWidth() const { return session_.field.width(); }
+  int FieldHeight() const { return session_.field.height(); }
+  int Score() const { return session_.score; }
+  int Length() const { return static_cast<int>(session_.body.size()); }
+  SnakeDirection Direction() const { return session_.direction; }
+
+  /**
+   * @brief Голова змейки ({-1, -1}, пока партия не началась).
+   */
+  SnakeSegment Head() const {
+    return session_.body.empty() ? SnakeSegment{-1, -1}
+                                 : session_.body.front();
+  }
+
+  /**
+   * @brief Упакованное поле (см. SnakeGrid).
+   */
+  const SnakeGrid<Width, Height>& Field() const { return session_.field; }
+
+  /**
+   * @brief Задаёт зерно генератора яблок (воспроизводимые партии).
+   */
+  void Seed(std::uint32_t seed) { session_.rng.state = seed; }
+
+  /**
+   * @brief Состояние партии целиком (клон для поиска и симуляций).
+   */
+  const State& Session() const { return session_; }
+
+  /**
+   * @brief Заменяет состояние партии, например клоном из Session().
+   *
+   * Рекорд в файл не пишется.
+   *
+   * @return false, если размер поля другой (состояние не меняется)
+   */
+  bool RestoreSession(const State& session);
+
+  /**
+   * @brief Включает или выключает запись рекорда в файл.
+   *
+   * Без файла рекорд считается только в памяти (пакетные среды,
+   * симуляции).
+   */
+  void SetHighScoreFile(bool enabled) { high_score_file_ = enabled; }
+
+  /**
+   * @brief Записывает рекорд в snake_highscore.txt, если он вырос с
+   *        прошлой записи.
+   *
+   * Тики файл не трогают: вызывается в конце партии, вне тика.
+   */
+  void FlushHighScore();
 
   /**
    * @brief Полный сброс игры (счёт, уровень, змейка, поле).
@@ -61,12 +440,29 @@ class SnakeGame {
   void Update();
 
   /**
-   * @brief Меняет направление движения змейки (если допустимо).
+   * @brief Ставит поворот в очередь (если он допустим).
+   *
+   * Поворот проверяется относительно последнего поворота в очереди и
+   * применяется на ближайшем шаге, где для него осталось место (см.
+   * SetTurnsPerTick()), поэтому быстрые повороты внутри одного шага не
+   * теряются. Ускорение по hold включается сразу.
+   *
    * @param action Действие пользователя (Up, Down, Left, Right).
    * @param hold Флаг удержания клавиши для ускорения.
    */
   void ChangeDirection(UserAction_t action, bool hold = false);
 
+  /**
+   * @brief Сколько поворотов из очереди применяется за один шаг.
+   * @param turns Число поворотов (не меньше 1).
+   */
+  void SetTurnsPerTick(int turns);
+
+  /**
+   * @brief Число поворотов, ожидающих своего шага.
+   */
+  int QueuedTurns() const { return static_cast<int>(session_.turns.count); }
+
   /**
    * @brief Управляет ускорением змейки.
    * @param enable true — включить ускорение, false — выключить.
@@ -90,10 +486,23 @@ class SnakeGame {
 
   /**
    * @brief Возвращает полную информацию о текущем состоянии игры.
+   *
+   * Поле выделяется через SnakeAllocHooks(); освобождение — FreeGameInfo().
    * @return Структура GameInfo_t (поле, очки, уровень, скорость, пауза).
    */
   GameInfo_t GetGameInfo() const;
 
+  /**
+   * @brief Возвращает кадр игры в постоянном буфере объекта.
+   *
+   * В отличие от GetGameInfo() память не выделяется: поле указывает на
+   * внутренний буфер, который перезаписывается следующим вызовом.
+   * Освобождать кадр не нужно.
+   *
+   * @return Структура GameInfo_t (поле, очки, уровень, скорость, пауза).
+   */
+  GameInfo_t GetFrame();
+
   /**
    * @brief Получает текущее состояние игры.
    * @return Ready, Running, Paused, Won или Lost.
@@ -111,6 +520,52 @@ class SnakeGame {
    */
   void Tick();
 
+  /**
+   * @brief Продвигает игру на прошедшее реальное время.
+   *
+   * Время копится, и за вызов выполняется столько шагов по одной клетке,
+   * сколько их набралось (шаг длится speed_ мс, не более
+   * kMaxCatchUpSteps за вызов). Скорость змейки не зависит от частоты
+   * вызовов фронтенда.
+   *
+   * @param elapsed_ms Время с предыдущего вызова, мс.
+   * @return Число выполненных шагов.
+   */
+  int Advance(int elapsed_ms);
+
+  /**
+   * @brief Сохраняет полное состояние сессии в бинарный снимок.
+   *
+   * В снимок входят тело, направления, яблоко, поле, счёт, уровень,
+   * скорость и состояние генератора случайных чисел.
+   *
+   * @param buf Буфер (nullptr — только подсчёт размера).
+   * @param size Размер буфера.
+   * @return Полный размер снимка; если он больше size, снимок не записан.
+   */
+  std::size_t SaveState(void* buf, std::size_t size) const;
+
+  /**
+   * @brief Пишет поле в упакованном виде (2 бита на клетку).
+   *
+   * Формат — packed_grid.h, значения — CellType; поле 10x20 занимает
+   * 50 байт.
+   *
+   * @param buf Буфер (nullptr — только подсчёт размера).
+   * @param size Размер буфера.
+   * @return Размер упакованного поля; если он больше size, поле не
+   *         записано.
+   */
+  std::size_t ExportPackedField(void* buf, std::size_t size) const;
+
+  /**
+   * @brief Восстанавливает сессию из снимка SaveState().
+   * @param buf Снимок.
+   * @param size Размер снимка.
+   * @return true при успехе; при ошибке состояние не меняется.
+   */
+  bool LoadState(const void* buf, std::size_t size);
+
  private:
   /**
    * @brief Передвигает змейку на один шаг. Проверяет столкновения и рост.
@@ -180,13 +635,21 @@ class SnakeGame {
    */
   void ClearField();
 
+  /**
+   * @brief Общая часть конструкторов.
+   */
+  void Init();
+
   /**
    * @brief Размещает змейку в стартовом положении.
    */
   void InitializeSnake();
 
   /**
-   * @brief Обновляет high score при необходимости и сохраняет его.
+   * @brief Обновляет high score в памяти при необходимости.
+   *
+   * Вызывается в конце партии: во время игры рекорд в кадре считается
+   * как max(score_, high_score_). Файл пишет FlushHighScore().
    */
   void UpdateHighScore();
 
@@ -202,78 +665,49 @@ class SnakeGame {
   void SaveHighScore() const;
 
   /**
-   * @brief Текущее тело змейки, представленное последовательностью сегментов.
-   * Первый элемент — голова, последний — хвост.
-   */
-  std::deque<SnakeSegment> snake_;
-
-  /**
-   * @brief Текущее направление движения змейки.
-   */
-  SnakeDirection direction_;
-
-  /**
-   * @brief Направление, которое змейка примет на следующем шаге.
-   * Устанавливается через обработку ввода.
-   */
-  SnakeDirection next_direction_;
-
-  /**
-   * @brief Текущее состояние игры (готово, запущено, на паузе, победа,
-   * поражение).
-   */
-  SnakeGameState state_;
-
-  /**
-   * @brief Текущая длина змейки.
+   * @brief Состояние партии (тело, поле, очередь поворотов, счёт,
+   *        генератор яблок).
    */
-  int length_;
+  State session_;
 
   /**
-   * @brief X-координата яблока на игровом поле.
+   * @brief Записывать ли рекорд в snake_highscore.txt.
    */
-  int apple_x_;
+  bool high_score_file_ = true;
 
   /**
-   * @brief Y-координата яблока на игровом поле.
+   * @brief Рекорд в памяти новее файла.
    */
-  int apple_y_;
+  bool high_score_dirty_ = false;
 
   /**
-   * @brief Очки игрока за текущую игру.
+   * @brief Постоянный буфер кадра для GetFrame() (распакованное поле).
    */
-  int score_;
+  std::conditional_t<kFixed, std::array<int, kFixed ? Width * Height : 1>,
+                     std::vector<int>>
+      frame_cells_{};
 
   /**
-   * @brief Рекордный счёт (high score).
+   * @brief Указатели на строки frame_cells_ (GameInfo_t::field).
    */
-  int high_score_;
-
-  /**
-   * @brief Текущий уровень игры (увеличивается с ростом счёта).
-   */
-  int level_;
+  std::conditional_t<kFixed, std::array<int*, kFixed ? Height : 1>,
+                     std::vector<int*>>
+      frame_rows_{};
+};
 
-  /**
-   * @brief Скорость игры (меньше — быстрее).
-   */
-  int speed_;
+/**
+ * @brief Классическая игра на поле kGameWidth x kGameHeight.
+ */
+using SnakeGame = BasicSnakeGame<kGameWidth, kGameHeight>;
 
-  /**
-   * @brief Флаг ускоренного движения (включается при резких манёврах).
-   */
-  bool accelerated_;
+/**
+ * @brief Игра на поле, размер которого задаётся в конструкторе.
+ */
+using DynamicSnakeGame = BasicSnakeGame<kDynamicExtent, kDynamicExtent>;
 
-  /**
-   * @brief Игровое поле в виде матрицы (ячейки: пустая, змейка, яблоко).
-   */
-  int field_[kGameHeight][kGameWidth];
+extern template class BasicSnakeGame<kGameWidth, kGameHeight>;
+extern template class BasicSnakeGame<kDynamicExtent, kDynamicExtent>;
 
-  /**
-   * @brief Генератор случайных чисел для появления яблок.
-   */
-  std::mt19937 gen_;
-};
 }  // namespace s21
 
 #endif  // S21_SNAKE_GAME_HPP
\ No newline at end of file
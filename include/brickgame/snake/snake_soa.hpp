@@ -0,0 +1,189 @@
+/**
+ * @file snake_soa.hpp
+ * @brief Пакет из тысяч партий Snake в виде структуры массивов.
+ *
+ * Состояния N партий классического поля 10x20 лежат по массивам:
+ * координаты голов, направления, длины, яблоки, часы партий и метки
+ * клеток. Тело змейки не хранится списком: клетка помнит шаг часов
+ * партии, на котором в неё вошла голова, и занята, пока
+ * часы - метка < длины. Хвост поэтому уходит сам, а рост — это только
+ * длина + 1.
+ *
+ * Все поля партии 16-битные, и шаг — один проход ядра по группам из
+ * шестнадцати партий (на x86-64 с AVX2 группа — один вектор, иначе та
+ * же логика скалярно): поворот, сдвиг головы, выход за поле,
+ * столкновение (одна выборка метки), яблоко и метка новой головы;
+ * проигрыш гасит дорожку маской. В скалярную доочистку уходят только
+ * редкие события: рост, новое яблоко, победа и перенос часов
+ * (kClockLimit).
+ *
+ * Генератор яблок не трогается на шаге: кандидаты в клетки яблока
+ * вытягиваются заранее по kAppleQueue на партию (в том же порядке, что
+ * SnakeGame::PlaceApple()), а опустевшие очереди пополняются после
+ * прохода ядра.
+ *
+ * Скорость (make bench, замер snake_soa, 4096 партий): шаг и
+ * перезапуск меряются отдельно. Бот на гамильтоновом цикле не
+ * проигрывает, и замер показывает цену шага: ядро AVX2 в 7-11 раз
+ * быстрее цикла по SnakeGame (около 3 нс на шаг партии), скалярный
+ * путь — в 3-4 раза. Упирается ядро в запись меток: в AVX2 нет записи
+ * по адресам (scatter), и шестнадцать меток группы пишутся по одной.
+ * При случайных действиях партия живёт около 12 шагов, в замер входят
+ * перезапуски, и выигрыш 6-7 раз.
+ *
+ * Результат совпадает с SnakeGame клетка в клетку: SnakeGame с тем же
+ * зерном (Seed()), после Reset() и Resume(), при тех же действиях
+ * проходит те же состояния, включая яблоки.
+ */
+#ifndef S21_SNAKE_SOA_HPP
+#define S21_SNAKE_SOA_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "../common/types.h"
+#include "snake_game.hpp"
+
+namespace s21 {
+
+class EXPORT SnakeSoaBatch {
+ public:
+  static constexpr int kWidth = 10;
+  static constexpr int kHeight = 20;
+  static constexpr int kCells = kWidth * kHeight;
+  /// Партий в группе ядра (16-битных дорожек вектора AVX2).
+  static constexpr int kLanes = 16;
+  /// Кандидатов в яблоко, вытягиваемых из генератора за раз.
+  static constexpr int kAppleQueue = 8;
+
+  /**
+   * @brief Создаёт count партий; партия i получает зерно seed + i.
+   *
+   * Все партии сразу начаты (как SnakeGame после Reset() и Resume()).
+   */
+  SnakeSoaBatch(int count, std::uint32_t seed);
+
+  int Count() const { return count_; }
+
+  /**
+   * @brief Начинает партию env заново (генератор яблок не сбрасывается).
+   */
+  void Reset(int env);
+
+  /**
+   * @brief Начинает заново все закончившиеся партии (как Reset()).
+   *
+   * @return число перезапущенных партий
+   */
+  int ResetFinished();
+
+  /**
+   * @brief Шаг всех партий (как SnakeGame::ChangeDirection() и Update()).
+   *
+   * @param actions count действий UserAction_t: Up, Down, Left, Right
+   *        поворачивают, остальные сохраняют направление (nullptr — все
+   *        сохраняют). Закончившиеся партии стоят до Reset().
+   */
+  void Step(const std::int32_t* actions);
+
+  /**
+   * @brief Включает векторное ядро (если процессор его поддерживает).
+   */
+  void SetSimd(bool enabled);
+  bool SimdEnabled() const { return simd_; }
+
+  /**
+   * @brief Поддерживает ли процессор векторное ядро.
+   */
+  static bool SimdAvailable();
+
+  SnakeGameState State(int env) const {
+    if (status_[env] == kRunning) return SnakeGameState::Running;
+    return status_[env] == kWon ? SnakeGameState::Won : SnakeGameState::Lost;
+  }
+  SnakeSegment Head(int env) const { return {head_x_[env], head_y_[env]}; }
+  SnakeDirection Direction(int env) const {
+    return static_cast<SnakeDirection>(direction_[env]);
+  }
+  int Length(int env) const { return length_[env]; }
+  int Score(int env) const { return score_[env]; }
+  int Level(int env) const { return level_[env]; }
+  SnakeSegment Apple(int env) const {
+    return {apple_[env] % kWidth, apple_[env] / kWidth};
+  }
+
+  /**
+   * @brief Клетка партии env, как в поле SnakeGame.
+   */
+  CellType Cell(int env, int x, int y) const;
+
+  /**
+   * @brief Сегмент тела: 0 — голова, Length(env) - 1 — хвост.
+   */
+  SnakeSegment Segment(int env, int index) const;
+
+ private:
+  /// Состояние партии в status_: ядро гасит проигравшие дорожки одной
+  /// маской, без скалярной доочистки.
+  enum Status : std::int16_t { kLost = 0, kRunning = 1, kWon = 2 };
+
+  /// Часы новой партии и после переноса: не меньше kCells, чтобы
+  /// нулевая метка была свободной клеткой при любой длине.
+  static constexpr std::int32_t kClockStart = kCells;
+  /// Часы, после которых метки партии переносятся к kClockStart: часы
+  /// 16-битные со знаком и растут на единицу за ход и на стартовую
+  /// длину при перезапуске.
+  static constexpr std::int32_t kClockLimit = 1 << 14;
+  static_assert(kClockLimit + kCells <= INT16_MAX, "clock fits 16 bits");
+
+  /// Метка клетки cell партии env.
+  std::size_t Stamp(int env, int cell) const {
+    return static_cast<std::size_t>(env) * kCells + cell;
+  }
+  bool Occupied(int env, int cell) const {
+    return clock_[env] - stamp_[Stamp(env, cell)] < length_[env];
+  }
+
+  void StepScalar(const std::int32_t* actions);
+  void StepSimd(const std::int32_t* actions);
+  int ResetFinishedSimd();
+  /// Тело новой партии: kStartLength меток в строке kHeight / 2.
+  void PlaceStartBody(int env);
+  void Grow(int env);
+  void Rebase(int env);
+  void PlaceApple(int env);
+  void DrawApples(int env);
+  void RefillApples();
+
+  int count_;
+  int lanes_;  ///< count_, округлённое вверх до kLanes
+  bool simd_ = false;
+  /// С последнего ResetFinished() какая-то партия могла закончиться.
+  bool finished_ = false;
+
+  // Массивы по партиям длиной lanes_: хвостовые дорожки последней
+  // группы всегда стоят (kLost).
+  std::vector<std::int16_t> status_;     ///< Status
+  std::vector<std::int16_t> head_x_;
+  std::vector<std::int16_t> head_y_;
+  std::vector<std::int16_t> direction_;  ///< SnakeDirection
+  std::vector<std::int16_t> apple_;      ///< Клетка яблока y * kWidth + x
+  std::vector<std::int16_t> length_;
+  std::vector<std::int16_t> score_;
+  std::vector<std::int16_t> level_;
+  std::vector<std::int16_t> clock_;      ///< Часы партии (ходов)
+  /// Метки клеток, kCells на партию: часы, когда в клетку вошла голова.
+  /// В конце — метка-заглушка для записей стоящих дорожек и запас под
+  /// 32-битную выборку.
+  std::vector<std::uint16_t> stamp_;
+  std::vector<SnakeRng> gen_;  ///< Генераторы яблок, как в SnakeGame
+
+  std::vector<std::uint8_t> apple_queue_;  ///< kAppleQueue на партию
+  std::vector<std::int32_t> apple_next_;   ///< Первый невзятый кандидат
+  std::vector<std::uint8_t> refill_pending_;
+  std::vector<std::int32_t> refill_;  ///< Партии с опустевшей очередью
+};
+
+}  // namespace s21
+
+#endif  // S21_SNAKE_SOA_HPP
@@ -17,19 +17,216 @@
 
 #include <stdio.h>
 #define SCORE_FILE "tetris_highscore.txt"
+#include "../common/alloc_hooks.h"
+#include "../common/packed_grid.h"
+#include "../common/state_blob.h"
 #include "../common/types.h"
 
+/// Ширина поля Tetris (в клетках).
+#define TETRIS_FIELD_WIDTH 10
+/// Высота поля Tetris (в клетках).
+#define TETRIS_FIELD_HEIGHT 20
+/// Версия формата снимка состояния Tetris.
+#define TETRIS_STATE_VERSION 4
+
+/// Одна клетка за кадр в фиксированной точке 16.16.
+#define TETRIS_GRAVITY_ONE 65536
+/// Гравитация 20G: фигура падает до опоры за один кадр.
+#define TETRIS_GRAVITY_20G (20 * TETRIS_GRAVITY_ONE)
+/// Максимальный уровень в режиме фиксированного кадра.
+#define TETRIS_MAX_LEVEL 20
+/// Максимум сбросов задержки фиксации движением одной фигуры.
+#define TETRIS_MAX_LOCK_RESETS 15
+
+/// Заполненная строка поля: 1 во всех клетках по 2 бита.
+#define TETRIS_ROW_FULL \
+  (((1u << (PACKED_CELL_BITS * TETRIS_FIELD_WIDTH)) - 1u) / 3u)
+/// Размер поля, упакованного по 2 бита на клетку (50 байт).
+#define TETRIS_PACKED_FIELD_BYTES \
+  PACKED_GRID_BYTES(TETRIS_FIELD_WIDTH, TETRIS_FIELD_HEIGHT)
+
+/// Размер матрицы фигуры.
+#define TETRIS_FIGURE_SIZE 4
+
 /**
  * @brief Статус выполнения игровой операции.
  */
 typedef enum { BACKEND_OK, BACKEND_GAME_OVER } BackendStatus;
 
+/**
+ * @brief Фигура: матрица 4x4 и позиция её левого верхнего угла на поле.
+ */
+typedef struct {
+  int shape[TETRIS_FIGURE_SIZE][TETRIS_FIGURE_SIZE];
+  int x, y;
+} Tetromino;
+
+/**
+ * @brief Полное состояние одного поля Tetris.
+ *
+ * Строки поля хранятся кольцом: логическая строка y лежит в
+ * rows[(top + y) % TETRIS_FIELD_HEIGHT]. Вставка строки снизу (мусор
+ * в режиме versus) сдвигает top и переписывает одну строку — O(1)
+ * вместо сдвига всего поля.
+ *
+ * Строка — одно 32-битное слово, по 2 бита на клетку (клетка x — биты
+ * 2x и 2x + 1, как в packed_grid.h). Заполненность строки проверяется
+ * одним сравнением с TETRIS_ROW_FULL, а всё поле занимает 80 байт.
+ *
+ * Структура не содержит указателей (генератор фигур — одно слово
+ * SplitMix64), поэтому поле копируется присваиванием или memcpy: клон
+ * для поиска продолжает ту же последовательность фигур, а несколько
+ * полей работают независимо.
+ */
+typedef struct {
+  uint32_t rows[TETRIS_FIELD_HEIGHT];  ///< Кольцо строк по 2 бита на клетку
+  int top;              ///< Физический индекс логической строки 0
+  Tetromino current;    ///< Падающая фигура
+  Tetromino next;       ///< Следующая фигура
+  int score;            ///< Счёт
+  int level;            ///< Уровень
+  int speed;            ///< Интервал тика (мс)
+  uint64_t rng_state;   ///< Генератор фигур (SplitMix64)
+  int frame_ms;         ///< Длительность кадра (0 — классический режим)
+  int lock_delay;       ///< Задержка фиксации, кадры
+  int32_t gravity_acc;  ///< Накопитель гравитации
+  int lock_frames;      ///< Кадров фигура лежит на опоре
+  int lock_resets;      ///< Сбросов задержки фиксации движением
+  int last_cleared;     ///< Линий очищено последней фиксацией
+  uint32_t locks;       ///< Зафиксировано фигур с начала партии
+} TetrisBoard;
+
+/**
+ * @brief Физический индекс логической строки y поля.
+ */
+static inline int tetris_board_row(const TetrisBoard *board, int y) {
+  int row = board->top + y;
+  return row >= TETRIS_FIELD_HEIGHT ? row - TETRIS_FIELD_HEIGHT : row;
+}
+
+/**
+ * @brief Клетка (x, y) поля без падающей фигуры.
+ */
+static inline int tetris_board_cell(const TetrisBoard *board, int x, int y) {
+  return (int)((board->rows[tetris_board_row(board, y)] >>
+                (PACKED_CELL_BITS * x)) &
+               PACKED_CELL_MASK);
+}
+
+/**
+ * @brief Записывает значение (0..3) в клетку (x, y) поля.
+ */
+static inline void tetris_board_set_cell(TetrisBoard *board, int x, int y,
+                                         int value) {
+  uint32_t *row = &board->rows[tetris_board_row(board, y)];
+  unsigned shift = (unsigned)(PACKED_CELL_BITS * x);
+  *row = (*row & ~(PACKED_CELL_MASK << shift)) |
+         (((uint32_t)value & PACKED_CELL_MASK) << shift);
+}
+
+/**
+ * @brief Готовит поле к первой партии.
+ *
+ * @param board поле
+ * @param seed  зерно генератора фигур
+ */
+void tetris_board_init(TetrisBoard *board, uint64_t seed);
+
+/**
+ * @brief Новая партия на том же поле (генератор и темп сохраняются).
+ */
+void tetris_board_reset(TetrisBoard *board);
+
+/**
+ * @brief Настраивает темп поля (см. backend_set_timing()).
+ */
+void tetris_board_set_timing(TetrisBoard *board, int ms, int lock_delay);
+
+/**
+ * @brief Движение или поворот падающей фигуры.
+ */
+BackendStatus tetris_board_input(TetrisBoard *board, UserAction_t action,
+                                 bool hold);
+
+/**
+ * @brief Один тик (кадр) падения фигуры.
+ */
+BackendStatus tetris_board_physics(TetrisBoard *board);
+
+/**
+ * @brief Фиксирует фигуру, очищает линии и выдаёт следующую.
+ *
+ * Число очищенных линий остаётся в board->last_cleared.
+ */
+BackendStatus tetris_board_fix_piece(TetrisBoard *board);
+
+/**
+ * @brief Вставляет снизу rows строк мусора с дыркой в столбце hole.
+ *
+ * Поле сдвигается вверх; падающая фигура поднимается, если мусор
+ * её задел.
+ *
+ * @return false, если занятые клетки ушли за верх поля (проигрыш)
+ */
+bool tetris_board_add_garbage(TetrisBoard *board, int rows, int hole);
+
+/**
+ * @brief Копирует поле с наложенной фигурой в строки кадра.
+ *
+ * @param board поле
+ * @param field TETRIS_FIELD_HEIGHT строк по TETRIS_FIELD_WIDTH клеток
+ */
+void tetris_board_overlay(const TetrisBoard *board, int **field);
+
+/**
+ * @brief Упаковывает поле по 2 бита на клетку (формат packed_grid.h).
+ *
+ * @param board      поле
+ * @param with_piece наложить падающую фигуру (как в кадре)
+ * @param out        буфер на TETRIS_PACKED_FIELD_BYTES байт
+ */
+void tetris_board_pack(const TetrisBoard *board, bool with_piece,
+                       uint8_t *out);
+
+/**
+ * @brief Максимальный уровень в режиме темпа поля.
+ */
+int tetris_board_max_level(const TetrisBoard *board);
+
+/**
+ * @brief Гравитация уровня для темпа поля (см. backend_gravity_for_level()).
+ */
+int32_t tetris_board_gravity(const TetrisBoard *board, int level);
+
+/**
+ * @brief Записывает поле, фигуры, счёт и генератор в снимок.
+ */
+void tetris_board_save(StateWriter *w, const TetrisBoard *board);
+
+/**
+ * @brief Читает поле из снимка tetris_board_save().
+ *
+ * @return false при неверных данных (board тогда не меняется)
+ */
+bool tetris_board_load(StateReader *r, TetrisBoard *board);
+
 /**
  * @brief Инициализация новой игры или рестарт.
  *
  * @return GameInfo_t структура с начальными данными игры.
  */
 GameInfo_t backend_init_game(void);
+
+/**
+ * @brief Рестарт игры в уже выделенных буферах кадра.
+ *
+ * То же, что backend_init_game(), но без выделения памяти: поле и превью
+ * копируются в буферы frame, которые backend использует и дальше.
+ *
+ * @param frame кадр с буферами предыдущей партии
+ * @return GameInfo_t структура с начальными данными игры.
+ */
+GameInfo_t backend_restart_game(const GameInfo_t *frame);
 /**
  * @brief Обработка пользовательского ввода.
  *
@@ -72,6 +269,22 @@ void backend_overlay_piece(GameInfo_t *info_ptr);
  * @param high_score значение рекорда
  */
 void save_high_score(int high_score);
+
+/**
+ * @brief Читает рекорд из файла; повторные вызовы ничего не делают.
+ *
+ * Рекорд читается при инициализации плагина (или при первой партии),
+ * а рестарты партий берут его из памяти.
+ */
+void backend_load_high_score(void);
+
+/**
+ * @brief Записывает рекорд в файл, если он вырос с прошлой записи.
+ *
+ * Тики обновляют рекорд только в памяти; запись — в конце партии
+ * и при завершении плагина.
+ */
+void backend_flush_high_score(void);
 /**
  * @brief Получает актуальное состояние игры.
  *
@@ -86,4 +299,90 @@ GameInfo_t backend_get_info(void);
  */
 void backend_free_game_info(GameInfo_t *game_info);
 
+/**
+ * @brief Настраивает темп игры.
+ *
+ * В режиме фиксированного кадра каждый вызов backend_update_physics()
+ * — один кадр длительностью ms: фигура опускается по накопителю
+ * гравитации уровня, а фиксируется после lock_delay кадров на опоре.
+ * info.speed при этом постоянен и равен ms, уровни идут до
+ * TETRIS_MAX_LEVEL (20G). При ms == 0 — классический режим: одна строка
+ * за вызов, темп задаётся интервалом get_level_speed().
+ *
+ * @param ms длительность кадра в мс (0 — классический режим)
+ * @param lock_delay задержка фиксации в кадрах
+ */
+void backend_set_timing(int ms, int lock_delay);
+
+/**
+ * @brief Максимальный уровень в текущем режиме темпа.
+ */
+int backend_max_level(void);
+
+/**
+ * @brief Гравитация уровня в единицах TETRIS_GRAVITY_ONE за кадр.
+ *
+ * @param level уровень игры
+ */
+int32_t backend_gravity_for_level(int level);
+
+/**
+ * @brief Выделяет новые буферы кадра (поле и превью) для текущего состояния.
+ *
+ * @return GameInfo_t с новыми буферами (освобождаются
+ *         backend_free_game_info())
+ */
+GameInfo_t backend_alloc_info(void);
+
+/**
+ * @brief Аллокатор и счётчики выделений библиотеки Tetris.
+ *
+ * Все буферы backend выделяются через него (см. alloc_hooks.h).
+ *
+ * @return состояние аллокатора библиотеки
+ */
+AllocHooks *backend_alloc_hooks(void);
+
+/**
+ * @brief Записывает поле, фигуры, счёт и генератор фигур в снимок.
+ *
+ * @param w писатель снимка
+ */
+void backend_save_state(StateWriter *w);
+
+/**
+ * @brief Упаковывает кадр одиночной игры (поле с падающей фигурой).
+ *
+ * @param buf  буфер на TETRIS_PACKED_FIELD_BYTES байт (NULL — только
+ *             размер)
+ * @param size размер буфера
+ * @return TETRIS_PACKED_FIELD_BYTES; если это больше size, кадр не
+ *         записан
+ */
+size_t backend_export_packed(void *buf, size_t size);
+
+/**
+ * @brief Копирует поле одиночной игры (клон партии для поиска).
+ *
+ * @param out поле-приёмник
+ */
+void backend_copy_board(TetrisBoard *out);
+
+/**
+ * @brief Заменяет поле одиночной игры, например копией
+ *        backend_copy_board(); счёт, уровень и скорость кадра
+ *        обновляются.
+ *
+ * @param board новое состояние поля
+ */
+void backend_restore_board(const TetrisBoard *board);
+
+/**
+ * @brief Восстанавливает состояние backend из снимка.
+ *
+ * @param r читатель снимка (позиция — начало данных backend)
+ * @return true, если данные корректны и состояние восстановлено
+ */
+bool backend_load_state(StateReader *r);
+
 #endif  // BRICKGAME_TETRIS_BACKEND_H_
\ No newline at end of file
@@ -15,12 +15,28 @@
 #define S21_TETRIS_GAME_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
+#include "../common/plugin_api.h"
 #include "../common/types.h"
+#include "backend.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
+
+/**
+ * @brief Имя функции внешнего API Tetris.
+ *
+ * При сборке со встроенными играми (BRICKGAME_STATIC_ENGINES) все движки
+ * линкуются в один бинарник, поэтому их C API получает префикс игры.
+ * Фронтенд в этом случае работает только через таблицу функций.
+ */
+#ifdef BRICKGAME_STATIC_ENGINES
+#define TETRIS_API(name) tetris_##name
+#else
+#define TETRIS_API(name) name
+#endif
 /**
  * @brief Обрабатывает ввод пользователя.
  *
@@ -29,7 +45,7 @@ extern "C" {
  * @param action действие пользователя (влево, вправо, поворот и т.д.)
  * @param hold   признак удержания кнопки
  */
-EXPORT void userInput(UserAction_t action, bool hold);
+EXPORT void TETRIS_API(userInput)(UserAction_t action, bool hold);
 /**
  * @brief Обновляет текущее состояние игры.
  *
@@ -38,13 +54,116 @@ EXPORT void userInput(UserAction_t action, bool hold);
  *
  * @return GameInfo_t структура с данными для отрисовки.
  */
-EXPORT GameInfo_t updateCurrentState();
+EXPORT GameInfo_t TETRIS_API(updateCurrentState)();
 /**
  * @brief Проверяет, окончена ли игра.
  *
  * @return true если игра завершена, иначе false.
  */
-EXPORT bool isGameOver();
+EXPORT bool TETRIS_API(isGameOver)();
+/**
+ * @brief Освобождает буферы GameInfo_t, выделенные библиотекой.
+ *
+ * @param info указатель на структуру с состоянием игры
+ */
+EXPORT void TETRIS_API(freeGameInfo)(GameInfo_t *info);
+/**
+ * @brief Сохраняет полное состояние сессии в бинарный снимок.
+ *
+ * Вызов с buf == NULL возвращает требуемый размер буфера.
+ *
+ * @param buf  буфер для снимка
+ * @param size размер буфера
+ * @return полный размер снимка; если он больше size, снимок не записан
+ */
+EXPORT size_t TETRIS_API(saveGameState)(void *buf, size_t size);
+/**
+ * @brief Восстанавливает сессию из снимка saveGameState().
+ *
+ * @param buf  снимок
+ * @param size размер снимка
+ * @return true при успехе; при ошибке состояние игры не меняется
+ */
+EXPORT bool TETRIS_API(loadGameState)(const void *buf, size_t size);
+/**
+ * @brief Пишет кадр поля в упакованном виде: 2 бита на клетку, формат
+ *        packed_grid.h (50 байт вместо int[20][10]).
+ *
+ * Поле включает падающую фигуру, как в updateCurrentState().
+ *
+ * @param buf  буфер (NULL — только подсчёт размера)
+ * @param size размер буфера
+ * @return размер упакованного поля; если он больше size, поле не записано
+ */
+EXPORT size_t TETRIS_API(exportPackedField)(void *buf, size_t size);
+/**
+ * @brief Копирует поле текущей партии.
+ *
+ * TetrisBoard не содержит указателей и глобального состояния, поэтому
+ * клон — одна структура в несколько сотен байт. Клон продолжает ту же
+ * последовательность фигур и годится для поиска хода и симуляций, не
+ * затрагивая идущую игру.
+ *
+ * @param out поле-приёмник
+ */
+EXPORT void TETRIS_API(copyBoard)(TetrisBoard *out);
+/**
+ * @brief Переключает игру в режим фиксированного кадра.
+ *
+ * Каждый updateCurrentState() становится кадром длительностью frame_ms:
+ * падение считается накопителем гравитации (до 20G на 20-м уровне),
+ * лежащая фигура фиксируется через lock_delay_frames кадров.
+ * GameInfo_t::speed остаётся равным frame_ms, поэтому фронтенду не нужно
+ * перенастраивать таймер. frame_ms == 0 возвращает классический режим.
+ *
+ * @param frame_ms          длительность кадра в мс
+ * @param lock_delay_frames задержка фиксации в кадрах
+ */
+EXPORT void TETRIS_API(setTetrisTiming)(int frame_ms,
+                                        int lock_delay_frames);
+/**
+ * @brief Включает применение ввода на границе тика (см. input_queue.h).
+ *
+ * Движения фигуры копятся в ограниченной очереди с отметкой времени и
+ * применяются в начале updateCurrentState() до гравитации, не больше
+ * per_tick за тик. per_tick == 0 возвращает немедленное применение.
+ *
+ * @param per_tick действий за тик
+ */
+EXPORT void TETRIS_API(setInputsPerTick)(int per_tick);
+/**
+ * @brief Устанавливает аллокатор для буферов игры (см. alloc_hooks.h).
+ *
+ * Буферы, выделенные прежним аллокатором, освобождаются им же.
+ *
+ * @param allocator аллокатор (NULL — malloc/free)
+ */
+EXPORT void TETRIS_API(setAllocator)(const BrickGameAllocator *allocator);
+/**
+ * @brief Выделения памяти за последний updateCurrentState().
+ *
+ * Буферы кадра выделяются один раз и переживают рестарты, поэтому
+ * после первого кадра все счётчики равны нулю.
+ *
+ * @return счётчики выделений последнего тика
+ */
+EXPORT BrickGameAllocStats TETRIS_API(tickAllocStats)(void);
+/**
+ * @brief Записывает рекорд в tetris_highscore.txt, если он вырос.
+ *
+ * Тик обновляет рекорд только в памяти; фронтенд вызывает функцию в
+ * конце партии (завершение плагина тоже записывает рекорд).
+ */
+EXPORT void TETRIS_API(flushHighScore)(void);
+/**
+ * @brief Таблица функций Tetris под уникальным именем.
+ *
+ * В отличие от brickgame_get_api() доступна и при сборке со встроенными
+ * играми.
+ *
+ * @return таблица функций игры
+ */
+EXPORT const BrickGameApi *brickgame_tetris_get_api(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,111 @@
+/**
+ * @file rollout.h
+ * @brief Оценка установок фигуры методом Монте-Карло.
+ *
+ * Для позиции TetrisBoard перебираются все различные установки падающей
+ * фигуры: число поворотов, сдвиг по столбцу и сброс до опоры. Из каждой
+ * установки разыгрывается rollouts продолжений по depth фигур со
+ * случайной или жадной политикой; по ним считаются выживаемость,
+ * средние линии и очки.
+ *
+ * Падающая и следующая фигуры позиции известны, дальнейшие фигуры
+ * продолжение i берёт из генератора поля, перезасеянного от seed и i.
+ * Продолжение i у всех установок видит одну последовательность фигур,
+ * поэтому разница между установками не тонет в разнице раскладов.
+ *
+ * Продолжения делятся между потоками; каждое работает на своей копии
+ * поля, а суммы целочисленные, так что результат зависит только от
+ * позиции и настроек, но не от числа потоков.
+ */
+#ifndef BRICKGAME_TETRIS_ROLLOUT_H_
+#define BRICKGAME_TETRIS_ROLLOUT_H_
+
+#include <stdint.h>
+
+#include "../common/types.h"
+#include "backend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Наибольшее число установок одной фигуры (4 поворота x 13 столбцов).
+#define TETRIS_ROLLOUT_MAX_PLACEMENTS \
+  (4 * (TETRIS_FIELD_WIDTH + TETRIS_FIGURE_SIZE - 1))
+
+/**
+ * @brief Политика, которой продолжение ставит фигуры.
+ */
+typedef enum {
+  TETRIS_ROLLOUT_RANDOM,  ///< Случайная установка из возможных
+  TETRIS_ROLLOUT_GREEDY   ///< Лучшая по высоте, дырам и линиям
+} TetrisRolloutPolicy;
+
+/**
+ * @brief Настройки оценки.
+ */
+typedef struct {
+  int rollouts;                ///< Продолжений на установку (больше 0)
+  int depth;                   ///< Фигур в продолжении после установки
+  TetrisRolloutPolicy policy;  ///< Политика продолжений
+  uint64_t seed;               ///< Зерно раскладов фигур и политики
+  int threads;                 ///< Потоков (0 — по числу ядер)
+} TetrisRolloutConfig;
+
+/**
+ * @brief Установка фигуры и статистика её продолжений.
+ */
+typedef struct {
+  int rotation;        ///< Поворотов (Action) перед сдвигом
+  int x;               ///< Столбец левого угла матрицы фигуры
+  int y;               ///< Строка левого угла после сброса
+  int lines;           ///< Линий очищает сама установка
+  double survival;     ///< Доля продолжений, доигравших depth фигур
+  double mean_lines;   ///< Линий за продолжение, включая установку
+  double mean_score;   ///< Прирост счёта за продолжение
+  double mean_pieces;  ///< Поставлено фигур до конца продолжения
+} TetrisPlacementStats;
+
+/**
+ * @brief Оценивает все установки падающей фигуры позиции board.
+ *
+ * Поле board не меняется. Установки идут в порядке поворотов, затем
+ * столбцов; совпадающие после сброса не повторяются.
+ *
+ * @param board     позиция
+ * @param config    настройки
+ * @param out       массив статистики установок
+ * @param max_count размер out (TETRIS_ROLLOUT_MAX_PLACEMENTS хватает
+ *                  всегда)
+ * @return число установок (не больше max_count) или -1 при неверных
+ *         настройках и нехватке памяти
+ */
+EXPORT int tetris_rollout_evaluate(const TetrisBoard *board,
+                                   const TetrisRolloutConfig *config,
+                                   TetrisPlacementStats *out, int max_count);
+
+/**
+ * @brief Лучшая установка: наибольшая выживаемость, при равной — больше
+ *        средних очков.
+ *
+ * @return индекс в stats или -1, если count == 0
+ */
+EXPORT int tetris_rollout_best(const TetrisPlacementStats *stats, int count);
+
+/**
+ * @brief Ставит падающую фигуру: rotation поворотов, сдвиг к столбцу x,
+ *        сброс до опоры и фиксация.
+ *
+ * Для установки из tetris_rollout_evaluate() повторяет её в точности;
+ * если столбец x недостижим, фигура сбрасывается с ближайшего.
+ *
+ * @return BACKEND_GAME_OVER, если следующей фигуре нет места
+ */
+EXPORT BackendStatus tetris_rollout_place(TetrisBoard *board, int rotation,
+                                          int x);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICKGAME_TETRIS_ROLLOUT_H_
@@ -0,0 +1,96 @@
+/**
+ * @file tetris_batch.h
+ * @brief Пакет сред Tetris для обучения с подкреплением.
+ *
+ * Один вызов tetris_batch_step() делает шаг во всех N полях пакета:
+ * действия берутся из непрерывного массива, наблюдения, награды и
+ * признаки конца эпизода пишутся в непрерывные буферы вызывающего.
+ * Среда — TetrisBoard в классическом режиме, шаг — tetris_board_input()
+ * и один tetris_board_physics() (фигура опускается на клетку или
+ * фиксируется). Кадры int** и FSM одиночной игры не участвуют.
+ *
+ * Наблюдение одной среды — TETRIS_BATCH_OBS_SIZE чисел float:
+ * - две плоскости 20x10 по строкам: лежащие блоки и падающая фигура;
+ * - признаки: следующая фигура 4x4 по строкам и уровень /
+ *   TETRIS_MAX_LEVEL.
+ *
+ * Награда — прирост счёта за шаг. Закончившаяся партия (поле
+ * переполнено или max_steps шагов) сразу начинается заново: done = 1,
+ * а наблюдение уже относится к новой партии.
+ */
+#ifndef BRICKGAME_TETRIS_BATCH_H_
+#define BRICKGAME_TETRIS_BATCH_H_
+
+#include <stdint.h>
+
+#include "../common/types.h"
+#include "backend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Плоскостей поля в наблюдении.
+#define TETRIS_BATCH_PLANES 2
+/// Скалярных признаков в наблюдении.
+#define TETRIS_BATCH_FEATURES (TETRIS_FIGURE_SIZE * TETRIS_FIGURE_SIZE + 1)
+/// Чисел в наблюдении одной среды.
+#define TETRIS_BATCH_OBS_SIZE                                          \
+  (TETRIS_BATCH_PLANES * TETRIS_FIELD_WIDTH * TETRIS_FIELD_HEIGHT + \
+   TETRIS_BATCH_FEATURES)
+
+typedef struct TetrisBatch TetrisBatch;
+
+/**
+ * @brief Создаёт пакет сред.
+ *
+ * Зёрна сред получаются перемешиванием seed и номера среды, так что
+ * последовательности фигур у сред не совпадают.
+ *
+ * @param count     число сред (больше 0)
+ * @param seed      зерно пакета
+ * @param max_steps предел шагов эпизода (0 — без предела)
+ * @return пакет или NULL при ошибке
+ */
+EXPORT TetrisBatch *tetris_batch_create(int count, uint64_t seed,
+                                        int max_steps);
+
+/**
+ * @brief Освобождает пакет.
+ */
+EXPORT void tetris_batch_destroy(TetrisBatch *batch);
+
+/**
+ * @brief Число сред в пакете.
+ */
+EXPORT int tetris_batch_count(const TetrisBatch *batch);
+
+/**
+ * @brief Начинает все эпизоды заново.
+ *
+ * @param batch        пакет
+ * @param observations count * TETRIS_BATCH_OBS_SIZE чисел (может быть
+ *                     NULL)
+ */
+EXPORT void tetris_batch_reset(TetrisBatch *batch, float *observations);
+
+/**
+ * @brief Шаг всех сред пакета.
+ *
+ * @param batch        пакет
+ * @param actions      count действий UserAction_t: Left, Right, Down,
+ *                     Action (поворот); остальные — без действия
+ * @param observations count * TETRIS_BATCH_OBS_SIZE чисел (может быть
+ *                     NULL)
+ * @param rewards      count наград (может быть NULL)
+ * @param dones        count признаков конца эпизода (может быть NULL)
+ */
+EXPORT void tetris_batch_step(TetrisBatch *batch, const int32_t *actions,
+                              float *observations, float *rewards,
+                              uint8_t *dones);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICKGAME_TETRIS_BATCH_H_
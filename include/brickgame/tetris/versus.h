@@ -0,0 +1,130 @@
+/**
+ * @file versus.h
+ * @brief Матч Tetris на несколько игроков в одном процессе.
+ *
+ * Поля игроков (TetrisBoard) идут в ногу: tetris_versus_step() делает
+ * ровно один кадр для всех живых игроков в порядке номеров. Линии,
+ * очищенные игроком, превращаются в атаку и уходят сопернику как
+ * строки мусора; атака, набранная за кадр, доставляется после того,
+ * как кадр сделали все, поэтому порядок игроков на исход не влияет.
+ *
+ * Входящий мусор копится и вставляется снизу поля, когда игрок
+ * фиксирует фигуру без очистки линий; очистка сначала гасит
+ * накопленный мусор, остаток атаки уходит дальше.
+ *
+ * Матч детерминирован: при одном зерне и одном вводе кадр за кадром
+ * получается то же самое. Без фронтенда матч гоняется вызовами
+ * tetris_versus_step() с полной скоростью (турниры ботов), фронтенд
+ * передаёт прошедшее время в tetris_versus_advance().
+ */
+#ifndef BRICKGAME_TETRIS_VERSUS_H_
+#define BRICKGAME_TETRIS_VERSUS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../common/input_queue.h"
+#include "../common/types.h"
+#include "backend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Максимум игроков в матче.
+#define TETRIS_VERSUS_MAX_PLAYERS 8
+/// Длительность кадра по умолчанию, мс.
+#define TETRIS_VERSUS_FRAME_MS 16
+/// Задержка фиксации по умолчанию, кадры.
+#define TETRIS_VERSUS_LOCK_DELAY 30
+/// Сколько кадров tetris_versus_advance() догоняет за вызов.
+#define TETRIS_VERSUS_MAX_CATCHUP 8
+
+/**
+ * @brief Игрок матча.
+ */
+typedef struct {
+  TetrisBoard board;      ///< Поле игрока
+  InputQueue input;       ///< Ввод до следующего кадра
+  uint64_t garbage_rng;   ///< Генератор столбца дырки во входящем мусоре
+  int pending_garbage;    ///< Входящий мусор, ещё не вставленный
+  int outgoing;           ///< Атака за текущий кадр
+  int target;             ///< Последний соперник, получивший атаку
+  int lines_sent;         ///< Отправлено строк мусора
+  int lines_received;     ///< Вставлено строк мусора
+  bool alive;             ///< Игрок в игре
+} TetrisVersusPlayer;
+
+/**
+ * @brief Состояние матча.
+ */
+typedef struct {
+  TetrisVersusPlayer players[TETRIS_VERSUS_MAX_PLAYERS];
+  int count;           ///< Игроков в матче
+  int alive;           ///< Игроков в игре
+  int winner;          ///< Победитель (-1 — нет или ничья)
+  bool finished;       ///< Матч окончен
+  uint64_t frame;      ///< Сделано кадров
+  int frame_ms;        ///< Длительность кадра, мс
+  uint32_t clock_ms;   ///< Накопленное, но не отыгранное время
+} TetrisVersus;
+
+/**
+ * @brief Начинает матч.
+ *
+ * Все игроки получают одну последовательность фигур и дырок в мусоре.
+ *
+ * @param versus     матч
+ * @param players    число игроков (1..TETRIS_VERSUS_MAX_PLAYERS)
+ * @param seed       зерно матча
+ * @param frame_ms   длительность кадра (<= 0 — TETRIS_VERSUS_FRAME_MS)
+ * @param lock_delay задержка фиксации в кадрах (< 0 — по умолчанию)
+ */
+EXPORT void tetris_versus_init(TetrisVersus *versus, int players,
+                               uint64_t seed, int frame_ms, int lock_delay);
+
+/**
+ * @brief Ставит ввод игрока в очередь; применяется в начале его кадра.
+ *
+ * Учитываются только движения и поворот фигуры.
+ */
+EXPORT void tetris_versus_input(TetrisVersus *versus, int player,
+                                UserAction_t action, bool hold);
+
+/**
+ * @brief Добавляет игроку входящий мусор (фора, сценарии, тесты).
+ */
+EXPORT void tetris_versus_send_garbage(TetrisVersus *versus, int player,
+                                       int rows);
+
+/**
+ * @brief Один кадр для всех живых игроков.
+ *
+ * @return false, если матч уже окончен
+ */
+EXPORT bool tetris_versus_step(TetrisVersus *versus);
+
+/**
+ * @brief Отыгрывает кадры, накопившиеся за elapsed_ms реального времени.
+ *
+ * Остаток меньше кадра переносится на следующий вызов; за вызов
+ * делается не больше TETRIS_VERSUS_MAX_CATCHUP кадров.
+ *
+ * @return число сделанных кадров
+ */
+EXPORT int tetris_versus_advance(TetrisVersus *versus, uint32_t elapsed_ms);
+
+/**
+ * @brief Заполняет кадр игрока для отрисовки.
+ *
+ * Поле (с падающей фигурой) и превью копируются, только если в info
+ * заданы буферы field и next; буферы принадлежат вызывающему.
+ */
+EXPORT void tetris_versus_view(const TetrisVersus *versus, int player,
+                               GameInfo_t *info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // BRICKGAME_TETRIS_VERSUS_H_
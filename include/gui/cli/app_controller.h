@@ -17,6 +17,7 @@
 
 #include <stdbool.h>
 
+#include "../../brickgame/common/plugin_loader.h"
 #include "../../brickgame/common/types.h"
 
 /**
@@ -25,6 +26,9 @@
  */
 typedef enum { GAME_TETRIS, GAME_SNAKE } GameType;
 
+/// Интервал кадра для игр, продвигаемых по реальному времени (мс).
+#define GAME_FRAME_MS 16
+
 /**
  * @struct GameAPI
  * @brief Структура для работы с API динамически подключаемой игровой
@@ -33,6 +37,7 @@ typedef enum { GAME_TETRIS, GAME_SNAKE } GameType;
 
 typedef struct {
   void* lib_handle; /**< Дескриптор загруженной библиотеки */
+  const BrickGameApi* table; /**< Таблица функций плагина */
   void (*userInput)(UserAction_t action,
                     bool hold); /**< Указатель на функцию обработки ввода */
   GameInfo_t (*updateState)(
@@ -40,6 +45,8 @@ typedef struct {
   bool (*isOver)(void); /**< Указатель на функцию проверки завершения игры */
   void (*freeGameInfo)(GameInfo_t* info); /**< Указатель на функцию освобождения
                                              памяти GameInfo_t */
+  GameInfo_t (*advance)(int elapsed_ms); /**< Продвижение по реальному
+                                            времени (NULL, если нет) */
   bool valid;  /**< Флаг валидности API */
   char* error; /**< Сообщение об ошибке (если есть) */
 } GameAPI;
@@ -53,12 +60,45 @@ typedef struct {
 void run_app(void);
 
 /**
- * @brief Загружает динамическую библиотеку выбранной игры.
+ * @brief Загружает динамическую библиотеку игры по пути.
  *
- * @param game Тип игры (Tetris или Snake)
+ * @param path Путь к библиотеке плагина
  * @return Структура GameAPI с указателями на функции игры или ошибкой
  */
-GameAPI load_game_lib(GameType game);
+GameAPI load_game_lib(const char* path);
+
+/**
+ * @brief Заполняет GameAPI из таблицы уже загруженного плагина.
+ *
+ * Владение дескриптором библиотеки переходит к GameAPI.
+ *
+ * @param plugin Загруженный плагин
+ * @return Структура GameAPI с указателями на функции игры
+ */
+GameAPI game_api_from_plugin(const BrickGamePlugin* plugin);
+
+/**
+ * @brief Определяет схему ввода по возможностям плагина.
+ *
+ * @param api Загруженное API игры
+ * @return GAME_SNAKE для игр с ускорением удержанием, иначе GAME_TETRIS
+ */
+GameType game_type_for_api(const GameAPI* api);
+
+/**
+ * @brief Проверяет, должен ли вызывающий освобождать кадры игры.
+ *
+ * @param api Загруженное API игры
+ * @return true, если плагин выделяет GameInfo_t на каждый кадр
+ */
+bool game_api_caller_frees_info(const GameAPI* api);
+
+/**
+ * @brief Записывает рекорд игры в конце партии (вне тика).
+ *
+ * @param api Загруженное API игры
+ */
+void game_api_flush_high_score(const GameAPI* api);
 
 /**
  * @brief Выгружает игровую библиотеку и освобождает ресурсы.
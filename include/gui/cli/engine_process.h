@@ -0,0 +1,52 @@
+/**
+ * @file engine_process.h
+ * @brief Запуск игрового движка в отдельном процессе.
+ *
+ * Движок работает в дочернем процессе и публикует кадры в кольцо
+ * разделяемой памяти (frame_ring.h), а CLI только читает последний кадр
+ * и отправляет ввод. Медленная отрисовка или падение терминального
+ * фронтенда не останавливает симуляцию.
+ *
+ * Режим включается переменной окружения BRICKGAME_ENGINE_PROCESS=1.
+ * Если задана BRICKGAME_FRAME_RING=/имя, кольцо создаётся как именованный
+ * сегмент POSIX shm, и к нему могут подключиться другие дисплеи.
+ */
+#ifndef ENGINE_PROCESS_H
+#define ENGINE_PROCESS_H
+
+#include <stdbool.h>
+#include <sys/types.h>
+
+#include "../../brickgame/common/frame_ring.h"
+#include "app_controller.h"
+
+/// Интервал опроса кольца фронтендом (мс).
+#define ENGINE_PROCESS_POLL_MS 16
+
+/**
+ * @brief Проверяет, включён ли режим отдельного процесса движка.
+ *
+ * @return true, если BRICKGAME_ENGINE_PROCESS задана и не равна "0"
+ */
+bool engine_process_enabled(void);
+
+/**
+ * @brief Возвращает имя кольца из BRICKGAME_FRAME_RING или NULL.
+ */
+const char* engine_process_ring_name(void);
+
+/**
+ * @brief Игровой цикл движка (выполняется в дочернем процессе).
+ *
+ * Забирает ввод из очереди кольца, делает тик и публикует кадр,
+ * пока фронтенд не запросит завершение. Если фронтенд-процесс умер,
+ * не успев этого сделать, движок тоже завершается (SIGTERM по
+ * PR_SET_PDEATHSIG на Linux, иначе по смене getppid()).
+ *
+ * @param api API загруженной игры
+ * @param ring кольцо кадров
+ * @param parent pid фронтенда, снятый до fork()
+ */
+void engine_process_run(GameAPI api, FrameRing* ring, pid_t parent);
+
+#endif  // ENGINE_PROCESS_H
@@ -7,6 +7,11 @@
  * Он обеспечивает единый способ работы с вводом для разных игр (Tetris, Snake),
  * абстрагируя специфичные для каждой игры комбинации клавиш.
  *
+ * За кадр из буфера терминала забираются все накопившиеся нажатия.
+ * Терминал не сообщает об отпускании клавиши, поэтому удержание
+ * определяется по автоповтору: клавиша, повторённая несколько раз без
+ * паузы, считается зажатой, а пропавший автоповтор — отпусканием.
+ *
  * Используется совместно с контроллером приложения (`app_controller.h`),
  * чтобы маршрутизировать команды пользователя в игровой движок.
  */
@@ -18,16 +23,42 @@
 #include "../../brickgame/common/types.h"
 #include "app_controller.h"
 
+/// Максимум действий за один кадр (остальные нажатия отбрасываются).
+#define INPUT_MAX_ACTIONS 32
+
+/// Повторов подряд, после которых клавиша считается зажатой.
+#define INPUT_HOLD_REPEATS 3
+
+/// Пауза в автоповторе (мс), после которой клавиша считается отпущенной.
+#define INPUT_RELEASE_MS 150
+
+/**
+ * @brief Действие пользователя с признаком удержания.
+ */
+typedef struct {
+  UserAction_t action; /**< Действие */
+  bool hold;           /**< Клавиша зажата */
+} InputEvent;
+
+/**
+ * @brief Действия, собранные за один кадр, в порядке нажатий.
+ */
+typedef struct {
+  InputEvent events[INPUT_MAX_ACTIONS]; /**< Действия */
+  int count;                            /**< Число действий */
+} InputFrame;
+
 /**
- * @brief Читает пользовательский ввод с клавиатуры.
+ * @brief Забирает весь накопившийся ввод.
  *
- * Функция опрашивает ввод в CLI (ncurses), преобразует нажатые клавиши
- * в универсальные действия `UserAction_t` и сообщает, удерживается ли кнопка.
+ * Каждое нажатие становится отдельным действием. Кадр без нажатий даёт
+ * пустой список; для Snake, когда зажатая клавиша отпущена, в список
+ * один раз добавляется Action без удержания (выключение ускорения).
  *
- * @param hold Указатель на флаг удержания кнопки (true, если кнопка зажата)
- * @param game_type Тип активной игры (для правильной интерпретации ввода)
- * @return Код действия пользователя (см. UserAction_t)
+ * @param frame Список действий кадра (перезаписывается)
+ * @param game_type Тип активной игры (удержание отслеживается для Snake)
+ * @return Число действий в frame
  */
-UserAction_t read_input(bool *hold, GameType game_type);
+int read_inputs(InputFrame *frame, GameType game_type);
 
-#endif  // INPUT_H
\ No newline at end of file
+#endif  // INPUT_H
@@ -15,6 +15,25 @@
 
 #include "../../brickgame/common/types.h"
 #include "app_controller.h"
+
+/// Переменная окружения: "ansi" — вывод игрового экрана одним write().
+#define RENDER_BACKEND_ENV "BRICKGAME_CLI_RENDER"
+
+/**
+ * @brief Задаёт размер поля выбранной игры и выбирает способ вывода.
+ *
+ * Вызывается после initscr(). Поле, не помещающееся в терминал, в
+ * режиме ansi показывается через прокручиваемое окно.
+ *
+ * @param width  ширина поля
+ * @param height высота поля
+ */
+void render_set_field_size(int width, int height);
+
+/**
+ * @brief Освобождает буферы вывода.
+ */
+void render_shutdown(void);
 /**
  * @brief Отрисовывает текущее состояние игры.
  *
@@ -49,11 +68,13 @@ void renderGameWonScreen();
 /**
  * @brief Отображает меню выбора игры.
  *
- * Предлагает игроку список доступных игр и возвращает выбранный вариант.
+ * Предлагает игроку список найденных плагинов и возвращает выбранный.
  *
- * @return GameType Тип выбранной игры.
+ * @param plugins Массив загруженных плагинов.
+ * @param count Число плагинов (1..9).
+ * @return Индекс выбранного плагина.
  */
-GameType render_game_selection();
+int render_game_selection(const BrickGamePlugin* plugins, int count);
 
 /**
  * @brief Отображает сообщение об ошибке загрузки.
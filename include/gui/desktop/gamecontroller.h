@@ -7,18 +7,22 @@
  * - GameStateManager - управление состоянием
  * - TimerManager - управление таймером
  * - LibraryLoader - загрузка игр
+ * - SimulationThread - тики игры в отдельном потоке
  *
  * Тонкий контроллер только координирует, не содержит бизнес-логику.
  */
 #ifndef GAMECONTROLLER_H
 #define GAMECONTROLLER_H
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <memory>
 
+#include "../../brickgame/common/frame_stats.h"
 #include "../../brickgame/common/types.h"
 #include "inputhandler.h"
 #include "libraryloader.h"
+#include "simulationthread.h"
 #include "timermanager.h"
 
 /**
@@ -26,10 +30,12 @@
  *
  * Координирует работу специализированных компонентов:
  * - InputHandler для обработки ввода
- * - TimerManager для управления таймером
+ * - TimerManager для опроса кадров
  * - LibraryLoader для загрузки игр
+ * - SimulationThread для тиков игры
  *
- * Состояние игры получается только из backend FSM через GameInfo_t
+ * Состояние игры получается только из кадров, которые публикует поток
+ * симуляции; функции игры из потока GUI не вызываются.
  */
 class GameController : public QObject {
   Q_OBJECT
@@ -47,11 +53,11 @@ class GameController : public QObject {
   ~GameController();
 
   /**
-   * @brief Загружает игру заданного типа.
-   * @param gameType Тип игры
+   * @brief Загружает игру по идентификатору плагина.
+   * @param gameId Идентификатор игры (BrickGameApi::id)
    * @return true если успешно загружена
    */
-  bool loadGame(GameType gameType);
+  bool loadGame(const QString& gameId);
 
   /**
    * @brief Выгружает текущую игру.
@@ -83,7 +89,7 @@ class GameController : public QObject {
   void handleKeyReleased(int key);
 
   /**
-   * @brief Получает текущее состояние игры.
+   * @brief Получает последний полученный кадр игры.
    * @return Состояние игры
    */
   GameInfo_t getCurrentState() const;
@@ -112,12 +118,23 @@ class GameController : public QObject {
    */
   GameType getCurrentGameType() const;
 
+  /**
+   * @brief Статистика темпа кадров (шаг движка и дрожание тика).
+   *
+   * Тики измеряет поток симуляции; здесь — копия, обновляемая при
+   * каждом опросе кадров. Виджет поля дописывает в неё длительность
+   * отрисовки. При выходе статистика сохраняется в файл из
+   * BRICKGAME_FRAME_STATS, если переменная задана.
+   * @return Статистика, принадлежащая контроллеру
+   */
+  FrameStats* frameStats();
+
   // Методы для совместимости с UI
   void showGameSelection();
   void stopGame();
   void closeApplication();
   void handleRestartGame();
-  void handleGameSelection(GameType gameType);
+  void handleGameSelection(const QString& gameId);
   void handleStartButton();
   void handlePauseButton();
   void handleQuitButton();
@@ -135,16 +152,25 @@ class GameController : public QObject {
 
  private slots:
   /**
-   * @brief Обновляет состояние игры по таймеру.
+   * @brief Забирает последний кадр потока симуляции по таймеру.
    */
   void updateGame();
 
  protected:
   std::unique_ptr<LibraryLoader> m_libraryLoader; /**< Загрузчик библиотек */
   std::unique_ptr<InputHandler> m_inputHandler; /**< Обработчик ввода */
-  std::unique_ptr<TimerManager> m_timerManager; /**< Менеджер таймера */
+  std::unique_ptr<TimerManager> m_timerManager; /**< Таймер опроса кадров */
+  std::unique_ptr<SimulationThread> m_simulation; /**< Поток симуляции */
   GameType m_currentGameType; /**< Текущий тип игры */
   bool m_wasPaused; /**< Предыдущее состояние паузы */
+  bool m_started; /**< Партия начата (Start) */
+  bool m_gameOverHandled; /**< Конец партии уже обработан */
+  uint64_t m_startSeq; /**< Число кадров на момент Start */
+  FrameSnapshot m_snapshot; /**< Последний кадр (принадлежит GUI) */
+  QElapsedTimer m_gameClock; /**< Время с начала партии */
+  FrameStats m_frameStats; /**< Статистика темпа кадров */
+
+  static constexpr int kFrameIntervalMs = 16; /**< Опрос кадров, мс */
 
  private:
   /**
@@ -153,9 +179,15 @@ class GameController : public QObject {
   void setupConnections();
 
   /**
-   * @brief Обновляет состояние игры в библиотеке.
+   * @brief Отмечает начало партии после отправки Start.
+   */
+  void beginGame();
+
+  /**
+   * @brief Записывает результат завершённой партии в таблицу лидеров.
+   * @param state Последний кадр партии
    */
-  void updateGameState();
+  void recordResult(const GameInfo_t& state);
 };
 
 #endif  // GAMECONTROLLER_H
@@ -3,12 +3,13 @@
  * @brief Заголовочный файл диалога выбора игры для Desktop GUI.
  *
  * Этот класс предоставляет интерфейс диалога выбора игры в приложении
- * BrickGame. Диалог отображает кнопки для выбора игры Tetris или Snake и
- * сигнализирует контроллеру (GameController) о выборе пользователя. Также
- * поддерживает сигнал при закрытии окна вручную.
+ * BrickGame. Диалог отображает по кнопке на каждую найденную игру
+ * (LibraryLoader::availablePlugins()) и сигнализирует контроллеру
+ * (GameController) об идентификаторе выбранной. Также поддерживает сигнал
+ * при закрытии окна вручную.
  *
  * Основные возможности:
- *  - Отображение кнопок Tetris и Snake.
+ *  - Отображение кнопок найденных игр, как в меню CLI.
  *  - Сигналы для выбранной игры и отклонения диалога.
  *  - Настройка интерфейса с помощью QVBoxLayout и QHBoxLayout.
  */
@@ -26,8 +27,8 @@
 
 /**
  * @brief Диалог выбора игры.
- * Отображает две кнопки для выбора Tetris или Snake.
- * Сигнализирует контроллеру выбранную игру.
+ * Отображает кнопку на каждую найденную игру.
+ * Сигнализирует контроллеру идентификатор выбранной игры.
  */
 class GameSelectionDialog : public QDialog {
   Q_OBJECT
@@ -54,36 +55,19 @@ class GameSelectionDialog : public QDialog {
  signals:
   /**
    * @brief Сигнал выбора игры.
-   * @param gameType Выбранная игра (TETRIS или SNAKE).
+   * @param gameId Идентификатор выбранной игры (BrickGameApi::id).
    */
-
-  void gameSelected(GameType gameType);
+  void gameSelected(const QString& gameId);
   /**
    * @brief Сигнал, который испускается при отклонении диалога.
    */
   void dialogRejected();
 
- private slots:
-  /**
-   * @brief Слот для выбора игры Tetris.
-   * Генерирует сигнал gameSelected(GameType::TETRIS) и закрывает диалог.
-   */
-  void onTetrisSelected();
-  /**
-   * @brief Слот для выбора игры Snake.
-   * Генерирует сигнал gameSelected(GameType::SNAKE) и закрывает диалог.
-   */
-  void onSnakeSelected();
-
  private:
   /**
-   * @brief Настраивает интерфейс диалога.
+   * @brief Настраивает интерфейс диалога и создаёт кнопки игр.
    */
   void setupUI();
-  /** @brief Кнопка для выбора игры Tetris. */
-  QPushButton* m_tetrisButton;
-  /** @brief Кнопка для выбора игры Snake. */
-  QPushButton* m_snakeButton;
   /** @brief Метка с заголовком диалога ("Select a Game"). */
   QLabel* m_titleLabel;
 };
@@ -11,16 +11,22 @@
  *  - Обновление состояния игры через updateGameState().
  *  - Показ стартового, финального и победного экранов.
  *  - Настройка типа игры (Tetris или Snake).
- *  - Отрисовка игрового поля с цветными ячейками.
+ *  - Отрисовка игрового поля с цветными ячейками: векторно (QPainter на
+ *    каждую ячейку) или растром (поле пишется в QImage по пикселю на
+ *    ячейку и масштабируется одним drawImage).
+ *  - Оверлей темпа кадров (F3): гистограммы отрисовки, шага движка и
+ *    дрожания тика, число опоздавших и потерянных кадров.
  */
 
 #ifndef GAMEWIDGET_H
 #define GAMEWIDGET_H
 
+#include <QImage>
 #include <QKeyEvent>
 #include <QPainter>
 #include <QWidget>
 
+#include "../../brickgame/common/frame_stats.h"
 #include "../../brickgame/common/game_constants.h"
 #include "../../brickgame/common/types.h"
 #include "libraryloader.h"
@@ -29,6 +35,12 @@ class GameWidget : public QWidget {
   Q_OBJECT
 
  public:
+  /** @brief Способ отрисовки игрового поля. */
+  enum class RenderMode {
+    VECTOR, /**< Прямоугольник и рамка QPainter на каждую ячейку */
+    RASTER  /**< Поле в QImage и один drawImage без сглаживания */
+  };
+
   /**
    * @brief Конструктор. Инициализирует виджет и устанавливает фокус.
    */
@@ -65,6 +77,29 @@ class GameWidget : public QWidget {
    */
   void setGameType(GameType gameType);
 
+  /**
+   * @brief Подключает статистику темпа кадров.
+   * Виджет записывает в неё длительность отрисовки и показывает её в
+   * оверлее.
+   * @param stats Статистика (nullptr — не учитывать).
+   */
+  void setFrameStats(FrameStats* stats);
+
+  /**
+   * @brief Показывает или скрывает оверлей темпа кадров.
+   */
+  void toggleHud();
+
+  /**
+   * @brief Устанавливает способ отрисовки поля.
+   */
+  void setRenderMode(RenderMode mode);
+
+  /**
+   * @brief Переключает векторную и растровую отрисовку поля.
+   */
+  void toggleRenderMode();
+
  protected:
   /**
    * @brief Переопределение метода QWidget для перерисовки виджета.
@@ -82,6 +117,13 @@ class GameWidget : public QWidget {
    */
   void drawGameField(QPainter& painter);
 
+  /**
+   * @brief Отрисовывает поле через растр с разрешением в одну ячейку.
+   * Стоимость не зависит от числа заполненных ячеек.
+   * @param painter Объект QPainter для рисования.
+   */
+  void drawGameFieldRaster(QPainter& painter);
+
   /**
    * @brief Отрисовывает стартовый экран с названием игры и инструкциями.
    * @param painter Объект QPainter для рисования.
@@ -106,6 +148,24 @@ class GameWidget : public QWidget {
    */
   void drawBorders(QPainter& painter);
 
+  /**
+   * @brief Рисует оверлей темпа кадров поверх текущего экрана.
+   * @param painter Объект QPainter для рисования.
+   */
+  void drawHud(QPainter& painter);
+
+  /**
+   * @brief Рисует одну гистограмму оверлея со сводкой.
+   * @param painter Объект QPainter для рисования.
+   * @param area Область гистограммы.
+   * @param title Название метрики.
+   * @param histogram Гистограмма.
+   * @param color Цвет столбцов.
+   */
+  void drawHistogram(QPainter& painter, const QRect& area,
+                     const QString& title, const FrameHistogram& histogram,
+                     const QColor& color);
+
   /**
    * @brief Возвращает цвет ячейки по её значению.
    * @param cellValue Значение ячейки в поле.
@@ -130,6 +190,18 @@ class GameWidget : public QWidget {
   /** @brief Текущий отображаемый экран виджета. */
   enum class ScreenType { START, GAME, GAME_OVER, GAME_WON } m_currentScreen;
 
+  /** @brief Статистика темпа кадров (принадлежит GameController). */
+  FrameStats* m_frameStats;
+
+  /** @brief Показывать ли оверлей темпа кадров. */
+  bool m_hudVisible;
+
+  /** @brief Способ отрисовки поля. */
+  RenderMode m_renderMode;
+
+  /** @brief Растр поля: пиксель на ячейку (режим RASTER). */
+  QImage m_boardImage;
+
   /** @brief Размер одной ячейки игрового поля в пикселях. */
   static const int CELL_SIZE = 25;
 
@@ -18,6 +18,7 @@
 
 #include "../../brickgame/common/types.h"
 #include "libraryloader.h"
+#include "simulationthread.h"
 
 /**
  * @brief Обработчик пользовательского ввода.
@@ -41,9 +42,9 @@ class InputHandler : public QObject {
   /**
    * @brief Обрабатывает нажатие клавиши.
    * @param key Код клавиши Qt
-   * @param libraryLoader Загрузчик библиотеки для передачи команд
+   * @param simulation Поток симуляции, которому передаются команды
    */
-  void handleKeyPress(int key, LibraryLoader* libraryLoader);
+  void handleKeyPress(int key, SimulationThread* simulation);
 
   /**
    * @brief Обрабатывает отпускание клавиши.
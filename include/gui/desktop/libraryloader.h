@@ -1,7 +1,8 @@
 /**
  * @file libraryloader.h
- * @brief Класс для динамической подгрузки игровых библиотек (Tetris, Snake)
- * через dlopen/dlsym и предоставления API для взаимодействия с игрой.
+ * @brief Класс для динамической подгрузки игровых плагинов (Tetris, Snake)
+ * через единую точку входа brickgame_get_api() и предоставления API для
+ * взаимодействия с игрой.
  */
 #ifndef LIBRARYLOADER_H
 #define LIBRARYLOADER_H
@@ -10,11 +11,17 @@
 
 #include <QObject>
 #include <QString>
+#include <QStringList>
+#include <vector>
 
+#include "../../brickgame/common/plugin_loader.h"
 #include "../../brickgame/common/types.h"
 
 /**
- * @brief Перечисление доступных типов игр.
+ * @brief Раскладка управления и панели игры.
+ *
+ * Выводится из возможностей плагина (LibraryLoader::gameTypeFor()), как
+ * в CLI; выбор и загрузка игры идут по идентификатору плагина.
  */
 enum class GameType { TETRIS, SNAKE };
 
@@ -24,6 +31,7 @@ enum class GameType { TETRIS, SNAKE };
  */
 struct GameAPI {
   void* lib_handle = nullptr; /**< Хэндл библиотеки */
+  const BrickGameApi* table = nullptr; /**< Таблица функций плагина */
   void (*userInput)(UserAction_t action,
                     bool hold) = nullptr; /**< Функция обработки ввода */
   GameInfo_t (*updateCurrentState)(void) =
@@ -31,6 +39,8 @@ struct GameAPI {
   bool (*isOver)(void) = nullptr; /**< Функция проверки окончания игры */
   void (*freeGameInfo)(GameInfo_t* info) =
       nullptr; /**< Функция освобождения памяти GameInfo_t */
+  GameInfo_t (*advance)(int elapsed_ms) =
+      nullptr; /**< Продвижение по реальному времени (если поддерживается) */
   bool valid = false; /**< Флаг корректной загрузки */
   QString error; /**< Сообщение об ошибке при загрузке */
 };
@@ -54,11 +64,39 @@ class LibraryLoader : public QObject {
   ~LibraryLoader();
 
   /**
-   * @brief Загружает библиотеку выбранной игры.
-   * @param gameType Тип игры для загрузки.
-   * @return true, если библиотека успешно загружена.
+   * @brief Запускает игру из списка availablePlugins().
+   * @param gameId Идентификатор игры (BrickGameApi::id).
+   * @return true, если игра найдена и запущена.
    */
-  bool loadGame(GameType gameType);
+  bool loadGame(const QString& gameId);
+
+  /**
+   * @brief Загружает плагин по пути к библиотеке.
+   * @param libraryPath Путь к разделяемой библиотеке плагина.
+   * @return true, если плагин загружен и его ABI совместим.
+   */
+  bool loadPlugin(const QString& libraryPath);
+
+  /**
+   * @brief Каталоги поиска плагинов: BRICKGAME_PLUGIN_DIR, текущий
+   * каталог и каталог приложения.
+   */
+  static QStringList pluginDirectories();
+
+  /**
+   * @brief Игры, встроенные в приложение, и плагины из каталогов поиска.
+   *
+   * Список строится при первом вызове и живёт до выхода из приложения:
+   * библиотеки остаются открытыми, но init() вызывает только loadGame().
+   * Встроенные игры имеют приоритет над плагинами с тем же id; порядок —
+   * по имени игры.
+   */
+  static const std::vector<BrickGamePlugin>& availablePlugins();
+
+  /**
+   * @brief Раскладка управления для таблицы плагина.
+   */
+  static GameType gameTypeFor(const BrickGameApi* table);
 
   /**
    * @brief Выгружает текущую библиотеку и сбрасывает API.
@@ -84,11 +122,25 @@ class LibraryLoader : public QObject {
   GameAPI m_api;
 
   /**
-   * @brief Формирует путь к библиотеке в зависимости от типа игры.
-   * @param gameType Тип игры.
-   * @return Полный путь к файлу библиотеки.
+   * @brief Плагин, загруженный loadPlugin() (принадлежит загрузчику).
+   */
+  BrickGamePlugin m_plugin = {};
+
+  /**
+   * @brief Запущенный плагин: &m_plugin или элемент availablePlugins().
+   */
+  BrickGamePlugin* m_active = nullptr;
+
+  /**
+   * @brief Заполняет m_api из таблицы функций m_active.
+   */
+  void adoptPlugin();
+
+  /**
+   * @brief Кэш availablePlugins(); после построения не меняет размер,
+   * так что указатели на элементы стабильны.
    */
-  QString getLibraryPath(GameType gameType) const;
+  static std::vector<BrickGamePlugin>& pluginCache();
 };
 
 #endif  // LIBRARYLOADER_H
@@ -0,0 +1,150 @@
+/**
+ * @file simulationthread.h
+ * @brief Поток симуляции игры с передачей кадров GUI без блокировок.
+ *
+ * Движок работает в отдельном потоке: забирает ввод из очереди кольца
+ * кадров (frame_ring.h), делает тики и публикует кадры в слоты кольца.
+ * Поток GUI копирует последний опубликованный кадр в собственный
+ * FrameSnapshot и рисует только его, поэтому медленная отрисовка или
+ * модальный диалог не задерживают тики.
+ *
+ * После start() функции игры вызывает только поток симуляции; поток GUI
+ * общается с ним через pushInput() и latestFrame().
+ *
+ * Темп тиков (интервал между тиками и длительность шага) измеряется
+ * там, где тики происходят, — в цикле потока симуляции, в его
+ * собственной FrameStats. Поток GUI получает копию через tickStats().
+ */
+#ifndef SIMULATIONTHREAD_H
+#define SIMULATIONTHREAD_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../../brickgame/common/frame_ring.h"
+#include "../../brickgame/common/frame_stats.h"
+#include "../../brickgame/common/types.h"
+#include "libraryloader.h"
+
+/**
+ * @brief Копия кадра, принадлежащая потоку GUI.
+ *
+ * info.field и info.next указывают во внутренние буферы снимка и
+ * действительны до следующего latestFrame() с этим снимком.
+ */
+struct FrameSnapshot {
+  GameInfo_t info{};     /**< Кадр (указатели во внутренние буферы) */
+  bool gameOver = false; /**< Игра окончена */
+  uint64_t seq = 0;      /**< Номер кадра */
+  bool valid = false;    /**< Кадр получен хотя бы раз */
+
+  FrameSnapshot() = default;
+  FrameSnapshot(const FrameSnapshot&) = delete;
+  FrameSnapshot& operator=(const FrameSnapshot&) = delete;
+
+ private:
+  friend class SimulationThread;
+
+  std::vector<int> m_cells;  /**< Ячейки поля построчно */
+  std::vector<int*> m_rows;  /**< Указатели на строки поля */
+  int m_next[FRAME_RING_NEXT_SIZE][FRAME_RING_NEXT_SIZE] = {};
+  int* m_nextRows[FRAME_RING_NEXT_SIZE] = {};
+};
+
+/**
+ * @brief Поток, в котором выполняются тики игры.
+ */
+class SimulationThread {
+ public:
+  SimulationThread();
+
+  /**
+   * @brief Деструктор. Останавливает поток.
+   */
+  ~SimulationThread();
+
+  SimulationThread(const SimulationThread&) = delete;
+  SimulationThread& operator=(const SimulationThread&) = delete;
+
+  /**
+   * @brief Создаёт кольцо кадров и запускает поток симуляции.
+   * @param api API загруженной игры
+   * @return false, если поток уже запущен или кольцо не создано
+   */
+  bool start(const GameAPI& api);
+
+  /**
+   * @brief Останавливает поток и применяет оставшийся ввод.
+   *
+   * После возврата функции игры снова можно вызывать из потока GUI.
+   */
+  void stop();
+
+  /**
+   * @brief Запущен ли поток.
+   */
+  bool isRunning() const { return m_ring != nullptr; }
+
+  /**
+   * @brief Передаёт действие пользователя движку.
+   * @return false, если поток не запущен или очередь переполнена
+   */
+  bool pushInput(UserAction_t action, bool hold);
+
+  /**
+   * @brief Копирует последний опубликованный кадр, если он новее снимка.
+   * @param snapshot Снимок потока GUI
+   * @return true, если снимок обновлён
+   */
+  bool latestFrame(FrameSnapshot& snapshot) const;
+
+  /**
+   * @brief Число опубликованных кадров.
+   */
+  uint64_t frames() const;
+
+  /**
+   * @brief Копирует статистику тиков потока симуляции.
+   *
+   * Заполняются шаг движка, дрожание, опоздавшие и потерянные тики и
+   * целевой интервал; гистограмма paint в stats не меняется. Статистика
+   * копится через перезапуски потока (новые игры).
+   * @param stats Статистика потока GUI
+   */
+  void tickStats(FrameStats& stats) const;
+
+  static constexpr int kFrameIntervalMs = 16; /**< Кадр для advance, мс */
+  static constexpr int kPollIntervalMs = 2; /**< Опрос ввода между тиками */
+
+ private:
+  /**
+   * @brief Цикл потока симуляции.
+   */
+  void run();
+
+  /**
+   * @brief Применяет весь ввод из очереди.
+   */
+  void drainInput();
+
+  /**
+   * @brief Учитывает тик в статистике потока и публикует её копию.
+   * @param now Начало тика
+   * @param stepUs Длительность шага движка, мкс
+   * @param targetUs Интервал, назначенный на предыдущем тике, мкс
+   */
+  void recordTick(std::chrono::steady_clock::time_point now, uint64_t stepUs,
+                  uint32_t targetUs);
+
+  GameAPI m_api;                /**< API игры */
+  FrameRing* m_ring = nullptr;  /**< Кольцо кадров и очередь ввода */
+  std::thread m_thread;         /**< Поток симуляции */
+  FrameStats m_stats;            /**< Темп тиков (только поток симуляции) */
+  FrameStats m_publishedStats;   /**< Копия m_stats для потока GUI */
+  mutable std::mutex m_statsMutex; /**< Защищает m_publishedStats */
+};
+
+#endif  // SIMULATIONTHREAD_H
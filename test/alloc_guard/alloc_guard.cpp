@@ -0,0 +1,64 @@
+/**
+ * @file alloc_guard.cpp
+ * @brief Перехват malloc для тестов (см. alloc_guard.h).
+ */
+#include "alloc_guard.h"
+
+#include <cstddef>
+
+namespace {
+thread_local bool armed = false;
+thread_local std::uint64_t allocations = 0;
+
+void *Count(void *ptr) {
+  if (ptr && armed) ++allocations;
+  return ptr;
+}
+}  // namespace
+
+#ifdef __GLIBC__
+extern "C" {
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *ptr, std::size_t size);
+void *__libc_memalign(std::size_t alignment, std::size_t size);
+
+// Определения в исполняемом файле перекрывают malloc из libc и для
+// разделяемых библиотек движков.
+void *malloc(std::size_t size) noexcept { return Count(__libc_malloc(size)); }
+
+void *calloc(std::size_t count, std::size_t size) noexcept {
+  return Count(__libc_calloc(count, size));
+}
+
+void *realloc(void *ptr, std::size_t size) noexcept {
+  return Count(__libc_realloc(ptr, size));
+}
+
+void *aligned_alloc(std::size_t alignment, std::size_t size) noexcept {
+  return Count(__libc_memalign(alignment, size));
+}
+
+int posix_memalign(void **out, std::size_t alignment,
+                   std::size_t size) noexcept {
+  void *ptr = Count(__libc_memalign(alignment, size));
+  if (!ptr) return 12;  // ENOMEM
+  *out = ptr;
+  return 0;
+}
+}  // extern "C"
+
+bool alloc_guard_available() { return true; }
+#else
+bool alloc_guard_available() { return false; }
+#endif
+
+void alloc_guard_arm() {
+  allocations = 0;
+  armed = true;
+}
+
+std::uint64_t alloc_guard_disarm() {
+  armed = false;
+  return allocations;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file alloc_guard.h
+ * @brief Счётчик всех выделений памяти для тестов «тик без выделений».
+ *
+ * Хуки аллокатора движка (alloc_hooks.h) видят только выделения самого
+ * движка. Здесь перехватываются malloc/calloc/realloc/aligned_alloc
+ * исполняемого файла (glibc): их же вызывают libc (fopen, потоки),
+ * operator new и плагины, так что учитывается любое выделение.
+ *
+ * Счёт ведётся только в потоке, вызвавшем alloc_guard_arm(), и только
+ * до alloc_guard_disarm().
+ */
+#ifndef BRICKGAME_TEST_ALLOC_GUARD_H
+#define BRICKGAME_TEST_ALLOC_GUARD_H
+
+#include <cstdint>
+
+/**
+ * @brief Перехват работает (glibc); иначе счётчик всегда равен нулю.
+ */
+bool alloc_guard_available();
+
+/**
+ * @brief Начинает счёт выделений в текущем потоке.
+ */
+void alloc_guard_arm();
+
+/**
+ * @brief Заканчивает счёт.
+ *
+ * @return число выделений с alloc_guard_arm()
+ */
+std::uint64_t alloc_guard_disarm();
+
+#endif  // BRICKGAME_TEST_ALLOC_GUARD_H
@@ -0,0 +1,565 @@
+/**
+ * @file bench.cpp
+ * @brief Замеры производительности движков (без GUI и плагинов).
+ *
+ * Каждый замер печатает строку «имя: значение единица» и, если задан
+ * порог, сравнивает с ним. Код возврата 1 — хотя бы один замер не
+ * уложился в порог.
+ *
+ * Использование:
+ *   bench [--ticks N] [--snakes N] [--size N] [--filter NAME]
+ */
+#include <ncurses.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../../include/brickgame/common/ansi_frame.h"
+#include "../../include/brickgame/snake/snake_arena.hpp"
+#include "../../include/brickgame/snake/snake_batch.h"
+#include "../../include/brickgame/snake/snake_game.hpp"
+#include "../../include/brickgame/snake/snake_soa.hpp"
+#include "../../include/brickgame/tetris/rollout.h"
+#include "../../include/brickgame/tetris/tetris_batch.h"
+#include "../../include/brickgame/tetris/versus.h"
+
+extern "C" {
+#include "../../include/gui/cli/render.h"
+}
+
+namespace {
+
+struct Options {
+  int ticks = 200;
+  int snakes = 1000;
+  int size = 1024;
+  const char* filter = nullptr;
+};
+
+using Clock = std::chrono::steady_clock;
+
+/// Прогонов в сравнении полей Snake.
+constexpr int kSnakeRounds = 5;
+/// Нижний порог ускорения SoA-ядра AVX2 на шаге бота: на порядок не
+/// выходит, ядро упирается в запись меток по одной (см. snake_soa.hpp).
+constexpr double kSnakeSoaSpeedup = 7;
+
+double SecondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Печатает результат замера.
+ * @param minimum Нижний порог (0 — без порога).
+ * @return false, если значение ниже порога.
+ */
+bool Report(const char* name, double value, const char* unit,
+            double minimum) {
+  bool ok = minimum <= 0 || value >= minimum;
+  std::printf("%-28s %12.1f %s%s\n", name, value, unit,
+              ok ? "" : "  (below target)");
+  return ok;
+}
+
+/**
+ * @brief Арена: N змеек-ботов на поле size x size, тиков в секунду.
+ *
+ * Цель — не меньше 20 тиков/с на одном ядре для 1000 змеек на 1024x1024.
+ */
+bool BenchArena(const Options& options) {
+  s21::SnakeArena arena(options.size, options.size, options.snakes, 1);
+  for (int i = 0; i < options.snakes; ++i) arena.AddRandomSnake(4);
+
+  Clock::time_point start = Clock::now();
+  for (int tick = 0; tick < options.ticks; ++tick) {
+    arena.SteerBots();
+    arena.Tick();
+  }
+  double seconds = SecondsSince(start);
+
+  std::printf("arena: %d snakes on %dx%d, %d alive after %d ticks\n",
+              options.snakes, options.size, options.size, arena.AliveCount(),
+              options.ticks);
+  return Report("arena_ticks_per_sec", options.ticks / seconds, "ticks/s",
+                20.0);
+}
+
+/**
+ * @brief Versus без фронтенда: два бота со случайным вводом, кадров в
+ *        секунду. Закончившийся матч начинается заново.
+ */
+bool BenchVersus(const Options& options) {
+  const UserAction_t actions[] = {Left, Right, Down, Action};
+  const int frames = options.ticks * 500;
+  TetrisVersus versus;
+  tetris_versus_init(&versus, 2, 1, 16, 15);
+  std::uint32_t seed = 1;
+  int matches = 1;
+
+  Clock::time_point start = Clock::now();
+  for (int frame = 0; frame < frames; ++frame) {
+    for (int player = 0; player < versus.count; ++player) {
+      seed = seed * 1664525u + 1013904223u;
+      if ((seed >> 28) < 4) {
+        tetris_versus_input(&versus, player, actions[(seed >> 8) % 4], false);
+      }
+    }
+    if (!tetris_versus_step(&versus)) {
+      tetris_versus_init(&versus, 2, ++matches, 16, 15);
+    }
+  }
+  double seconds = SecondsSince(start);
+
+  std::printf("versus: 2 players, %d frames, %d matches\n", frames, matches);
+  return Report("versus_frames_per_sec", frames / seconds, "frames/s", 0);
+}
+
+/**
+ * @brief Направление обхода гамильтонова цикла поля (высота чётная).
+ *
+ * Столбцы 1..width-1 проходятся змейкой по строкам, столбец 0 ведёт
+ * обратно наверх, поэтому бот не погибает и доедает поле до победы.
+ */
+UserAction_t CycleTurn(s21::SnakeSegment head, int width, int height) {
+  if (head.x == 0) return head.y == 0 ? Right : Up;
+  if (head.y % 2 == 0) return head.x < width - 1 ? Right : Down;
+  if (head.x > 1) return Left;
+  return head.y == height - 1 ? Left : Down;
+}
+
+/**
+ * @brief Шаг бота на гамильтоновом цикле; закончившаяся партия
+ *        начинается заново.
+ *
+ * @param head  голова змейки (обновляется)
+ * @param start голова в начале партии
+ */
+template <typename Game>
+void CycleStep(Game& game, s21::SnakeSegment& head, s21::SnakeSegment start) {
+  UserAction_t turn = CycleTurn(head, game.FieldWidth(), game.FieldHeight());
+  game.ChangeDirection(turn);
+  game.Tick();
+  head = s21::NextHeadPosition(
+      head, turn == Up     ? s21::SnakeDirection::Up
+            : turn == Down ? s21::SnakeDirection::Down
+            : turn == Left ? s21::SnakeDirection::Left
+                           : s21::SnakeDirection::Right);
+  if (game.GetState() != s21::SnakeGameState::Running) {
+    game.Reset();
+    game.Resume();
+    head = start;
+  }
+}
+
+/**
+ * @brief Шаги SnakeGame с ботом на гамильтоновом цикле.
+ */
+template <typename Game>
+double SnakeStepsPerSecond(Game& game, int steps) {
+  const s21::SnakeSegment start{3, game.FieldHeight() / 2};
+  s21::SnakeSegment head = start;
+  game.Resume();
+
+  Clock::time_point begin = Clock::now();
+  for (int step = 0; step < steps; ++step) CycleStep(game, head, start);
+  return steps / SecondsSince(begin);
+}
+
+/**
+ * @brief Классическое поле 10x20: шаблон фиксированного размера против
+ *        поля, заданного во время выполнения.
+ */
+bool BenchSnakeBoard(const Options& options) {
+  const int steps = options.ticks * 10000;
+  s21::SnakeGame fixed;
+  s21::DynamicSnakeGame dynamic(kGameWidth, kGameHeight);
+
+  // Лучший из нескольких прогонов, порядок чередуется: так прогрев и
+  // частота процессора не достаются одному из вариантов.
+  double fixed_rate = 0, dynamic_rate = 0;
+  for (int round = 0; round < kSnakeRounds; ++round) {
+    bool fixed_first = round % 2 == 0;
+    if (fixed_first) {
+      fixed_rate = std::max(fixed_rate, SnakeStepsPerSecond(fixed, steps));
+    }
+    dynamic_rate =
+        std::max(dynamic_rate, SnakeStepsPerSecond(dynamic, steps));
+    if (!fixed_first) {
+      fixed_rate = std::max(fixed_rate, SnakeStepsPerSecond(fixed, steps));
+    }
+  }
+  std::printf("snake: %d steps on %dx%d, fixed/dynamic = %.2f\n", steps,
+              kGameWidth, kGameHeight, fixed_rate / dynamic_rate);
+  Report("snake_fixed_steps_per_sec", fixed_rate, "steps/s", 0);
+  Report("snake_dynamic_steps_per_sec", dynamic_rate, "steps/s", 0);
+  return true;
+}
+
+/**
+ * @brief Пакеты сред Snake и Tetris: шаги сред в секунду.
+ */
+bool BenchBatch(const Options& options) {
+  const int envs = 256;
+  const int steps = options.ticks * 10;
+  std::vector<std::int32_t> actions(envs);
+  std::vector<float> rewards(envs);
+  std::vector<std::uint8_t> dones(envs);
+  std::uint32_t seed = 1;
+  auto random_actions = [&](const std::int32_t* choices, int count) {
+    for (std::int32_t& action : actions) {
+      seed = seed * 1664525u + 1013904223u;
+      action = choices[(seed >> 16) % count];
+    }
+  };
+
+  const std::int32_t snake_choices[] = {Up, Down, Left, Right, Action};
+  std::vector<float> snake_obs(envs * SNAKE_BATCH_OBS_SIZE);
+  SnakeBatch* snake = snake_batch_create(envs, 1, 1000);
+  Clock::time_point start = Clock::now();
+  for (int step = 0; step < steps; ++step) {
+    random_actions(snake_choices, 5);
+    snake_batch_step(snake, actions.data(), snake_obs.data(), rewards.data(),
+                     dones.data());
+  }
+  double snake_rate = static_cast<double>(envs) * steps / SecondsSince(start);
+  snake_batch_destroy(snake);
+
+  const std::int32_t tetris_choices[] = {Left, Right, Down, Action, Up};
+  std::vector<float> tetris_obs(envs * TETRIS_BATCH_OBS_SIZE);
+  TetrisBatch* tetris = tetris_batch_create(envs, 1, 1000);
+  start = Clock::now();
+  for (int step = 0; step < steps; ++step) {
+    random_actions(tetris_choices, 5);
+    tetris_batch_step(tetris, actions.data(), tetris_obs.data(),
+                      rewards.data(), dones.data());
+  }
+  double tetris_rate = static_cast<double>(envs) * steps / SecondsSince(start);
+  tetris_batch_destroy(tetris);
+
+  std::printf("batch: %d envs, %d steps\n", envs, steps);
+  Report("snake_batch_env_steps_per_sec", snake_rate, "steps/s", 0);
+  Report("tetris_batch_env_steps_per_sec", tetris_rate, "steps/s", 0);
+  return true;
+}
+
+/**
+ * @brief Шаги SoA-пакета: партии, закончившиеся на шаге, начинаются
+ *        заново (как в цикле по отдельным SnakeGame).
+ */
+double SoaStepsPerSecond(bool simd, int envs, int steps,
+                         const std::vector<std::int32_t>& actions) {
+  s21::SnakeSoaBatch batch(envs, 1);
+  batch.SetSimd(simd);
+  Clock::time_point start = Clock::now();
+  for (int step = 0; step < steps; ++step) {
+    batch.Step(&actions[static_cast<std::size_t>(step) * envs]);
+    batch.ResetFinished();
+  }
+  return static_cast<double>(envs) * steps / SecondsSince(start);
+}
+
+/**
+ * @brief Те же действия для отдельных SnakeGame подряд (партия i с
+ *        зерном 1 + i, как в SoA-пакете).
+ */
+double GamesStepsPerSecond(int envs, int steps,
+                           const std::vector<std::int32_t>& actions) {
+  s21::SnakeGame prototype;
+  prototype.SetHighScoreFile(false);
+  std::vector<s21::SnakeGame> games(envs, prototype);
+  for (int env = 0; env < envs; ++env) {
+    games[env].Seed(1 + static_cast<std::uint32_t>(env));
+    games[env].Reset();
+    games[env].Resume();
+  }
+  Clock::time_point start = Clock::now();
+  for (int step = 0; step < steps; ++step) {
+    const std::int32_t* row = &actions[static_cast<std::size_t>(step) * envs];
+    for (int env = 0; env < envs; ++env) {
+      s21::SnakeGame& game = games[env];
+      if (row[env] != Start) {
+        game.ChangeDirection(static_cast<UserAction_t>(row[env]));
+      }
+      game.Update();
+      if (game.GetState() != s21::SnakeGameState::Running) {
+        game.Reset();
+        game.Resume();
+      }
+    }
+  }
+  return static_cast<double>(envs) * steps / SecondsSince(start);
+}
+
+/**
+ * @brief Одна нагрузка SoA-пакета: лучшие из kSnakeRounds прогонов
+ *        SnakeGame, скалярного и векторного ядра (порядок сдвигается
+ *        по кругу).
+ *
+ * @return ускорение векторного ядра относительно SnakeGame
+ */
+double SoaWorkload(const char* name, int envs, int steps,
+                   const std::vector<std::int32_t>& actions) {
+  const bool simd = s21::SnakeSoaBatch::SimdAvailable();
+  double rates[3] = {0, 0, 0};  // SnakeGame, скалярное, векторное
+  for (int round = 0; round < kSnakeRounds; ++round) {
+    for (int i = 0; i < 3; ++i) {
+      int kind = (round + i) % 3;
+      double rate = 0;
+      if (kind == 0) {
+        rate = GamesStepsPerSecond(envs, steps, actions);
+      } else if (kind == 1 || simd) {
+        rate = SoaStepsPerSecond(kind == 2, envs, steps, actions);
+      }
+      rates[kind] = std::max(rates[kind], rate);
+    }
+  }
+
+  std::printf("snake_soa %s: %d envs, %d steps, scalar/games = %.1f, "
+              "simd/games = %.1f\n",
+              name, envs, steps, rates[1] / rates[0], rates[2] / rates[0]);
+  std::string prefix = std::string("snake_soa_") + name;
+  Report((prefix + "_games").c_str(), rates[0], "steps/s", 0);
+  Report((prefix + "_scalar").c_str(), rates[1], "steps/s", 0);
+  Report((prefix + "_simd").c_str(), rates[2], "steps/s", 0);
+  return rates[2] / rates[0];
+}
+
+/**
+ * @brief Тысячи партий Snake: SoA-пакет (скалярное и векторное ядро)
+ *        против шагов отдельных SnakeGame подряд.
+ *
+ * Две нагрузки: бот на гамильтоновом цикле не проигрывает, и замер
+ * показывает цену шага; при случайных действиях партия живёт около
+ * 12 шагов, и в замер входят перезапуски. Порог — векторное ядро в
+ * kSnakeSoaSpeedup раз быстрее SnakeGame на шаге бота.
+ */
+bool BenchSnakeSoa(const Options& options) {
+  const int envs = 4096;
+  const int steps = options.ticks * 5;
+  std::vector<std::int32_t> actions(static_cast<std::size_t>(envs) * steps);
+
+  // Действия бота записываются заранее скалярным пакетом: у всех
+  // реализаций одни и те же партии.
+  s21::SnakeSoaBatch recorder(envs, 1);
+  recorder.SetSimd(false);
+  for (int step = 0; step < steps; ++step) {
+    std::int32_t* row = &actions[static_cast<std::size_t>(step) * envs];
+    for (int env = 0; env < envs; ++env) {
+      row[env] = CycleTurn(recorder.Head(env), kGameWidth, kGameHeight);
+    }
+    recorder.Step(row);
+    recorder.ResetFinished();
+  }
+  double speedup = SoaWorkload("cycle", envs, steps, actions);
+
+  std::uint32_t seed = 1;
+  for (std::int32_t& action : actions) {
+    seed = seed * 1664525u + 1013904223u;
+    // Четверть шагов — поворот, остальные сохраняют направление.
+    std::uint32_t roll = (seed >> 16) % 16;
+    action = roll < 4 ? Left + static_cast<std::int32_t>(roll) : Start;
+  }
+  SoaWorkload("random", envs, steps, actions);
+
+  return Report("snake_soa_cycle_simd_speedup", speedup, "x",
+                s21::SnakeSoaBatch::SimdAvailable() ? kSnakeSoaSpeedup : 0);
+}
+
+/**
+ * @brief Оценка установок Монте-Карло: фигур продолжений в секунду для
+ *        случайной и жадной политики.
+ */
+bool BenchRollout(const Options& options) {
+  TetrisVersus versus;
+  tetris_versus_init(&versus, 1, 1, 0, -1);
+  const TetrisBoard& board = versus.players[0].board;
+
+  TetrisRolloutConfig config{};
+  config.rollouts = std::max(1, options.ticks / 2);
+  config.depth = 10;
+  config.seed = 1;
+  TetrisPlacementStats stats[TETRIS_ROLLOUT_MAX_PLACEMENTS];
+  double rates[2] = {0, 0};
+  int count = 0;
+  for (int policy = 0; policy < 2; ++policy) {
+    config.policy = static_cast<TetrisRolloutPolicy>(policy);
+    Clock::time_point start = Clock::now();
+    count = tetris_rollout_evaluate(&board, &config, stats,
+                                    TETRIS_ROLLOUT_MAX_PLACEMENTS);
+    double seconds = SecondsSince(start);
+    double pieces = 0;
+    for (int i = 0; i < count; ++i) {
+      pieces += stats[i].mean_pieces * config.rollouts;
+    }
+    rates[policy] = pieces / seconds;
+  }
+
+  std::printf("rollout: %d placements, %d rollouts, depth %d\n", count,
+              config.rollouts, config.depth);
+  Report("rollout_random_pieces_per_sec", rates[TETRIS_ROLLOUT_RANDOM],
+         "pieces/s", 0);
+  Report("rollout_greedy_pieces_per_sec", rates[TETRIS_ROLLOUT_GREEDY],
+         "pieces/s", 0);
+  return true;
+}
+
+/**
+ * @brief Приёмник вывода отрисовки: пара сокетов SOCK_SEQPACKET, где
+ *        одно сообщение — один write() пишущей стороны.
+ */
+struct WriteCounter {
+  int fds[2] = {-1, -1};  ///< [0] — для отрисовки, [1] — для подсчёта
+  std::uint64_t writes = 0;
+  std::uint64_t bytes = 0;
+
+  bool Open() { return socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) == 0; }
+  void Close() {
+    for (int& fd : fds) {
+      if (fd >= 0) close(fd);
+      fd = -1;
+    }
+  }
+  /// Забирает всё записанное с прошлого вызова.
+  void Drain() {
+    char buf[4096];
+    ssize_t len;
+    while ((len = recv(fds[1], buf, sizeof(buf), MSG_DONTWAIT | MSG_TRUNC)) >
+           0) {
+      ++writes;
+      bytes += static_cast<std::uint64_t>(len);
+    }
+  }
+};
+
+/**
+ * @brief Вывод игрового экрана CLI: байт и write() на кадр у ncurses
+ *        (render_game()) и у кадра ANSI на одной и той же партии.
+ *
+ * Бот на гамильтоновом цикле играет Snake на поле 10x20, каждый шаг —
+ * кадр. ncurses выводит в сокет через newterm() с терминалом xterm
+ * 80x24, кадр ANSI — через ansi_frame_flush(); его байты и write()
+ * берутся из счётчиков AnsiFrame.
+ */
+bool BenchRender(const Options& options) {
+  const int frames = options.ticks * 10;
+  WriteCounter curses_out, ansi_out;
+  FILE* out = nullptr;
+  FILE* in = std::fopen("/dev/null", "r");
+  SCREEN* screen = nullptr;
+  if (in && curses_out.Open() && ansi_out.Open()) {
+    out = fdopen(curses_out.fds[0], "w");
+  }
+  if (out) screen = newterm("xterm", out, in);
+  if (!screen) {
+    std::printf("render: cannot open ncurses screen, skipped\n");
+    if (out) std::fclose(out);
+    if (in) std::fclose(in);
+    if (!out) curses_out.Close();
+    ansi_out.Close();
+    return true;
+  }
+
+  unsetenv(RENDER_BACKEND_ENV);
+  render_set_field_size(kGameWidth, kGameHeight);
+  AnsiFrame ansi;
+  bool ansi_ready = ansi_frame_init(&ansi, kGameWidth, kGameHeight, COLS,
+                                    LINES);
+  curses_out.Drain();
+  curses_out.writes = curses_out.bytes = 0;
+
+  s21::SnakeGame game;
+  game.SetHighScoreFile(false);
+  const s21::SnakeSegment start{3, game.FieldHeight() / 2};
+  s21::SnakeSegment head = start;
+  game.Resume();
+  for (int frame = 0; frame < frames && ansi_ready; ++frame) {
+    CycleStep(game, head, start);
+    GameInfo_t info = game.GetFrame();
+    render_game(&info);
+    curses_out.Drain();
+    ansi_frame_compose(&ansi, &info);
+    ansi_frame_flush(&ansi, ansi_out.fds[0]);
+    ansi_out.Drain();
+  }
+
+  render_shutdown();
+  endwin();
+  delscreen(screen);
+  std::fclose(out);
+  std::fclose(in);
+  curses_out.fds[0] = -1;
+  curses_out.Close();
+  ansi_out.Close();
+  if (!ansi_ready) return false;
+
+  std::printf("render: %d frames on %dx%d, ansi frames with output %llu\n",
+              frames, kGameWidth, kGameHeight,
+              static_cast<unsigned long long>(ansi.frames));
+  Report("render_ncurses_bytes_per_frame",
+         static_cast<double>(curses_out.bytes) / frames, "B", 0);
+  Report("render_ncurses_writes_per_frame",
+         static_cast<double>(curses_out.writes) / frames, "writes", 0);
+  Report("render_ansi_bytes_per_frame",
+         static_cast<double>(ansi.bytes) / frames, "B", 0);
+  Report("render_ansi_writes_per_frame",
+         static_cast<double>(ansi.writes) / frames, "writes", 0);
+  ansi_frame_free(&ansi);
+  return true;
+}
+
+struct Benchmark {
+  const char* name;
+  bool (*run)(const Options&);
+};
+
+const Benchmark kBenchmarks[] = {
+    {"arena", BenchArena},
+    {"versus", BenchVersus},
+    {"snake_board", BenchSnakeBoard},
+    {"batch", BenchBatch},
+    {"snake_soa", BenchSnakeSoa},
+    {"rollout", BenchRollout},
+    {"render", BenchRender},
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    bool has_value = i + 1 < argc;
+    if (has_value && std::strcmp(argv[i], "--ticks") == 0) {
+      options.ticks = std::atoi(argv[++i]);
+    } else if (has_value && std::strcmp(argv[i], "--snakes") == 0) {
+      options.snakes = std::atoi(argv[++i]);
+    } else if (has_value && std::strcmp(argv[i], "--size") == 0) {
+      options.size = std::atoi(argv[++i]);
+    } else if (has_value && std::strcmp(argv[i], "--filter") == 0) {
+      options.filter = argv[++i];
+    } else {
+      std::fprintf(stderr,
+                   "usage: %s [--ticks N] [--snakes N] [--size N] "
+                   "[--filter NAME]\n",
+                   argv[0]);
+      return 2;
+    }
+  }
+  if (options.ticks < 1) options.ticks = 1;
+
+  bool ok = true;
+  for (const Benchmark& benchmark : kBenchmarks) {
+    if (options.filter && !std::strstr(benchmark.name, options.filter)) {
+      continue;
+    }
+    ok = benchmark.run(options) && ok;
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,365 @@
+/**
+ * @file soak.c
+ * @brief Длительный прогон игр через публичный API с контролем памяти.
+ *
+ * Для каждого плагина выполняется заданное число тиков со случайным
+ * вводом; после окончания партии игра перезапускается через Start.
+ * Периодически снимаются RSS процесса и счётчики выделений памяти
+ * (malloc/free перехватываются в этом исполняемом файле, поэтому
+ * учитываются и выделения внутри плагинов, включая operator new).
+ *
+ * Результаты пишутся в CSV. Программа завершается с кодом 1, если после
+ * прогрева есть тренд роста: наклон живых байт или живых блоков (метод
+ * наименьших квадратов) выше порога, либо максимум живых байт, блоков
+ * или RSS в последней четверти превышает максимум второй сверх допуска.
+ *
+ * Использование:
+ *   soak [--ticks N] [--samples N] [--csv PATH] [--tolerance-kb N]
+ *        [--rss-tolerance-kb N] [--alloc-tolerance N] [--max-slope N]
+ *        [--max-alloc-slope N] plugin...
+ */
+#define _GNU_SOURCE
+
+#include <malloc.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../../include/brickgame/common/plugin_loader.h"
+
+/* === Учёт выделений памяти (glibc) ===
+ * Функции экспортируются (EXPORT), чтобы плагины и libc связывались
+ * с ними, а не с malloc из libc. */
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void *ptr);
+
+/**
+ * @brief Счётчики выделений памяти процесса.
+ */
+typedef struct {
+  uint64_t total_allocs;  ///< Всего выделений с начала работы
+  int64_t live_allocs;    ///< Выделено и ещё не освобождено
+  int64_t live_bytes;     ///< Байт в живых блоках (usable size)
+} AllocStats;
+
+static AllocStats alloc_stats;
+
+static void *track_alloc(void *ptr) {
+  if (ptr) {
+    alloc_stats.total_allocs++;
+    alloc_stats.live_allocs++;
+    alloc_stats.live_bytes += (int64_t)malloc_usable_size(ptr);
+  }
+  return ptr;
+}
+
+static void track_free(void *ptr) {
+  if (ptr) {
+    alloc_stats.live_allocs--;
+    alloc_stats.live_bytes -= (int64_t)malloc_usable_size(ptr);
+  }
+}
+
+EXPORT void *malloc(size_t size) { return track_alloc(__libc_malloc(size)); }
+
+EXPORT void *calloc(size_t count, size_t size) {
+  return track_alloc(__libc_calloc(count, size));
+}
+
+EXPORT void *realloc(void *ptr, size_t size) {
+  track_free(ptr);
+  void *result = __libc_realloc(ptr, size);
+  if (!result && size != 0 && ptr) {
+    /* Старый блок остался на месте. */
+    alloc_stats.live_allocs++;
+    alloc_stats.live_bytes += (int64_t)malloc_usable_size(ptr);
+    return NULL;
+  }
+  if (result) {
+    alloc_stats.live_allocs++;
+    alloc_stats.live_bytes += (int64_t)malloc_usable_size(result);
+  }
+  return result;
+}
+
+EXPORT void *aligned_alloc(size_t alignment, size_t size) {
+  return track_alloc(__libc_memalign(alignment, size));
+}
+
+EXPORT int posix_memalign(void **out, size_t alignment, size_t size) {
+  void *ptr = track_alloc(__libc_memalign(alignment, size));
+  if (!ptr) return 12; /* ENOMEM */
+  *out = ptr;
+  return 0;
+}
+
+EXPORT void free(void *ptr) {
+  track_free(ptr);
+  __libc_free(ptr);
+}
+
+/* === Прогон === */
+
+/**
+ * @brief Параметры прогона.
+ */
+typedef struct {
+  uint64_t ticks;            ///< Тиков на каждую игру
+  int samples;               ///< Замеров на каждую игру
+  const char *csv_path;      ///< Файл результатов
+  int64_t tolerance_bytes;   ///< Допустимый рост живой памяти
+  int64_t rss_tolerance_kb;  ///< Допустимый рост RSS
+  int64_t alloc_tolerance;   ///< Допустимый рост числа живых блоков
+  double max_slope;          ///< Наибольший наклон живых байт, Б/млн тиков
+  double max_alloc_slope;    ///< Наибольший наклон живых блоков на млн тиков
+} SoakOptions;
+
+/**
+ * @brief Один замер памяти.
+ */
+typedef struct {
+  uint64_t tick;
+  uint64_t restarts;
+  int64_t rss_kb;
+  AllocStats allocs;
+} SoakSample;
+
+/**
+ * @brief Текущий RSS процесса в КиБ (0, если /proc недоступен).
+ */
+static int64_t current_rss_kb(void) {
+  FILE *statm = fopen("/proc/self/statm", "r");
+  if (!statm) return 0;
+  long size = 0, resident = 0;
+  int fields = fscanf(statm, "%ld %ld", &size, &resident);
+  fclose(statm);
+  return fields == 2 ? (int64_t)resident * sysconf(_SC_PAGESIZE) / 1024 : 0;
+}
+
+/**
+ * @brief Генератор ввода (xorshift64), чтобы прогон был воспроизводим.
+ */
+static uint64_t next_input(uint64_t *state) {
+  uint64_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return *state = x;
+}
+
+/**
+ * @brief Случайное действие игрока; чаще всего — холостое.
+ */
+static UserAction_t random_action(const BrickGameApi *api, uint64_t *rng,
+                                  bool *hold) {
+  static const UserAction_t moves[] = {Left, Right, Up, Down, Action};
+  uint64_t r = next_input(rng) % 16;
+  *hold = false;
+  if (r >= 5) return api->idle_action;
+  *hold = (moves[r] == Action) && (next_input(rng) & 1);
+  return moves[r];
+}
+
+/**
+ * @brief Отслеживаемая величина замера.
+ */
+typedef enum { SOAK_LIVE_BYTES, SOAK_LIVE_ALLOCS, SOAK_RSS } SoakMetric;
+
+static int64_t metric_of(const SoakSample *sample, SoakMetric metric) {
+  switch (metric) {
+    case SOAK_LIVE_BYTES:
+      return sample->allocs.live_bytes;
+    case SOAK_LIVE_ALLOCS:
+      return sample->allocs.live_allocs;
+    default:
+      return sample->rss_kb;
+  }
+}
+
+/**
+ * @brief Максимум величины по отрезку замеров [from, to).
+ */
+static int64_t max_over(const SoakSample *samples, int from, int to,
+                        SoakMetric metric) {
+  int64_t result = INT64_MIN;
+  for (int i = from; i < to; ++i) {
+    int64_t value = metric_of(&samples[i], metric);
+    if (value > result) result = value;
+  }
+  return result;
+}
+
+/**
+ * @brief Наклон величины методом наименьших квадратов, единиц/млн тиков.
+ */
+static double slope_of(const SoakSample *samples, int from, int to,
+                       SoakMetric metric) {
+  double n = to - from, sx = 0, sy = 0, sxx = 0, sxy = 0;
+  for (int i = from; i < to; ++i) {
+    double x = (double)samples[i].tick / 1e6;
+    double y = (double)metric_of(&samples[i], metric);
+    sx += x;
+    sy += y;
+    sxx += x * x;
+    sxy += x * y;
+  }
+  double denom = n * sxx - sx * sx;
+  return denom != 0 ? (n * sxy - sx * sy) / denom : 0;
+}
+
+/**
+ * @brief Прогоняет одну игру и проверяет отсутствие роста памяти.
+ *
+ * Первая четверть замеров — прогрев (кэши, high score, буферы stdio).
+ * По остальным считаются наклоны живых байт и блоков; кроме того,
+ * максимум последней четверти сравнивается с максимумом второй.
+ *
+ * @return true, если роста сверх допуска нет
+ */
+static bool soak_plugin(const char *path, const SoakOptions *options,
+                        FILE *csv) {
+  char error[256];
+  BrickGamePlugin plugin;
+  if (!plugin_load(path, &plugin, error, sizeof(error))) {
+    fprintf(stderr, "soak: %s: %s\n", path, error);
+    return false;
+  }
+  const BrickGameApi *api = plugin.api;
+  bool caller_frees = api->freeGameInfo &&
+                      (api->capabilities & BRICKGAME_CAP_CALLER_FREES_INFO);
+
+  SoakSample *samples = __libc_malloc(sizeof(*samples) * options->samples);
+  uint64_t interval = options->ticks / (uint64_t)options->samples;
+  if (interval == 0) interval = 1;
+
+  uint64_t rng = 0x2545F4914F6CDD1Dull;
+  uint64_t restarts = 0;
+  int taken = 0;
+
+  api->userInput(Start, false);
+  for (uint64_t tick = 1; tick <= options->ticks; ++tick) {
+    if (api->isGameOver()) {
+      api->userInput(Start, false);
+      restarts++;
+    } else {
+      bool hold = false;
+      UserAction_t action = random_action(api, &rng, &hold);
+      api->userInput(action, hold);
+    }
+
+    GameInfo_t info = api->updateCurrentState();
+    if (caller_frees) api->freeGameInfo(&info);
+
+    if (tick % interval == 0 && taken < options->samples) {
+      SoakSample *sample = &samples[taken++];
+      sample->tick = tick;
+      sample->restarts = restarts;
+      sample->rss_kb = current_rss_kb();
+      sample->allocs = alloc_stats;
+      fprintf(csv, "%s,%llu,%llu,%lld,%lld,%lld,%llu\n", api->id,
+              (unsigned long long)sample->tick,
+              (unsigned long long)sample->restarts,
+              (long long)sample->rss_kb,
+              (long long)sample->allocs.live_allocs,
+              (long long)sample->allocs.live_bytes,
+              (unsigned long long)sample->allocs.total_allocs);
+    }
+  }
+
+  bool ok = true;
+  if (taken >= 4) {
+    int quarter = taken / 4;
+    int64_t growth[3];
+    for (int m = SOAK_LIVE_BYTES; m <= SOAK_RSS; ++m) {
+      growth[m] = max_over(samples, taken - quarter, taken, (SoakMetric)m) -
+                  max_over(samples, quarter, 2 * quarter, (SoakMetric)m);
+    }
+    double slope = slope_of(samples, quarter, taken, SOAK_LIVE_BYTES);
+    double alloc_slope = slope_of(samples, quarter, taken, SOAK_LIVE_ALLOCS);
+
+    ok = growth[SOAK_LIVE_BYTES] <= options->tolerance_bytes &&
+         growth[SOAK_LIVE_ALLOCS] <= options->alloc_tolerance &&
+         growth[SOAK_RSS] <= options->rss_tolerance_kb &&
+         slope <= options->max_slope && alloc_slope <= options->max_alloc_slope;
+    printf(
+        "%-8s ticks=%llu restarts=%llu live=%+lld B %+lld blocks "
+        "rss=%+lld KiB slope=%.1f B/Mtick %.2f blocks/Mtick %s\n",
+        api->id, (unsigned long long)options->ticks,
+        (unsigned long long)restarts, (long long)growth[SOAK_LIVE_BYTES],
+        (long long)growth[SOAK_LIVE_ALLOCS], (long long)growth[SOAK_RSS],
+        slope, alloc_slope, ok ? "OK" : "GROWTH");
+  } else {
+    printf("%-8s too few samples for a trend\n", api->id);
+  }
+
+  __libc_free(samples);
+  plugin_unload(&plugin);
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  SoakOptions options = {.ticks = 1000000,
+                         .samples = 200,
+                         .csv_path = "soak.csv",
+                         .tolerance_bytes = 64 * 1024,
+                         .rss_tolerance_kb = 1024,
+                         .alloc_tolerance = 0,
+                         .max_slope = 256,
+                         .max_alloc_slope = 1.0};
+  int first_plugin = argc;
+
+  for (int i = 1; i < argc; ++i) {
+    bool has_value = i + 1 < argc;
+    if (has_value && strcmp(argv[i], "--ticks") == 0) {
+      options.ticks = strtoull(argv[++i], NULL, 10);
+    } else if (has_value && strcmp(argv[i], "--samples") == 0) {
+      options.samples = atoi(argv[++i]);
+    } else if (has_value && strcmp(argv[i], "--csv") == 0) {
+      options.csv_path = argv[++i];
+    } else if (has_value && strcmp(argv[i], "--tolerance-kb") == 0) {
+      options.tolerance_bytes = atoll(argv[++i]) * 1024;
+    } else if (has_value && strcmp(argv[i], "--rss-tolerance-kb") == 0) {
+      options.rss_tolerance_kb = atoll(argv[++i]);
+    } else if (has_value && strcmp(argv[i], "--alloc-tolerance") == 0) {
+      options.alloc_tolerance = atoll(argv[++i]);
+    } else if (has_value && strcmp(argv[i], "--max-slope") == 0) {
+      options.max_slope = atof(argv[++i]);
+    } else if (has_value && strcmp(argv[i], "--max-alloc-slope") == 0) {
+      options.max_alloc_slope = atof(argv[++i]);
+    } else {
+      first_plugin = i;
+      break;
+    }
+  }
+  if (first_plugin >= argc || options.samples <= 0 || options.ticks == 0) {
+    fprintf(stderr,
+            "usage: %s [--ticks N] [--samples N] [--csv PATH] "
+            "[--tolerance-kb N] [--rss-tolerance-kb N] "
+            "[--alloc-tolerance N] [--max-slope N] [--max-alloc-slope N] "
+            "plugin...\n",
+            argv[0]);
+    return 2;
+  }
+
+  FILE *csv = fopen(options.csv_path, "w");
+  if (!csv) {
+    perror(options.csv_path);
+    return 2;
+  }
+  fprintf(csv,
+          "game,tick,restarts,rss_kb,live_allocs,live_bytes,total_allocs\n");
+
+  bool ok = true;
+  for (int i = first_plugin; i < argc; ++i) {
+    ok = soak_plugin(argv[i], &options, csv) && ok;
+  }
+  fclose(csv);
+  return ok ? 0 : 1;
+}
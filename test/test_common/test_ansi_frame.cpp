@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../../include/brickgame/common/ansi_frame.h"
+
+namespace {
+/// Поле width x height в формате GameInfo_t.
+struct Board {
+  Board(int width, int height)
+      : cells(static_cast<size_t>(width) * height, 0), rows(height) {
+    for (int y = 0; y < height; ++y) rows[y] = cells.data() + y * width;
+    info.field = rows.data();
+    info.level = 1;
+    info.speed = 600;
+  }
+  std::vector<int> cells;
+  std::vector<int*> rows;
+  GameInfo_t info{};
+};
+
+std::string Compose(AnsiFrame& frame, const Board& board) {
+  size_t len = ansi_frame_compose(&frame, &board.info);
+  return std::string(frame.buf, len);
+}
+}  // namespace
+
+TEST(AnsiFrameTest, FirstFrameIsFullThenOnlyChangesAreWritten) {
+  Board board(10, 20);
+  board.rows[0][0] = 1;
+  AnsiFrame frame;
+  ASSERT_TRUE(ansi_frame_init(&frame, 10, 20, 80, 24));
+  EXPECT_EQ(frame.view_w, 10);
+  EXPECT_EQ(frame.view_h, 20);
+
+  std::string full = Compose(frame, board);
+  EXPECT_EQ(full.rfind("\x1b[H\x1b[2J", 0), 0u);
+  EXPECT_NE(full.find("\x1b[2;2H[]"), std::string::npos);
+  EXPECT_NE(full.find("Score: 0"), std::string::npos);
+
+  EXPECT_EQ(Compose(frame, board), "");
+
+  // Две соседние клетки выводятся с одной перестановкой курсора.
+  board.rows[3][4] = 1;
+  board.rows[3][5] = 1;
+  EXPECT_EQ(Compose(frame, board), "\x1b[5;10H[][]");
+
+  board.info.score = 7;
+  EXPECT_EQ(Compose(frame, board), "\x1b[8;24HScore: 7\x1b[K");
+
+  ansi_frame_invalidate(&frame);
+  EXPECT_EQ(Compose(frame, board).rfind("\x1b[H\x1b[2J", 0), 0u);
+  ansi_frame_free(&frame);
+}
+
+TEST(AnsiFrameTest, FlushWritesFrameWithSingleWrite) {
+  Board board(10, 20);
+  AnsiFrame frame;
+  ASSERT_TRUE(ansi_frame_init(&frame, 10, 20, 80, 24));
+  size_t len = ansi_frame_compose(&frame, &board.info);
+
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  ASSERT_TRUE(ansi_frame_flush(&frame, fds[1]));
+  close(fds[1]);
+  std::string out(len, '\0');
+  ASSERT_EQ(read(fds[0], out.data(), len), static_cast<ssize_t>(len));
+  close(fds[0]);
+
+  EXPECT_EQ(frame.writes, 1u);
+  EXPECT_EQ(frame.frames, 1u);
+  EXPECT_EQ(frame.bytes, len);
+  EXPECT_EQ(out.rfind("\x1b[H\x1b[2J", 0), 0u);
+  ansi_frame_free(&frame);
+}
+
+TEST(AnsiFrameTest, ViewportFollowsChangesOnLargeBoard) {
+  Board board(60, 80);
+  AnsiFrame frame;
+  ASSERT_TRUE(ansi_frame_init(&frame, 60, 80, 80, 24));
+  EXPECT_EQ(frame.view_w, (80 - 3 - ANSI_FRAME_PANEL_COLS) / 2);
+  EXPECT_EQ(frame.view_h, 22);
+  Compose(frame, board);
+
+  board.rows[70][50] = 1;
+  std::string moved = Compose(frame, board);
+  EXPECT_EQ(moved.rfind("\x1b[H\x1b[2J", 0), 0u);
+  EXPECT_LE(frame.view_x, 50);
+  EXPECT_GT(frame.view_x + frame.view_w, 50);
+  EXPECT_LE(frame.view_y, 70);
+  EXPECT_GT(frame.view_y + frame.view_h, 70);
+  EXPECT_NE(moved.find("View "), std::string::npos);
+
+  // Изменение рядом с центром окна не сдвигает его.
+  int view_x = frame.view_x;
+  board.rows[71][50] = 1;
+  std::string step = Compose(frame, board);
+  EXPECT_EQ(step.find("\x1b[2J"), std::string::npos);
+  EXPECT_EQ(frame.view_x, view_x);
+  ansi_frame_free(&frame);
+}
+
+TEST(AnsiFrameTest, BufferIsSizedByViewportAndGrowsOnResize) {
+  Board board(1024, 1024);
+  AnsiFrame frame;
+  ASSERT_TRUE(ansi_frame_init(&frame, 1024, 1024, 80, 24));
+  size_t small = frame.capacity;
+  EXPECT_LT(small, 64u * 1024);
+
+  ASSERT_TRUE(ansi_frame_resize(&frame, 400, 150));
+  EXPECT_EQ(frame.view_w, (400 - 3 - ANSI_FRAME_PANEL_COLS) / 2);
+  EXPECT_EQ(frame.view_h, 148);
+  EXPECT_GT(frame.capacity, small);
+
+  // Окно целиком заполнено: кадр помещается в буфер без обрезки.
+  for (int& cell : board.cells) cell = 1;
+  board.info.score = 123456;
+  std::string full = Compose(frame, board);
+  EXPECT_LT(full.size(), frame.capacity);
+  char last[32];
+  std::snprintf(last, sizeof(last), "\x1b[%d;2H", frame.view_h + 1);
+  EXPECT_NE(full.find(last), std::string::npos);
+  EXPECT_NE(full.find("Score: 123456"), std::string::npos);
+  EXPECT_NE(full.find("View "), std::string::npos);
+
+  // Терминал уменьшился: буфер не сжимается, окно — да.
+  size_t grown = frame.capacity;
+  ASSERT_TRUE(ansi_frame_resize(&frame, 80, 24));
+  EXPECT_EQ(frame.capacity, grown);
+  EXPECT_EQ(frame.view_h, 22);
+  ansi_frame_free(&frame);
+}
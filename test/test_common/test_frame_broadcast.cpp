@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+
+#include "../../include/brickgame/common/frame_broadcast.h"
+#include "../alloc_guard/alloc_guard.h"
+
+class FrameBroadcastTest : public ::testing::Test {
+ protected:
+  static const int kWidth = 10;
+  static const int kHeight = 20;
+
+  void SetUp() override {
+    for (int y = 0; y < kHeight; ++y) {
+      rows_[y] = cells_[y];
+      for (int x = 0; x < kWidth; ++x) {
+        cells_[y][x] = (y >= kHeight / 2) ? (x + y) % 2 : 0;
+      }
+    }
+    for (int y = 0; y < 4; ++y) next_rows_[y] = next_[y];
+    info_ = GameInfo_t{};
+    info_.field = rows_;
+    info_.next = next_rows_;
+    info_.level = 1;
+    info_.speed = 600;
+  }
+
+  void ExpectFrameMatches(const BroadcastFrame& frame) {
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x) {
+        EXPECT_EQ(frame.cells[y * kWidth + x], cells_[y][x]);
+      }
+    }
+    for (int y = 0; y < 4; ++y) {
+      for (int x = 0; x < 4; ++x) {
+        EXPECT_EQ(frame.cells[kWidth * kHeight + y * 4 + x], next_[y][x]);
+      }
+    }
+    EXPECT_EQ(frame.score, info_.score);
+    EXPECT_EQ(frame.level, info_.level);
+    EXPECT_EQ(frame.speed, info_.speed);
+  }
+
+  int cells_[kHeight][kWidth] = {};
+  int next_[4][4] = {};
+  int* rows_[kHeight];
+  int* next_rows_[4];
+  GameInfo_t info_;
+};
+
+TEST_F(FrameBroadcastTest, FirstFrameIsKeyframe) {
+  FrameBroadcaster* b = broadcaster_create(kWidth, kHeight, 8, 16);
+  ASSERT_NE(b, nullptr);
+
+  const BroadcastPacket* packet = broadcaster_publish(b, &info_);
+  ASSERT_NE(packet, nullptr);
+  EXPECT_EQ(packet->type, BROADCAST_KEYFRAME);
+  EXPECT_EQ(packet->seq, 0u);
+  EXPECT_LT(packet->size, sizeof(cells_));
+
+  broadcaster_destroy(b);
+}
+
+TEST_F(FrameBroadcastTest, SmallChangeProducesDelta) {
+  FrameBroadcaster* b = broadcaster_create(kWidth, kHeight, 8, 16);
+  broadcaster_publish(b, &info_);
+
+  cells_[5][5] = 2;
+  const BroadcastPacket* packet = broadcaster_publish(b, &info_);
+  ASSERT_NE(packet, nullptr);
+  EXPECT_EQ(packet->type, BROADCAST_DELTA);
+  EXPECT_EQ(packet->size, (size_t)BROADCAST_HEADER_SIZE + 4 + 3);
+
+  broadcaster_destroy(b);
+}
+
+TEST_F(FrameBroadcastTest, PeriodicKeyframes) {
+  FrameBroadcaster* b = broadcaster_create(kWidth, kHeight, 4, 8);
+  for (int i = 0; i < 9; ++i) {
+    cells_[i % kHeight][i % kWidth] = 2;
+    const BroadcastPacket* packet = broadcaster_publish(b, &info_);
+    ASSERT_NE(packet, nullptr);
+    EXPECT_EQ(packet->type == BROADCAST_KEYFRAME, i % 4 == 0) << i;
+  }
+  broadcaster_destroy(b);
+}
+
+TEST_F(FrameBroadcastTest, LargeChangeProducesKeyframe) {
+  FrameBroadcaster* b = broadcaster_create(kWidth, kHeight, 8, 16);
+  broadcaster_publish(b, &info_);
+
+  // Дельта всех клеток длиннее байта на клетку.
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) cells_[y][x] = 3;
+  }
+  const BroadcastPacket* packet = broadcaster_publish(b, &info_);
+  ASSERT_NE(packet, nullptr);
+  EXPECT_EQ(packet->type, BROADCAST_KEYFRAME);
+
+  BroadcastFrame frame;
+  ASSERT_TRUE(broadcast_frame_init(&frame, kWidth, kHeight));
+  EXPECT_TRUE(broadcast_frame_apply(&frame, packet));
+  ExpectFrameMatches(frame);
+  broadcast_frame_free(&frame);
+  broadcaster_destroy(b);
+}
+
+TEST_F(FrameBroadcastTest, ReleasedPacketsAreReused) {
+  FrameBroadcaster* b = broadcaster_create(kWidth, kHeight, 4, 8);
+  BroadcastCursor cursor = broadcaster_subscribe(b);
+  std::set<const BroadcastPacket*> seen;
+
+  for (int i = 0; i < 100; ++i) {
+    cells_[i % kHeight][i % kWidth] ^= 1;
+    alloc_guard_arm();
+    const BroadcastPacket* packet = broadcaster_publish(b, &info_);
+    std::uint64_t allocations = alloc_guard_disarm();
+    ASSERT_NE(packet, nullptr);
+    // История (8) и запас заполняются за первые кадры.
+    if (i >= 16) {
+      ASSERT_EQ(allocations, 0u) << "frame " << i;
+    }
+    seen.insert(packet);
+
+    const BroadcastPacket* polled = broadcaster_poll(b, &cursor);
+    EXPECT_EQ(polled, packet);
+    broadcast_packet_release(polled);
+  }
+  EXPECT_LE(seen.size(), 9u);
+  broadcaster_destroy(b);
+}
+
+TEST_F(FrameBroadcastTest, HeldPacketIsNotReused) {
+  FrameBroadcaster* b = broadcaster_create(kWidth, kHeight, 4, 4);
+  BroadcastCursor cursor = broadcaster_subscribe(b);
+  broadcaster_publish(b, &info_);
+  const BroadcastPacket* held = broadcaster_poll(b, &cursor);
+  ASSERT_NE(held, nullptr);
+  const size_t size = held->size;
+
+  for (int i = 0; i < 40; ++i) {
+    cells_[i % kHeight][0] ^= 1;
+    EXPECT_NE(broadcaster_publish(b, &info_), held) << "frame " << i;
+  }
+  EXPECT_EQ(held->seq, 0u);
+  EXPECT_EQ(held->type, BROADCAST_KEYFRAME);
+  EXPECT_EQ(held->size, size);
+
+  broadcast_packet_release(held);
+  broadcaster_destroy(b);
+}
+
+TEST_F(FrameBroadcastTest, SubscribersShareSamePacket) {
+  FrameBroadcaster* b = broadcaster_create(kWidth, kHeight, 8, 16);
+  BroadcastCursor first = broadcaster_subscribe(b);
+  BroadcastCursor second = broadcaster_subscribe(b);
+
+  broadcaster_publish(b, &info_);
+
+  const BroadcastPacket* p1 = broadcaster_poll(b, &first);
+  const BroadcastPacket* p2 = broadcaster_poll(b, &second);
+  EXPECT_EQ(p1, p2);
+  EXPECT_EQ(broadcaster_poll(b, &first), nullptr);
+
+  broadcast_packet_release(p1);
+  broadcast_packet_release(p2);
+  broadcaster_destroy(b);
+}
+
+TEST_F(FrameBroadcastTest, ViewerReconstructsFrames) {
+  FrameBroadcaster* b = broadcaster_create(kWidth, kHeight, 5, 10);
+  BroadcastCursor cursor = broadcaster_subscribe(b);
+  BroadcastFrame frame;
+  ASSERT_TRUE(broadcast_frame_init(&frame, kWidth, kHeight));
+
+  for (int i = 0; i < 30; ++i) {
+    cells_[(i * 7) % kHeight][(i * 3) % kWidth] ^= 1;
+    next_[i % 4][(i + 1) % 4] = i % 2;
+    info_.score = i * 10;
+    broadcaster_publish(b, &info_);
+
+    const BroadcastPacket* packet = broadcaster_poll(b, &cursor);
+    ASSERT_NE(packet, nullptr);
+    EXPECT_TRUE(broadcast_frame_apply(&frame, packet));
+    broadcast_packet_release(packet);
+    ExpectFrameMatches(frame);
+  }
+
+  broadcast_frame_free(&frame);
+  broadcaster_destroy(b);
+}
+
+TEST_F(FrameBroadcastTest, LateJoinerStartsFromKeyframe) {
+  FrameBroadcaster* b = broadcaster_create(kWidth, kHeight, 4, 8);
+  for (int i = 0; i < 6; ++i) {
+    cells_[i][i] = 1;
+    broadcaster_publish(b, &info_);
+  }
+
+  BroadcastCursor cursor = broadcaster_subscribe(b);
+  EXPECT_EQ(cursor.next_seq, 4u);
+
+  BroadcastFrame frame;
+  ASSERT_TRUE(broadcast_frame_init(&frame, kWidth, kHeight));
+  const BroadcastPacket* packet = nullptr;
+  while ((packet = broadcaster_poll(b, &cursor)) != nullptr) {
+    EXPECT_TRUE(broadcast_frame_apply(&frame, packet));
+    broadcast_packet_release(packet);
+  }
+  ExpectFrameMatches(frame);
+
+  broadcast_frame_free(&frame);
+  broadcaster_destroy(b);
+}
+
+TEST_F(FrameBroadcastTest, LaggingViewerResyncs) {
+  FrameBroadcaster* b = broadcaster_create(kWidth, kHeight, 4, 4);
+  BroadcastCursor cursor = broadcaster_subscribe(b);
+
+  for (int i = 0; i < 20; ++i) {
+    cells_[i % kHeight][0] = 1;
+    broadcaster_publish(b, &info_);
+  }
+
+  const BroadcastPacket* packet = broadcaster_poll(b, &cursor);
+  ASSERT_NE(packet, nullptr);
+  EXPECT_EQ(packet->type, BROADCAST_KEYFRAME);
+  EXPECT_EQ(packet->seq, 16u);
+  broadcast_packet_release(packet);
+
+  broadcaster_destroy(b);
+}
+
+TEST_F(FrameBroadcastTest, PacketOutlivesBroadcaster) {
+  FrameBroadcaster* b = broadcaster_create(kWidth, kHeight, 4, 4);
+  BroadcastCursor cursor = broadcaster_subscribe(b);
+  broadcaster_publish(b, &info_);
+  const BroadcastPacket* packet = broadcaster_poll(b, &cursor);
+  broadcaster_destroy(b);
+
+  BroadcastFrame frame;
+  ASSERT_TRUE(broadcast_frame_init(&frame, kWidth, kHeight));
+  EXPECT_TRUE(broadcast_frame_apply(&frame, packet));
+  broadcast_packet_release(packet);
+  broadcast_frame_free(&frame);
+}
+
+TEST_F(FrameBroadcastTest, DeltaRequiresPreviousFrame) {
+  FrameBroadcaster* b = broadcaster_create(kWidth, kHeight, 8, 8);
+  broadcaster_publish(b, &info_);
+  cells_[0][0] = 2;
+  const BroadcastPacket* delta = broadcaster_publish(b, &info_);
+  ASSERT_EQ(delta->type, BROADCAST_DELTA);
+
+  BroadcastFrame frame;
+  ASSERT_TRUE(broadcast_frame_init(&frame, kWidth, kHeight));
+  EXPECT_FALSE(broadcast_frame_apply(&frame, delta));
+
+  broadcast_frame_free(&frame);
+  broadcaster_destroy(b);
+}
+
+TEST_F(FrameBroadcastTest, InvalidParameters) {
+  EXPECT_EQ(broadcaster_create(0, 20, 4, 4), nullptr);
+  EXPECT_EQ(broadcaster_create(10, 20, 0, 4), nullptr);
+  EXPECT_EQ(broadcaster_create(10, 20, 8, 4), nullptr);
+}
@@ -0,0 +1,211 @@
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdint>
+
+#include <string>
+
+#include "../../include/brickgame/common/frame_ring.h"
+
+class FrameRingTest : public ::testing::Test {
+ protected:
+  static const int kWidth = 10;
+  static const int kHeight = 20;
+
+  void SetUp() override {
+    for (int y = 0; y < kHeight; ++y) rows_[y] = cells_[y];
+    for (int y = 0; y < 4; ++y) next_rows_[y] = next_[y];
+    info_ = GameInfo_t{};
+    info_.field = rows_;
+    info_.next = next_rows_;
+  }
+
+  int cells_[kHeight][kWidth] = {};
+  int next_[4][4] = {};
+  int* rows_[kHeight];
+  int* next_rows_[4];
+  GameInfo_t info_;
+};
+
+TEST_F(FrameRingTest, EmptyRingHasNoFrames) {
+  FrameRing* ring = frame_ring_create(nullptr, kWidth, kHeight, 4);
+  ASSERT_NE(ring, nullptr);
+
+  FrameRingView view;
+  EXPECT_FALSE(frame_ring_read_latest(ring, &view));
+  EXPECT_EQ(frame_ring_frames(ring), 0u);
+
+  frame_ring_close(ring, false);
+}
+
+TEST_F(FrameRingTest, ReadsLatestFrameInPlace) {
+  FrameRing* ring = frame_ring_create(nullptr, kWidth, kHeight, 4);
+  ASSERT_NE(ring, nullptr);
+
+  for (int i = 0; i < 6; ++i) {
+    cells_[i][i] = 1;
+    next_[1][i % 4] = 1;
+    info_.score = i;
+    frame_ring_publish(ring, &info_, i == 5);
+  }
+
+  FrameRingView view;
+  ASSERT_TRUE(frame_ring_read_latest(ring, &view));
+  EXPECT_EQ(view.seq, 5u);
+  EXPECT_EQ(view.info.score, 5);
+  EXPECT_TRUE(view.game_over);
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      EXPECT_EQ(view.info.field[y][x], cells_[y][x]);
+    }
+  }
+  EXPECT_EQ(view.info.next[1][0], 1);
+  EXPECT_TRUE(frame_ring_view_valid(&view));
+
+  frame_ring_close(ring, false);
+}
+
+TEST_F(FrameRingTest, OverwrittenSlotIsDetected) {
+  FrameRing* ring = frame_ring_create(nullptr, kWidth, kHeight, 2);
+  frame_ring_publish(ring, &info_, false);
+
+  FrameRingView view;
+  ASSERT_TRUE(frame_ring_read_latest(ring, &view));
+
+  frame_ring_publish(ring, &info_, false);
+  EXPECT_TRUE(frame_ring_view_valid(&view));
+  frame_ring_publish(ring, &info_, false);
+  EXPECT_FALSE(frame_ring_view_valid(&view));
+
+  frame_ring_close(ring, false);
+}
+
+TEST_F(FrameRingTest, InputQueueIsFifo) {
+  FrameRing* ring = frame_ring_create(nullptr, kWidth, kHeight, 2);
+
+  EXPECT_TRUE(frame_ring_push_input(ring, Left, false));
+  EXPECT_TRUE(frame_ring_push_input(ring, Down, true));
+
+  UserAction_t action;
+  bool hold;
+  ASSERT_TRUE(frame_ring_pop_input(ring, &action, &hold));
+  EXPECT_EQ(action, Left);
+  EXPECT_FALSE(hold);
+  ASSERT_TRUE(frame_ring_pop_input(ring, &action, &hold));
+  EXPECT_EQ(action, Down);
+  EXPECT_TRUE(hold);
+  EXPECT_FALSE(frame_ring_pop_input(ring, &action, &hold));
+
+  frame_ring_close(ring, false);
+}
+
+TEST_F(FrameRingTest, InputQueueRejectsWhenFull) {
+  FrameRing* ring = frame_ring_create(nullptr, kWidth, kHeight, 2);
+
+  for (int i = 0; i < FRAME_RING_INPUT_CAPACITY; ++i) {
+    EXPECT_TRUE(frame_ring_push_input(ring, Right, false));
+  }
+  EXPECT_FALSE(frame_ring_push_input(ring, Right, false));
+
+  UserAction_t action;
+  bool hold;
+  EXPECT_TRUE(frame_ring_pop_input(ring, &action, &hold));
+  EXPECT_TRUE(frame_ring_push_input(ring, Left, false));
+
+  frame_ring_close(ring, false);
+}
+
+TEST_F(FrameRingTest, NamedRingCanBeOpenedByViewer) {
+  std::string name = "/brickgame_test_" + std::to_string(getpid());
+  FrameRing* engine = frame_ring_create(name.c_str(), kWidth, kHeight, 4);
+  ASSERT_NE(engine, nullptr);
+
+  FrameRing* viewer = frame_ring_open(name.c_str());
+  ASSERT_NE(viewer, nullptr);
+
+  info_.level = 7;
+  frame_ring_publish(engine, &info_, false);
+
+  FrameRingView view;
+  ASSERT_TRUE(frame_ring_read_latest(viewer, &view));
+  EXPECT_EQ(view.info.level, 7);
+
+  frame_ring_close(viewer, false);
+  frame_ring_close(engine, true);
+  EXPECT_EQ(frame_ring_open(name.c_str()), nullptr);
+}
+
+TEST_F(FrameRingTest, CreateDoesNotTruncateExistingSegment) {
+  std::string name = "/brickgame_test_excl_" + std::to_string(getpid());
+  FrameRing* engine = frame_ring_create(name.c_str(), kWidth, kHeight, 4);
+  ASSERT_NE(engine, nullptr);
+  info_.level = 3;
+  frame_ring_publish(engine, &info_, false);
+
+  EXPECT_EQ(frame_ring_create(name.c_str(), kWidth, kHeight, 4), nullptr);
+
+  FrameRing* viewer = frame_ring_open(name.c_str());
+  ASSERT_NE(viewer, nullptr);
+  FrameRingView view;
+  ASSERT_TRUE(frame_ring_read_latest(viewer, &view));
+  EXPECT_EQ(view.info.level, 3);
+
+  frame_ring_close(viewer, false);
+  frame_ring_close(engine, true);
+}
+
+TEST_F(FrameRingTest, OpenRejectsShortSlots) {
+  std::string name = "/brickgame_test_slot_" + std::to_string(getpid());
+  FrameRing* engine = frame_ring_create(name.c_str(), kWidth, kHeight, 4);
+  ASSERT_NE(engine, nullptr);
+
+  // slot_size — шестое 32-битное поле заголовка.
+  int fd = shm_open(name.c_str(), O_RDWR, 0600);
+  ASSERT_GE(fd, 0);
+  void* mem = mmap(nullptr, 64, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  ASSERT_NE(mem, MAP_FAILED);
+  static_cast<std::uint32_t*>(mem)[5] = 64;
+  munmap(mem, 64);
+
+  EXPECT_EQ(frame_ring_open(name.c_str()), nullptr);
+  frame_ring_close(engine, true);
+}
+
+TEST_F(FrameRingTest, EngineInChildProcess) {
+  FrameRing* ring = frame_ring_create(nullptr, kWidth, kHeight, 4);
+  ASSERT_NE(ring, nullptr);
+
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    UserAction_t action;
+    bool hold;
+    while (!frame_ring_pop_input(ring, &action, &hold)) usleep(100);
+    info_.score = static_cast<int>(action);
+    frame_ring_publish(ring, &info_, true);
+    _exit(0);
+  }
+
+  frame_ring_push_input(ring, Pause, false);
+  int status = 0;
+  waitpid(pid, &status, 0);
+
+  FrameRingView view;
+  ASSERT_TRUE(frame_ring_read_latest(ring, &view));
+  EXPECT_EQ(view.info.score, static_cast<int>(Pause));
+  EXPECT_TRUE(view.game_over);
+
+  frame_ring_close(ring, false);
+}
+
+TEST_F(FrameRingTest, ShutdownFlag) {
+  FrameRing* ring = frame_ring_create(nullptr, kWidth, kHeight, 2);
+  EXPECT_FALSE(frame_ring_shutdown_requested(ring));
+  frame_ring_request_shutdown(ring);
+  EXPECT_TRUE(frame_ring_shutdown_requested(ring));
+  frame_ring_close(ring, false);
+}
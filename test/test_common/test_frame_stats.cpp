@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../../include/brickgame/common/frame_stats.h"
+
+TEST(FrameHistogramTest, CountsValuesIntoBucketsAndOverflow) {
+  FrameHistogram histogram;
+  frame_histogram_init(&histogram, 100);
+
+  frame_histogram_add(&histogram, 0);
+  frame_histogram_add(&histogram, 99);
+  frame_histogram_add(&histogram, 150);
+  frame_histogram_add(&histogram, 100 * FRAME_HISTOGRAM_BUCKETS + 5);
+
+  EXPECT_EQ(histogram.buckets[0], 2u);
+  EXPECT_EQ(histogram.buckets[1], 1u);
+  EXPECT_EQ(histogram.overflow, 1u);
+  EXPECT_EQ(histogram.count, 4u);
+  EXPECT_EQ(histogram.max_us, 100u * FRAME_HISTOGRAM_BUCKETS + 5);
+  EXPECT_EQ(frame_histogram_peak(&histogram), 2u);
+}
+
+TEST(FrameHistogramTest, PercentileUsesBucketUpperBound) {
+  FrameHistogram histogram;
+  frame_histogram_init(&histogram, 100);
+  EXPECT_EQ(frame_histogram_percentile(&histogram, 0.5), 0u);
+
+  for (int i = 0; i < 90; ++i) frame_histogram_add(&histogram, 50);
+  for (int i = 0; i < 10; ++i) frame_histogram_add(&histogram, 730);
+
+  EXPECT_EQ(frame_histogram_percentile(&histogram, 0.5), 100u);
+  EXPECT_EQ(frame_histogram_percentile(&histogram, 0.99), 730u);
+  EXPECT_EQ(frame_histogram_percentile(&histogram, 1.0), 730u);
+}
+
+TEST(FrameStatsTest, MeasuresJitterAndLateTicks) {
+  FrameStats stats;
+  frame_stats_init(&stats, 16000);
+
+  frame_stats_tick(&stats, 1000000, 200);
+  frame_stats_tick(&stats, 1016300, 200);
+  frame_stats_tick(&stats, 1031600, 200);
+
+  EXPECT_EQ(stats.step.count, 3u);
+  EXPECT_EQ(stats.ticks, 2u);
+  EXPECT_EQ(stats.jitter.buckets[0], 1u);  // 300 мкс
+  EXPECT_EQ(stats.jitter.buckets[1], 1u);  // 700 мкс
+  EXPECT_EQ(stats.late_ticks, 0u);
+  EXPECT_EQ(stats.dropped_frames, 0u);
+
+  // Тик через ~4 интервала: три кадра потеряны.
+  frame_stats_tick(&stats, 1031600 + 4 * 16000 + 300, 200);
+  EXPECT_EQ(stats.late_ticks, 1u);
+  EXPECT_EQ(stats.dropped_frames, 3u);
+}
+
+TEST(FrameStatsTest, ResumeDoesNotCountPauseAsDroppedFrames) {
+  FrameStats stats;
+  frame_stats_init(&stats, 16000);
+
+  frame_stats_tick(&stats, 0, 100);
+  frame_stats_resume(&stats);
+  frame_stats_tick(&stats, 5000000, 100);
+  frame_stats_tick(&stats, 5016000, 100);
+
+  EXPECT_EQ(stats.ticks, 1u);
+  EXPECT_EQ(stats.late_ticks, 0u);
+  EXPECT_EQ(stats.dropped_frames, 0u);
+}
+
+TEST(FrameStatsTest, DumpWritesSummaryAndBuckets) {
+  FrameStats stats;
+  frame_stats_init(&stats, 16000);
+  frame_stats_paint(&stats, 1200);
+  frame_stats_tick(&stats, 0, 300);
+  frame_stats_tick(&stats, 16000, 300);
+
+  std::string path =
+      "/tmp/brickgame_frame_stats_" + std::to_string(getpid()) + ".csv";
+  ASSERT_TRUE(frame_stats_dump(&stats, path.c_str()));
+
+  std::ifstream file(path);
+  std::stringstream content;
+  content << file.rdbuf();
+  std::string text = content.str();
+  std::remove(path.c_str());
+
+  EXPECT_NE(text.find("# target_us=16000 ticks=1 late=0 dropped=0"),
+            std::string::npos);
+  EXPECT_NE(text.find("metric,bucket_start_us,bucket_end_us,count"),
+            std::string::npos);
+  EXPECT_NE(text.find("paint,1000,1250,1\n"), std::string::npos);
+  EXPECT_NE(text.find("step,300,400,2\n"), std::string::npos);
+  EXPECT_NE(text.find("jitter,0,500,1\n"), std::string::npos);
+  EXPECT_FALSE(frame_stats_dump(&stats, ""));
+}
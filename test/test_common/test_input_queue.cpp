@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include "../../include/brickgame/common/input_queue.h"
+#include "../../include/brickgame/common/types.h"
+
+TEST(InputQueueTest, KeepsOrderAndArrivalTime) {
+  InputQueue queue;
+  input_queue_init(&queue, 1);
+
+  EXPECT_EQ(input_queue_back(&queue), nullptr);
+  EXPECT_TRUE(input_queue_push(&queue, Down, false, 10));
+  EXPECT_TRUE(input_queue_push(&queue, Left, true, 25));
+  ASSERT_NE(input_queue_back(&queue), nullptr);
+  EXPECT_EQ(input_queue_back(&queue)->action, Left);
+
+  QueuedInput input;
+  ASSERT_TRUE(input_queue_pop(&queue, &input));
+  EXPECT_EQ(input.action, Down);
+  EXPECT_EQ(input.hold, 0);
+  EXPECT_EQ(input.time_ms, 10u);
+  ASSERT_TRUE(input_queue_pop(&queue, &input));
+  EXPECT_EQ(input.action, Left);
+  EXPECT_EQ(input.hold, 1);
+  EXPECT_EQ(input.time_ms, 25u);
+  EXPECT_FALSE(input_queue_pop(&queue, &input));
+}
+
+TEST(InputQueueTest, DropsNewInputWhenFull) {
+  InputQueue queue;
+  input_queue_init(&queue, 2);
+
+  for (int i = 0; i < INPUT_QUEUE_CAPACITY; ++i) {
+    EXPECT_TRUE(input_queue_push(&queue, i, false, i));
+  }
+  EXPECT_FALSE(input_queue_push(&queue, 99, false, 99));
+  EXPECT_EQ(queue.dropped, 1u);
+
+  // Кольцо продолжает работать после оборота head.
+  QueuedInput input;
+  ASSERT_TRUE(input_queue_pop(&queue, &input));
+  EXPECT_TRUE(input_queue_push(&queue, 42, false, 42));
+  EXPECT_EQ(input_queue_back(&queue)->action, 42);
+  ASSERT_TRUE(input_queue_pop(&queue, &input));
+  EXPECT_EQ(input.action, 1);
+
+  input_queue_clear(&queue);
+  EXPECT_EQ(queue.count, 0u);
+  EXPECT_EQ(queue.per_tick, 2u);
+}
+
+TEST(InputQueueTest, ReadsPerTickFromEnvironment) {
+  unsetenv(INPUT_QUEUE_ENV);
+  EXPECT_EQ(input_queue_per_tick_from_env(1), 1u);
+  setenv(INPUT_QUEUE_ENV, "3", 1);
+  EXPECT_EQ(input_queue_per_tick_from_env(1), 3u);
+  setenv(INPUT_QUEUE_ENV, "1000", 1);
+  EXPECT_EQ(input_queue_per_tick_from_env(1), 16u);
+  setenv(INPUT_QUEUE_ENV, "-2", 1);
+  EXPECT_EQ(input_queue_per_tick_from_env(1), 1u);
+  unsetenv(INPUT_QUEUE_ENV);
+}
@@ -0,0 +1,273 @@
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../include/brickgame/common/leaderboard.h"
+
+class LeaderboardTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = "leaderboard_test_" + std::to_string(getpid()) + ".dat";
+    unlink(path_.c_str());
+  }
+
+  void TearDown() override { unlink(path_.c_str()); }
+
+  static LeaderboardRecord Make(const char* player, int score) {
+    LeaderboardRecord record;
+    leaderboard_record_init(&record, player, score, 1, 1000, 0);
+    return record;
+  }
+
+  std::string path_;
+};
+
+TEST_F(LeaderboardTest, KeepsRecordsSortedByScore) {
+  Leaderboard* board = leaderboard_open(path_.c_str(), 16);
+  ASSERT_NE(board, nullptr);
+
+  LeaderboardRecord a = Make("a", 100);
+  LeaderboardRecord b = Make("b", 300);
+  LeaderboardRecord c = Make("c", 200);
+  EXPECT_EQ(leaderboard_submit(board, &a), 0);
+  EXPECT_EQ(leaderboard_submit(board, &b), 0);
+  EXPECT_EQ(leaderboard_submit(board, &c), 1);
+
+  LeaderboardRecord top[3];
+  ASSERT_EQ(leaderboard_top(board, top, 3), 3u);
+  EXPECT_STREQ(top[0].player, "b");
+  EXPECT_STREQ(top[1].player, "c");
+  EXPECT_STREQ(top[2].player, "a");
+
+  leaderboard_close(board);
+}
+
+TEST_F(LeaderboardTest, EqualScoresKeepSubmissionOrder) {
+  Leaderboard* board = leaderboard_open(path_.c_str(), 16);
+  LeaderboardRecord first = Make("first", 50);
+  LeaderboardRecord second = Make("second", 50);
+  leaderboard_submit(board, &first);
+  EXPECT_EQ(leaderboard_submit(board, &second), 1);
+
+  LeaderboardRecord record;
+  ASSERT_TRUE(leaderboard_get(board, 0, &record));
+  EXPECT_STREQ(record.player, "first");
+  EXPECT_FALSE(leaderboard_get(board, 2, &record));
+
+  leaderboard_close(board);
+}
+
+TEST_F(LeaderboardTest, FullBoardEvictsLowestScore) {
+  Leaderboard* board = leaderboard_open(path_.c_str(), 3);
+  for (int score : {10, 20, 30}) {
+    LeaderboardRecord record = Make("p", score);
+    leaderboard_submit(board, &record);
+  }
+
+  LeaderboardRecord low = Make("low", 5);
+  EXPECT_EQ(leaderboard_submit(board, &low), -1);
+
+  LeaderboardRecord mid = Make("mid", 25);
+  EXPECT_EQ(leaderboard_submit(board, &mid), 1);
+  EXPECT_EQ(leaderboard_count(board), 3u);
+
+  LeaderboardRecord last;
+  ASSERT_TRUE(leaderboard_get(board, 2, &last));
+  EXPECT_EQ(last.score, 20);
+
+  leaderboard_close(board);
+}
+
+TEST_F(LeaderboardTest, RankOfScore) {
+  Leaderboard* board = leaderboard_open(path_.c_str(), 16);
+  for (int score : {100, 80, 80, 40}) {
+    LeaderboardRecord record = Make("p", score);
+    leaderboard_submit(board, &record);
+  }
+
+  EXPECT_EQ(leaderboard_rank_of(board, 1000), 0u);
+  EXPECT_EQ(leaderboard_rank_of(board, 80), 3u);
+  EXPECT_EQ(leaderboard_rank_of(board, 50), 3u);
+  EXPECT_EQ(leaderboard_rank_of(board, 0), 4u);
+
+  leaderboard_close(board);
+}
+
+TEST_F(LeaderboardTest, PersistsAcrossReopen) {
+  Leaderboard* board = leaderboard_open(path_.c_str(), 8);
+  LeaderboardRecord record = Make("keeper", 77);
+  record.replay_id = 42;
+  leaderboard_submit(board, &record);
+  leaderboard_close(board);
+
+  board = leaderboard_open(path_.c_str(), 1000);
+  ASSERT_NE(board, nullptr);
+  EXPECT_EQ(leaderboard_capacity(board), 8u);
+  ASSERT_EQ(leaderboard_count(board), 1u);
+
+  LeaderboardRecord loaded;
+  ASSERT_TRUE(leaderboard_get(board, 0, &loaded));
+  EXPECT_STREQ(loaded.player, "keeper");
+  EXPECT_EQ(loaded.score, 77);
+  EXPECT_EQ(loaded.replay_id, 42u);
+
+  leaderboard_close(board);
+}
+
+TEST_F(LeaderboardTest, RejectsForeignFile) {
+  FILE* file = fopen(path_.c_str(), "w");
+  ASSERT_NE(file, nullptr);
+  fputs("12345\n", file);
+  fclose(file);
+
+  EXPECT_EQ(leaderboard_open(path_.c_str(), 8), nullptr);
+}
+
+TEST_F(LeaderboardTest, RejectsZeroCapacity) {
+  EXPECT_EQ(leaderboard_open(path_.c_str(), 0), nullptr);
+  // Файл не выделяется на всю ёмкость, поэтому она не ограничена.
+  Leaderboard* board = leaderboard_open(path_.c_str(), UINT32_MAX);
+  ASSERT_NE(board, nullptr);
+  EXPECT_EQ(leaderboard_capacity(board), UINT32_MAX);
+  leaderboard_close(board);
+}
+
+TEST_F(LeaderboardTest, HoldsFarMoreThanSixteenThousandRecords) {
+  const int kRecords = 200000;
+  Leaderboard* board = leaderboard_open(path_.c_str(), 1u << 20);
+  ASSERT_NE(board, nullptr);
+
+  // Эталон: (счёт, порядковый номер), порядок — по убыванию счёта, при
+  // равном счёте — по порядку вставки.
+  std::vector<std::pair<int, int>> expected;
+  uint32_t seed = 1;
+  for (int i = 0; i < kRecords; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    int score = static_cast<int>((seed >> 8) % 50000);
+    LeaderboardRecord record = Make("p", score);
+    record.replay_id = static_cast<uint64_t>(i);
+    int64_t rank = leaderboard_submit(board, &record);
+    ASSERT_GE(rank, 0);
+    if (i % 997 == 0) {
+      int64_t above = std::count_if(
+          expected.begin(), expected.end(),
+          [score](const std::pair<int, int>& e) { return e.first >= score; });
+      EXPECT_EQ(rank, above);
+    }
+    expected.emplace_back(score, i);
+  }
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const std::pair<int, int>& a,
+                      const std::pair<int, int>& b) {
+                     return a.first > b.first;
+                   });
+  leaderboard_close(board);
+
+  board = leaderboard_open(path_.c_str(), 1);
+  ASSERT_NE(board, nullptr);
+  ASSERT_EQ(leaderboard_count(board), uint32_t(kRecords));
+
+  std::vector<LeaderboardRecord> all(kRecords);
+  ASSERT_EQ(leaderboard_top(board, all.data(), kRecords), uint32_t(kRecords));
+  for (int i = 0; i < kRecords; ++i) {
+    ASSERT_EQ(all[i].score, expected[i].first) << i;
+    ASSERT_EQ(all[i].replay_id, uint64_t(expected[i].second)) << i;
+  }
+
+  for (int rank : {0, 62, 63, 16384, 123457, kRecords - 1}) {
+    LeaderboardRecord record;
+    ASSERT_TRUE(leaderboard_get(board, rank, &record));
+    EXPECT_EQ(record.replay_id, uint64_t(expected[rank].second));
+  }
+  for (int score : {-1, 0, 1, 24999, 49999, 50000}) {
+    auto above = std::count_if(
+        expected.begin(), expected.end(),
+        [score](const std::pair<int, int>& e) { return e.first >= score; });
+    EXPECT_EQ(leaderboard_rank_of(board, score), uint32_t(above));
+  }
+  leaderboard_close(board);
+}
+
+TEST_F(LeaderboardTest, LargeFullBoardKeepsBestRecords) {
+  const uint32_t kCapacity = 5000;
+  Leaderboard* board = leaderboard_open(path_.c_str(), kCapacity);
+  ASSERT_NE(board, nullptr);
+
+  std::vector<std::pair<int, int>> submitted;
+  uint32_t seed = 7;
+  for (int i = 0; i < 30000; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    int score = static_cast<int>((seed >> 8) % 20000);
+    // Последние записи лучше всех прежних: вытеснение опустошает и
+    // освобождает листья на правом краю.
+    if (i >= 25000) score = 20000 + i;
+    LeaderboardRecord record = Make("p", score);
+    record.replay_id = static_cast<uint64_t>(i);
+    leaderboard_submit(board, &record);
+    submitted.emplace_back(score, i);
+  }
+  std::stable_sort(submitted.begin(), submitted.end(),
+                   [](const std::pair<int, int>& a,
+                      const std::pair<int, int>& b) {
+                     return a.first > b.first;
+                   });
+
+  ASSERT_EQ(leaderboard_count(board), kCapacity);
+  std::vector<LeaderboardRecord> all(kCapacity + 1);
+  ASSERT_EQ(leaderboard_top(board, all.data(), kCapacity + 1), kCapacity);
+  for (uint32_t i = 0; i < kCapacity; ++i) {
+    ASSERT_EQ(all[i].replay_id, uint64_t(submitted[i].second)) << i;
+  }
+  LeaderboardRecord last;
+  ASSERT_TRUE(leaderboard_get(board, kCapacity - 1, &last));
+  EXPECT_EQ(last.replay_id, uint64_t(submitted[kCapacity - 1].second));
+
+  LeaderboardRecord low = Make("low", submitted[kCapacity - 1].first);
+  EXPECT_EQ(leaderboard_submit(board, &low), -1);
+  leaderboard_close(board);
+}
+
+TEST_F(LeaderboardTest, ConcurrentWritersLoseNothing) {
+  const int kWriters = 4;
+  const int kPerWriter = 200;
+
+  std::vector<pid_t> children;
+  for (int w = 0; w < kWriters; ++w) {
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      Leaderboard* board = leaderboard_open(path_.c_str(), 1024);
+      if (!board) _exit(1);
+      for (int i = 0; i < kPerWriter; ++i) {
+        LeaderboardRecord record = Make("w", (i * 7919 + w) % 1000);
+        leaderboard_submit(board, &record);
+      }
+      leaderboard_close(board);
+      _exit(0);
+    }
+    children.push_back(pid);
+  }
+  for (pid_t pid : children) {
+    int status = 0;
+    waitpid(pid, &status, 0);
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+  }
+
+  Leaderboard* board = leaderboard_open(path_.c_str(), 1024);
+  ASSERT_NE(board, nullptr);
+  ASSERT_EQ(leaderboard_count(board), uint32_t(kWriters * kPerWriter));
+
+  std::vector<LeaderboardRecord> all(kWriters * kPerWriter);
+  leaderboard_top(board, all.data(), all.size());
+  for (size_t i = 1; i < all.size(); ++i) {
+    EXPECT_GE(all[i - 1].score, all[i].score);
+  }
+
+  leaderboard_close(board);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "../../include/brickgame/common/packed_grid.h"
+
+namespace {
+
+/// Поле width x height со значениями (x * 7 + y * 3) % 4.
+struct Rows {
+  Rows(int width, int height)
+      : cells(static_cast<size_t>(width) * height), rows(height) {
+    for (int y = 0; y < height; ++y) {
+      rows[y] = cells.data() + y * width;
+      for (int x = 0; x < width; ++x) rows[y][x] = (x * 7 + y * 3) % 4;
+    }
+  }
+  std::vector<int> cells;
+  std::vector<int*> rows;
+};
+
+}  // namespace
+
+TEST(PackedGridTest, ClassicBoardTakesFiftyBytes) {
+  EXPECT_EQ(PACKED_GRID_BYTES(10, 20), 50u);
+  EXPECT_EQ(PACKED_GRID_BYTES(3, 3), 3u);
+}
+
+TEST(PackedGridTest, SetAndGetKeepNeighbours) {
+  uint8_t grid[PACKED_GRID_BYTES(10, 20)] = {};
+  packed_grid_set(grid, 5, 2);
+  packed_grid_set(grid, 6, 3);
+  packed_grid_set(grid, 7, 1);
+  packed_grid_set(grid, 6, 0);
+  EXPECT_EQ(packed_grid_get(grid, 4), 0u);
+  EXPECT_EQ(packed_grid_get(grid, 5), 2u);
+  EXPECT_EQ(packed_grid_get(grid, 6), 0u);
+  EXPECT_EQ(packed_grid_get(grid, 7), 1u);
+  EXPECT_EQ(grid[1], 0x48);
+}
+
+TEST(PackedGridTest, FillSetsEveryCell) {
+  uint8_t grid[PACKED_GRID_BYTES(10, 20)];
+  packed_grid_fill(grid, 200, 2);
+  for (size_t i = 0; i < 200; ++i) EXPECT_EQ(packed_grid_get(grid, i), 2u);
+}
+
+TEST(PackedGridTest, PackUnpackRoundTrip) {
+  // Ширины, при которых строки начинаются с разных клеток байта.
+  for (int width : {1, 3, 4, 7, 10, 33}) {
+    const int height = 9;
+    Rows source(width, height);
+    std::vector<uint8_t> grid(PACKED_GRID_BYTES(width, height));
+    packed_grid_pack(grid.data(), width, height, source.rows.data());
+
+    Rows unpacked(width, height);
+    for (int& cell : unpacked.cells) cell = -1;
+    packed_grid_unpack(grid.data(), width, height, unpacked.rows.data());
+    EXPECT_EQ(unpacked.cells, source.cells) << "width " << width;
+  }
+}
+
+TEST(PackedGridTest, PackMasksValues) {
+  int row[4] = {4, 5, 6, 7};
+  const int* rows[] = {row};
+  uint8_t grid[1];
+  packed_grid_pack(grid, 4, 1, rows);
+  EXPECT_EQ(grid[0], 0xE4);
+}
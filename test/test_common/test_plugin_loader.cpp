@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "../../include/brickgame/common/plugin_loader.h"
+#include "../../include/brickgame/common/state_blob.h"
+
+#ifdef __APPLE__
+#define TEST_PLUGIN_EXT ".dylib"
+#else
+#define TEST_PLUGIN_EXT ".so"
+#endif
+
+TEST(PluginLoaderTest, LoadsTetrisPlugin) {
+  BrickGamePlugin plugin;
+  char error[256] = {0};
+  ASSERT_TRUE(plugin_load("./libtetris" TEST_PLUGIN_EXT, &plugin, error,
+                          sizeof(error)))
+      << error;
+
+  EXPECT_STREQ(plugin.api->id, "tetris");
+  EXPECT_EQ(plugin.api->abi_version, BRICKGAME_ABI_VERSION);
+  EXPECT_EQ(plugin.api->field_width, 10);
+  EXPECT_EQ(plugin.api->field_height, 20);
+  EXPECT_TRUE(plugin.api->capabilities & BRICKGAME_CAP_NEXT_PREVIEW);
+  EXPECT_TRUE(plugin.api->capabilities & BRICKGAME_CAP_SAVE_STATE);
+  ASSERT_TRUE(BRICKGAME_API_HAS(plugin.api, loadState));
+  EXPECT_GT(plugin.api->saveState(nullptr, 0), sizeof(StateBlobHeader));
+  EXPECT_EQ(plugin.api->isVictory, nullptr);
+
+  GameInfo_t info = plugin.api->updateCurrentState();
+  EXPECT_NE(info.field, nullptr);
+  EXPECT_FALSE(plugin.api->isGameOver());
+
+  plugin_unload(&plugin);
+  EXPECT_EQ(plugin.handle, nullptr);
+}
+
+TEST(PluginLoaderTest, LoadsSnakePlugin) {
+  BrickGamePlugin plugin;
+  ASSERT_TRUE(plugin_load("./libsnake" TEST_PLUGIN_EXT, &plugin, nullptr, 0));
+
+  EXPECT_STREQ(plugin.api->id, "snake");
+  EXPECT_TRUE(plugin.api->capabilities & BRICKGAME_CAP_VICTORY);
+  // Кадр Snake лежит в постоянном буфере игры.
+  EXPECT_FALSE(plugin.api->capabilities & BRICKGAME_CAP_CALLER_FREES_INFO);
+  ASSERT_NE(plugin.api->freeGameInfo, nullptr);
+  ASSERT_NE(plugin.api->isVictory, nullptr);
+  ASSERT_TRUE(BRICKGAME_API_HAS(plugin.api, tickAllocStats));
+  ASSERT_NE(plugin.api->setAllocator, nullptr);
+
+  GameInfo_t info = plugin.api->updateCurrentState();
+  EXPECT_NE(info.field, nullptr);
+  plugin.api->freeGameInfo(&info);
+  EXPECT_EQ(info.field, nullptr);
+
+  plugin_unload(&plugin);
+}
+
+TEST(PluginLoaderTest, MissingLibraryReportsError) {
+  BrickGamePlugin plugin;
+  char error[256] = {0};
+  EXPECT_FALSE(plugin_load("./libmissing" TEST_PLUGIN_EXT, &plugin, error,
+                           sizeof(error)));
+  EXPECT_GT(std::strlen(error), 0u);
+}
+
+TEST(PluginLoaderTest, ScanDiscoversGames) {
+  BrickGamePlugin plugins[BRICKGAME_MAX_PLUGINS];
+  int count = plugin_scan(".", plugins, BRICKGAME_MAX_PLUGINS);
+  ASSERT_GE(count, 2);
+
+  int snake = plugin_find(plugins, count, "snake");
+  int tetris = plugin_find(plugins, count, "tetris");
+  EXPECT_GE(snake, 0);
+  EXPECT_GE(tetris, 0);
+  EXPECT_LT(snake, tetris);
+  EXPECT_EQ(plugin_find(plugins, count, "pong"), -1);
+
+  // Сканирование не запускает игры: init() вызывает только plugin_start().
+  for (int i = 0; i < count; ++i) EXPECT_FALSE(plugins[i].started);
+  plugin_start(&plugins[tetris]);
+  EXPECT_TRUE(plugins[tetris].started);
+  plugin_stop(&plugins[tetris]);
+  EXPECT_FALSE(plugins[tetris].started);
+  EXPECT_NE(plugins[tetris].handle, nullptr);
+
+  for (int i = 0; i < count; ++i) plugin_unload(&plugins[i]);
+}
+
+TEST(PluginLoaderTest, ScanAllFallsBackToDirectoryPlugins) {
+  BrickGamePlugin plugins[BRICKGAME_MAX_PLUGINS];
+  // Тесты собираются без BRICKGAME_STATIC_ENGINES: встроенных игр нет.
+  EXPECT_EQ(plugin_scan_builtin(plugins, BRICKGAME_MAX_PLUGINS), 0);
+
+  int count = plugin_scan_all(".", plugins, BRICKGAME_MAX_PLUGINS);
+  ASSERT_GE(count, 2);
+  int tetris = plugin_find(plugins, count, "tetris");
+  ASSERT_GE(tetris, 0);
+  EXPECT_FALSE(plugin_is_builtin(&plugins[tetris]));
+  EXPECT_GE(plugin_find(plugins, count, "snake"), 0);
+
+  for (int i = 0; i < count; ++i) plugin_unload(&plugins[i]);
+}
+
+TEST(PluginLoaderTest, RejectsIncompatibleTable) {
+  BrickGameApi api = {};
+  EXPECT_FALSE(plugin_api_compatible(nullptr));
+  EXPECT_FALSE(plugin_api_compatible(&api));
+
+  BrickGamePlugin plugin;
+  ASSERT_TRUE(plugin_load("./libtetris" TEST_PLUGIN_EXT, &plugin, nullptr, 0));
+  api = *plugin.api;
+  EXPECT_TRUE(plugin_api_compatible(&api));
+  api.abi_version = BRICKGAME_ABI_VERSION + 1;
+  EXPECT_FALSE(plugin_api_compatible(&api));
+  api = *plugin.api;
+  api.struct_size = offsetof(BrickGameApi, isGameOver);
+  EXPECT_FALSE(plugin_api_compatible(&api));
+  plugin_unload(&plugin);
+}
@@ -0,0 +1,22 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "../../include/brickgame/common/splitmix64.h"
+
+TEST(SplitMix64Test, MatchesReferenceSequence) {
+  // Первые значения эталонной реализации для зерна 0.
+  std::uint64_t state = 0;
+  EXPECT_EQ(splitmix64_next(&state), 0xE220A8397B1DCDAFull);
+  EXPECT_EQ(splitmix64_next(&state), 0x6E789E6AA1B965F4ull);
+  EXPECT_EQ(state, 2 * SPLITMIX64_GAMMA);
+}
+
+TEST(SplitMix64Test, CopiedStateRepeatsSequence) {
+  std::uint64_t state = 42;
+  splitmix64_next(&state);
+  std::uint64_t copy = state;
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(splitmix64_next(&copy), splitmix64_next(&state));
+  }
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "../../include/brickgame/common/trace.h"
+#include "../alloc_guard/alloc_guard.h"
+
+class TraceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = "/tmp/brickgame_trace_test_" + std::to_string(getpid()) + ".json";
+  }
+
+  void TearDown() override {
+    trace_stop();
+    std::remove(path_.c_str());
+  }
+
+  std::string ReadTrace() const {
+    std::ifstream file(path_);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+  }
+
+  static int Count(const std::string& text, const std::string& needle) {
+    int count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos;
+         pos = text.find(needle, pos + needle.size())) {
+      ++count;
+    }
+    return count;
+  }
+
+  std::string path_;
+};
+
+TEST_F(TraceTest, DisabledTraceRecordsNothing) {
+  EXPECT_FALSE(trace_enabled());
+  TraceSpan span = trace_begin("tick", "engine");
+  EXPECT_EQ(span.name, nullptr);
+  trace_end(&span);
+  EXPECT_FALSE(trace_stop());
+}
+
+TEST_F(TraceTest, StartRequiresPath) {
+  EXPECT_FALSE(trace_start(nullptr));
+  EXPECT_FALSE(trace_start(""));
+  EXPECT_FALSE(trace_enabled());
+}
+
+TEST_F(TraceTest, WritesCompleteEventsFromSeveralThreads) {
+  ASSERT_TRUE(trace_start(path_.c_str()));
+  trace_set_thread_name("main");
+
+  std::thread worker([] {
+    trace_set_thread_name("worker");
+    for (int i = 0; i < 3; ++i) {
+      TraceScope scope("paint", "render");
+    }
+  });
+  for (int i = 0; i < 5; ++i) {
+    TraceSpan span = trace_begin("tick", "engine");
+    trace_end(&span);
+  }
+  worker.join();
+
+  ASSERT_TRUE(trace_stop());
+  std::string json = ReadTrace();
+  EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+  EXPECT_EQ(Count(json, "\"ph\":\"X\""), 8);
+  EXPECT_EQ(Count(json, "{\"name\":\"tick\",\"cat\":\"engine\""), 5);
+  EXPECT_EQ(Count(json, "{\"name\":\"paint\",\"cat\":\"render\""), 3);
+  EXPECT_NE(json.find("\"args\":{\"name\":\"worker\"}"), std::string::npos);
+  EXPECT_NE(json.find("\"dropped_events\":0"), std::string::npos);
+}
+
+TEST_F(TraceTest, RestartDropsPreviousEvents) {
+  ASSERT_TRUE(trace_start(path_.c_str()));
+  trace_complete("old", "test", 0, 1);
+  ASSERT_TRUE(trace_stop());
+
+  ASSERT_TRUE(trace_start(path_.c_str()));
+  trace_complete("new", "test", 5, 3);
+  ASSERT_TRUE(trace_stop());
+
+  std::string json = ReadTrace();
+  EXPECT_EQ(json.find("\"old\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"new\",\"cat\":\"test\",\"ph\":\"X\","
+                      "\"ts\":5,\"dur\":0"),
+            std::string::npos);
+}
+
+TEST_F(TraceTest, ThreadNameWithoutTraceDoesNotAllocate) {
+  std::uint64_t allocations = 1;
+  std::thread idle([&allocations] {
+    alloc_guard_arm();
+    trace_set_thread_name("idle");
+    allocations = alloc_guard_disarm();
+  });
+  idle.join();
+  EXPECT_EQ(allocations, 0u);
+
+  // Имя, заданное до записи, попадает в трассу с первым событием.
+  std::thread named([this] {
+    trace_set_thread_name("early");
+    ASSERT_TRUE(trace_start(path_.c_str()));
+    trace_complete("tick", "engine", 1, 2);
+  });
+  named.join();
+  ASSERT_TRUE(trace_stop());
+  std::string json = ReadTrace();
+  EXPECT_NE(json.find("\"args\":{\"name\":\"early\"}"), std::string::npos);
+  EXPECT_EQ(json.find("\"idle\""), std::string::npos);
+}
+
+TEST_F(TraceTest, ExitedThreadKeepsEventsUntilExport) {
+  ASSERT_TRUE(trace_start(path_.c_str()));
+  std::thread first([] { trace_complete("first", "test", 1, 2); });
+  first.join();
+  std::thread second([] { trace_complete("second", "test", 3, 4); });
+  second.join();
+
+  ASSERT_TRUE(trace_stop());
+  std::string json = ReadTrace();
+  EXPECT_EQ(Count(json, "{\"name\":\"first\""), 1);
+  EXPECT_EQ(Count(json, "{\"name\":\"second\""), 1);
+}
+
+TEST_F(TraceTest, ExitedThreadBufferIsReusedAfterExport) {
+  ASSERT_TRUE(trace_start(path_.c_str()));
+  std::thread first([] {
+    trace_set_thread_name("first");
+    trace_complete("old", "test", 1, 2);
+  });
+  first.join();
+  ASSERT_TRUE(trace_stop());
+
+  ASSERT_TRUE(trace_start(path_.c_str()));
+  std::uint64_t allocations = 1;
+  std::thread second([&allocations] {
+    alloc_guard_arm();
+    trace_complete("new", "test", 3, 4);
+    allocations = alloc_guard_disarm();
+  });
+  second.join();
+  EXPECT_EQ(allocations, 0u);
+
+  ASSERT_TRUE(trace_stop());
+  std::string json = ReadTrace();
+  EXPECT_EQ(json.find("\"old\""), std::string::npos);
+  EXPECT_EQ(json.find("\"first\""), std::string::npos);
+  EXPECT_EQ(Count(json, "{\"name\":\"new\""), 1);
+}
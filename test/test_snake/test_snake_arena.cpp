@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include "../../include/brickgame/snake/snake_arena.hpp"
+
+using s21::SnakeArena;
+using s21::SnakeDirection;
+
+namespace {
+
+int CountOwned(const SnakeArena& arena, std::uint32_t owner) {
+  int count = 0;
+  for (int y = 0; y < arena.Height(); ++y) {
+    for (int x = 0; x < arena.Width(); ++x) {
+      if (arena.Owner(x, y) == owner) ++count;
+    }
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(SnakeArenaTest, AddSnakeTagsCellsWithOwner) {
+  SnakeArena arena(10, 10, 0, 1);
+  int id = arena.AddSnake({5, 5}, SnakeDirection::Right, 3);
+  ASSERT_EQ(id, 0);
+
+  EXPECT_EQ(arena.Owner(5, 5), 1u);
+  EXPECT_EQ(arena.Owner(4, 5), 1u);
+  EXPECT_EQ(arena.Owner(3, 5), 1u);
+  EXPECT_EQ(arena.FreeCellCount(), 97);
+  EXPECT_EQ(arena.AddSnake({4, 5}, SnakeDirection::Up, 2), -1);
+  EXPECT_EQ(arena.AddSnake({1, 0}, SnakeDirection::Right, 3), -1);
+}
+
+TEST(SnakeArenaTest, WallKillsSnakeAndFreesItsCells) {
+  SnakeArena arena(10, 10, 0, 1);
+  int id = arena.AddSnake({9, 0}, SnakeDirection::Right, 3);
+  arena.Tick();
+
+  EXPECT_FALSE(arena.IsAlive(id));
+  EXPECT_EQ(arena.AliveCount(), 0);
+  EXPECT_EQ(arena.FreeCellCount(), 100);
+  EXPECT_EQ(CountOwned(arena, 1), 0);
+}
+
+TEST(SnakeArenaTest, HeadToHeadKillsBoth) {
+  SnakeArena arena(10, 10, 0, 1);
+  int left = arena.AddSnake({3, 5}, SnakeDirection::Right, 2);
+  int right = arena.AddSnake({5, 5}, SnakeDirection::Left, 2);
+  arena.Tick();
+
+  EXPECT_FALSE(arena.IsAlive(left));
+  EXPECT_FALSE(arena.IsAlive(right));
+  EXPECT_EQ(arena.FreeCellCount(), 100);
+}
+
+TEST(SnakeArenaTest, HeadIntoBodyKillsOnlyTheMover) {
+  SnakeArena arena(10, 10, 0, 1);
+  int wall = arena.AddSnake({5, 4}, SnakeDirection::Down, 4);
+  int mover = arena.AddSnake({3, 4}, SnakeDirection::Right, 2);
+  arena.Tick();
+  ASSERT_TRUE(arena.IsAlive(mover));
+
+  // Голова wall ушла на (5,5), в (5,4) осталось её тело.
+  arena.Tick();
+
+  EXPECT_FALSE(arena.IsAlive(mover));
+  EXPECT_TRUE(arena.IsAlive(wall));
+  EXPECT_EQ(arena.Length(wall), 4);
+  EXPECT_EQ(arena.Owner(5, 4), 1u);
+}
+
+TEST(SnakeArenaTest, AppleGrowsSnakeAndIsReplaced) {
+  SnakeArena arena(10, 10, 0, 1);
+  int id = arena.AddSnake({2, 2}, SnakeDirection::Right, 2);
+  ASSERT_TRUE(arena.PlaceApple({3, 2}));
+  EXPECT_EQ(arena.AppleCount(), 1);
+  EXPECT_FALSE(arena.PlaceApple({2, 2}));
+
+  arena.Tick();
+
+  EXPECT_TRUE(arena.IsAlive(id));
+  EXPECT_EQ(arena.Length(id), 3);
+  EXPECT_EQ(arena.Score(id), 1);
+  EXPECT_EQ(arena.AppleCount(), 0);
+  EXPECT_EQ(arena.Owner(3, 2), 1u);
+}
+
+TEST(SnakeArenaTest, SteerIgnoresReversal) {
+  SnakeArena arena(10, 10, 0, 1);
+  int id = arena.AddSnake({5, 5}, SnakeDirection::Right, 3);
+  arena.Steer(id, SnakeDirection::Left);
+  arena.Tick();
+
+  EXPECT_TRUE(arena.IsAlive(id));
+  EXPECT_EQ(arena.Direction(id), SnakeDirection::Right);
+  EXPECT_EQ(arena.Head(id).x, 6);
+}
+
+TEST(SnakeArenaTest, ThousandSnakesKeepGridConsistent) {
+  SnakeArena arena(1024, 1024, 256, 42);
+  for (int i = 0; i < 1000; ++i) ASSERT_GE(arena.AddRandomSnake(4), 0);
+  EXPECT_EQ(arena.AliveCount(), 1000);
+  EXPECT_EQ(arena.AppleCount(), 256);
+
+  for (int tick = 0; tick < 200; ++tick) {
+    arena.SteerBots();
+    arena.Tick();
+  }
+
+  int body_cells = 0;
+  for (int id = 0; id < arena.SnakeCount(); ++id) {
+    if (arena.IsAlive(id)) body_cells += arena.Length(id);
+  }
+  EXPECT_GT(arena.AliveCount(), 0);
+  EXPECT_EQ(arena.AppleCount(), 256);
+  EXPECT_EQ(arena.FreeCellCount(),
+            1024 * 1024 - body_cells - arena.AppleCount());
+  EXPECT_EQ(CountOwned(arena, SnakeArena::kEmpty), arena.FreeCellCount());
+}
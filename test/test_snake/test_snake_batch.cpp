@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "../../include/brickgame/snake/snake_batch.h"
+
+namespace {
+
+constexpr int kCells = SNAKE_BATCH_WIDTH * SNAKE_BATCH_HEIGHT;
+
+float PlaneSum(const float* obs, int plane) {
+  float sum = 0;
+  for (int i = 0; i < kCells; ++i) sum += obs[plane * kCells + i];
+  return sum;
+}
+
+}  // namespace
+
+TEST(SnakeBatchTest, ResetObservation) {
+  SnakeBatch* batch = snake_batch_create(3, 7, 0);
+  ASSERT_NE(batch, nullptr);
+  EXPECT_EQ(snake_batch_count(batch), 3);
+
+  std::vector<float> obs(3 * SNAKE_BATCH_OBS_SIZE, -1.0f);
+  snake_batch_reset(batch, obs.data());
+  for (int env = 0; env < 3; ++env) {
+    const float* o = obs.data() + env * SNAKE_BATCH_OBS_SIZE;
+    EXPECT_EQ(PlaneSum(o, 0), 4.0f);
+    EXPECT_EQ(PlaneSum(o, 1), 1.0f);
+    EXPECT_EQ(PlaneSum(o, 2), 1.0f);
+    // Голова в (3, 10), змейка идёт вправо.
+    EXPECT_EQ(o[kCells + 10 * SNAKE_BATCH_WIDTH + 3], 1.0f);
+    const float* features = o + SNAKE_BATCH_PLANES * kCells;
+    EXPECT_FLOAT_EQ(features[0], 4.0f / kCells);
+    EXPECT_EQ(features[4], 1.0f);
+  }
+  snake_batch_destroy(batch);
+}
+
+TEST(SnakeBatchTest, WallEndsEpisodeAndResets) {
+  SnakeBatch* batch = snake_batch_create(2, 1, 0);
+  std::vector<int32_t> actions(2, Right);
+  std::vector<float> obs(2 * SNAKE_BATCH_OBS_SIZE);
+  float rewards[2];
+  uint8_t dones[2];
+
+  // С x = 3 до стены шесть шагов, седьмой — в стену.
+  int steps = 0;
+  do {
+    snake_batch_step(batch, actions.data(), obs.data(), rewards, dones);
+    ++steps;
+  } while (!dones[0] && steps < 20);
+  EXPECT_EQ(steps, 7);
+  EXPECT_EQ(dones[1], 1);
+
+  EXPECT_EQ(PlaneSum(obs.data(), 0), 4.0f);
+  EXPECT_EQ(obs[kCells + 10 * SNAKE_BATCH_WIDTH + 3], 1.0f);
+  snake_batch_destroy(batch);
+}
+
+TEST(SnakeBatchTest, MaxStepsTruncatesEpisode) {
+  SnakeBatch* batch = snake_batch_create(1, 1, 3);
+  int32_t action = Up;
+  uint8_t done = 0;
+  for (int i = 0; i < 2; ++i) {
+    snake_batch_step(batch, &action, nullptr, nullptr, &done);
+    EXPECT_EQ(done, 0);
+  }
+  snake_batch_step(batch, &action, nullptr, nullptr, &done);
+  EXPECT_EQ(done, 1);
+  snake_batch_destroy(batch);
+}
+
+TEST(SnakeBatchTest, SameSeedSameEpisodes) {
+  SnakeBatch* a = snake_batch_create(4, 42, 50);
+  SnakeBatch* b = snake_batch_create(4, 42, 50);
+  std::vector<float> obs_a(4 * SNAKE_BATCH_OBS_SIZE);
+  std::vector<float> obs_b(4 * SNAKE_BATCH_OBS_SIZE);
+  std::vector<float> rewards_a(4), rewards_b(4);
+  const int32_t cycle[] = {Up, Left, Down, Right, Right, Down};
+
+  for (int step = 0; step < 200; ++step) {
+    std::vector<int32_t> actions(4);
+    for (int env = 0; env < 4; ++env) actions[env] = cycle[(step + env) % 6];
+    snake_batch_step(a, actions.data(), obs_a.data(), rewards_a.data(),
+                     nullptr);
+    snake_batch_step(b, actions.data(), obs_b.data(), rewards_b.data(),
+                     nullptr);
+    ASSERT_EQ(obs_a, obs_b) << "step " << step;
+    ASSERT_EQ(rewards_a, rewards_b);
+  }
+  snake_batch_destroy(a);
+  snake_batch_destroy(b);
+}
+
+TEST(SnakeBatchTest, RejectsEmptyBatch) {
+  EXPECT_EQ(snake_batch_create(0, 1, 0), nullptr);
+  EXPECT_EQ(snake_batch_count(nullptr), 0);
+}
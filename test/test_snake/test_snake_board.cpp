@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "../../include/brickgame/snake/snake_game.hpp"
+
+TEST(SnakeBoardTest, DynamicBoardClampsSides) {
+  s21::DynamicSnakeGame game(2, 1000);
+  EXPECT_EQ(game.FieldWidth(), s21::kMinBoardSide);
+  EXPECT_EQ(game.FieldHeight(), s21::kMaxBoardSide);
+}
+
+TEST(SnakeBoardTest, FixedBoardIsClassic) {
+  s21::SnakeGame game;
+  EXPECT_EQ(game.FieldWidth(), kGameWidth);
+  EXPECT_EQ(game.FieldHeight(), kGameHeight);
+}
+
+TEST(SnakeBoardTest, DynamicBoardRunsToItsOwnWall) {
+  const int width = 30;
+  s21::DynamicSnakeGame game(width, 8);
+  game.Resume();
+
+  // Голова стартует в x = 3 и идёт вправо до стены.
+  int steps = 0;
+  while (game.GetState() == s21::SnakeGameState::Running && steps < 100) {
+    game.Tick();
+    ++steps;
+  }
+  EXPECT_EQ(game.GetState(), s21::SnakeGameState::Lost);
+  EXPECT_EQ(steps, width - 3);
+
+  GameInfo_t frame = game.GetFrame();
+  ASSERT_NE(frame.field, nullptr);
+  for (int y = 0; y < 8; ++y) EXPECT_NE(frame.field[y], nullptr);
+}
+
+TEST(SnakeBoardTest, SnapshotKeepsBoardSize) {
+  s21::DynamicSnakeGame classic(kGameWidth, kGameHeight);
+  s21::DynamicSnakeGame wide(16, 16);
+  s21::SnakeGame fixed;
+  classic.Resume();
+  wide.Resume();
+
+  std::vector<unsigned char> buf(classic.SaveState(nullptr, 0));
+  classic.SaveState(buf.data(), buf.size());
+  EXPECT_TRUE(fixed.LoadState(buf.data(), buf.size()));
+  EXPECT_EQ(fixed.GetState(), classic.GetState());
+
+  buf.resize(wide.SaveState(nullptr, 0));
+  wide.SaveState(buf.data(), buf.size());
+  EXPECT_FALSE(fixed.LoadState(buf.data(), buf.size()));
+}
+
+TEST(SnakeBoardTest, PackedFieldMatchesFrame) {
+  s21::SnakeGame game;
+  game.Resume();
+  for (int i = 0; i < 3; ++i) game.Tick();
+
+  ASSERT_EQ(game.ExportPackedField(nullptr, 0), 50u);
+  unsigned char packed[50];
+  ASSERT_EQ(game.ExportPackedField(packed, sizeof(packed)), 50u);
+
+  GameInfo_t frame = game.GetFrame();
+  std::vector<int> cells(kGameWidth * kGameHeight, -1);
+  std::vector<int*> rows(kGameHeight);
+  for (int y = 0; y < kGameHeight; ++y) rows[y] = &cells[y * kGameWidth];
+  packed_grid_unpack(packed, kGameWidth, kGameHeight, rows.data());
+
+  int apples = 0;
+  for (int y = 0; y < kGameHeight; ++y) {
+    for (int x = 0; x < kGameWidth; ++x) {
+      EXPECT_EQ(rows[y][x], frame.field[y][x]);
+      apples += rows[y][x] == static_cast<int>(CellType::Apple);
+    }
+  }
+  EXPECT_EQ(apples, 1);
+}
+
+TEST(SnakeBoardTest, SessionCloneContinuesIdentically) {
+  static_assert(sizeof(s21::SnakeState) < 1024);
+  s21::SnakeGame game;
+  game.SetHighScoreFile(false);
+  game.Seed(11);
+  game.Resume();
+  for (int i = 0; i < 3; ++i) game.Tick();
+
+  // Клон — побайтовая копия состояния в другой объект.
+  s21::SnakeState state;
+  std::memcpy(static_cast<void*>(&state), &game.Session(), sizeof(state));
+  s21::SnakeGame clone;
+  clone.SetHighScoreFile(false);
+  ASSERT_TRUE(clone.RestoreSession(state));
+
+  const UserAction_t turns[] = {Down, Left, Down, Right, Up, Right};
+  for (int i = 0; i < 40; ++i) {
+    game.ChangeDirection(turns[i % 6]);
+    clone.ChangeDirection(turns[i % 6]);
+    game.Tick();
+    clone.Tick();
+    ASSERT_EQ(clone.GetState(), game.GetState());
+    EXPECT_EQ(clone.Score(), game.Score());
+    EXPECT_EQ(clone.Head().x, game.Head().x);
+    EXPECT_EQ(clone.Head().y, game.Head().y);
+    EXPECT_EQ(std::memcmp(clone.Field().data(), game.Field().data(),
+                          game.Field().size()),
+              0);
+  }
+}
+
+TEST(SnakeBoardTest, RestoreSessionRejectsOtherBoardSize) {
+  s21::DynamicSnakeGame small(8, 8);
+  s21::DynamicSnakeGame wide(16, 8);
+  EXPECT_FALSE(small.RestoreSession(wide.Session()));
+  EXPECT_TRUE(small.RestoreSession(s21::DynamicSnakeGame(8, 8).Session()));
+}
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <cstdlib>
+#include <vector>
+
 #include "../../include/brickgame/snake/snake_api.h"
+#include "../alloc_guard/alloc_guard.h"
 
 class SnakeGameTest : public ::testing::Test {
  protected:
@@ -515,3 +519,194 @@ TEST_F(SnakeGameTest, AccelerateDisable) {
   EXPECT_NE(info.field, nullptr);
   freeGameInfo(&info);
 }
+
+namespace {
+std::vector<int> SnapshotField(const GameInfo_t& info) {
+  std::vector<int> cells;
+  for (int y = 0; y < 20; ++y) {
+    for (int x = 0; x < 10; ++x) cells.push_back(info.field[y][x]);
+  }
+  cells.push_back(info.score);
+  cells.push_back(info.level);
+  return cells;
+}
+
+std::vector<std::vector<int>> PlayTicks(int ticks) {
+  std::vector<std::vector<int>> frames;
+  const UserAction_t turns[] = {Down, Left, Up, Right};
+  for (int i = 0; i < ticks; ++i) {
+    if (i % 3 == 0) userInput(turns[(i / 3) % 4], false);
+    GameInfo_t info = updateCurrentState();
+    frames.push_back(SnapshotField(info));
+    ::freeGameInfo(&info);
+  }
+  return frames;
+}
+}  // namespace
+
+TEST_F(SnakeGameTest, SaveStateRoundTripIsDeterministic) {
+  userInput(Start, false);
+  PlayTicks(3);
+
+  std::vector<unsigned char> blob(saveGameState(nullptr, 0));
+  ASSERT_GT(blob.size(), 0u);
+  ASSERT_EQ(saveGameState(blob.data(), blob.size()), blob.size());
+
+  bool over_before = isGameOver();
+  auto first = PlayTicks(40);
+
+  ASSERT_TRUE(loadGameState(blob.data(), blob.size()));
+  EXPECT_EQ(isGameOver(), over_before);
+  auto second = PlayTicks(40);
+
+  EXPECT_EQ(first, second);
+}
+
+TEST_F(SnakeGameTest, LoadStateRejectsDamagedBlob) {
+  userInput(Start, false);
+  std::vector<unsigned char> blob(saveGameState(nullptr, 0));
+  saveGameState(blob.data(), blob.size());
+
+  EXPECT_FALSE(loadGameState(blob.data(), blob.size() - 1));
+  EXPECT_FALSE(loadGameState(nullptr, 0));
+
+  std::vector<unsigned char> broken = blob;
+  broken[0] ^= 0xFF;
+  EXPECT_FALSE(loadGameState(broken.data(), broken.size()));
+
+  EXPECT_TRUE(loadGameState(blob.data(), blob.size()));
+}
+
+namespace {
+/// Правая граница змейки в стартовой строке (голова при движении вправо).
+int HeadColumn(const GameInfo_t& info) {
+  int head = -1;
+  for (int x = 0; x < 10; ++x) {
+    if (info.field[10][x] == 1) head = x;
+  }
+  return head;
+}
+
+int AdvanceAndGetHead(int elapsed_ms) {
+  GameInfo_t info = advanceState(elapsed_ms);
+  int head = HeadColumn(info);
+  ::freeGameInfo(&info);
+  return head;
+}
+}  // namespace
+
+TEST_F(SnakeGameTest, AdvanceAccumulatesElapsedTime) {
+  userInput(Terminate, false);
+  userInput(Start, false);
+
+  EXPECT_EQ(AdvanceAndGetHead(0), 3);
+  EXPECT_EQ(AdvanceAndGetHead(599), 3);
+  EXPECT_EQ(AdvanceAndGetHead(1), 4);
+  EXPECT_EQ(AdvanceAndGetHead(300), 4);
+  EXPECT_EQ(AdvanceAndGetHead(900), 6);
+}
+
+TEST_F(SnakeGameTest, AdvanceHandlesSmallFrontendTicks) {
+  userInput(Terminate, false);
+  userInput(Start, false);
+
+  // 60 Гц: 37 кадров по 16 мс = 592 мс, 38-й кадр переходит за 600 мс.
+  for (int i = 0; i < 37; ++i) EXPECT_EQ(AdvanceAndGetHead(16), 3);
+  EXPECT_EQ(AdvanceAndGetHead(16), 4);
+}
+
+TEST_F(SnakeGameTest, AdvanceIgnoresTimeWhilePaused) {
+  userInput(Terminate, false);
+  userInput(Start, false);
+  userInput(Pause, false);
+
+  EXPECT_EQ(AdvanceAndGetHead(5000), 3);
+
+  userInput(Pause, false);
+  EXPECT_EQ(AdvanceAndGetHead(599), 3);
+  EXPECT_EQ(AdvanceAndGetHead(1), 4);
+}
+
+TEST_F(SnakeGameTest, FrameBufferIsReusedAcrossTicks) {
+  userInput(Terminate, false);
+  userInput(Start, false);
+
+  GameInfo_t first = updateCurrentState();
+  GameInfo_t second = updateCurrentState();
+  EXPECT_EQ(first.field, second.field);
+  EXPECT_EQ(HeadColumn(second), 5);
+
+  ::freeGameInfo(&second);
+  EXPECT_EQ(second.field, nullptr);
+}
+
+namespace {
+/// Аллокатор, считающий вызовы поверх malloc/free.
+struct CountingAllocator {
+  int allocations = 0;
+
+  static void* Allocate(void* context, size_t size) {
+    static_cast<CountingAllocator*>(context)->allocations++;
+    return std::malloc(size);
+  }
+  static void Deallocate(void*, void* ptr, size_t) { std::free(ptr); }
+  BrickGameAllocator Hooks() { return {Allocate, Deallocate, this}; }
+};
+}  // namespace
+
+TEST_F(SnakeGameTest, TicksDoNotAllocate) {
+  CountingAllocator counter;
+  BrickGameAllocator hooks = counter.Hooks();
+  setAllocator(&hooks);
+  userInput(Terminate, false);
+  userInput(Start, false);
+
+  const UserAction_t inputs[] = {Down, Right, Up, Right, Action};
+  for (int i = 0; i < 3000; ++i) {
+    if (isGameOver()) {
+      userInput(Start, false);
+    } else {
+      userInput(inputs[(i / 3) % 5], i % 11 == 0);
+    }
+    alloc_guard_arm();
+    GameInfo_t info = (i % 2) ? updateCurrentState() : advanceState(700);
+    ::freeGameInfo(&info);
+    ASSERT_EQ(alloc_guard_disarm(), 0u) << "tick " << i;
+    BrickGameAllocStats stats = tickAllocStats();
+    ASSERT_EQ(stats.allocations, 0u) << "tick " << i;
+    ASSERT_EQ(stats.frees, 0u) << "tick " << i;
+  }
+  EXPECT_EQ(counter.allocations, 0);
+  setAllocator(nullptr);
+}
+
+TEST_F(SnakeGameTest, QuickTurnsWithinOneTickAreNotLost) {
+  userInput(Terminate, false);
+  userInput(Start, false);
+
+  // Змейка едет вправо, голова в (3, 10). «Вниз, затем влево» внутри
+  // одного тика раньше теряло первый поворот, а второй отбрасывался
+  // как разворот; теперь повороты применяются на двух шагах подряд.
+  userInput(Down, false);
+  userInput(Left, false);
+
+  GameInfo_t info = updateCurrentState();
+  EXPECT_EQ(info.field[11][3], 1);
+  info = updateCurrentState();
+  EXPECT_EQ(info.field[11][2], 1);
+  EXPECT_FALSE(isGameOver());
+}
+
+TEST_F(SnakeGameTest, QueuedTurnRejectsReversalOfPreviousTurn) {
+  userInput(Terminate, false);
+  userInput(Start, false);
+
+  // Вверх противоположен уже поставленному в очередь повороту вниз.
+  userInput(Down, false);
+  userInput(Up, false);
+
+  GameInfo_t info = updateCurrentState();
+  EXPECT_EQ(info.field[11][3], 1);
+  info = updateCurrentState();
+  EXPECT_EQ(info.field[12][3], 1);
+}
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../../include/brickgame/snake/snake_soa.hpp"
+
+using namespace s21;
+
+namespace {
+
+/// Не кратно шестнадцати: последняя группа ядра дополнена стоящими
+/// дорожками.
+constexpr int kEnvs = 61;
+constexpr std::uint32_t kSeed = 2024;
+
+std::vector<SnakeGame> MakeGames(int count, std::uint32_t seed) {
+  SnakeGame prototype;
+  prototype.SetHighScoreFile(false);
+  std::vector<SnakeGame> games(static_cast<std::size_t>(count), prototype);
+  for (int i = 0; i < count; ++i) {
+    games[i].Seed(seed + static_cast<std::uint32_t>(i));
+    games[i].Reset();
+    games[i].Resume();
+  }
+  return games;
+}
+
+/**
+ * @brief Действие «чаще к яблоку», иногда случайное: змейки успевают
+ *        вырасти, а не только разбиться о стену.
+ */
+std::int32_t Policy(const SnakeSoaBatch& batch, int env, std::mt19937& rng) {
+  std::uniform_int_distribution<int> coin(0, 3);
+  if (coin(rng) == 0) return Left + coin(rng);
+  SnakeSegment head = batch.Head(env);
+  SnakeSegment apple = batch.Apple(env);
+  if (apple.x != head.x) return apple.x < head.x ? Left : Right;
+  if (apple.y != head.y) return apple.y < head.y ? Up : Down;
+  return Start;
+}
+
+void ExpectSame(SnakeGame& game, const SnakeSoaBatch& batch, int env,
+                int step) {
+  SCOPED_TRACE(testing::Message() << "env " << env << ", step " << step);
+  ASSERT_EQ(batch.State(env), game.GetState());
+  EXPECT_EQ(batch.Direction(env), game.Direction());
+  EXPECT_EQ(batch.Length(env), game.Length());
+  EXPECT_EQ(batch.Score(env), game.Score());
+  EXPECT_EQ(batch.Level(env), game.GetFrame().level);
+  EXPECT_EQ(batch.Head(env).x, game.Head().x);
+  EXPECT_EQ(batch.Head(env).y, game.Head().y);
+  for (int y = 0; y < kGameHeight; ++y) {
+    for (int x = 0; x < kGameWidth; ++x) {
+      ASSERT_EQ(batch.Cell(env, x, y), game.Field().get(x, y))
+          << "cell " << x << "," << y;
+    }
+  }
+}
+
+/**
+ * @brief Пакет и набор SnakeGame идут одними действиями; закончившиеся
+ *        партии начинаются заново в обоих.
+ */
+void RunMatch(bool simd) {
+  SnakeSoaBatch batch(kEnvs, kSeed);
+  batch.SetSimd(simd);
+  std::vector<SnakeGame> games = MakeGames(kEnvs, kSeed);
+  std::mt19937 rng(5);
+  std::vector<std::int32_t> actions(kEnvs);
+  int eaten = 0;
+
+  for (int step = 0; step < 1000; ++step) {
+    for (int env = 0; env < kEnvs; ++env) {
+      actions[env] = Policy(batch, env, rng);
+      if (actions[env] >= Left && actions[env] <= Down) {
+        games[env].ChangeDirection(static_cast<UserAction_t>(actions[env]));
+      }
+      games[env].Update();
+    }
+    batch.Step(actions.data());
+
+    std::vector<int> finished;
+    for (int env = 0; env < kEnvs; ++env) {
+      ExpectSame(games[env], batch, env, step);
+      if (testing::Test::HasFatalFailure()) return;
+      if (batch.State(env) != SnakeGameState::Running) {
+        eaten += batch.Score(env);
+        games[env].Reset();
+        games[env].Resume();
+        finished.push_back(env);
+      }
+    }
+    // Чётные шаги перезапускают по одной партии, нечётные — разом.
+    if (step % 2 == 0) {
+      for (int env : finished) batch.Reset(env);
+    } else {
+      ASSERT_EQ(batch.ResetFinished(), static_cast<int>(finished.size()));
+    }
+    for (int env : finished) ExpectSame(games[env], batch, env, step);
+  }
+  EXPECT_GT(eaten, 100);
+}
+
+/**
+ * @brief Бот на гамильтоновом цикле: столбцы 1..9 змейкой по строкам,
+ *        столбец 0 ведёт наверх. Не проигрывает и доедает поле.
+ */
+std::int32_t CycleTurn(SnakeSegment head) {
+  if (head.x == 0) return head.y == 0 ? Right : Up;
+  if (head.y % 2 == 0) return head.x < kGameWidth - 1 ? Right : Down;
+  if (head.x > 1) return Left;
+  return head.y == kGameHeight - 1 ? Left : Down;
+}
+
+/**
+ * @brief Две партии бота подряд до победы: во второй часы партий
+ *        переходят kClockLimit и переносятся (Rebase()).
+ */
+void RunCycleToWin(bool simd) {
+  constexpr int kCycleEnvs = 17;
+  SnakeSoaBatch batch(kCycleEnvs, kSeed);
+  batch.SetSimd(simd);
+  std::vector<SnakeGame> games = MakeGames(kCycleEnvs, kSeed);
+  std::vector<std::int32_t> actions(kCycleEnvs);
+
+  for (int round = 0; round < 2; ++round) {
+    int won = 0;
+    for (int step = 0; won < kCycleEnvs; ++step) {
+      ASSERT_LT(step, 50000);
+      for (int env = 0; env < kCycleEnvs; ++env) {
+        actions[env] = CycleTurn(batch.Head(env));
+        games[env].ChangeDirection(static_cast<UserAction_t>(actions[env]));
+        games[env].Update();
+      }
+      batch.Step(actions.data());
+
+      won = 0;
+      for (int env = 0; env < kCycleEnvs; ++env) {
+        ASSERT_EQ(batch.State(env), games[env].GetState()) << "step " << step;
+        ASSERT_EQ(batch.Length(env), games[env].Length()) << "step " << step;
+        if (step % 1000 == 0) ExpectSame(games[env], batch, env, step);
+        won += batch.State(env) == SnakeGameState::Won;
+      }
+    }
+    for (int env = 0; env < kCycleEnvs; ++env) {
+      EXPECT_EQ(batch.Length(env), kGameWidth * kGameHeight);
+      ExpectSame(games[env], batch, env, -1);
+      games[env].Reset();
+      games[env].Resume();
+    }
+    ASSERT_EQ(batch.ResetFinished(), kCycleEnvs);
+  }
+}
+
+}  // namespace
+
+TEST(SnakeSoaTest, StartsLikeSnakeGame) {
+  SnakeSoaBatch batch(3, kSeed);
+  std::vector<SnakeGame> games = MakeGames(3, kSeed);
+  for (int env = 0; env < 3; ++env) {
+    ExpectSame(games[env], batch, env, 0);
+    EXPECT_EQ(batch.Segment(env, 0).x, 3);
+    EXPECT_EQ(batch.Segment(env, 3).x, 0);
+    EXPECT_EQ(batch.Segment(env, 3).y, kGameHeight / 2);
+  }
+}
+
+TEST(SnakeSoaTest, ScalarMatchesSnakeGame) { RunMatch(false); }
+
+TEST(SnakeSoaTest, SimdMatchesSnakeGame) {
+  if (!SnakeSoaBatch::SimdAvailable()) GTEST_SKIP() << "no AVX2";
+  RunMatch(true);
+}
+
+TEST(SnakeSoaTest, ScalarCycleBotWins) { RunCycleToWin(false); }
+
+TEST(SnakeSoaTest, SimdCycleBotWins) {
+  if (!SnakeSoaBatch::SimdAvailable()) GTEST_SKIP() << "no AVX2";
+  RunCycleToWin(true);
+}
+
+TEST(SnakeSoaTest, OppositeTurnIgnoredAndWallKills) {
+  SnakeSoaBatch batch(9, 1);
+  std::vector<std::int32_t> actions(9, Left);
+  batch.Step(actions.data());
+  for (int env = 0; env < 9; ++env) {
+    EXPECT_EQ(batch.Direction(env), SnakeDirection::Right);
+    EXPECT_EQ(batch.Head(env).x, 4);
+  }
+
+  // Без действий до стены ещё пять шагов, шестой — в стену.
+  for (int i = 0; i < 5; ++i) batch.Step(nullptr);
+  EXPECT_EQ(batch.State(0), SnakeGameState::Running);
+  batch.Step(nullptr);
+  for (int env = 0; env < 9; ++env) {
+    EXPECT_EQ(batch.State(env), SnakeGameState::Lost);
+    EXPECT_EQ(batch.Head(env).x, kGameWidth - 1);
+  }
+
+  batch.Step(nullptr);
+  EXPECT_EQ(batch.State(8), SnakeGameState::Lost);
+  batch.Reset(8);
+  EXPECT_EQ(batch.State(8), SnakeGameState::Running);
+  EXPECT_EQ(batch.Length(8), 4);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../../include/brickgame/tetris/tetris_batch.h"
+
+namespace {
+
+constexpr int kCells = TETRIS_FIELD_WIDTH * TETRIS_FIELD_HEIGHT;
+
+float PlaneSum(const float* obs, int plane) {
+  float sum = 0;
+  for (int i = 0; i < kCells; ++i) sum += obs[plane * kCells + i];
+  return sum;
+}
+
+}  // namespace
+
+TEST(TetrisBatchTest, ResetObservation) {
+  TetrisBatch* batch = tetris_batch_create(2, 5, 0);
+  ASSERT_NE(batch, nullptr);
+  EXPECT_EQ(tetris_batch_count(batch), 2);
+
+  std::vector<float> obs(2 * TETRIS_BATCH_OBS_SIZE, -1.0f);
+  tetris_batch_reset(batch, obs.data());
+  for (int env = 0; env < 2; ++env) {
+    const float* o = obs.data() + env * TETRIS_BATCH_OBS_SIZE;
+    EXPECT_EQ(PlaneSum(o, 0), 0.0f);
+    const float* next = o + TETRIS_BATCH_PLANES * kCells;
+    float next_cells = 0;
+    for (int i = 0; i < 16; ++i) next_cells += next[i];
+    EXPECT_EQ(next_cells, 4.0f);
+    EXPECT_FLOAT_EQ(next[16], 1.0f / TETRIS_MAX_LEVEL);
+  }
+  tetris_batch_destroy(batch);
+}
+
+TEST(TetrisBatchTest, PieceFallsAndLocks) {
+  TetrisBatch* batch = tetris_batch_create(1, 5, 0);
+  std::vector<float> obs(TETRIS_BATCH_OBS_SIZE);
+  int32_t action = Down;
+  uint8_t done = 0;
+  float reward = 0;
+
+  // Фигура падает по две клетки за шаг и ложится на дно.
+  for (int i = 0; i < 15 && PlaneSum(obs.data(), 0) == 0.0f; ++i) {
+    tetris_batch_step(batch, &action, obs.data(), &reward, &done);
+    EXPECT_EQ(done, 0);
+    EXPECT_EQ(reward, 0.0f);
+  }
+  EXPECT_EQ(PlaneSum(obs.data(), 0), 4.0f);
+  tetris_batch_destroy(batch);
+}
+
+TEST(TetrisBatchTest, GameOverResetsBoard) {
+  TetrisBatch* batch = tetris_batch_create(1, 9, 0);
+  std::vector<float> obs(TETRIS_BATCH_OBS_SIZE);
+  int32_t action = Terminate;  // без действия: фигуры копятся в столбце
+  uint8_t done = 0;
+  int steps = 0;
+  while (!done && steps < 1000) {
+    tetris_batch_step(batch, &action, obs.data(), nullptr, &done);
+    ++steps;
+  }
+  EXPECT_EQ(done, 1);
+  EXPECT_LT(steps, 1000);
+  EXPECT_EQ(PlaneSum(obs.data(), 0), 0.0f);
+  tetris_batch_destroy(batch);
+}
+
+TEST(TetrisBatchTest, SameSeedSameEpisodesAndEnvsDiffer) {
+  TetrisBatch* a = tetris_batch_create(3, 11, 100);
+  TetrisBatch* b = tetris_batch_create(3, 11, 100);
+  std::vector<float> obs_a(3 * TETRIS_BATCH_OBS_SIZE);
+  std::vector<float> obs_b(3 * TETRIS_BATCH_OBS_SIZE);
+  std::vector<uint8_t> dones_a(3), dones_b(3);
+  const int32_t cycle[] = {Left, Action, Right, Down, Right, Left, Up};
+
+  bool envs_differ = false;
+  for (int step = 0; step < 300; ++step) {
+    int32_t actions[3];
+    for (int env = 0; env < 3; ++env) actions[env] = cycle[step % 7];
+    tetris_batch_step(a, actions, obs_a.data(), nullptr, dones_a.data());
+    tetris_batch_step(b, actions, obs_b.data(), nullptr, dones_b.data());
+    ASSERT_EQ(obs_a, obs_b) << "step " << step;
+    ASSERT_EQ(dones_a, dones_b);
+    envs_differ |= !std::equal(obs_a.begin(),
+                               obs_a.begin() + TETRIS_BATCH_OBS_SIZE,
+                               obs_a.begin() + TETRIS_BATCH_OBS_SIZE);
+  }
+  EXPECT_TRUE(envs_differ);
+  tetris_batch_destroy(a);
+  tetris_batch_destroy(b);
+}
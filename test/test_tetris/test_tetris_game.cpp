@@ -1,6 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "../include/brickgame/common/packed_grid.h"
 #include "../include/brickgame/tetris/game.h"
+#include "../alloc_guard/alloc_guard.h"
 
 class TetrisGameTest : public ::testing::Test {
  protected:
@@ -446,3 +452,366 @@ TEST_F(TetrisGameTest, LineClearingEdgeCase) {
   EXPECT_NE(final_info.field, nullptr);
   freeGameInfo(&final_info);
 }
+
+namespace {
+std::vector<int> SnapshotFrame(const GameInfo_t& info) {
+  std::vector<int> cells;
+  for (int y = 0; y < 20; ++y) {
+    for (int x = 0; x < 10; ++x) cells.push_back(info.field[y][x]);
+  }
+  for (int y = 0; y < 4; ++y) {
+    for (int x = 0; x < 4; ++x) cells.push_back(info.next[y][x]);
+  }
+  cells.push_back(info.score);
+  return cells;
+}
+
+std::vector<std::vector<int>> PlayTicks(int ticks) {
+  std::vector<std::vector<int>> frames;
+  const UserAction_t moves[] = {Left, Action, Right, Down};
+  for (int i = 0; i < ticks; ++i) {
+    userInput(moves[i % 4], false);
+    GameInfo_t info = updateCurrentState();
+    frames.push_back(SnapshotFrame(info));
+  }
+  return frames;
+}
+}  // namespace
+
+TEST_F(TetrisGameTest, SaveStateRoundTripIsDeterministic) {
+  userInput(Start, false);
+  PlayTicks(5);
+
+  std::vector<unsigned char> blob(saveGameState(nullptr, 0));
+  ASSERT_GT(blob.size(), 0u);
+  ASSERT_EQ(saveGameState(blob.data(), blob.size()), blob.size());
+
+  auto first = PlayTicks(120);
+  ASSERT_TRUE(loadGameState(blob.data(), blob.size()));
+  auto second = PlayTicks(120);
+
+  EXPECT_EQ(first, second);
+}
+
+TEST_F(TetrisGameTest, LoadStateRestoresFsmState) {
+  userInput(Start, false);
+  updateCurrentState();
+  userInput(Pause, false);
+
+  std::vector<unsigned char> blob(saveGameState(nullptr, 0));
+  saveGameState(blob.data(), blob.size());
+
+  userInput(Pause, false);
+  userInput(Terminate, false);
+  EXPECT_TRUE(isGameOver());
+
+  ASSERT_TRUE(loadGameState(blob.data(), blob.size()));
+  EXPECT_FALSE(isGameOver());
+  EXPECT_TRUE(updateCurrentState().pause);
+
+  userInput(Pause, false);
+}
+
+TEST_F(TetrisGameTest, LoadStateRejectsDamagedBlob) {
+  std::vector<unsigned char> blob(saveGameState(nullptr, 0));
+  saveGameState(blob.data(), blob.size());
+
+  EXPECT_FALSE(loadGameState(blob.data(), blob.size() - 1));
+  std::vector<unsigned char> broken = blob;
+  broken[4] ^= 0xFF;
+  EXPECT_FALSE(loadGameState(broken.data(), broken.size()));
+  EXPECT_TRUE(loadGameState(blob.data(), blob.size()));
+}
+
+TEST_F(TetrisGameTest, PackedFieldMatchesFrame) {
+  userInput(Start, false);
+  PlayTicks(40);
+
+  ASSERT_EQ(exportPackedField(nullptr, 0), 50u);
+  unsigned char packed[50];
+  EXPECT_EQ(exportPackedField(packed, sizeof(packed) - 1), 50u);
+  ASSERT_EQ(exportPackedField(packed, sizeof(packed)), 50u);
+
+  GameInfo_t info = updateCurrentState();
+  int cells[20][10];
+  int* rows[20];
+  for (int y = 0; y < 20; ++y) rows[y] = cells[y];
+  exportPackedField(packed, sizeof(packed));
+  packed_grid_unpack(packed, 10, 20, rows);
+  for (int y = 0; y < 20; ++y) {
+    for (int x = 0; x < 10; ++x) EXPECT_EQ(cells[y][x], info.field[y][x]);
+  }
+}
+
+namespace {
+/// Поля совпадают: строки, фигуры, счёт и генератор фигур.
+bool SameBoard(const TetrisBoard& a, const TetrisBoard& b) {
+  return std::memcmp(a.rows, b.rows, sizeof(a.rows)) == 0 && a.top == b.top &&
+         std::memcmp(&a.current, &b.current, sizeof(a.current)) == 0 &&
+         std::memcmp(&a.next, &b.next, sizeof(a.next)) == 0 &&
+         a.score == b.score && a.level == b.level &&
+         a.rng_state == b.rng_state && a.locks == b.locks;
+}
+}  // namespace
+
+TEST_F(TetrisGameTest, CopyBoardClonesRunningGame) {
+  // Игра общая для тестов: в конце она возвращается к этому снимку.
+  std::vector<unsigned char> initial(saveGameState(nullptr, 0));
+  saveGameState(initial.data(), initial.size());
+  userInput(Start, false);
+  PlayTicks(40);
+
+  TetrisBoard clone;
+  copyBoard(&clone);
+  GameInfo_t info = updateCurrentState();
+  EXPECT_EQ(clone.score, info.score);
+  EXPECT_EQ(clone.level, info.level);
+
+  // Клон не связан с игрой: партия идёт дальше, копия не меняется.
+  TetrisBoard before = clone;
+  PlayTicks(10);
+  EXPECT_TRUE(SameBoard(before, clone));
+
+  // Снимок восстанавливает то же поле, что даёт копия.
+  std::vector<unsigned char> blob(saveGameState(nullptr, 0));
+  saveGameState(blob.data(), blob.size());
+  copyBoard(&before);
+  PlayTicks(10);
+  ASSERT_TRUE(loadGameState(blob.data(), blob.size()));
+  copyBoard(&clone);
+  EXPECT_TRUE(SameBoard(before, clone));
+
+  ASSERT_TRUE(loadGameState(initial.data(), initial.size()));
+}
+
+namespace {
+/// Верхняя занятая строка поля (или 20, если поле пустое).
+int TopFilledRow(const GameInfo_t& info) {
+  for (int y = 0; y < 20; ++y) {
+    for (int x = 0; x < 10; ++x) {
+      if (info.field[y][x]) return y;
+    }
+  }
+  return 20;
+}
+
+/// Нижняя занятая строка поля (или -1, если поле пустое).
+int BottomFilledRow(const GameInfo_t& info) {
+  for (int y = 19; y >= 0; --y) {
+    for (int x = 0; x < 10; ++x) {
+      if (info.field[y][x]) return y;
+    }
+  }
+  return -1;
+}
+
+/// Начинает новую партию на пустом поле.
+void RestartGame() {
+  userInput(Terminate, false);
+  updateCurrentState();
+  userInput(Start, false);
+  updateCurrentState();
+}
+}  // namespace
+
+TEST_F(TetrisGameTest, FixedFrameModeKeepsConstantSpeed) {
+  setTetrisTiming(16, 30);
+  RestartGame();
+
+  GameInfo_t info = updateCurrentState();
+  EXPECT_EQ(info.speed, 16);
+
+  setTetrisTiming(0, 0);
+  info = updateCurrentState();
+  EXPECT_EQ(info.speed, 600);
+}
+
+TEST_F(TetrisGameTest, GravityAccumulatesAcrossFrames) {
+  setTetrisTiming(16, 30);
+  RestartGame();
+
+  // Уровень 1: 16/600 клетки за кадр — строка примерно за 38 кадров.
+  GameInfo_t info = updateCurrentState();
+  int start = BottomFilledRow(info);
+  for (int i = 0; i < 30; ++i) info = updateCurrentState();
+  EXPECT_LE(BottomFilledRow(info) - start, 1);
+
+  for (int i = 0; i < 60; ++i) info = updateCurrentState();
+  EXPECT_GE(BottomFilledRow(info) - start, 2);
+
+  setTetrisTiming(0, 0);
+}
+
+TEST_F(TetrisGameTest, LockDelayPostponesFixing) {
+  const int kLockDelay = 10;
+  setTetrisTiming(16, kLockDelay);
+  RestartGame();
+
+  for (int i = 0; i < 10; ++i) userInput(Down, true);
+  GameInfo_t info = updateCurrentState();
+  ASSERT_GT(TopFilledRow(info), 10);
+
+  // Пока идёт задержка, новая фигура не появляется наверху.
+  for (int i = 0; i < kLockDelay - 1; ++i) {
+    info = updateCurrentState();
+    EXPECT_GT(TopFilledRow(info), 2);
+  }
+
+  bool spawned = false;
+  for (int i = 0; i < 5 && !spawned; ++i) {
+    info = updateCurrentState();
+    spawned = TopFilledRow(info) <= 2;
+  }
+  EXPECT_TRUE(spawned);
+
+  setTetrisTiming(0, 0);
+}
+
+TEST_F(TetrisGameTest, StartRightAfterGameOverRestartsInSameBuffers) {
+  RestartGame();
+  GameInfo_t info = updateCurrentState();
+  int** field = info.field;
+
+  for (int i = 0; i < 2000 && !isGameOver(); ++i) {
+    userInput(Down, true);
+    info = updateCurrentState();
+  }
+  ASSERT_TRUE(isGameOver());
+
+  // Start без промежуточного кадра в состоянии game over.
+  userInput(Start, false);
+  info = updateCurrentState();
+  EXPECT_FALSE(isGameOver());
+  EXPECT_EQ(info.field, field);
+  EXPECT_LE(BottomFilledRow(info), 3);
+}
+
+namespace {
+/// Аллокатор, считающий вызовы поверх malloc/free.
+struct CountingAllocator {
+  int allocations = 0;
+  int frees = 0;
+
+  static void* Allocate(void* context, size_t size) {
+    static_cast<CountingAllocator*>(context)->allocations++;
+    return std::malloc(size);
+  }
+  static void Deallocate(void* context, void* ptr, size_t) {
+    static_cast<CountingAllocator*>(context)->frees++;
+    std::free(ptr);
+  }
+  BrickGameAllocator Hooks() { return {Allocate, Deallocate, this}; }
+};
+}  // namespace
+
+TEST_F(TetrisGameTest, FrameBuffersUseInstalledAllocator) {
+  const BrickGameApi* api = brickgame_tetris_get_api();
+  CountingAllocator counter;
+  BrickGameAllocator hooks = counter.Hooks();
+  api->shutdown();
+  setAllocator(&hooks);
+
+  updateCurrentState();
+  BrickGameAllocStats first = tickAllocStats();
+  EXPECT_EQ(first.allocations, static_cast<uint64_t>(counter.allocations));
+  EXPECT_GT(first.bytes, 0u);
+
+  // Смена аллокатора: буферы освобождаются тем, кто их выделил.
+  setAllocator(nullptr);
+  api->shutdown();
+  EXPECT_EQ(counter.frees, counter.allocations);
+  api->init();
+}
+
+TEST_F(TetrisGameTest, TicksDoNotAllocate) {
+  CountingAllocator counter;
+  BrickGameAllocator hooks = counter.Hooks();
+  RestartGame();
+  setAllocator(&hooks);
+
+  const UserAction_t inputs[] = {Left, Action, Right, Down, Up};
+  for (int i = 0; i < 3000; ++i) {
+    if (isGameOver()) {
+      userInput(Start, false);
+    } else {
+      userInput(inputs[i % 5], i % 7 == 0);
+    }
+    alloc_guard_arm();
+    updateCurrentState();
+    ASSERT_EQ(alloc_guard_disarm(), 0u) << "tick " << i;
+    BrickGameAllocStats stats = tickAllocStats();
+    ASSERT_EQ(stats.allocations, 0u) << "tick " << i;
+    ASSERT_EQ(stats.frees, 0u) << "tick " << i;
+  }
+  EXPECT_EQ(counter.allocations, 0);
+  setAllocator(nullptr);
+}
+
+namespace {
+/// Левая занятая колонка поля (или 10, если поле пустое).
+int LeftFilledColumn(const GameInfo_t& info) {
+  for (int x = 0; x < 10; ++x) {
+    for (int y = 0; y < 20; ++y) {
+      if (info.field[y][x]) return x;
+    }
+  }
+  return 10;
+}
+}  // namespace
+
+TEST_F(TetrisGameTest, QueuedInputIsAppliedAtTickBoundary) {
+  setTetrisTiming(16, 30);
+  RestartGame();
+  // Фигура появляется частично над полем: опускаем её целиком в кадр.
+  for (int i = 0; i < 3; ++i) userInput(Down, false);
+  setInputsPerTick(1);
+
+  GameInfo_t info = updateCurrentState();
+  int start = LeftFilledColumn(info);
+
+  // Два нажатия внутри одного кадра применяются по одному за тик.
+  userInput(Left, false);
+  userInput(Left, false);
+  info = updateCurrentState();
+  EXPECT_EQ(LeftFilledColumn(info), start - 1);
+  info = updateCurrentState();
+  EXPECT_EQ(LeftFilledColumn(info), start - 2);
+  info = updateCurrentState();
+  EXPECT_EQ(LeftFilledColumn(info), start - 2);
+
+  // Пауза отбрасывает ввод, не дождавшийся тика.
+  userInput(Right, false);
+  userInput(Pause, false);
+  userInput(Pause, false);
+  info = updateCurrentState();
+  EXPECT_EQ(LeftFilledColumn(info), start - 2);
+
+  setInputsPerTick(0);
+  setTetrisTiming(0, 0);
+}
+
+TEST_F(TetrisGameTest, QueuedInputSurvivesSaveAndLoad) {
+  setTetrisTiming(16, 30);
+  RestartGame();
+  // Фигура появляется частично над полем: опускаем её целиком в кадр.
+  for (int i = 0; i < 3; ++i) userInput(Down, false);
+  setInputsPerTick(1);
+  updateCurrentState();
+
+  userInput(Left, false);
+  userInput(Left, false);
+  std::vector<unsigned char> blob(saveGameState(nullptr, 0));
+  saveGameState(blob.data(), blob.size());
+
+  updateCurrentState();
+  int expected = LeftFilledColumn(updateCurrentState());
+
+  // Очередь и число действий за тик восстанавливаются из снимка.
+  setInputsPerTick(0);
+  ASSERT_TRUE(loadGameState(blob.data(), blob.size()));
+  updateCurrentState();
+  EXPECT_EQ(LeftFilledColumn(updateCurrentState()), expected);
+
+  setInputsPerTick(0);
+  setTetrisTiming(0, 0);
+}
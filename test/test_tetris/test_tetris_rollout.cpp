@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "../../include/brickgame/tetris/rollout.h"
+
+namespace {
+
+constexpr int kI[4][4] = {
+    {0, 0, 0, 0}, {1, 1, 1, 1}, {0, 0, 0, 0}, {0, 0, 0, 0}};
+constexpr int kO[4][4] = {
+    {0, 0, 0, 0}, {0, 1, 1, 0}, {0, 1, 1, 0}, {0, 0, 0, 0}};
+
+void SetPiece(Tetromino* piece, const int shape[4][4]) {
+  std::memcpy(piece->shape, shape, sizeof(piece->shape));
+  piece->x = 3;
+  piece->y = -2;
+}
+
+/**
+ * @brief Пустое поле классического режима: падает I, следом O.
+ */
+TetrisBoard MakeBoard() {
+  TetrisBoard board{};
+  SetPiece(&board.current, kI);
+  SetPiece(&board.next, kO);
+  board.level = 1;
+  board.rng_state = 7;
+  return board;
+}
+
+/**
+ * @brief Заполняет строку y кроме столбца hole.
+ */
+void FillRow(TetrisBoard* board, int y, int hole) {
+  for (int x = 0; x < TETRIS_FIELD_WIDTH; ++x) {
+    tetris_board_set_cell(board, x, y, x == hole ? 0 : 1);
+  }
+}
+
+/**
+ * @brief Заполняет строки [from, TETRIS_FIELD_HEIGHT) кроме столбца hole.
+ */
+void FillRows(TetrisBoard* board, int from, int hole) {
+  for (int y = from; y < TETRIS_FIELD_HEIGHT; ++y) FillRow(board, y, hole);
+}
+
+TetrisRolloutConfig MakeConfig(TetrisRolloutPolicy policy, int threads) {
+  TetrisRolloutConfig config{};
+  config.rollouts = 16;
+  config.depth = 6;
+  config.policy = policy;
+  config.seed = 99;
+  config.threads = threads;
+  return config;
+}
+
+}  // namespace
+
+TEST(TetrisRolloutTest, EnumeratesDistinctPlacements) {
+  TetrisBoard board = MakeBoard();
+  TetrisRolloutConfig config = MakeConfig(TETRIS_ROLLOUT_RANDOM, 1);
+  config.depth = 0;
+  TetrisPlacementStats stats[TETRIS_ROLLOUT_MAX_PLACEMENTS];
+  // I: 7 горизонтальных и 10 вертикальных, повороты на 180 совпадают.
+  ASSERT_EQ(tetris_rollout_evaluate(&board, &config, stats,
+                                    TETRIS_ROLLOUT_MAX_PLACEMENTS),
+            17);
+  for (const TetrisPlacementStats& s : stats) {
+    if (&s == stats + 17) break;
+    EXPECT_EQ(s.lines, 0);
+    EXPECT_EQ(s.survival, 1.0);
+    EXPECT_EQ(s.mean_pieces, 1.0);
+  }
+
+  SetPiece(&board.current, kO);
+  EXPECT_EQ(tetris_rollout_evaluate(&board, &config, stats,
+                                    TETRIS_ROLLOUT_MAX_PLACEMENTS),
+            9);
+  EXPECT_EQ(tetris_rollout_evaluate(&board, &config, stats, 4), 4);
+}
+
+TEST(TetrisRolloutTest, RejectsBadConfig) {
+  TetrisBoard board = MakeBoard();
+  TetrisRolloutConfig config = MakeConfig(TETRIS_ROLLOUT_RANDOM, 1);
+  TetrisPlacementStats stats[TETRIS_ROLLOUT_MAX_PLACEMENTS];
+  config.rollouts = 0;
+  EXPECT_EQ(tetris_rollout_evaluate(&board, &config, stats, 1), -1);
+  config.rollouts = 1;
+  config.depth = -1;
+  EXPECT_EQ(tetris_rollout_evaluate(&board, &config, stats, 1), -1);
+  EXPECT_EQ(tetris_rollout_best(stats, 0), -1);
+}
+
+TEST(TetrisRolloutTest, SameStatsForAnyThreadCount) {
+  TetrisBoard board = MakeBoard();
+  FillRows(&board, 16, 4);
+  TetrisPlacementStats one[TETRIS_ROLLOUT_MAX_PLACEMENTS];
+  TetrisPlacementStats many[TETRIS_ROLLOUT_MAX_PLACEMENTS];
+
+  for (TetrisRolloutPolicy policy :
+       {TETRIS_ROLLOUT_RANDOM, TETRIS_ROLLOUT_GREEDY}) {
+    TetrisRolloutConfig config = MakeConfig(policy, 1);
+    int count = tetris_rollout_evaluate(&board, &config, one,
+                                        TETRIS_ROLLOUT_MAX_PLACEMENTS);
+    config.threads = 3;
+    ASSERT_EQ(tetris_rollout_evaluate(&board, &config, many,
+                                      TETRIS_ROLLOUT_MAX_PLACEMENTS),
+              count);
+    for (int i = 0; i < count; ++i) {
+      EXPECT_EQ(many[i].x, one[i].x);
+      EXPECT_EQ(many[i].rotation, one[i].rotation);
+      EXPECT_EQ(many[i].survival, one[i].survival);
+      EXPECT_EQ(many[i].mean_lines, one[i].mean_lines);
+      EXPECT_EQ(many[i].mean_score, one[i].mean_score);
+      EXPECT_EQ(many[i].mean_pieces, one[i].mean_pieces);
+    }
+  }
+}
+
+TEST(TetrisRolloutTest, BestPlacementClearsFourLines) {
+  TetrisBoard board = MakeBoard();
+  FillRows(&board, 16, 9);
+  TetrisRolloutConfig config = MakeConfig(TETRIS_ROLLOUT_GREEDY, 0);
+  TetrisPlacementStats stats[TETRIS_ROLLOUT_MAX_PLACEMENTS];
+  int count = tetris_rollout_evaluate(&board, &config, stats,
+                                      TETRIS_ROLLOUT_MAX_PLACEMENTS);
+  int best = tetris_rollout_best(stats, count);
+  ASSERT_GE(best, 0);
+  EXPECT_EQ(stats[best].lines, 4);
+  EXPECT_EQ(stats[best].x, 7);
+  EXPECT_GE(stats[best].mean_lines, 4.0);
+  EXPECT_EQ(stats[best].survival, 1.0);
+
+  TetrisBoard placed = board;
+  EXPECT_EQ(tetris_rollout_place(&placed, stats[best].rotation, stats[best].x),
+            BACKEND_OK);
+  EXPECT_EQ(placed.last_cleared, 4);
+  EXPECT_EQ(placed.score, 1500);
+  for (int y = 0; y < TETRIS_FIELD_HEIGHT; ++y) {
+    EXPECT_EQ(placed.rows[tetris_board_row(&placed, y)], 0u);
+  }
+}
+
+TEST(TetrisRolloutTest, CrowdedBoardLowersSurvival) {
+  TetrisBoard board = MakeBoard();
+  TetrisRolloutConfig config = MakeConfig(TETRIS_ROLLOUT_RANDOM, 0);
+  TetrisPlacementStats stats[TETRIS_ROLLOUT_MAX_PLACEMENTS];
+  int count = tetris_rollout_evaluate(&board, &config, stats,
+                                      TETRIS_ROLLOUT_MAX_PLACEMENTS);
+  double empty = stats[tetris_rollout_best(stats, count)].survival;
+  EXPECT_EQ(empty, 1.0);
+
+  // Дыры в разных столбцах: линии не очищаются, до верха три строки.
+  for (int y = 3; y < TETRIS_FIELD_HEIGHT; ++y) FillRow(&board, y, y % 10);
+  count = tetris_rollout_evaluate(&board, &config, stats,
+                                  TETRIS_ROLLOUT_MAX_PLACEMENTS);
+  ASSERT_GT(count, 0);
+  int best = tetris_rollout_best(stats, count);
+  EXPECT_LT(stats[best].survival, 1.0);
+  for (int i = 0; i < count; ++i) {
+    EXPECT_LE(stats[i].survival, stats[best].survival);
+    EXPECT_GE(stats[i].mean_pieces, 1.0);
+    EXPECT_LE(stats[i].mean_pieces, config.depth + 1.0);
+  }
+}
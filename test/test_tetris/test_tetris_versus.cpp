@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "../../include/brickgame/tetris/versus.h"
+
+namespace {
+
+/// Кадры до следующей фиксации фигуры игрока (или до конца матча).
+void StepUntilLock(TetrisVersus* versus, int player) {
+  uint32_t locks = versus->players[player].board.locks;
+  for (int i = 0; i < 10000 && versus->players[player].board.locks == locks;
+       ++i) {
+    if (!tetris_versus_step(versus)) break;
+  }
+}
+
+void FillRow(TetrisBoard* board, int y) {
+  for (int x = 0; x < TETRIS_FIELD_WIDTH; ++x) {
+    tetris_board_set_cell(board, x, y, 1);
+  }
+}
+
+int RowCount(const TetrisBoard& board, int y) {
+  int count = 0;
+  for (int x = 0; x < TETRIS_FIELD_WIDTH; ++x) {
+    count += tetris_board_cell(&board, x, y);
+  }
+  return count;
+}
+
+/// Случайный ввод ботов, одинаковый для одного зерна.
+void PlayRandom(TetrisVersus* versus, uint32_t seed, int frames) {
+  const UserAction_t actions[] = {Left, Right, Down, Action};
+  for (int frame = 0; frame < frames && !versus->finished; ++frame) {
+    for (int player = 0; player < versus->count; ++player) {
+      seed = seed * 1664525u + 1013904223u;
+      if ((seed >> 28) < 6) {
+        tetris_versus_input(versus, player, actions[(seed >> 8) % 4], false);
+      }
+    }
+    tetris_versus_step(versus);
+  }
+}
+
+}  // namespace
+
+TEST(TetrisVersusTest, InitGivesEveryPlayerTheSamePieces) {
+  TetrisVersus versus;
+  tetris_versus_init(&versus, 3, 7, 0, -1);
+
+  EXPECT_EQ(versus.count, 3);
+  EXPECT_EQ(versus.alive, 3);
+  EXPECT_EQ(versus.frame_ms, TETRIS_VERSUS_FRAME_MS);
+  for (int i = 1; i < 3; ++i) {
+    EXPECT_EQ(std::memcmp(versus.players[i].board.current.shape,
+                          versus.players[0].board.current.shape,
+                          sizeof(versus.players[0].board.current.shape)),
+              0);
+    EXPECT_EQ(versus.players[i].board.rng_state,
+              versus.players[0].board.rng_state);
+  }
+}
+
+TEST(TetrisVersusTest, SameSeedAndInputReplayIdentically) {
+  TetrisVersus first, second;
+  tetris_versus_init(&first, 2, 12345, 16, 10);
+  tetris_versus_init(&second, 2, 12345, 16, 10);
+  PlayRandom(&first, 99, 5000);
+  PlayRandom(&second, 99, 5000);
+
+  EXPECT_EQ(first.frame, second.frame);
+  EXPECT_EQ(first.finished, second.finished);
+  EXPECT_EQ(first.winner, second.winner);
+  for (int i = 0; i < 2; ++i) {
+    const TetrisBoard& a = first.players[i].board;
+    const TetrisBoard& b = second.players[i].board;
+    EXPECT_EQ(a.score, b.score);
+    EXPECT_EQ(a.locks, b.locks);
+    for (int y = 0; y < TETRIS_FIELD_HEIGHT; ++y) {
+      for (int x = 0; x < TETRIS_FIELD_WIDTH; ++x) {
+        EXPECT_EQ(tetris_board_cell(&a, x, y), tetris_board_cell(&b, x, y));
+      }
+    }
+  }
+}
+
+TEST(TetrisVersusTest, PendingGarbageIsInsertedAtBottomOnLock) {
+  TetrisVersus versus;
+  tetris_versus_init(&versus, 2, 1, 16, 0);
+  tetris_versus_send_garbage(&versus, 1, 2);
+  EXPECT_EQ(versus.players[1].pending_garbage, 2);
+
+  StepUntilLock(&versus, 1);
+
+  const TetrisBoard& board = versus.players[1].board;
+  EXPECT_EQ(versus.players[1].pending_garbage, 0);
+  EXPECT_EQ(versus.players[1].lines_received, 2);
+  EXPECT_EQ(RowCount(board, TETRIS_FIELD_HEIGHT - 1), TETRIS_FIELD_WIDTH - 1);
+  EXPECT_EQ(RowCount(board, TETRIS_FIELD_HEIGHT - 2), TETRIS_FIELD_WIDTH - 1);
+  for (int x = 0; x < TETRIS_FIELD_WIDTH; ++x) {
+    EXPECT_EQ(tetris_board_cell(&board, x, TETRIS_FIELD_HEIGHT - 1),
+              tetris_board_cell(&board, x, TETRIS_FIELD_HEIGHT - 2));
+  }
+  // Зафиксированная фигура поднялась вместе с полем.
+  EXPECT_GT(RowCount(board, TETRIS_FIELD_HEIGHT - 3), 0);
+}
+
+TEST(TetrisVersusTest, ClearedLinesAttackOpponent) {
+  TetrisVersus versus;
+  tetris_versus_init(&versus, 2, 1, 16, 0);
+  FillRow(&versus.players[0].board, TETRIS_FIELD_HEIGHT - 1);
+  FillRow(&versus.players[0].board, TETRIS_FIELD_HEIGHT - 2);
+
+  StepUntilLock(&versus, 0);
+
+  EXPECT_EQ(versus.players[0].board.last_cleared, 2);
+  EXPECT_EQ(versus.players[0].lines_sent, 1);
+  EXPECT_EQ(versus.players[1].pending_garbage, 1);
+}
+
+TEST(TetrisVersusTest, ClearedLinesCancelPendingGarbage) {
+  TetrisVersus versus;
+  tetris_versus_init(&versus, 2, 1, 16, 0);
+  tetris_versus_send_garbage(&versus, 0, 3);
+  FillRow(&versus.players[0].board, TETRIS_FIELD_HEIGHT - 1);
+  FillRow(&versus.players[0].board, TETRIS_FIELD_HEIGHT - 2);
+  FillRow(&versus.players[0].board, TETRIS_FIELD_HEIGHT - 3);
+
+  StepUntilLock(&versus, 0);
+
+  EXPECT_EQ(versus.players[0].pending_garbage, 1);
+  EXPECT_EQ(versus.players[0].lines_sent, 0);
+  EXPECT_EQ(versus.players[1].pending_garbage, 0);
+}
+
+TEST(TetrisVersusTest, GarbageOverflowKnocksPlayerOut) {
+  TetrisVersus versus;
+  tetris_versus_init(&versus, 2, 1, 16, 0);
+  tetris_versus_send_garbage(&versus, 0, 100);
+  EXPECT_EQ(versus.players[0].pending_garbage, TETRIS_FIELD_HEIGHT);
+
+  StepUntilLock(&versus, 0);
+
+  EXPECT_FALSE(versus.players[0].alive);
+  EXPECT_TRUE(versus.finished);
+  EXPECT_EQ(versus.winner, 1);
+  EXPECT_FALSE(tetris_versus_step(&versus));
+}
+
+TEST(TetrisVersusTest, AdvanceStepsWholeFramesAndCarriesRemainder) {
+  TetrisVersus versus;
+  tetris_versus_init(&versus, 2, 1, 10, 30);
+
+  EXPECT_EQ(tetris_versus_advance(&versus, 25), 2);
+  EXPECT_EQ(versus.clock_ms, 5u);
+  EXPECT_EQ(tetris_versus_advance(&versus, 5), 1);
+  EXPECT_EQ(versus.clock_ms, 0u);
+  EXPECT_EQ(tetris_versus_advance(&versus, 1000), TETRIS_VERSUS_MAX_CATCHUP);
+  EXPECT_LT(versus.clock_ms, 10u);
+  EXPECT_EQ(versus.frame, 3u + TETRIS_VERSUS_MAX_CATCHUP);
+}
+
+TEST(TetrisVersusTest, ViewCopiesBoardWithFallingPiece) {
+  TetrisVersus versus;
+  tetris_versus_init(&versus, 2, 1, 16, 30);
+  for (int i = 0; i < 5; ++i) tetris_versus_step(&versus);
+
+  int rows[TETRIS_FIELD_HEIGHT][TETRIS_FIELD_WIDTH] = {};
+  int next_rows[TETRIS_FIGURE_SIZE][TETRIS_FIGURE_SIZE] = {};
+  int* field[TETRIS_FIELD_HEIGHT];
+  int* next[TETRIS_FIGURE_SIZE];
+  for (int y = 0; y < TETRIS_FIELD_HEIGHT; ++y) field[y] = rows[y];
+  for (int y = 0; y < TETRIS_FIGURE_SIZE; ++y) next[y] = next_rows[y];
+
+  GameInfo_t info = {};
+  info.field = field;
+  info.next = next;
+  tetris_versus_view(&versus, 1, &info);
+
+  int filled = 0;
+  for (int y = 0; y < TETRIS_FIELD_HEIGHT; ++y) {
+    for (int x = 0; x < TETRIS_FIELD_WIDTH; ++x) filled += rows[y][x];
+  }
+  EXPECT_GT(filled, 0);
+  EXPECT_EQ(info.level, 1);
+  EXPECT_EQ(info.speed, 16);
+}